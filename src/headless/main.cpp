@@ -1,7 +1,10 @@
+#include <charconv>
 #include <chrono>
 #include <filesystem>
+#include <iterator>
 #include <memory>
 #include <random>
+#include <string_view>
 
 #include <fmt/base.h>
 #include <fmt/chrono.h>
@@ -20,6 +23,8 @@
 #include <openvic-simulation/economy/GoodDefinition.hpp>
 #include <openvic-simulation/economy/production/ProductionType.hpp>
 #include <openvic-simulation/economy/production/ResourceGatheringOperation.hpp>
+#include <openvic-simulation/military/UnitInstanceGroup.hpp>
+#include <openvic-simulation/misc/InstanceChecksum.hpp>
 #include <openvic-simulation/pathfinding/AStarPathing.hpp>
 #include <openvic-simulation/testing/Testing.hpp>
 #include <openvic-simulation/utility/Logger.hpp>
@@ -44,11 +49,15 @@ inline static void print_memory_usage( //
 }
 
 static void print_help(FILE* file, std::string_view program_name) {
-	fmt::println(file, "Usage: {} [-h] [-t] [-b <path>] [path]+", program_name);
+	fmt::println(file, "Usage: {} [-h] [-t] [-b <path>] [-c <path>] [-d <ticks>] [path]+", program_name);
 	fmt::println(file, "    -h : Print this help message and exit the program.");
 	fmt::println(file, "    -t : Run tests after loading defines.");
 	fmt::println(file, "    -b : Use the following path as the base directory (instead of searching for one).");
 	fmt::println(file, "    -s : Use the following path as a hint to search for a base directory.");
+	fmt::println(file, "    -c : Cache data derived from the map images at the following path, to speed up later runs.");
+	fmt::println(
+		file, "    -d : Run the game twice for the following number of ticks, comparing their checksums after every tick."
+	);
 	fmt::println(
 		file,
 		"Any following paths are read as mods (/path/to/my/MODNAME.mod), with priority starting at one above the base "
@@ -181,8 +190,108 @@ struct SinkGuard {
 	}
 };
 
+static void report_divergence(
+	InstanceManager& instance_manager, const size_t tick, InstanceChecksum::divergence_t const& divergence
+) {
+	const std::string_view section_name = InstanceSave::get_section_name(divergence.section);
+	if (!divergence.entity_index.has_value()) {
+		spdlog::error_s("Runs diverged after tick {} in the {} section!", tick, section_name);
+		return;
+	}
+
+	const size_t index = *divergence.entity_index;
+	switch (divergence.section) {
+		case InstanceChecksum::section_t::MARKETS:
+			spdlog::error_s(
+				"Runs diverged after tick {} in the {} section, first at {}!", tick, section_name,
+				instance_manager.get_good_instance_manager().get_good_instances()[index]
+			);
+			break;
+		case InstanceChecksum::section_t::COUNTRIES:
+			spdlog::error_s(
+				"Runs diverged after tick {} in the {} section, first at {}!", tick, section_name,
+				instance_manager.get_country_instance_manager().get_country_instances()[index]
+			);
+			break;
+		case InstanceChecksum::section_t::PROVINCES:
+			spdlog::error_s(
+				"Runs diverged after tick {} in the {} section, first at {}!", tick, section_name,
+				instance_manager.get_map_instance().get_province_instances()[index]
+			);
+			break;
+		case InstanceChecksum::section_t::UNITS: {
+			UnitInstanceManager const& unit_instance_manager = instance_manager.get_unit_instance_manager();
+			const size_t army_count = unit_instance_manager.get_armies().size();
+			const std::string_view unit_group_name = index < army_count
+				? std::next(unit_instance_manager.get_armies().begin(), index)->get_name()
+				: std::next(unit_instance_manager.get_navies().begin(), index - army_count)->get_name();
+			spdlog::error_s(
+				"Runs diverged after tick {} in the {} section, first at unit group {}!", tick, section_name, unit_group_name
+			);
+			break;
+		}
+		default:
+			spdlog::error_s("Runs diverged after tick {} in the {} section, first at index {}!", tick, section_name, index);
+			break;
+	}
+}
+
+/* Runs the game twice from the same bookmark, checking that both runs have the same checksum after every tick. The first
+ * run's checksums are kept, so only one instance exists at a time. */
+static bool run_desync_check(GameManager& game_manager, const size_t tick_count) {
+	Bookmark const& bookmark = game_manager.get_definition_manager()
+		.get_history_manager()
+		.get_bookmark_manager()
+		.get_front_bookmark();
+
+	memory::vector<InstanceChecksum> first_run_checksums;
+	first_run_checksums.reserve(tick_count + 1);
+	InstanceChecksum second_run_checksum;
+
+	for (size_t run = 1; run <= 2; ++run) {
+		SPDLOG_INFO("===== Desync check run {}... =====", run);
+		if (!game_manager.setup_instance(bookmark) || !game_manager.start_game_session() || !game_manager.update_clock()) {
+			spdlog::error_s("Failed to start desync check run {}!", run);
+			game_manager.end_game_session();
+			return false;
+		}
+		InstanceManager& instance_manager = *game_manager.get_instance_manager();
+
+		// Tick 0 is the state after the bookmark's initial gamestate update
+		for (size_t tick = 0; tick <= tick_count; ++tick) {
+			if (tick > 0) {
+				instance_manager.force_tick_and_update();
+			}
+
+			InstanceChecksum& checksum = run == 1 ? first_run_checksums.emplace_back() : second_run_checksum;
+			if (!InstanceChecksum::compute(instance_manager, checksum)) {
+				game_manager.end_game_session();
+				return false;
+			}
+
+			if (run == 2) {
+				const std::optional<InstanceChecksum::divergence_t> divergence =
+					first_run_checksums[tick].find_first_divergence(checksum);
+				if (divergence.has_value()) {
+					report_divergence(instance_manager, tick, *divergence);
+					game_manager.end_game_session();
+					return false;
+				}
+			}
+		}
+
+		game_manager.end_game_session();
+	}
+
+	SPDLOG_INFO("Runs matched for {} ticks, final checksum: {:016x}", tick_count, first_run_checksums.back().total);
+	return true;
+}
+
 static size_t info_count = 0, warning_count = 0, error_count = 0, critical_count = 0;
-static bool run_headless(fs::path const& root, memory::vector<memory::string>& mods, bool run_tests) {
+static bool run_headless(
+	fs::path const& root, memory::vector<memory::string>& mods, fs::path const& derived_map_cache_path, bool run_tests,
+	const size_t desync_check_ticks
+) {
 	bool ret = true;
 	Dataloader::path_vector_t roots = { root };
 	Dataloader::path_vector_t replace_paths = {};
@@ -219,11 +328,8 @@ static bool run_headless(fs::path const& root, memory::vector<memory::string>& m
 	ret &= game_manager.load_mods(mods);
 
 	SPDLOG_INFO("===== Loading definitions... =====");
-	ret &= game_manager.load_definitions(
-		[](std::string_view key, Dataloader::locale_t locale, std::string_view localisation) -> bool {
-			return true;
-		}
-	);
+	game_manager.set_derived_map_cache_path(derived_map_cache_path);
+	ret &= game_manager.load_definitions();
 
 	print_memory_usage("Definition Setup");
 
@@ -369,21 +475,28 @@ static bool run_headless(fs::path const& root, memory::vector<memory::string>& m
 	SPDLOG_INFO("===== Ending game session... =====");
 	ret &= game_manager.end_game_session();
 
+	if (ret && desync_check_ticks > 0) {
+		SPDLOG_INFO("===== Desync check... =====");
+		ret &= run_desync_check(game_manager, desync_check_ticks);
+	}
+
 	SPDLOG_INFO("Max Memory Usage: {} Bytes", OpenVic::memory::MemoryTracker::get_max_memory_usage());
 
 	return ret;
 }
 
 /*
-	$ program [-h] [-t] [-b] [path]+
+	$ program [-h] [-t] [-b] [-c] [-d] [path]+
 */
 
 int main(int argc, char const* argv[]) {
 	std::string_view program_name = get_filename(argc > 0 ? argv[0] : "", "<program>");
 	fs::path root;
+	fs::path derived_map_cache_path;
 	memory::vector<memory::string> mods;
 	mods.reserve(argc);
 	bool run_tests = false;
+	size_t desync_check_ticks = 0;
 	int argn = 0;
 
 	/* Reads the next argument and converts it to a path via path_transform. If reading or converting fails, an error
@@ -427,6 +540,24 @@ int main(int argc, char const* argv[]) {
 			if (!_read("-s", "search hint", Dataloader::search_for_game_path)) {
 				return -1;
 			}
+		} else if (strcmp(arg, "-c") == 0) {
+			if (++argn < argc) {
+				derived_map_cache_path = argv[argn];
+			} else {
+				fmt::println(stderr, "Missing path after cache command line argument \"-c\".");
+				print_help(stderr, program_name);
+				return -1;
+			}
+		} else if (strcmp(arg, "-d") == 0) {
+			const std::string_view ticks_str = ++argn < argc ? argv[argn] : "";
+			const std::from_chars_result result = std::from_chars(
+				ticks_str.data(), ticks_str.data() + ticks_str.size(), desync_check_ticks
+			);
+			if (result.ec != std::errc {} || result.ptr != ticks_str.data() + ticks_str.size() || desync_check_ticks == 0) {
+				fmt::println(stderr, "Invalid tick count \"{}\" after desync check command line argument \"-d\".", ticks_str);
+				print_help(stderr, program_name);
+				return -1;
+			}
 		} else {
 			break;
 		}
@@ -445,7 +576,7 @@ int main(int argc, char const* argv[]) {
 
 	SPDLOG_INFO("!!! HEADLESS SIMULATION START !!!");
 
-	const bool ret = run_headless(root, mods, run_tests);
+	const bool ret = run_headless(root, mods, derived_map_cache_path, run_tests, desync_check_ticks);
 
 	SPDLOG_INFO("!!! HEADLESS SIMULATION END !!!");
 
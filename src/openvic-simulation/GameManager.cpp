@@ -7,11 +7,16 @@
 #include <range/v3/algorithm/contains.hpp>
 #include <range/v3/algorithm/find_if.hpp>
 
+#include <fmt/std.h>
+
 #include <spdlog/spdlog.h>
 
+#include "openvic-simulation/core/io/BinaryStream.hpp"
+#include "openvic-simulation/core/io/MappedFile.hpp"
 #include "openvic-simulation/core/memory/String.hpp"
 #include "openvic-simulation/core/memory/Vector.hpp"
 #include "openvic-simulation/dataloader/Dataloader.hpp"
+#include "openvic-simulation/misc/InstanceSave.hpp"
 #include "openvic-simulation/utility/Logger.hpp"
 
 using namespace OpenVic;
@@ -155,14 +160,19 @@ bool GameManager::load_definitions(Dataloader::localisation_callback_t localisat
 
 	bool ret = true;
 
+	dataloader.set_derived_map_cache_path(derived_map_cache_path);
+
 	if (!dataloader.load_defines(game_rules_manager, definition_manager)) {
 		spdlog::critical_s("Failed to load defines!");
 		ret = false;
 	}
 
-	if (!dataloader.load_localisation_files(localisation_callback)) {
+	if (!dataloader.load_localisation_store(localisation_store)) {
 		spdlog::error_s("Failed to load localisation!");
 		ret = false;
+	} else if (localisation_callback && !localisation_store.for_each_entry(localisation_callback)) {
+		spdlog::error_s("Localisation callback failed!");
+		ret = false;
 	}
 
 	definitions_loaded = true;
@@ -203,6 +213,63 @@ bool GameManager::is_bookmark_loaded() const {
 	return instance_manager && instance_manager->is_bookmark_loaded();
 }
 
+bool GameManager::save_game(fs::path const& path) const {
+	if (!instance_manager) {
+		spdlog::error_s("Cannot save game - instance manager not initialised!");
+		return false;
+	}
+
+	SPDLOG_INFO("Saving game to {}", path);
+
+	BinaryWriter writer;
+	if (!InstanceSave::write(*instance_manager, writer)) {
+		return false;
+	}
+	return writer.save_to_file(path);
+}
+
+bool GameManager::load_game(fs::path const& path) {
+	if (instance_manager) {
+		spdlog::error_s("Cannot load game - a game instance is already set up!");
+		return false;
+	}
+
+	MappedFile file;
+	if (!file.open(path)) {
+		return false;
+	}
+	BinaryReader reader { file.get_data() };
+
+	InstanceSave::header_t header;
+	if (!InstanceSave::read_header(reader, header)) {
+		spdlog::error_s("Failed to load game from {}", path);
+		return false;
+	}
+	if (header.definitions_fingerprint != InstanceSave::get_definitions_fingerprint(definition_manager)) {
+		spdlog::error_s("Cannot load game from {} - it was saved with different game data!", path);
+		return false;
+	}
+
+	BookmarkManager const& bookmark_manager = definition_manager.get_history_manager().get_bookmark_manager();
+	if (header.bookmark_index >= bookmark_manager.get_bookmark_count()) {
+		spdlog::error_s("Cannot load game from {} - invalid bookmark index {}!", path, header.bookmark_index);
+		return false;
+	}
+
+	SPDLOG_INFO("Loading game from {}", path);
+
+	if (
+		!setup_instance(bookmark_manager.get_bookmarks()[header.bookmark_index]) ||
+		!InstanceSave::read_sections(*instance_manager, header, reader)
+	) {
+		spdlog::error_s("Failed to load game from {}", path);
+		instance_manager.reset();
+		return false;
+	}
+
+	return true;
+}
+
 bool GameManager::start_game_session() {
 	if (!instance_manager || !instance_manager->is_game_instance_setup()) {
 		spdlog::error_s("Cannot start game session - instance manager not set up!");
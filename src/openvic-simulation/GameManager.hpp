@@ -7,6 +7,7 @@
 
 #include "openvic-simulation/core/memory/Vector.hpp"
 #include "openvic-simulation/dataloader/Dataloader.hpp"
+#include "openvic-simulation/dataloader/LocalisationStore.hpp"
 #include "openvic-simulation/dataloader/ModManager.hpp"
 #include "openvic-simulation/DefinitionManager.hpp"
 #include "openvic-simulation/gen/commit_info.gen.hpp"
@@ -25,9 +26,12 @@ namespace OpenVic {
 		Dataloader PROPERTY(dataloader);
 		DefinitionManager PROPERTY(definition_manager);
 		ModManager PROPERTY(mod_manager);
+		LocalisationStore PROPERTY(localisation_store);
 		std::optional<InstanceManager> instance_manager;
 
 		InstanceManager::gamestate_updated_func_t gamestate_updated_callback;
+		/* Where the map images' products are cached between runs, disabled if empty. */
+		fs::path PROPERTY(derived_map_cache_path);
 		bool PROPERTY_CUSTOM_PREFIX(definitions_loaded, are);
 		bool PROPERTY_CUSTOM_PREFIX(mod_descriptors_loaded, are);
 
@@ -57,12 +61,26 @@ namespace OpenVic {
 
 		bool load_mods(memory::vector<memory::string> const& mods_to_find);
 
-		bool load_definitions(Dataloader::localisation_callback_t localisation_callback);
+		/* Opts in to caching the map images' products at path, so later loads with unchanged map images and the same build
+		 * can skip processing them. Must be set before load_definitions to have any effect. */
+		inline void set_derived_map_cache_path(fs::path const& path) {
+			derived_map_cache_path = path;
+		}
+
+		/* Localisation is loaded into the localisation store, and each of its entries is also passed to
+		 * localisation_callback if it is set. */
+		bool load_definitions(Dataloader::localisation_callback_t localisation_callback = {});
 
 		bool setup_instance(Bookmark const& bookmark);
 		bool is_game_instance_setup() const;
 		bool is_bookmark_loaded() const;
 
+		/* Saves the instance's state to path, see InstanceSave. Must be called between ticks. */
+		bool save_game(fs::path const& path) const;
+		/* Sets up a new instance from the save's bookmark and applies the save to it, so no instance can already be set
+		 * up. The save must have been made with matching definitions, see InstanceSave::get_definitions_fingerprint. */
+		bool load_game(fs::path const& path);
+
 		bool start_game_session();
 		bool end_game_session();
 		bool is_game_session_active() const;
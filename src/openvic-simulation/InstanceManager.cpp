@@ -168,7 +168,7 @@ void InstanceManager::update_gamestate() {
 	update_modifier_sums();
 
 	// Update gamestate...
-	map_instance.update_gamestate(*this);
+	map_instance.update_gamestate();
 	country_instance_manager.update_gamestate(today, map_instance);
 	unit_instance_manager.update_gamestate();
 
@@ -236,10 +236,13 @@ bool InstanceManager::setup() {
 	thread_pool.initialise_threadpool(
 		game_rules_manager,
 		good_instance_manager,
+		map_instance,
+		definition_manager.get_define_manager().get_military_defines(),
 		definition_manager.get_modifier_manager().get_modifier_effect_cache(),
 		definition_manager.get_define_manager().get_pops_defines(),
 		definition_manager.get_economy_manager().get_production_type_manager(),
 		strata_index_t(definition_manager.get_pop_manager().get_strata_count()),
+		pop_type_index_t(definition_manager.get_pop_manager().get_pop_type_count()),
 		good_instance_manager.get_good_instances(),
 		country_instance_manager.get_country_instances(),
 		map_instance.get_province_instances()
@@ -305,7 +308,7 @@ bool InstanceManager::load_bookmark(Bookmark const& new_bookmark) {
 	OV_ERR_FAIL_COND_V_MSG(!all_has_state, false, "At least one land province has no state");
 
 	update_modifier_sums();
-	map_instance.initialise_for_new_game(*this);
+	map_instance.initialise_for_new_game();
 	country_instance_manager.update_gamestate(today, map_instance);
 	market_instance.execute_orders();
 
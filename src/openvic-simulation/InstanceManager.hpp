@@ -33,6 +33,8 @@ namespace OpenVic {
 
 	struct InstanceManager {
 		friend GameActionManager;
+		friend struct InstanceChecksum;
+		friend struct InstanceSave;
 
 		using gamestate_updated_func_t = fu2::function_base<true, true, fu2::capacity_can_hold<void*>, false, false, void()>;
 
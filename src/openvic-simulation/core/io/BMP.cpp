@@ -16,8 +16,7 @@ BMP::~BMP() {
 
 bool BMP::open(fs::path const& filepath) {
 	reset();
-	file.open(filepath, std::ios::binary);
-	if (file.fail()) {
+	if (!file.open(filepath)) {
 		spdlog::error_s("Failed to open BMP file \"{}\"", filepath);
 		close();
 		return false;
@@ -34,16 +33,12 @@ bool BMP::read_header() {
 		spdlog::error_s("Cannot read BMP header before opening a file");
 		return false;
 	}
-	file.seekg(0, std::ios::beg);
-	if (file.fail()) {
-		spdlog::error_s("Failed to move to the beginning of the BMP file!");
-		return false;
-	}
-	file.read(reinterpret_cast<char*>(&header), sizeof(header));
-	if (file.fail()) {
+	const std::span<const uint8_t> file_data = file.get_data();
+	if (file_data.size() < sizeof(header)) {
 		spdlog::error_s("Failed to read BMP header!");
 		return false;
 	}
+	std::memcpy(&header, file_data.data(), sizeof(header));
 
 	header_validated = true;
 
@@ -146,26 +141,22 @@ bool BMP::read_palette() {
 		spdlog::error_s("Cannot read BMP palette - header indicates this file doesn't have one");
 		return false;
 	}
-	file.seekg(sizeof(header), std::ios::beg);
-	if (file.fail()) {
-		spdlog::error_s("Failed to move to the palette in the BMP file!");
-		return false;
-	}
-	palette.resize(palette_size);
-	file.read(reinterpret_cast<char*>(palette.data()), palette_size * PALETTE_COLOUR_SIZE);
-	if (file.fail()) {
+	const std::span<const uint8_t> file_data = file.get_data();
+	const size_t palette_size_bytes = palette_size * PALETTE_COLOUR_SIZE;
+	if (file_data.size() < sizeof(header) + palette_size_bytes) {
 		spdlog::error_s("Failed to read BMP palette!");
-		palette.clear();
 		return false;
 	}
+	palette.resize(palette_size);
+	std::memcpy(palette.data(), file_data.data() + sizeof(header), palette_size_bytes);
 	palette_read = true;
 	return palette_read;
 }
 
 void BMP::close() {
-	if (file.is_open()) {
-		file.close();
-	}
+	file.close();
+	pixel_data = {};
+	pixel_data_read = false;
 }
 
 void BMP::reset() {
@@ -174,7 +165,7 @@ void BMP::reset() {
 	header_validated = false;
 	palette_size = 0;
 	palette.clear();
-	pixel_data.clear();
+	palette_read = false;
 }
 
 int32_t BMP::get_width() const {
@@ -209,19 +200,13 @@ bool BMP::read_pixel_data() {
 		spdlog::error_s("Cannot read pixel data before BMP header is validated!");
 		return false;
 	}
-	file.seekg(header.offset, std::ios::beg);
-	if (file.fail()) {
-		spdlog::error_s("Failed to move to the pixel data in the BMP file!");
-		return false;
-	}
-	const size_t pixel_data_size = get_width() * get_height() * header.bits_per_pixel / CHAR_BIT;
-	pixel_data.resize(pixel_data_size);
-	file.read(reinterpret_cast<char*>(pixel_data.data()), pixel_data_size);
-	if (file.fail()) {
+	const std::span<const uint8_t> file_data = file.get_data();
+	const size_t pixel_data_size = static_cast<size_t>(get_width()) * get_height() * header.bits_per_pixel / CHAR_BIT;
+	if (header.offset > file_data.size() || pixel_data_size > file_data.size() - header.offset) {
 		spdlog::error_s("Failed to read BMP pixel data!");
-		pixel_data.clear();
 		return false;
 	}
+	pixel_data = file_data.subspan(header.offset, pixel_data_size);
 	pixel_data_read = true;
 	return pixel_data_read;
 }
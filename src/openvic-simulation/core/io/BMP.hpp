@@ -1,9 +1,9 @@
 #pragma once
 
 #include <filesystem>
-#include <fstream>
 #include <span>
 
+#include "openvic-simulation/core/io/MappedFile.hpp"
 #include "openvic-simulation/core/memory/Vector.hpp"
 
 namespace OpenVic {
@@ -38,11 +38,12 @@ namespace OpenVic {
 		using palette_colour_t = uint32_t;
 
 	private:
-		std::ifstream file;
+		// The file is memory mapped, so pixel data is read in place rather than being copied out of the file
+		MappedFile file;
 		bool header_validated = false, palette_read = false, pixel_data_read = false;
 		uint32_t palette_size = 0;
 		memory::vector<palette_colour_t> palette;
-		memory::vector<uint8_t> pixel_data;
+		std::span<const uint8_t> pixel_data;
 
 	public:
 		static constexpr uint32_t PALETTE_COLOUR_SIZE = sizeof(palette_colour_t);
@@ -61,6 +62,7 @@ namespace OpenVic {
 		int32_t get_height() const;
 		uint16_t get_bits_per_pixel() const;
 		std::span<const palette_colour_t> get_palette() const;
+		/* Points into the mapped file, so it is only valid until the BMP is closed, reset or destroyed. */
 		std::span<const uint8_t> get_pixel_data() const;
 	};
 }
@@ -0,0 +1,37 @@
+#include "BinaryStream.hpp"
+
+#include <fstream>
+#include <system_error>
+
+#include <fmt/std.h>
+
+#include "openvic-simulation/utility/Logger.hpp"
+
+using namespace OpenVic;
+
+bool BinaryWriter::save_to_file(fs::path const& path) const {
+	std::error_code ec;
+	if (path.has_parent_path()) {
+		fs::create_directories(path.parent_path(), ec);
+	}
+
+	fs::path temporary_path = path;
+	temporary_path += ".tmp";
+	{
+		std::ofstream file { temporary_path, std::ios::binary | std::ios::trunc };
+		file.write(reinterpret_cast<char const*>(buffer.data()), buffer.size());
+		if (!file.good()) {
+			spdlog::error_s("Failed to write file \"{}\"", temporary_path);
+			file.close();
+			fs::remove(temporary_path, ec);
+			return false;
+		}
+	}
+	fs::rename(temporary_path, path, ec);
+	if (ec) {
+		spdlog::error_s("Failed to replace file \"{}\": {}", path, ec.message());
+		fs::remove(temporary_path, ec);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
+
+namespace OpenVic {
+	namespace fs = std::filesystem;
+
+	template<typename T>
+	concept binary_streamable = std::is_trivially_copyable_v<T>;
+
+	/* Appends values to a byte buffer in native byte order. Only suitable for data read back by the same build on the
+	 * same platform, such as caches, which must be keyed accordingly. */
+	struct BinaryWriter {
+	private:
+		memory::vector<uint8_t> buffer;
+
+	public:
+		template<binary_streamable T>
+		void write(T const& value) {
+			const size_t offset = buffer.size();
+			buffer.resize(offset + sizeof(T));
+			std::memcpy(buffer.data() + offset, &value, sizeof(T));
+		}
+
+		/* Writes the element count followed by the elements. */
+		template<binary_streamable T>
+		void write_span(std::span<const T> values) {
+			write<uint64_t>(values.size());
+			const size_t offset = buffer.size();
+			buffer.resize(offset + values.size_bytes());
+			if (!values.empty()) {
+				std::memcpy(buffer.data() + offset, values.data(), values.size_bytes());
+			}
+		}
+
+		void write_string(std::string_view string) {
+			write_span<char>(string);
+		}
+
+		/* Starts a span of bytes in the format written by write_span<uint8_t>, whose contents are written directly after
+		 * this call, so they don't need to be written to a separate buffer first. Returns the offset of the byte count,
+		 * which end_byte_span fills in once the contents have been written. */
+		size_t begin_byte_span() {
+			const size_t offset = buffer.size();
+			write<uint64_t>(0);
+			return offset;
+		}
+
+		void end_byte_span(const size_t count_offset) {
+			const uint64_t count = buffer.size() - count_offset - sizeof(uint64_t);
+			std::memcpy(buffer.data() + count_offset, &count, sizeof(count));
+		}
+
+		std::span<const uint8_t> get_data() const {
+			return buffer;
+		}
+
+		memory::vector<uint8_t> release() {
+			return std::move(buffer);
+		}
+
+		/* Discards the data but keeps the buffer's capacity, so the writer can be reused without reallocating. */
+		void clear() {
+			buffer.clear();
+		}
+
+		/* Writes the data to a temporary file next to path which then replaces path, so a reader never sees a partially
+		 * written file. Creates any missing parent directories, and logs an error and returns false on failure. */
+		bool save_to_file(fs::path const& path) const;
+	};
+
+	/* Reads values written by BinaryWriter. A read past the end of the data fails and leaves the reader failed, so
+	 * a whole sequence of reads can be checked once at the end. */
+	struct BinaryReader {
+	private:
+		std::span<const uint8_t> data;
+		size_t position = 0;
+		bool failed = false;
+
+		bool _can_read(const size_t size) {
+			if (failed || size > data.size() - position) {
+				failed = true;
+				return false;
+			}
+			return true;
+		}
+
+	public:
+		BinaryReader(std::span<const uint8_t> new_data) : data { new_data } {}
+
+		template<binary_streamable T>
+		bool read(T& value) {
+			if (!_can_read(sizeof(T))) {
+				return false;
+			}
+			std::memcpy(&value, data.data() + position, sizeof(T));
+			position += sizeof(T);
+			return true;
+		}
+
+		template<binary_streamable T>
+		bool read_vector(memory::vector<T>& values) {
+			uint64_t count = 0;
+			if (!read(count) || count > (data.size() - position) / sizeof(T)) {
+				failed = true;
+				return false;
+			}
+			values.resize(count);
+			if (count > 0) {
+				std::memcpy(values.data(), data.data() + position, count * sizeof(T));
+				position += count * sizeof(T);
+			}
+			return true;
+		}
+
+		/* Reads a span written by BinaryWriter::write_span<uint8_t> without copying it, so the returned span is only valid
+		 * as long as the data being read is. */
+		bool read_byte_span(std::span<const uint8_t>& bytes) {
+			uint64_t size = 0;
+			if (!read(size) || !_can_read(size)) {
+				failed = true;
+				return false;
+			}
+			bytes = data.subspan(position, static_cast<size_t>(size));
+			position += size;
+			return true;
+		}
+
+		/* The returned string_view points into the data being read, so it is only valid as long as that data is. */
+		bool read_string(std::string_view& string) {
+			uint64_t length = 0;
+			if (!read(length) || !_can_read(length)) {
+				failed = true;
+				return false;
+			}
+			string = { reinterpret_cast<char const*>(data.data() + position), static_cast<size_t>(length) };
+			position += length;
+			return true;
+		}
+
+		bool has_failed() const {
+			return failed;
+		}
+
+		bool is_at_end() const {
+			return position == data.size();
+		}
+	};
+}
@@ -0,0 +1,135 @@
+#include "MappedFile.hpp"
+
+#include <utility>
+
+#include <fmt/std.h>
+
+#include "openvic-simulation/utility/Logger.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace OpenVic;
+
+MappedFile::MappedFile(MappedFile&& other) {
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+	if (this != &other) {
+		close();
+		data = std::exchange(other.data, nullptr);
+		size = std::exchange(other.size, 0);
+		mapped = std::exchange(other.mapped, false);
+#if defined(_WIN32)
+		file_handle = std::exchange(other.file_handle, nullptr);
+		mapping_handle = std::exchange(other.mapping_handle, nullptr);
+#endif
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open(fs::path const& path) {
+	close();
+
+#if defined(_WIN32)
+	file_handle = CreateFileW(
+		path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+	);
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		file_handle = nullptr;
+		spdlog::error_s("Failed to open file \"{}\"", path);
+		return false;
+	}
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file_handle, &file_size)) {
+		spdlog::error_s("Failed to get size of file \"{}\"", path);
+		close();
+		return false;
+	}
+	size = static_cast<size_t>(file_size.QuadPart);
+	mapped = true;
+	if (size == 0) {
+		return true;
+	}
+	mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_handle == nullptr) {
+		spdlog::error_s("Failed to create mapping of file \"{}\"", path);
+		close();
+		return false;
+	}
+	data = static_cast<uint8_t const*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+#else
+	const int descriptor = ::open(path.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		spdlog::error_s("Failed to open file \"{}\"", path);
+		return false;
+	}
+	struct stat file_stat;
+	if (fstat(descriptor, &file_stat) != 0) {
+		spdlog::error_s("Failed to get size of file \"{}\"", path);
+		::close(descriptor);
+		return false;
+	}
+	size = static_cast<size_t>(file_stat.st_size);
+	mapped = true;
+	if (size == 0) {
+		::close(descriptor);
+		return true;
+	}
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	// The mapping keeps the file open, so the descriptor is no longer needed
+	::close(descriptor);
+	data = mapping != MAP_FAILED ? static_cast<uint8_t const*>(mapping) : nullptr;
+#endif
+
+	if (data == nullptr) {
+		spdlog::error_s("Failed to map file \"{}\"", path);
+		close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::close() {
+#if defined(_WIN32)
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+	if (mapping_handle != nullptr) {
+		CloseHandle(mapping_handle);
+		mapping_handle = nullptr;
+	}
+	if (file_handle != nullptr) {
+		CloseHandle(file_handle);
+		file_handle = nullptr;
+	}
+#else
+	if (data != nullptr) {
+		munmap(const_cast<uint8_t*>(data), size);
+	}
+#endif
+	data = nullptr;
+	size = 0;
+	mapped = false;
+}
+
+bool MappedFile::is_open() const {
+	return mapped;
+}
+
+std::span<const uint8_t> MappedFile::get_data() const {
+	return { data, data != nullptr ? size : 0 };
+}
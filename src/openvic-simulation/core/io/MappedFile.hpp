@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace OpenVic {
+	namespace fs = std::filesystem;
+
+	/* A read-only memory mapping of a whole file, so its contents can be read in place without being copied into a buffer.
+	 * Pages are only read from disk as they are first touched, which also lets different threads fault in different parts
+	 * of the file at the same time. */
+	class MappedFile {
+		uint8_t const* data = nullptr;
+		size_t size = 0;
+		bool mapped = false;
+#if defined(_WIN32)
+		void* file_handle = nullptr;
+		void* mapping_handle = nullptr;
+#endif
+
+	public:
+		MappedFile() {};
+		MappedFile(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+		MappedFile(MappedFile&& other);
+		MappedFile& operator=(MappedFile&& other);
+		~MappedFile();
+
+		/* Logs an error and returns false if the file can't be mapped. An empty file opens successfully with no data. */
+		bool open(fs::path const& path);
+		void close();
+
+		bool is_open() const;
+		std::span<const uint8_t> get_data() const;
+	};
+}
@@ -156,11 +156,20 @@ namespace OpenVic {
 		// - insert
 		// - insert_range
 		// - emplace
-		// - erase
 		// - append_range (C++23)
 		// - pop_back
 		// - swap
 
+		constexpr iterator erase(const const_iterator pos) {
+			return container.erase(pos);
+		}
+
+		// Keeps the order of the remaining elements, returns the number of elements erased.
+		template<typename Predicate>
+		constexpr size_type erase_if(Predicate&& predicate) {
+			return std::erase_if(container, std::forward<Predicate>(predicate));
+		}
+
 		constexpr void push_back(value_type const& value) {
 			flush_pending_room();
 			container.push_back(value);
@@ -192,8 +201,7 @@ namespace OpenVic {
 				container.reserve(new_valid_size);
 			}
 
-			std::uninitialized_copy(first, last, end());
-			container.resize(new_valid_size);
+			container.insert(container.end(), first, last);
 		}
 
 		// resize() is omitted as we manage that via make_room_for
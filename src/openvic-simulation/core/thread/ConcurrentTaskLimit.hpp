@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace OpenVic {
+	namespace detail {
+		/* Replaces get_concurrent_task_limit's result while non-zero, see ScopedConcurrentTaskLimit. */
+		inline std::atomic<std::size_t> concurrent_task_limit_override = 0;
+	}
+
+	/* The most tasks to run at once, one per core. ThreadPool starts up to this many worker threads. */
+	inline std::size_t get_concurrent_task_limit() {
+		const std::size_t limit_override = detail::concurrent_task_limit_override.load(std::memory_order_relaxed);
+		if (limit_override > 0) {
+			return limit_override;
+		}
+		return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+	/* Overrides get_concurrent_task_limit until destroyed, so tests can check that results don't depend on how many tasks
+	 * the work was split into. */
+	struct ScopedConcurrentTaskLimit {
+	private:
+		const std::size_t previous_limit_override;
+
+	public:
+		explicit ScopedConcurrentTaskLimit(const std::size_t limit)
+		  : previous_limit_override {
+			detail::concurrent_task_limit_override.exchange(std::max<std::size_t>(limit, 1), std::memory_order_relaxed)
+		} {}
+		ScopedConcurrentTaskLimit(ScopedConcurrentTaskLimit const&) = delete;
+		ScopedConcurrentTaskLimit& operator=(ScopedConcurrentTaskLimit const&) = delete;
+		~ScopedConcurrentTaskLimit() {
+			detail::concurrent_task_limit_override.store(previous_limit_override, std::memory_order_relaxed);
+		}
+	};
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/core/thread/ConcurrentTaskLimit.hpp"
+
+namespace OpenVic {
+	/* Calls callback(index) once for every index in [0, count), claiming indices one at a time across the calling thread and
+	 * short-lived helper threads, and returns once every call has finished. This is for load-time work which happens before
+	 * there is a game ThreadPool, so the calls must not depend on each other or on the order they happen in. At most
+	 * get_concurrent_task_limit calls run at once. */
+	template<typename Callback>
+	void for_each_index_concurrently(const std::size_t count, Callback&& callback) {
+		std::atomic<std::size_t> next_index = 0;
+
+		const auto run_claimed_indices = [count, &callback, &next_index]() -> void {
+			std::size_t index;
+			while ((index = next_index.fetch_add(1, std::memory_order_relaxed)) < count) {
+				callback(index);
+			}
+		};
+
+		//the calling thread runs callbacks too, so only start helpers if there's more than one index
+		const std::size_t helper_thread_count = std::min<std::size_t>(
+			get_concurrent_task_limit() - 1, count > 0 ? count - 1 : 0
+		);
+		memory::vector<std::thread> helper_threads;
+		helper_threads.reserve(helper_thread_count);
+		for (std::size_t i = 0; i < helper_thread_count; ++i) {
+			helper_threads.emplace_back(run_claimed_indices);
+		}
+		run_claimed_indices();
+		for (std::thread& helper_thread : helper_threads) {
+			helper_thread.join();
+		}
+	}
+}
@@ -5,13 +5,13 @@
 #include <cstdint>
 #include <functional>
 #include <limits>
-#include <mutex>
 
 #include <type_safe/strong_typedef.hpp>
 
 #include "openvic-simulation/core/error/ErrorMacros.hpp"
 #include "openvic-simulation/core/Typedefs.hpp"
 #include "openvic-simulation/country/CountryDefinition.hpp"
+#include "openvic-simulation/country/CountryReportBuffer.hpp"
 #include "openvic-simulation/country/SharedCountryValues.hpp"
 #include "openvic-simulation/defines/CountryDefines.hpp"
 #include "openvic-simulation/defines/DiplomacyDefines.hpp"
@@ -657,6 +657,7 @@ bool CountryInstance::add_reform(Reform const& new_reform) {
 		}
 
 		reform = &new_reform;
+		national_modifiers_dirty = true;
 
 		// TODO - if new_reform.get_reform_group().is_uncivilised() ?
 		// TODO - new_reform.get_on_execute_trigger() / new_reform.get_on_execute_effect() ?
@@ -1081,6 +1082,7 @@ bool CountryInstance::modify_technology_unlock(
 	}
 
 	unlock_level += unlock_level_change;
+	national_modifiers_dirty = true;
 
 	bool ret = true;
 
@@ -1131,6 +1133,7 @@ bool CountryInstance::modify_invention_unlock(
 
 	const bool invention_was_unlocked = is_unlocked(unlock_level);
 	unlock_level += unlock_level_change;
+	national_modifiers_dirty = true;
 	if (invention_was_unlocked != is_unlocked(unlock_level)) {
 		if (invention_was_unlocked) {
 			inventions_count-=1;
@@ -1783,35 +1786,27 @@ static constexpr Modifier const& get_country_status_static_effect(
 }
 
 void CountryInstance::update_modifier_sum(Date today, StaticModifierCache const& static_modifier_cache) {
-	// Update sum of national modifiers
-	modifier_sum.clear();
+	const bool has_expired_event_modifier = std::any_of(
+		event_modifiers.begin(), event_modifiers.end(),
+		[today](ModifierInstance const& modifier) -> bool {
+			return today > modifier.get_expiry_date();
+		}
+	);
 
-	// Add static modifiers
-	modifier_sum.add_modifier(static_modifier_cache.get_base_modifier());
-	modifier_sum.add_modifier(get_country_status_static_effect(country_status, static_modifier_cache));
-	if (is_disarmed()) {
-		modifier_sum.add_modifier(static_modifier_cache.get_disarming());
+	if (national_modifiers_dirty || has_expired_event_modifier) {
+		_rebuild_national_modifiers(today);
+		national_modifiers_dirty = false;
 	}
-	modifier_sum.add_modifier(static_modifier_cache.get_war_exhaustion(), war_exhaustion);
-	modifier_sum.add_modifier(static_modifier_cache.get_infamy(), infamy.get_untracked());
-	modifier_sum.add_modifier(static_modifier_cache.get_literacy(), get_average_literacy());
-	modifier_sum.add_modifier(static_modifier_cache.get_plurality(), plurality.get_untracked());
-	modifier_sum.add_modifier(is_at_war() ? static_modifier_cache.get_war() : static_modifier_cache.get_peace());
-	// TODO - difficulty modifiers, debt_default_to, bad_debtor, generalised_debt_default,
-	//        total_occupation, total_blockaded, in_bankruptcy
 
-	// TODO - handle triggered modifiers
+	_update_status_modifiers(static_modifier_cache);
 
-	CountryParty const* ruling_party_copy = ruling_party.get_untracked();
-	if (ruling_party_copy != nullptr) {
-		for (PartyPolicy const* party_policy : ruling_party_copy->get_policies()) {
-			// The ruling party's issues here could be null as they're stored in an FixedVector which has
-			// values for every PartyPolicyGroup regardless of whether or not they have a policy set.
-			if (party_policy != nullptr) {
-				modifier_sum.add_modifier(*party_policy);
-			}
-		}
-	}
+	// TODO - calculate stats for each unit type (locked and unlocked)
+}
+
+void CountryInstance::_rebuild_national_modifiers(Date today) {
+	// Province contributions have the provinces as their sources, so only the national modifiers are removed
+	modifier_sum.remove_modifiers_from_source(this);
+	applied_status_modifiers.clear();
 
 	for (Reform const* reform : reforms.get_values()) {
 		// The country's reforms here could be null as they're stored in an FixedVector which has
@@ -1821,11 +1816,6 @@ void CountryInstance::update_modifier_sum(Date today, StaticModifierCache const&
 		}
 	}
 
-	TechnologySchool const* tech_school_copy = tech_school.get_untracked();
-	if (tech_school_copy != nullptr) {
-		modifier_sum.add_modifier(*tech_school_copy);
-	}
-
 	for (Technology const& technology : technology_unlock_levels.get_keys()) {
 		if (is_technology_unlocked(technology)) {
 			modifier_sum.add_modifier(technology);
@@ -1847,13 +1837,77 @@ void CountryInstance::update_modifier_sum(Date today, StaticModifierCache const&
 			return true;
 		}
 	});
+}
+
+void CountryInstance::_update_status_modifiers(StaticModifierCache const& static_modifier_cache) {
+	// These are cheap to list but their multipliers and selection change often, so they're listed every update and
+	// only the entries which differ from the last update are removed and re-added.
+	reusable_status_modifiers.clear();
+	const auto add_status_modifier = [this](Modifier const& modifier, const fixed_point_t multiplier = 1) -> void {
+		reusable_status_modifiers.emplace_back(&modifier, multiplier);
+	};
+
+	// Add static modifiers
+	add_status_modifier(static_modifier_cache.get_base_modifier());
+	add_status_modifier(get_country_status_static_effect(country_status, static_modifier_cache));
+	if (is_disarmed()) {
+		add_status_modifier(static_modifier_cache.get_disarming());
+	}
+	add_status_modifier(static_modifier_cache.get_war_exhaustion(), war_exhaustion);
+	add_status_modifier(static_modifier_cache.get_infamy(), infamy.get_untracked());
+	add_status_modifier(static_modifier_cache.get_literacy(), get_average_literacy());
+	add_status_modifier(static_modifier_cache.get_plurality(), plurality.get_untracked());
+	add_status_modifier(is_at_war() ? static_modifier_cache.get_war() : static_modifier_cache.get_peace());
+	// TODO - difficulty modifiers, debt_default_to, bad_debtor, generalised_debt_default,
+	//        total_occupation, total_blockaded, in_bankruptcy
+
+	// TODO - handle triggered modifiers
+
+	CountryParty const* ruling_party_copy = ruling_party.get_untracked();
+	if (ruling_party_copy != nullptr) {
+		for (PartyPolicy const* party_policy : ruling_party_copy->get_policies()) {
+			// The ruling party's issues here could be null as they're stored in an FixedVector which has
+			// values for every PartyPolicyGroup regardless of whether or not they have a policy set.
+			if (party_policy != nullptr) {
+				add_status_modifier(*party_policy);
+			}
+		}
+	}
+
+	TechnologySchool const* tech_school_copy = tech_school.get_untracked();
+	if (tech_school_copy != nullptr) {
+		add_status_modifier(*tech_school_copy);
+	}
 
 	NationalValue const* national_value_copy = national_value.get_untracked();
 	if (national_value_copy != nullptr) {
-		modifier_sum.add_modifier(*national_value_copy);
+		add_status_modifier(*national_value_copy);
 	}
 
-	// TODO - calculate stats for each unit type (locked and unlocked)
+	const size_t status_modifier_count = std::max(applied_status_modifiers.size(), reusable_status_modifiers.size());
+	for (size_t i = 0; i < status_modifier_count; ++i) {
+		const bool was_applied = i < applied_status_modifiers.size();
+		const bool is_applied = i < reusable_status_modifiers.size();
+		if (was_applied && is_applied && applied_status_modifiers[i] == reusable_status_modifiers[i]) {
+			continue;
+		}
+
+		if (was_applied) {
+			auto const& [modifier, multiplier] = applied_status_modifiers[i];
+			if (OV_unlikely(!modifier_sum.remove_modifier(*modifier, multiplier))) {
+				spdlog::error_s(
+					"Failed to remove modifier {} with multiplier {} from country {}",
+					*modifier, multiplier, *this
+				);
+			}
+		}
+		if (is_applied) {
+			auto const& [modifier, multiplier] = reusable_status_modifiers[i];
+			modifier_sum.add_modifier(*modifier, multiplier);
+		}
+	}
+
+	applied_status_modifiers.swap(reusable_status_modifiers);
 }
 
 void CountryInstance::make_room_for_province_modifier_sum(ModifierSum const& province_modifier_sum) {
@@ -1864,6 +1918,13 @@ void CountryInstance::contribute_province_modifier_sum(ModifierSum const& provin
 	modifier_sum.add_modifier_sum(province_modifier_sum);
 }
 
+void CountryInstance::remove_stale_province_modifier_sums() {
+	modifier_sum.remove_modifiers_if([](modifier_entry_t const& m) -> bool {
+		ProvinceInstance const* const province = m.get_source_province();
+		return province != nullptr && province->is_modifier_sum_contribution_stale();
+	});
+}
+
 fixed_point_t CountryInstance::get_modifier_effect_value(ModifierEffect const& effect) const {
 	return modifier_sum.get_modifier_effect_value(effect);
 }
@@ -1991,7 +2052,7 @@ void CountryInstance::update_gamestate(const Date today, MapInstance& map_instan
 	}
 }
 
-void CountryInstance::after_buy(void* actor, BuyResult const& buy_result) {
+void CountryInstance::after_buy(void* actor, BuyResult const& buy_result, CountryReportBuffer& country_report_buffer) {
 	const fixed_point_t quantity_bought = buy_result.quantity_bought;
 
 	if (quantity_bought <= 0) {
@@ -2009,7 +2070,12 @@ void CountryInstance::after_buy(void* actor, BuyResult const& buy_result) {
 	good_data.money_traded_yesterday = -money_spent;
 }
 
-void CountryInstance::after_sell(void* actor, SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector) {
+void CountryInstance::after_sell(
+	void* actor,
+	SellResult const& sell_result,
+	CountryReportBuffer& country_report_buffer,
+	memory::vector<fixed_point_t>& reusable_vector
+) {
 	const fixed_point_t quantity_sold = sell_result.quantity_sold;
 
 	if (quantity_sold <= 0) {
@@ -2028,6 +2094,8 @@ void CountryInstance::after_sell(void* actor, SellResult const& sell_result, mem
 }
 
 void CountryInstance::country_tick_before_map(
+	MarketOrderBuffer& market_order_buffer,
+	CountryReportBuffer& country_report_buffer,
 	TypedSpan<good_index_t, char> reusable_goods_mask,
 	forwardable_span<
 		memory::vector<fixed_point_t>,
@@ -2118,6 +2186,8 @@ void CountryInstance::country_tick_before_map(
 	calculate_government_good_needs();
 
 	manage_national_stockpile(
+		market_order_buffer,
+		country_report_buffer,
 		reusable_goods_mask,
 		reusable_vectors,
 		reusable_good_index_vector,
@@ -2152,6 +2222,8 @@ void CountryInstance::calculate_government_good_needs() {
 }
 
 void CountryInstance::manage_national_stockpile(
+	MarketOrderBuffer& market_order_buffer,
+	CountryReportBuffer& country_report_buffer,
 	TypedSpan<good_index_t, char> reusable_goods_mask,
 	forwardable_span<
 		memory::vector<fixed_point_t>,
@@ -2211,6 +2283,8 @@ void CountryInstance::manage_national_stockpile(
 					this,
 					after_sell,
 				},
+				market_order_buffer,
+				country_report_buffer,
 				reusable_vectors[3] //temporarily used here and later used as money_to_spend_per_good
 			);
 		}
@@ -2273,7 +2347,9 @@ void CountryInstance::manage_national_stockpile(
 					money_to_spend,
 					this,
 					after_buy
-				}
+				},
+				market_order_buffer,
+				country_report_buffer
 			);
 		}
 	}
@@ -2411,12 +2487,7 @@ void CountryInstance::country_tick_after_map(const Date today) {
 	balance_history.push_back(yesterdays_balance);
 }
 
-CountryInstance::good_data_t::good_data_t()
-	: mutex { memory::make_unique<spin_mutex>() }
-	{ }
-
 void CountryInstance::good_data_t::clear_daily_recorded_data() {
-	const std::lock_guard<spin_mutex> lock_guard { *mutex };
 	stockpile_change_yesterday
 		= quantity_traded_yesterday
 		= money_traded_yesterday
@@ -2435,52 +2506,109 @@ void CountryInstance::good_data_t::clear_daily_recorded_data() {
 	production_per_production_type.clear();
 }
 
-void CountryInstance::report_pop_income_tax(PopType const& pop_type, const fixed_point_t gross_income, const fixed_point_t paid_as_tax) {
-	const std::lock_guard<spin_mutex> lock_guard { taxable_income_mutex };
-	taxable_income_by_pop_type.at(pop_type) += gross_income;
+void CountryInstance::report_pop_income_tax(
+	CountryReportBuffer& country_report_buffer,
+	PopType const& pop_type,
+	const fixed_point_t gross_income,
+	const fixed_point_t paid_as_tax
+) {
+	country_report_buffer.report_taxable_income(index, pop_type.index, gross_income);
+	//the tax itself is available right away, as cash_stockpile is atomic
 	cash_stockpile += paid_as_tax;
 }
 
-void CountryInstance::report_pop_need_consumption(PopType const& pop_type, const good_index_t good_index, const fixed_point_t quantity) {
-	good_data_t& good_data = goods_data.at_index(good_index);
-	const std::lock_guard<spin_mutex> lock_guard { *good_data.mutex };
-	good_data.need_consumption_per_pop_type[&pop_type] += quantity;
+void CountryInstance::report_pop_need_consumption(
+	CountryReportBuffer& country_report_buffer,
+	PopType const& pop_type,
+	const good_index_t good_index,
+	const fixed_point_t quantity
+) {
+	country_report_buffer.report_pop_need_consumption(index, pop_type.index, good_index, quantity);
 }
-void CountryInstance::report_pop_need_demand(PopType const& pop_type, const good_index_t good_index, const fixed_point_t quantity) {
-	good_data_t& good_data = goods_data.at_index(good_index);
-	const std::lock_guard<spin_mutex> lock_guard { *good_data.mutex };
-	good_data.pop_demand += quantity;
+void CountryInstance::report_pop_need_demand(
+	CountryReportBuffer& country_report_buffer,
+	PopType const& pop_type,
+	const good_index_t good_index,
+	const fixed_point_t quantity
+) {
+	country_report_buffer.report_pop_demand(index, good_index, quantity);
 }
-void CountryInstance::report_input_consumption(ProductionType const& production_type, const good_index_t good_index, const fixed_point_t quantity) {
-	good_data_t& good_data = goods_data.at_index(good_index);
-	const std::lock_guard<spin_mutex> lock_guard { *good_data.mutex };
-	good_data.input_consumption_per_production_type[&production_type] += quantity;
+void CountryInstance::report_input_consumption(
+	CountryReportBuffer& country_report_buffer,
+	ProductionType const& production_type,
+	const good_index_t good_index,
+	const fixed_point_t quantity
+) {
+	country_report_buffer.report_input_consumption(index, production_type, good_index, quantity);
 }
-void CountryInstance::report_input_demand(ProductionType const& production_type, const good_index_t good_index, const fixed_point_t quantity) {
-	good_data_t& good_data = goods_data.at_index(good_index);
-
+void CountryInstance::report_input_demand(
+	CountryReportBuffer& country_report_buffer,
+	ProductionType const& production_type,
+	const good_index_t good_index,
+	const fixed_point_t quantity
+) {
 	if (production_type.template_type == ProductionType::template_type_t::ARTISAN) {
 		switch (game_rules_manager.get_artisanal_input_demand_category()) {
 			case demand_category::FactoryNeeds: break;
 			case demand_category::PopNeeds: {
-				const std::lock_guard<spin_mutex> lock_guard { *good_data.mutex };
-				good_data.pop_demand += quantity;
+				country_report_buffer.report_pop_demand(index, good_index, quantity);
 				return;
 			}
 			default: return; //demand_category::None
 		}
 	}
 
-	const std::lock_guard<spin_mutex> lock_guard { *good_data.mutex };
-	good_data.factory_demand += quantity;
+	country_report_buffer.report_factory_demand(index, good_index, quantity);
+}
+void CountryInstance::report_output(
+	CountryReportBuffer& country_report_buffer,
+	ProductionType const& production_type,
+	const fixed_point_t quantity
+) {
+	country_report_buffer.report_output(index, production_type, production_type.output_good.index, quantity);
 }
-void CountryInstance::report_output(ProductionType const& production_type, const fixed_point_t quantity) {
-	good_data_t& good_data = get_good_data(production_type.output_good);
-	const std::lock_guard<spin_mutex> lock_guard { *good_data.mutex };
-	good_data.production_per_production_type[&production_type] += quantity;
+
+void CountryInstance::fold_reports_from(CountryReportBuffer& country_report_buffer) {
+	struct country_report_target_t {
+		CountryInstance& country;
+
+		void add_pop_demand(const good_index_t good_index, const fixed_point_t quantity) {
+			country.goods_data.at_index(good_index).pop_demand += quantity;
+		}
+		void add_factory_demand(const good_index_t good_index, const fixed_point_t quantity) {
+			country.goods_data.at_index(good_index).factory_demand += quantity;
+		}
+		void add_pop_need_consumption(
+			const pop_type_index_t pop_type_index,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		) {
+			PopType const& pop_type = country.taxable_income_by_pop_type.get_key_at_index(pop_type_index);
+			country.goods_data.at_index(good_index).need_consumption_per_pop_type[&pop_type] += quantity;
+		}
+		void add_taxable_income(const pop_type_index_t pop_type_index, const fixed_point_t gross_income) {
+			country.taxable_income_by_pop_type.at_index(pop_type_index) += gross_income;
+		}
+		void add_input_consumption(
+			ProductionType const& production_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		) {
+			country.goods_data.at_index(good_index).input_consumption_per_production_type[&production_type] += quantity;
+		}
+		void add_output(
+			ProductionType const& production_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		) {
+			country.goods_data.at_index(good_index).production_per_production_type[&production_type] += quantity;
+		}
+	} country_report_target { *this };
+
+	country_report_buffer.fold_reports_into(index, country_report_target);
 }
 
-void CountryInstance::request_salaries_and_welfare_and_import_subsidies(Pop& pop) {
+void CountryInstance::request_salaries_and_welfare_and_import_subsidies(Pop& pop, CountryReportBuffer& country_report_buffer) {
 	PopType const& pop_type = pop.get_type();
 	const pop_size_t pop_size = pop.get_size();
 	SharedPopTypeValues const& pop_type_values = shared_country_values.get_shared_pop_type_values(pop_type);
@@ -2492,7 +2620,7 @@ void CountryInstance::request_salaries_and_welfare_and_import_subsidies(Pop& pop
 			projected_administration_spending_unscaled_by_slider.get_untracked()
 		) / Pop::size_denominator;
 		if (administration_salary > 0) {
-			pop.add_government_salary_administration(administration_salary);
+			pop.add_government_salary_administration(administration_salary, country_report_buffer);
 			actual_administration_spending += administration_salary;
 		}
 	}
@@ -2504,7 +2632,7 @@ void CountryInstance::request_salaries_and_welfare_and_import_subsidies(Pop& pop
 			projected_education_spending_unscaled_by_slider.get_untracked()
 		) / Pop::size_denominator;
 		if (education_salary > 0) {
-			pop.add_government_salary_education(education_salary);
+			pop.add_government_salary_education(education_salary, country_report_buffer);
 			actual_education_spending += education_salary;
 		}
 	}
@@ -2516,7 +2644,7 @@ void CountryInstance::request_salaries_and_welfare_and_import_subsidies(Pop& pop
 			projected_military_spending_unscaled_by_slider.get_untracked()
 		) / Pop::size_denominator;
 		if (military_salary > 0) {
-			pop.add_government_salary_military(military_salary);
+			pop.add_government_salary_military(military_salary, country_report_buffer);
 			actual_military_spending += military_salary;
 		}
 	}
@@ -2528,7 +2656,7 @@ void CountryInstance::request_salaries_and_welfare_and_import_subsidies(Pop& pop
 			projected_social_spending_unscaled_by_slider.get_untracked()
 		) / Pop::size_denominator;
 		if (pension_income > 0) {
-			pop.add_pensions(pension_income);
+			pop.add_pensions(pension_income, country_report_buffer);
 			actual_pensions_spending += pension_income;
 		}
 
@@ -2538,7 +2666,7 @@ void CountryInstance::request_salaries_and_welfare_and_import_subsidies(Pop& pop
 			projected_social_spending_unscaled_by_slider.get_untracked()
 		) / Pop::size_denominator;
 		if (unemployment_subsidies > 0) {
-			pop.add_unemployment_subsidies(unemployment_subsidies);
+			pop.add_unemployment_subsidies(unemployment_subsidies, country_report_buffer);
 			actual_unemployment_subsidies_spending += unemployment_subsidies;
 		}
 	}
@@ -2546,7 +2674,7 @@ void CountryInstance::request_salaries_and_welfare_and_import_subsidies(Pop& pop
 	if (actual_import_subsidies_budget > 0) {
 		const fixed_point_t import_subsidies = fp::mul_div(
 			effective_tariff_rate.get_untracked() // < 0
-				* pop.get_yesterdays_import_value().get_copy_of_value(),
+				* pop.get_yesterdays_import_value(),
 			actual_import_subsidies_budget, // < 0
 			projected_import_subsidies.get_untracked() // > 0
 		); //effective_tariff_rate * actual_net_tariffs cancel out the negative
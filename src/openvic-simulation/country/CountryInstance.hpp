@@ -8,7 +8,6 @@
 #include "openvic-simulation/core/memory/SmartPtr.hpp"
 #include "openvic-simulation/core/memory/Vector.hpp"
 #include "openvic-simulation/core/stl/containers/TypedSpan.hpp"
-#include "openvic-simulation/core/thread/SpinMutex.hpp"
 #include "openvic-simulation/diplomacy/CountryRelation.hpp"
 #include "openvic-simulation/economy/BuildingLevel.hpp"
 #include "openvic-simulation/economy/BuildingRestrictionCategory.hpp"
@@ -44,6 +43,7 @@ namespace OpenVic {
 	struct CountryInstanceDeps;
 	struct CountryParty;
 	struct CountryRelationManager;
+	struct CountryReportBuffer;
 	struct Crime;
 	struct Culture;
 	struct DefineManager;
@@ -59,6 +59,7 @@ namespace OpenVic {
 	struct LeaderInstance;
 	struct MapInstance;
 	struct MarketInstance;
+	struct MarketOrderBuffer;
 	struct MilitaryDefines;
 	struct ModifierEffectCache;
 	struct NationalValue;
@@ -87,6 +88,7 @@ namespace OpenVic {
 	 * but can be swapped with other CountryInstance's CountryDefinition when switching tags. */
 	struct CountryInstance : FlagStrings, HasIndex<CountryInstance, country_index_t>, PopsAggregate {
 		friend struct CountryInstanceManager;
+		friend struct InstanceSave;
 
 		/*
 			Westernisation Progress vs Status for Uncivilised Countries:
@@ -153,6 +155,12 @@ namespace OpenVic {
 		// The total/resultant modifier affecting this country, including owned province contributions.
 		ModifierSum PROPERTY(modifier_sum);
 		memory::vector<ModifierInstance> SPAN_PROPERTY(event_modifiers);
+		// Set by anything changing the country's reforms, technologies or inventions, so update_modifier_sum only
+		// re-adds those and the event modifiers when they may have changed or an event modifier has expired.
+		bool national_modifiers_dirty = true;
+		// Static, party and national value modifiers with the multipliers they were last added to modifier_sum with.
+		memory::vector<std::pair<Modifier const*, fixed_point_t>> applied_status_modifiers;
+		memory::vector<std::pair<Modifier const*, fixed_point_t>> reusable_status_modifiers;
 
 		/* Production */
 		OV_STATE_PROPERTY(fixed_point_t, industrial_power);
@@ -168,7 +176,6 @@ namespace OpenVic {
 		ValueHistory<fixed_point_t> PROPERTY(balance_history);
 		OV_STATE_PROPERTY(fixed_point_t, gold_income);
 		atomic_fixed_point_t PROPERTY(cash_stockpile);
-		spin_mutex taxable_income_mutex;
 		OV_IFLATMAP_PROPERTY(PopType, fixed_point_t, taxable_income_by_pop_type);
 		OV_STATE_PROPERTY(fixed_point_t, tax_efficiency);
 		IndexedFlatMap<Strata, DerivedState<fixed_point_t>> PROPERTY(effective_tax_rate_by_strata);
@@ -304,7 +311,6 @@ namespace OpenVic {
 
 		/* Trade */
 		struct good_data_t {
-			memory::unique_ptr<spin_mutex> mutex;
 			fixed_point_t stockpile_amount;
 			fixed_point_t stockpile_change_yesterday; // positive if we gained, negative if we lost
 			fixed_point_t quantity_traded_yesterday; // positive if we bought, negative if we sold
@@ -329,11 +335,6 @@ namespace OpenVic {
 			ordered_map<ProductionType const*, fixed_point_t> input_consumption_per_production_type;
 			ordered_map<ProductionType const*, fixed_point_t> production_per_production_type;
 
-			good_data_t();
-			good_data_t(good_data_t&&) = default;
-			good_data_t& operator=(good_data_t&&) = default;
-
-			//thread safe
 			void clear_daily_recorded_data();
 		};
 
@@ -651,13 +652,20 @@ namespace OpenVic {
 			return true;
 		}
 
-		static void after_buy(void* actor, BuyResult const& buy_result);
+		static void after_buy(void* actor, BuyResult const& buy_result, CountryReportBuffer& country_report_buffer);
 		//matching GoodMarketSellOrder::callback_t
-		static void after_sell(void* actor, SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector);
+		static void after_sell(
+			void* actor,
+			SellResult const& sell_result,
+			CountryReportBuffer& country_report_buffer,
+			memory::vector<fixed_point_t>& reusable_vector
+		);
 
 		void calculate_government_good_needs();
 
 		void manage_national_stockpile(
+			MarketOrderBuffer& market_order_buffer,
+			CountryReportBuffer& country_report_buffer,
 			TypedSpan<good_index_t, char> reusable_goods_mask,
 			forwardable_span<
 				memory::vector<fixed_point_t>,
@@ -684,10 +692,15 @@ namespace OpenVic {
 
 		bool update_rule_set();
 
+		void _rebuild_national_modifiers(Date today);
+		void _update_status_modifiers(StaticModifierCache const& static_modifier_cache);
+
 	public:
 		void update_modifier_sum(Date today, StaticModifierCache const& static_modifier_cache);
 		void make_room_for_province_modifier_sum(ModifierSum const& province_modifier_sum);
 		void contribute_province_modifier_sum(ModifierSum const& province_modifier_sum);
+		// Removes the contributions of provinces whose modifier sums have changed or which are no longer controlled.
+		void remove_stale_province_modifier_sums();
 		fixed_point_t get_modifier_effect_value(ModifierEffect const& effect) const;
 		constexpr void for_each_contributing_modifier(
 			ModifierEffect const& effect, ContributingModifierCallback auto callback
@@ -697,6 +710,8 @@ namespace OpenVic {
 
 		void update_gamestate(const Date today, MapInstance& map_instance);
 		void country_tick_before_map(
+			MarketOrderBuffer& market_order_buffer,
+			CountryReportBuffer& country_report_buffer,
 			TypedSpan<good_index_t, char> reusable_goods_mask,
 			forwardable_span<
 				memory::vector<fixed_point_t>,
@@ -711,14 +726,41 @@ namespace OpenVic {
 		good_data_t& get_good_data(GoodDefinition const& good_definition);
 		good_data_t const& get_good_data(GoodDefinition const& good_definition) const;
 
-		//thread safe
-		void report_pop_income_tax(PopType const& pop_type, const fixed_point_t gross_income, const fixed_point_t paid_as_tax);
-		void report_pop_need_consumption(PopType const& pop_type, const good_index_t good_index, const fixed_point_t quantity);
-		void report_pop_need_demand(PopType const& pop_type, const good_index_t good_index, const fixed_point_t quantity);
-		void report_input_consumption(ProductionType const& production_type, const good_index_t good_index, const fixed_point_t quantity);
-		void report_input_demand(ProductionType const& production_type, const good_index_t good_index, const fixed_point_t quantity);
-		void report_output(ProductionType const& production_type, const fixed_point_t quantity);
-		void request_salaries_and_welfare_and_import_subsidies(Pop& pop);
+		//These go to the WorkBundle's CountryReportBuffer and are folded in by fold_reports_from().
+		void report_pop_income_tax(
+			CountryReportBuffer& country_report_buffer,
+			PopType const& pop_type,
+			const fixed_point_t gross_income,
+			const fixed_point_t paid_as_tax
+		);
+		void report_pop_need_consumption(
+			CountryReportBuffer& country_report_buffer,
+			PopType const& pop_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		);
+		void report_pop_need_demand(
+			CountryReportBuffer& country_report_buffer,
+			PopType const& pop_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		);
+		void report_input_consumption(
+			CountryReportBuffer& country_report_buffer,
+			ProductionType const& production_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		);
+		void report_input_demand(
+			CountryReportBuffer& country_report_buffer,
+			ProductionType const& production_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		);
+		void report_output(CountryReportBuffer& country_report_buffer, ProductionType const& production_type, const fixed_point_t quantity);
+		//not thread safe for the same country
+		void fold_reports_from(CountryReportBuffer& country_report_buffer);
+		void request_salaries_and_welfare_and_import_subsidies(Pop& pop, CountryReportBuffer& country_report_buffer);
 		fixed_point_t calculate_minimum_wage_base(PopType const& pop_type);
 		fixed_point_t apply_tariff(const fixed_point_t money_spent_on_imports);
 	};
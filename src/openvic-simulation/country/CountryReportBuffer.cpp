@@ -0,0 +1,105 @@
+#include "CountryReportBuffer.hpp"
+
+#include <type_safe/strong_typedef.hpp>
+
+using namespace OpenVic;
+
+void CountryReportBuffer::set_sizes(
+	const country_index_t new_country_count,
+	const good_index_t new_good_count,
+	const pop_type_index_t new_pop_type_count
+) {
+	good_count = type_safe::get(new_good_count);
+	pop_type_count = type_safe::get(new_pop_type_count);
+	reports_index_per_country.assign(type_safe::get(new_country_count), NO_REPORTS);
+	reports_pool.clear();
+	countries_with_reports.clear();
+}
+
+CountryReportBuffer::country_reports_t& CountryReportBuffer::get_or_add_reports(const country_index_t country_index) {
+	std::size_t& reports_index = reports_index_per_country[type_safe::get(country_index)];
+	if (reports_index != NO_REPORTS) {
+		return reports_pool[reports_index];
+	}
+
+	reports_index = countries_with_reports.size();
+	countries_with_reports.push_back(country_index);
+	if (reports_index == reports_pool.size()) {
+		country_reports_t& reports = reports_pool.emplace_back();
+		reports.need_consumption_per_good_and_pop_type.resize(good_count * pop_type_count);
+		reports.pop_demand_per_good.resize(good_count);
+		reports.factory_demand_per_good.resize(good_count);
+		reports.is_good_reported.resize(good_count);
+		reports.taxable_income_per_pop_type.resize(pop_type_count);
+	}
+	return reports_pool[reports_index];
+}
+
+CountryReportBuffer::country_reports_t& CountryReportBuffer::get_or_add_good_reports(
+	const country_index_t country_index,
+	const good_index_t good_index
+) {
+	country_reports_t& reports = get_or_add_reports(country_index);
+	char& is_good_reported = reports.is_good_reported[type_safe::get(good_index)];
+	if (!is_good_reported) {
+		is_good_reported = true;
+		reports.reported_good_indices.push_back(good_index);
+	}
+	return reports;
+}
+
+void CountryReportBuffer::report_pop_need_consumption(
+	const country_index_t country_index,
+	const pop_type_index_t pop_type_index,
+	const good_index_t good_index,
+	const fixed_point_t quantity
+) {
+	get_or_add_good_reports(country_index, good_index).need_consumption_per_good_and_pop_type[
+		type_safe::get(good_index) * pop_type_count + type_safe::get(pop_type_index)
+	] += quantity;
+}
+
+void CountryReportBuffer::report_pop_demand(const country_index_t country_index, const good_index_t good_index, const fixed_point_t quantity) {
+	get_or_add_good_reports(country_index, good_index).pop_demand_per_good[type_safe::get(good_index)] += quantity;
+}
+
+void CountryReportBuffer::report_factory_demand(const country_index_t country_index, const good_index_t good_index, const fixed_point_t quantity) {
+	get_or_add_good_reports(country_index, good_index).factory_demand_per_good[type_safe::get(good_index)] += quantity;
+}
+
+void CountryReportBuffer::report_taxable_income(
+	const country_index_t country_index,
+	const pop_type_index_t pop_type_index,
+	const fixed_point_t gross_income
+) {
+	get_or_add_reports(country_index).taxable_income_per_pop_type[type_safe::get(pop_type_index)] += gross_income;
+}
+
+void CountryReportBuffer::report_input_consumption(
+	const country_index_t country_index,
+	ProductionType const& production_type,
+	const good_index_t good_index,
+	const fixed_point_t quantity
+) {
+	get_or_add_reports(country_index).input_consumption_reports.push_back({ &production_type, good_index, quantity });
+}
+
+void CountryReportBuffer::report_output(
+	const country_index_t country_index,
+	ProductionType const& production_type,
+	const good_index_t good_index,
+	const fixed_point_t quantity
+) {
+	get_or_add_reports(country_index).output_reports.push_back({ &production_type, good_index, quantity });
+}
+
+CountryReportBuffer::country_reports_t const* CountryReportBuffer::get_reports_nullable(const country_index_t country_index) const {
+	const std::size_t reports_index = reports_index_per_country[type_safe::get(country_index)];
+	return reports_index == NO_REPORTS
+		? nullptr
+		: &reports_pool[reports_index];
+}
+
+void CountryReportBuffer::reset() {
+	countries_with_reports.clear();
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include <type_safe/strong_typedef.hpp>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
+
+namespace OpenVic {
+	struct ProductionType;
+
+	//Economy figures reported to countries while processing a single WorkBundle.
+	//Only the thread processing the owning WorkBundle writes to it, so reporting needs no locking.
+	//Each country folds the buffers of all bundles in bundle order at the end of every phase that reports.
+	struct CountryReportBuffer {
+	public:
+		struct production_type_report_t {
+			ProductionType const* production_type;
+			good_index_t good_index;
+			fixed_point_t quantity;
+		};
+
+		struct country_reports_t {
+			//dense [good][pop_type]
+			memory::vector<fixed_point_t> need_consumption_per_good_and_pop_type;
+			memory::vector<fixed_point_t> pop_demand_per_good;
+			memory::vector<fixed_point_t> factory_demand_per_good;
+			//goods with any of the reports above, in the order they were first reported
+			memory::vector<good_index_t> reported_good_indices;
+			memory::vector<char> is_good_reported;
+			memory::vector<fixed_point_t> taxable_income_per_pop_type;
+			//production types aren't indexed and report at most once per producer per day
+			memory::vector<production_type_report_t> input_consumption_reports;
+			memory::vector<production_type_report_t> output_reports;
+		};
+
+	private:
+		static constexpr std::size_t NO_REPORTS = std::numeric_limits<std::size_t>::max();
+
+		std::size_t good_count = 0;
+		std::size_t pop_type_count = 0;
+		memory::vector<std::size_t> reports_index_per_country;
+		//only the first countries_with_reports.size() are in use, the rest are zeroed and kept for reuse
+		memory::vector<country_reports_t> reports_pool;
+		memory::vector<country_index_t> countries_with_reports;
+
+		country_reports_t& get_or_add_reports(const country_index_t country_index);
+		country_reports_t& get_or_add_good_reports(const country_index_t country_index, const good_index_t good_index);
+
+	public:
+		void set_sizes(
+			const country_index_t new_country_count,
+			const good_index_t new_good_count,
+			const pop_type_index_t new_pop_type_count
+		);
+
+		void report_pop_need_consumption(
+			const country_index_t country_index,
+			const pop_type_index_t pop_type_index,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		);
+		void report_pop_demand(const country_index_t country_index, const good_index_t good_index, const fixed_point_t quantity);
+		void report_factory_demand(const country_index_t country_index, const good_index_t good_index, const fixed_point_t quantity);
+		void report_taxable_income(
+			const country_index_t country_index,
+			const pop_type_index_t pop_type_index,
+			const fixed_point_t gross_income
+		);
+		void report_input_consumption(
+			const country_index_t country_index,
+			ProductionType const& production_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		);
+		void report_output(
+			const country_index_t country_index,
+			ProductionType const& production_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		);
+
+		//in the order they first reported
+		std::span<const country_index_t> get_countries_with_reports() const {
+			return countries_with_reports;
+		}
+		country_reports_t const* get_reports_nullable(const country_index_t country_index) const;
+
+		//Passes the country's non-zero reports to report_target in the order they were first reported, then clears them.
+		//Safe to call for different countries at the same time.
+		template<typename ReportTarget>
+		void fold_reports_into(const country_index_t country_index, ReportTarget& report_target) {
+			std::size_t& reports_index = reports_index_per_country[type_safe::get(country_index)];
+			if (reports_index == NO_REPORTS) {
+				return;
+			}
+			country_reports_t& reports = reports_pool[reports_index];
+			reports_index = NO_REPORTS;
+
+			for (const good_index_t good_index : reports.reported_good_indices) {
+				const std::size_t good_i = type_safe::get(good_index);
+				fixed_point_t& pop_demand = reports.pop_demand_per_good[good_i];
+				if (pop_demand != 0) {
+					report_target.add_pop_demand(good_index, pop_demand);
+					pop_demand = 0;
+				}
+				fixed_point_t& factory_demand = reports.factory_demand_per_good[good_i];
+				if (factory_demand != 0) {
+					report_target.add_factory_demand(good_index, factory_demand);
+					factory_demand = 0;
+				}
+				for (std::size_t pop_type_i = 0; pop_type_i < pop_type_count; ++pop_type_i) {
+					fixed_point_t& consumed_quantity = reports.need_consumption_per_good_and_pop_type[
+						good_i * pop_type_count + pop_type_i
+					];
+					if (consumed_quantity != 0) {
+						report_target.add_pop_need_consumption(pop_type_index_t(pop_type_i), good_index, consumed_quantity);
+						consumed_quantity = 0;
+					}
+				}
+				reports.is_good_reported[good_i] = false;
+			}
+			reports.reported_good_indices.clear();
+
+			for (std::size_t pop_type_i = 0; pop_type_i < pop_type_count; ++pop_type_i) {
+				fixed_point_t& taxable_income = reports.taxable_income_per_pop_type[pop_type_i];
+				if (taxable_income != 0) {
+					report_target.add_taxable_income(pop_type_index_t(pop_type_i), taxable_income);
+					taxable_income = 0;
+				}
+			}
+
+			for (production_type_report_t const& report : reports.input_consumption_reports) {
+				report_target.add_input_consumption(*report.production_type, report.good_index, report.quantity);
+			}
+			reports.input_consumption_reports.clear();
+			for (production_type_report_t const& report : reports.output_reports) {
+				report_target.add_output(*report.production_type, report.good_index, report.quantity);
+			}
+			reports.output_reports.clear();
+		}
+
+		//Call once every country in get_countries_with_reports() has folded its reports.
+		void reset();
+	};
+}
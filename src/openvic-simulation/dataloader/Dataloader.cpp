@@ -1,7 +1,12 @@
 #include "Dataloader.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
 #include <string_view>
 #include <system_error>
+#include <utility>
 
 #include <openvic-dataloader/csv/Parser.hpp>
 #include <openvic-dataloader/detail/CallbackOStream.hpp>
@@ -12,8 +17,11 @@
 
 #include <fmt/std.h>
 
+#include "openvic-simulation/core/memory/Formatting.hpp"
 #include "openvic-simulation/core/string/Utility.hpp"
 #include "openvic-simulation/core/template/Concepts.hpp"
+#include "openvic-simulation/core/thread/ForEachIndexConcurrently.hpp"
+#include "openvic-simulation/dataloader/LocalisationStore.hpp"
 #include "openvic-simulation/DefinitionManager.hpp"
 #include "openvic-simulation/interface/UI.hpp"
 #include "openvic-simulation/misc/GameRulesManager.hpp"
@@ -24,17 +32,70 @@ using namespace OpenVic;
 using namespace OpenVic::NodeTools;
 using namespace ovdl;
 
-#if !defined(_WIN32)
-#define FILESYSTEM_NEEDS_FORWARD_SLASHES
-#endif
-
-static fs::path ensure_forward_slash_path(std::string_view path) {
-#if defined(FILESYSTEM_NEEDS_FORWARD_SLASHES)
-	/* Back-slashes need to be converted into forward-slashes */
-	return make_forward_slash_path(remove_leading_slashes(path));
-#else
-	return path;
-#endif
+/* Converts a path into the form used as a key by the path index: relative, with forward slashes and no trailing slash. */
+static memory::string _make_index_key(std::string_view path) {
+	memory::string key = make_forward_slash_path(remove_leading_slashes(path));
+	while (!key.empty() && key.back() == '/') {
+		key.pop_back();
+	}
+	return key;
+}
+
+void Dataloader::_build_path_index() {
+	indexed_paths.clear();
+	file_index.clear();
+	case_insensitive_file_index.clear();
+	directory_children_per_root.clear();
+	directory_children_per_root.resize(roots.size());
+
+	for (size_t root_index = 0; root_index < roots.size(); ++root_index) {
+		fs::path const& root = roots[root_index];
+		const bool is_base_root = root_index == roots.size() - 1;
+		directory_children_map_t& directory_children = directory_children_per_root[root_index];
+
+		std::error_code ec;
+		for (
+			fs::recursive_directory_iterator it {
+				root, fs::directory_options::follow_directory_symlink | fs::directory_options::skip_permission_denied, ec
+			}, end;
+			!ec && it != end; it.increment(ec)
+		) {
+			fs::directory_entry const& entry = *it;
+			std::error_code status_ec;
+			const bool is_directory = entry.is_directory(status_ec);
+			if (!is_directory && !entry.is_regular_file(status_ec)) {
+				continue;
+			}
+
+			memory::string relative_path = _make_index_key(
+				entry.path().lexically_relative(root).generic_string<char>(memory::string::allocator_type{})
+			);
+			if (!is_directory && is_base_root && should_ignore_path(fs::path { relative_path }, replace_paths)) {
+				continue;
+			}
+
+			const size_t path_index = indexed_paths.size();
+
+			const size_t parent_length = relative_path.rfind('/');
+			const std::string_view parent_path = parent_length != memory::string::npos
+				? std::string_view { relative_path }.substr(0, parent_length)
+				: std::string_view {};
+			directory_children[memory::string { parent_path }].push_back(path_index);
+
+			if (!is_directory) {
+				// Roots are walked in priority order, so emplace keeping an existing entry leaves the highest priority file
+				file_index.emplace(relative_path, path_index);
+				case_insensitive_file_index.emplace(relative_path, path_index);
+			}
+
+			indexed_paths.push_back({ entry.path(), std::move(relative_path), root_index, is_directory });
+		}
+		if (ec) {
+			spdlog::error_s("Failed to index dataloader root {}: {}", root, ec.message());
+		}
+	}
+
+	SPDLOG_INFO("Indexed {} files and directories across {} dataloader roots", indexed_paths.size(), roots.size());
 }
 
 bool Dataloader::set_roots(path_span_t new_roots, path_span_t new_replace_paths, bool warn_on_override) {
@@ -68,53 +129,27 @@ bool Dataloader::set_roots(path_span_t new_roots, path_span_t new_replace_paths,
 		spdlog::error_s("Dataloader has no roots after attempting to add {}", new_roots.size());
 		ret = false;
 	}
+
+	_build_path_index();
+
 	return ret;
 }
 
 fs::path Dataloader::lookup_file(std::string_view path, bool print_error) const {
-	const fs::path filepath { ensure_forward_slash_path(path) };
-
-	const std::string_view filename = get_filename(path);
-	for (fs::path const& root : roots) {
-		const fs::path composed = root / filepath;
-		if (fs::is_regular_file(composed)) {
-			if (root == roots.back()) {
-				bool ignore = false;
-				for (fs::path const& replace_path : replace_paths) {
-					if (filepath.string().starts_with(replace_path.string())) {
-						ignore = true;
-						break;
-					}
-				}
-				if (!ignore) {
-					return composed;
-				}
-			} else {
-				return composed;
-			}
-		}
-		std::error_code ec;
-		for (fs::directory_entry const& entry : fs::directory_iterator { composed.parent_path(), ec }) {
-			if (entry.is_regular_file()) {
-				const fs::path file = entry;
-				if (ascii_equal_case_insensitive(file.filename().string(), filename)) {
-					if (root == roots.back()) {
-						bool ignore = false;
-						for (fs::path const& replace_path : replace_paths) {
-							if (filepath.string().starts_with(replace_path.string())) {
-								ignore = true;
-								break;
-							}
-						}
-						if (!ignore) {
-							return file;
-						}
-					} else {
-						return file;
-					}
-				}
-			}
-		}
+	const memory::string key = _make_index_key(path);
+
+	const decltype(file_index)::const_iterator exact_it = file_index.find(key);
+	const decltype(case_insensitive_file_index)::const_iterator case_insensitive_it = case_insensitive_file_index.find(key);
+
+	// An exact match is preferred over a case-insensitive one, unless the latter comes from a higher priority root
+	if (exact_it != file_index.end() && (
+		case_insensitive_it == case_insensitive_file_index.end() ||
+		indexed_paths[exact_it->second].root_index <= indexed_paths[case_insensitive_it->second].root_index
+	)) {
+		return indexed_paths[exact_it->second].path;
+	}
+	if (case_insensitive_it != case_insensitive_file_index.end()) {
+		return indexed_paths[case_insensitive_it->second].path;
 	}
 
 	if (print_error) {
@@ -145,43 +180,57 @@ bool Dataloader::should_ignore_path(fs::path const& path, path_span_t replace_pa
 	return ignore;
 }
 
-template<typename _DirIterator, unique_file_key _UniqueKey>
+template<bool Recursive, unique_file_key _UniqueKey>
 Dataloader::path_vector_t Dataloader::_lookup_files_in_dir(
 	std::string_view path, fs::path const& extension, _UniqueKey const& unique_key
 ) const {
-	const fs::path dirpath { ensure_forward_slash_path(path) };
+	const memory::string dirpath = _make_index_key(path);
 	path_vector_t ret;
 	struct file_entry_t {
-		fs::path file;
-		fs::path const* root = nullptr;
+		fs::path const* file = nullptr;
+		size_t root_index = 0;
 	};
 	string_map_t<file_entry_t> found_files;
-	for (fs::path const& root : roots) {
-		const size_t root_len = root.string().size();
-		std::error_code ec;
-		if (root == roots.back() && should_ignore_path(dirpath, replace_paths)) {
+	// Stack of directories being visited and the position of the next child to visit in each
+	memory::vector<std::pair<memory::vector<size_t> const*, size_t>> pending_directories;
+	for (size_t root_index = 0; root_index < roots.size(); ++root_index) {
+		if (root_index == roots.size() - 1 && should_ignore_path(fs::path { dirpath }, replace_paths)) {
 			continue;
 		}
-		for (fs::directory_entry const& entry : _DirIterator { root / dirpath, ec }) {
-			if (entry.is_regular_file()) {
-				fs::path file = entry;
-				if (extension.empty() || file.extension() == extension) {
-					const memory::string full_path = file.string<char>(memory::string::allocator_type{});
-					std::string_view relative_path = full_path;
-					relative_path.remove_prefix(root_len);
-					relative_path = remove_leading_slashes(relative_path);
-					const std::string_view key = unique_key(relative_path);
-					if (!key.empty()) {
-						const typename decltype(found_files)::const_iterator it = found_files.find(key);
-						if (it == found_files.end()) {
-							found_files.emplace(key, file_entry_t { file, &root });
-							ret.emplace_back(std::move(file));
-						} else if (it->second.root == &root) {
-							spdlog::warn_s(
-								"Files under the same root with conflicting keys: {} - {} (accepted) and {} - {} (rejected)",
-								it->first, it->second.file, key, file
-							);
-						}
+		directory_children_map_t const& directory_children = directory_children_per_root[root_index];
+		const directory_children_map_t::const_iterator dir_it = directory_children.find(dirpath);
+		if (dir_it == directory_children.end()) {
+			continue;
+		}
+		pending_directories.emplace_back(&dir_it.value(), 0);
+		while (!pending_directories.empty()) {
+			auto& [children, next_child] = pending_directories.back();
+			if (next_child >= children->size()) {
+				pending_directories.pop_back();
+				continue;
+			}
+			indexed_path_t const& entry = indexed_paths[(*children)[next_child++]];
+			if (entry.is_directory) {
+				if constexpr (Recursive) {
+					const directory_children_map_t::const_iterator subdir_it = directory_children.find(entry.relative_path);
+					if (subdir_it != directory_children.end()) {
+						pending_directories.emplace_back(&subdir_it.value(), 0);
+					}
+				}
+				continue;
+			}
+			if (extension.empty() || entry.path.extension() == extension) {
+				const std::string_view key = unique_key(std::string_view { entry.relative_path });
+				if (!key.empty()) {
+					const typename decltype(found_files)::const_iterator it = found_files.find(key);
+					if (it == found_files.end()) {
+						found_files.emplace(key, file_entry_t { &entry.path, root_index });
+						ret.push_back(entry.path);
+					} else if (it->second.root_index == root_index) {
+						spdlog::warn_s(
+							"Files under the same root with conflicting keys: {} - {} (accepted) and {} - {} (rejected)",
+							it->first, *it->second.file, key, entry.path
+						);
 					}
 				}
 			}
@@ -191,11 +240,11 @@ Dataloader::path_vector_t Dataloader::_lookup_files_in_dir(
 }
 
 Dataloader::path_vector_t Dataloader::lookup_files_in_dir(std::string_view path, fs::path const& extension) const {
-	return _lookup_files_in_dir<fs::directory_iterator>(path, extension, std::identity {});
+	return _lookup_files_in_dir<false>(path, extension, std::identity {});
 }
 
 Dataloader::path_vector_t Dataloader::lookup_files_in_dir_recursive(std::string_view path, fs::path const& extension) const {
-	return _lookup_files_in_dir<fs::recursive_directory_iterator>(path, extension, std::identity {});
+	return _lookup_files_in_dir<true>(path, extension, std::identity {});
 }
 
 static std::string_view _extract_basic_identifier_prefix_from_path(std::string_view path) {
@@ -205,13 +254,13 @@ static std::string_view _extract_basic_identifier_prefix_from_path(std::string_v
 Dataloader::path_vector_t Dataloader::lookup_basic_identifier_prefixed_files_in_dir(
 	std::string_view path, fs::path const& extension
 ) const {
-	return _lookup_files_in_dir<fs::directory_iterator>(path, extension, _extract_basic_identifier_prefix_from_path);
+	return _lookup_files_in_dir<false>(path, extension, _extract_basic_identifier_prefix_from_path);
 }
 
 Dataloader::path_vector_t Dataloader::lookup_basic_identifier_prefixed_files_in_dir_recursive(
 	std::string_view path, fs::path const& extension
 ) const {
-	return _lookup_files_in_dir<fs::recursive_directory_iterator>(path, extension, _extract_basic_identifier_prefix_from_path);
+	return _lookup_files_in_dir<true>(path, extension, _extract_basic_identifier_prefix_from_path);
 }
 
 bool Dataloader::apply_to_files(path_span_t files, apply_files_callback_t callback) const {
@@ -225,65 +274,96 @@ bool Dataloader::apply_to_files(path_span_t files, apply_files_callback_t callba
 	return ret;
 }
 
+bool Dataloader::apply_to_parsed_files(path_span_t files, apply_parsed_files_callback_t callback) const {
+	memory::vector<parsed_defines_t> parsed_files = parse_defines_concurrently(files);
+
+	bool ret = true;
+	for (std::size_t i = 0; i < files.size(); ++i) {
+		if (!callback(files[i], parsed_files[i])) {
+			spdlog::error_s("Callback failed for file: {}", files[i]);
+			ret = false;
+		}
+	}
+	return ret;
+}
+
 string_set_t Dataloader::lookup_dirs_in_dir(std::string_view path) const {
-	const fs::path dirpath { ensure_forward_slash_path(path) };
+	const memory::string dirpath = _make_index_key(path);
 	string_set_t ret;
-	for (fs::path const& root : roots) {
-		std::error_code ec;
-		for (fs::directory_entry const& entry : fs::directory_iterator { root / dirpath, ec }) {
-			if (entry.is_directory()) {
-				ret.emplace(entry.path().filename().string());
+	for (directory_children_map_t const& directory_children : directory_children_per_root) {
+		const directory_children_map_t::const_iterator dir_it = directory_children.find(dirpath);
+		if (dir_it != directory_children.end()) {
+			for (const size_t child_index : dir_it->second) {
+				indexed_path_t const& entry = indexed_paths[child_index];
+				if (entry.is_directory) {
+					ret.emplace(entry.path.filename().string());
+				}
 			}
 		}
 	}
 	return ret;
 }
 
-template<std::derived_from<ovdl::detail::BasicParser> Parser, bool (*parse_func)(Parser&)>
-static Parser _run_ovdl_parser(fs::path const& path) {
+/* log_error is called with each error message, letting concurrent parses hold their errors back until the file is used. */
+template<std::derived_from<ovdl::detail::BasicParser> Parser, bool (*parse_func)(Parser&), typename ErrorCallback>
+static Parser _run_ovdl_parser(fs::path const& path, ErrorCallback&& log_error) {
 	Parser parser;
 	memory::string buffer;
+	struct error_log_data_t {
+		memory::string& buffer;
+		ErrorCallback& log_error;
+	} error_log_data { buffer, log_error };
 	auto error_log_stream = ovdl::detail::make_callback_stream<char>(
 		[](void const* s, std::streamsize n, void* user_data) -> std::streamsize {
 			if (s != nullptr && n > 0 && user_data != nullptr) {
-				static_cast<memory::string*>(user_data)->append(static_cast<char const*>(s), n);
+				static_cast<error_log_data_t*>(user_data)->buffer.append(static_cast<char const*>(s), n);
 				return n;
 			} else {
-				spdlog::error_s("Invalid input to parser error log callback: {} / {} / {}", s, n, user_data);
+				if (user_data != nullptr) {
+					static_cast<error_log_data_t*>(user_data)->log_error(memory::fmt::format(
+						"Invalid input to parser error log callback: {} / {} / {}", s, n, user_data
+					));
+				} else {
+					spdlog::error_s("Invalid input to parser error log callback: {} / {} / {}", s, n, user_data);
+				}
 				return 0;
 			}
 		},
-		&buffer
+		&error_log_data
 	);
 	parser.set_error_log_to(error_log_stream);
 	parser.load_from_file(path);
 	if (!buffer.empty()) {
-		spdlog::error_s("Parser load errors for {}:\n\n{}\n", path, buffer);
+		log_error(memory::fmt::format("Parser load errors for {}:\n\n{}\n", path, buffer));
 		buffer.clear();
 	}
 	if (parser.has_fatal_error() || parser.has_error()) {
-		spdlog::error_s("Parser errors while loading {}", path);
+		log_error(memory::fmt::format("Parser errors while loading {}", path));
 		return parser;
 	}
 	if (!parse_func(parser)) {
-		spdlog::error_s("Parse function returned false for {}!", path);
+		log_error(memory::fmt::format("Parse function returned false for {}!", path));
 	}
 	if (!buffer.empty()) {
-		spdlog::error_s("Parser parse errors for {}:\n\n{}\n", path, buffer);
+		log_error(memory::fmt::format("Parser parse errors for {}:\n\n{}\n", path, buffer));
 		buffer.clear();
 	}
 	if (parser.has_fatal_error() || parser.has_error()) {
-		spdlog::error_s("Parser errors while parsing {}", path);
+		log_error(memory::fmt::format("Parser errors while parsing {}", path));
 	}
 	return parser;
 }
 
+static void _log_parser_error(memory::string const& message) {
+	spdlog::error_s("{}", message);
+}
+
 static bool _v2script_parse(v2script::Parser& parser) {
 	return parser.simple_parse();
 }
 
 v2script::Parser Dataloader::parse_defines(fs::path const& path) {
-	return _run_ovdl_parser<v2script::Parser, &_v2script_parse>(path);
+	return _run_ovdl_parser<v2script::Parser, &_v2script_parse>(path, _log_parser_error);
 }
 
 static bool _lua_parse(v2script::Parser& parser) {
@@ -291,7 +371,7 @@ static bool _lua_parse(v2script::Parser& parser) {
 }
 
 v2script::Parser Dataloader::parse_lua_defines(fs::path const& path) {
-	return _run_ovdl_parser<v2script::Parser, &_lua_parse>(path);
+	return _run_ovdl_parser<v2script::Parser, &_lua_parse>(path, _log_parser_error);
 }
 
 static bool _csv_parse(csv::Parser& parser) {
@@ -299,13 +379,37 @@ static bool _csv_parse(csv::Parser& parser) {
 }
 
 csv::Parser Dataloader::parse_csv(fs::path const& path) {
-	return _run_ovdl_parser<csv::Parser, &_csv_parse>(path);
+	return _run_ovdl_parser<csv::Parser, &_csv_parse>(path, _log_parser_error);
 }
 
 v2script::Parser& Dataloader::parse_defines_cached(fs::path const& path) {
 	return cached_parsers.emplace_back(parse_defines(path));
 }
 
+ast::NodeCPtr Dataloader::parsed_defines_t::get_file_node() {
+	for (memory::string const& message : deferred_errors) {
+		_log_parser_error(message);
+	}
+	deferred_errors.clear();
+	return parser->get_file_node();
+}
+
+memory::vector<Dataloader::parsed_defines_t> Dataloader::parse_defines_concurrently(path_span_t files) {
+	memory::vector<parsed_defines_t> parsed_files(files.size());
+
+	for_each_index_concurrently(files.size(), [files, &parsed_files](const std::size_t file_index) -> void {
+		parsed_defines_t& parsed_file = parsed_files[file_index];
+		parsed_file.parser.emplace(_run_ovdl_parser<v2script::Parser, &_v2script_parse>(
+			files[file_index],
+			[&parsed_file](memory::string&& message) -> void {
+				parsed_file.deferred_errors.push_back(std::move(message));
+			}
+		));
+	});
+
+	return parsed_files;
+}
+
 void Dataloader::free_cache() {
 	cached_parsers.clear();
 }
@@ -591,9 +695,11 @@ bool Dataloader::_load_history(DefinitionManager& definition_manager, bool unuse
 		country_history_manager.reserve_more_country_histories(country_history_files.size());
 		deployment_manager.reserve_more_deployments(country_history_files.size());
 
-		ret &= apply_to_files(
+		ret &= apply_to_parsed_files(
 			country_history_files,
-			[this, &definition_manager, &country_history_manager, unused_history_file_warnings](fs::path const& file) -> bool {
+			[this, &definition_manager, &country_history_manager, unused_history_file_warnings](
+				fs::path const& file, parsed_defines_t& parsed_file
+			) -> bool {
 				const memory::string filename = file.stem().string<char>(memory::string::allocator_type{});
 				const std::string_view country_id = extract_basic_identifier_prefix(filename);
 
@@ -610,7 +716,7 @@ bool Dataloader::_load_history(DefinitionManager& definition_manager, bool unuse
 					definition_manager, *this, *country,
 					definition_manager.get_politics_manager().get_ideology_manager().get_ideologies(),
 					definition_manager.get_politics_manager().get_government_type_manager().get_government_types(),
-					parse_defines(file).get_file_node()
+					parsed_file.get_file_node()
 				);
 			}
 		);
@@ -634,10 +740,10 @@ bool Dataloader::_load_history(DefinitionManager& definition_manager, bool unuse
 
 		province_history_manager.reserve_more_province_histories(province_history_files.size());
 
-		ret &= apply_to_files(
+		ret &= apply_to_parsed_files(
 			province_history_files,
 			[this, &definition_manager, &province_history_manager, &map_definition, unused_history_file_warnings](
-				fs::path const& file
+				fs::path const& file, parsed_defines_t& parsed_file
 			) -> bool {
 				const memory::string filename = file.stem().string<char>(memory::string::allocator_type{});
 				const std::string_view province_id = extract_basic_identifier_prefix(filename);
@@ -651,7 +757,7 @@ bool Dataloader::_load_history(DefinitionManager& definition_manager, bool unuse
 				}
 
 				return province_history_manager.load_province_history_file(
-					definition_manager, *province, parse_defines(file).get_file_node()
+					definition_manager, *province, parsed_file.get_file_node()
 				);
 			}
 		);
@@ -670,13 +776,13 @@ bool Dataloader::_load_history(DefinitionManager& definition_manager, bool unuse
 			if (result.ec == std::errc{} && date <= last_bookmark_date) {
 				bool non_integer_size = false;
 
-				ret &= apply_to_files(
+				ret &= apply_to_parsed_files(
 					lookup_files_in_dir(append_string_views(pop_history_directory, dir), ".txt"),
 					[this, &definition_manager, &province_history_manager, date, &non_integer_size](
-						fs::path const& file
+						fs::path const& file, parsed_defines_t& parsed_file
 					) -> bool {
 						return province_history_manager.load_pop_history_file(
-							definition_manager, date, parse_defines(file).get_file_node(), &non_integer_size
+							definition_manager, date, parsed_file.get_file_node(), &non_integer_size
 						);
 					}
 				);
@@ -697,11 +803,13 @@ bool Dataloader::_load_history(DefinitionManager& definition_manager, bool unuse
 
 		static constexpr std::string_view diplomacy_history_directory = "history/diplomacy";
 
-		ret &= apply_to_files(
+		ret &= apply_to_parsed_files(
 			lookup_files_in_dir(diplomacy_history_directory, ".txt"),
-			[this, &definition_manager, &diplomatic_history_manager](fs::path const& file) -> bool {
+			[this, &definition_manager, &diplomatic_history_manager](
+				fs::path const& file, parsed_defines_t& parsed_file
+			) -> bool {
 				return diplomatic_history_manager.load_diplomacy_history_file(
-					definition_manager.get_country_definition_manager(), parse_defines(file).get_file_node()
+					definition_manager.get_country_definition_manager(), parsed_file.get_file_node()
 				);
 			}
 		);
@@ -712,11 +820,13 @@ bool Dataloader::_load_history(DefinitionManager& definition_manager, bool unuse
 
 		diplomatic_history_manager.reserve_more_wars(war_history_files.size());
 
-		ret &= apply_to_files(
+		ret &= apply_to_parsed_files(
 			war_history_files,
-			[this, &definition_manager, &diplomatic_history_manager](fs::path const& file) -> bool {
+			[this, &definition_manager, &diplomatic_history_manager](
+				fs::path const& file, parsed_defines_t& parsed_file
+			) -> bool {
 				return diplomatic_history_manager.load_war_history_file(
-					definition_manager, parse_defines(file).get_file_node()
+					definition_manager, parsed_file.get_file_node()
 				);
 			}
 		);
@@ -855,7 +965,7 @@ bool Dataloader::_load_map_dir(DefinitionManager& definition_manager) const {
 	if (!map_definition.load_map_images(
 		lookup_file(append_string_views(map_directory, provinces)),
 		lookup_file(append_string_views(map_directory, terrain)),
-		lookup_file(append_string_views(map_directory, rivers)), false
+		lookup_file(append_string_views(map_directory, rivers)), false, derived_map_cache_path
 	)) {
 		spdlog::critical_s("Failed to load map images!");
 		ret = false;
@@ -1226,8 +1336,9 @@ bool Dataloader::parse_scripts(DefinitionManager& definition_manager) const {
 
 #undef PARSE_SCRIPTS
 
-static bool _load_localisation_file(Dataloader::localisation_callback_t callback, std::span<const csv::LineObject> lines) {
-	bool ret = true;
+static void _collect_localisation_entries(
+	std::span<const csv::LineObject> lines, memory::vector<LocalisationStore::source_entry_t>& entries
+) {
 	for (csv::LineObject const& line : lines) {
 		const std::string_view key = line.get_value_for(0);
 		if (!key.empty()) {
@@ -1235,19 +1346,45 @@ static bool _load_localisation_file(Dataloader::localisation_callback_t callback
 			for (size_t i = 0; i < max_entry; ++i) {
 				const std::string_view entry = line.get_value_for(i + 1);
 				if (!entry.empty()) {
-					ret &= callback(key, static_cast<Dataloader::locale_t>(i), entry);
+					entries.push_back({ key, static_cast<Dataloader::locale_t>(i), entry });
 				}
 			}
 		}
 	}
-	return ret;
 }
 
-bool Dataloader::load_localisation_files(localisation_callback_t callback, std::string_view localisation_dir) const {
-	return apply_to_files(
-		lookup_files_in_dir(localisation_dir, ".csv"),
-		[callback](fs::path path) -> bool {
-			return _load_localisation_file(callback, parse_csv(path).get_lines());
+bool Dataloader::load_localisation_store(LocalisationStore& store, std::string_view localisation_dir) const {
+	const path_vector_t localisation_files = lookup_files_in_dir(localisation_dir, ".csv");
+
+	/* The files are parsed concurrently, then their errors are logged and their entries resolved in load order. */
+	memory::vector<std::optional<csv::Parser>> parsers(localisation_files.size());
+	memory::vector<memory::vector<memory::string>> deferred_errors(localisation_files.size());
+	memory::vector<memory::vector<LocalisationStore::source_entry_t>> file_entries(localisation_files.size());
+	for_each_index_concurrently(localisation_files.size(), [&](const std::size_t file_index) -> void {
+		memory::vector<memory::string>& errors = deferred_errors[file_index];
+		csv::Parser& parser = parsers[file_index].emplace(_run_ovdl_parser<csv::Parser, &_csv_parse>(
+			localisation_files[file_index],
+			[&errors](memory::string&& message) -> void {
+				errors.push_back(std::move(message));
+			}
+		));
+		_collect_localisation_entries(parser.get_lines(), file_entries[file_index]);
+	});
+	for (memory::vector<memory::string> const& errors : deferred_errors) {
+		for (memory::string const& message : errors) {
+			_log_parser_error(message);
 		}
+	}
+
+	store.build(file_entries);
+	SPDLOG_INFO(
+		"Loaded {} localisation keys with {} entries ({} bytes of text) from {} files", store.get_key_count(),
+		store.get_entry_count(), store.get_arena_size(), localisation_files.size()
 	);
+	return true;
+}
+
+bool Dataloader::load_localisation_files(localisation_callback_t callback, std::string_view localisation_dir) const {
+	LocalisationStore store;
+	return load_localisation_store(store, localisation_dir) && store.for_each_entry(callback);
 }
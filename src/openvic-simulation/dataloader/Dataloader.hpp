@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <string_view>
 
 #include <openvic-dataloader/csv/Parser.hpp>
@@ -8,16 +9,19 @@
 
 #include <function2/function2.hpp>
 
+#include "openvic-simulation/core/memory/String.hpp"
 #include "openvic-simulation/core/memory/Vector.hpp"
 #include "openvic-simulation/core/template/Concepts.hpp"
 #include "openvic-simulation/dataloader/ModManager.hpp"
 #include "openvic-simulation/dataloader/NodeTools.hpp"
+#include "openvic-simulation/types/OrderedContainers.hpp"
 
 namespace OpenVic {
 	namespace fs = std::filesystem;
 
 	struct DefinitionManager;
 	struct GameRulesManager;
+	struct LocalisationStore;
 	class UIManager;
 
 	class Dataloader {
@@ -28,8 +32,28 @@ namespace OpenVic {
 	private:
 		path_vector_t PROPERTY(roots);
 		path_vector_t PROPERTY(replace_paths);
+		/* Where MapDefinition caches the products of the map images between runs, disabled if empty. */
+		fs::path PROPERTY(derived_map_cache_path);
 		memory::vector<ovdl::v2script::Parser> cached_parsers;
 
+		/* Every file and directory under the roots, found by walking each root once when the roots are set. Paths under the
+		 * base root which fall within a replace path are never indexed as files, so lookups don't need to check for them. */
+		struct indexed_path_t {
+			fs::path path;
+			memory::string relative_path; // Relative to the root, with forward slashes and no leading or trailing slashes
+			size_t root_index;
+			bool is_directory;
+		};
+		memory::vector<indexed_path_t> indexed_paths;
+		/* Relative file path -> index of the file under the highest priority root containing it. */
+		string_map_t<size_t> file_index;
+		case_insensitive_string_map_t<size_t> case_insensitive_file_index;
+		/* Per root, relative directory path -> indices of its children in directory iteration order. */
+		using directory_children_map_t = string_map_t<memory::vector<size_t>>;
+		memory::vector<directory_children_map_t> directory_children_per_root;
+
+		void _build_path_index();
+
 		bool _load_interface_files(UIManager& ui_manager) const;
 		bool _load_pop_types(DefinitionManager& definition_manager);
 		bool _load_units(DefinitionManager& definition_manager) const;
@@ -46,10 +70,11 @@ namespace OpenVic {
 
 		bool should_ignore_path(fs::path const& path, path_span_t replace_paths) const;
 
-		/* _DirIterator is fs::directory_iterator or fs::recursive_directory_iterator. _UniqueKey is the type of a callable
-		 * which converts a string_view filepath with root removed into a string_view unique key. Any path whose key is empty
-		 * or matches an earlier found path's key is discarded, ensuring each looked up path's key is non-empty and unique. */
-		template<typename _DirIterator, unique_file_key _UniqueKey>
+		/* Recursive chooses whether files in subdirectories are included, in the same order as fs::recursive_directory_iterator
+		 * would visit them. _UniqueKey is the type of a callable which converts a string_view filepath with root removed into a
+		 * string_view unique key. Any path whose key is empty or matches an earlier found path's key is discarded, ensuring
+		 * each looked up path's key is non-empty and unique. */
+		template<bool Recursive, unique_file_key _UniqueKey>
 		path_vector_t _lookup_files_in_dir(
 			std::string_view path, fs::path const& extension, _UniqueKey const& unique_key
 		) const;
@@ -64,6 +89,22 @@ namespace OpenVic {
 		 * is only guaranteed to be valid until the function is next called. */
 		ovdl::v2script::Parser& parse_defines_cached(fs::path const& path);
 
+		/* A file parsed by parse_defines_concurrently. Parser errors are held back until the file node is first requested,
+		 * so they're logged at the same point relative to other logs as if the file had been parsed with parse_defines. */
+		struct parsed_defines_t {
+			friend class Dataloader;
+
+		private:
+			std::optional<ovdl::v2script::Parser> parser;
+			memory::vector<memory::string> deferred_errors;
+
+		public:
+			ast::NodeCPtr get_file_node();
+		};
+
+		/* Parses every file on worker threads, returning the results in the same order as files. */
+		static memory::vector<parsed_defines_t> parse_defines_concurrently(path_span_t files);
+
 	private:
 		/* Clear the cache vector, freeing all cached Parsers and their Node trees. Pointers to cached Parsers' Nodes should
 		 * be set to null before this is called to avoid segfaults. */
@@ -102,6 +143,10 @@ namespace OpenVic {
 		/// @return True if successful, false if failed.
 		bool set_roots(path_span_t new_roots, path_span_t new_replace_paths, bool warn_on_override = true);
 
+		inline void set_derived_map_cache_path(fs::path const& path) {
+			derived_map_cache_path = path;
+		}
+
 		/* REQUIREMENTS:
 		 * DAT-24
 		 */
@@ -121,6 +166,13 @@ namespace OpenVic {
 		using apply_files_callback_t = fu2::function_base<true, true, fu2::capacity_fixed<apply_callback_stack_size, 8>, false, false, bool(fs::path const&)>;
 		bool apply_to_files(path_span_t files, apply_files_callback_t callback) const;
 
+		using apply_parsed_files_callback_t = fu2::function_base<
+			true, true, fu2::capacity_fixed<apply_callback_stack_size, 8>, false, false,
+			bool(fs::path const&, parsed_defines_t&)
+		>;
+		/* Parses all the files concurrently, then calls callback for each file in order on the calling thread. */
+		bool apply_to_parsed_files(path_span_t files, apply_parsed_files_callback_t callback) const;
+
 		string_set_t lookup_dirs_in_dir(std::string_view path) const;
 
 		/* Load all mod descriptors present in the mod/ directory. Importantly, loads dependencies and replace_paths for us to check. */
@@ -147,6 +199,9 @@ namespace OpenVic {
 
 		/* Args: key, locale, localisation */
 		using localisation_callback_t = NodeTools::callback_t<std::string_view, locale_t, std::string_view>;
+		/* Parses the localisation files concurrently into store. */
+		bool load_localisation_store(LocalisationStore& store, std::string_view localisation_dir = "localisation") const;
+		/* Loads a LocalisationStore and passes each of its entries to callback. */
 		bool load_localisation_files(
 			localisation_callback_t callback, std::string_view localisation_dir = "localisation"
 		) const;
@@ -0,0 +1,115 @@
+#include "LocalisationStore.hpp"
+
+#include <algorithm>
+
+using namespace OpenVic;
+
+void LocalisationStore::build(std::span<const memory::vector<source_entry_t>> file_entries) {
+	clear();
+
+	size_t source_count = 0;
+	for (memory::vector<source_entry_t> const& entries_in_file : file_entries) {
+		source_count += entries_in_file.size();
+	}
+	memory::vector<source_entry_t const*> sources;
+	sources.reserve(source_count);
+	// Sources are gathered last loaded first, so after sorting stably by key and locale the entry loaded last, which
+	// overrides the others, comes first in each run of duplicates
+	for (auto file_it = file_entries.rbegin(); file_it != file_entries.rend(); ++file_it) {
+		for (auto source_it = file_it->rbegin(); source_it != file_it->rend(); ++source_it) {
+			sources.push_back(&*source_it);
+		}
+	}
+
+	std::stable_sort(sources.begin(), sources.end(), [](source_entry_t const* lhs, source_entry_t const* rhs) -> bool {
+		return lhs->key < rhs->key || (lhs->key == rhs->key && lhs->locale < rhs->locale);
+	});
+	sources.erase(
+		std::unique(sources.begin(), sources.end(), [](source_entry_t const* lhs, source_entry_t const* rhs) -> bool {
+			return lhs->key == rhs->key && lhs->locale == rhs->locale;
+		}),
+		sources.end()
+	);
+
+	// Entries are often repeated across locales and keys, so each distinct string is only stored once
+	ordered_map<std::string_view, size_t> string_offsets;
+	size_t arena_size = 0;
+	const auto reserve_string = [&string_offsets, &arena_size](const std::string_view string) -> void {
+		if (string_offsets.emplace(string, arena_size).second) {
+			arena_size += string.size();
+		}
+	};
+	for (source_entry_t const* source : sources) {
+		reserve_string(source->key);
+		reserve_string(source->entry);
+	}
+	arena.resize(arena_size);
+	for (auto const& [string, offset] : string_offsets) {
+		std::copy(string.begin(), string.end(), arena.begin() + offset);
+	}
+	const auto get_interned = [this, &string_offsets](const std::string_view string) -> std::string_view {
+		return { arena.data() + string_offsets.find(string)->second, string.size() };
+	};
+
+	entries.reserve(sources.size());
+	for (size_t source_index = 0; source_index < sources.size();) {
+		const std::string_view key = sources[source_index]->key;
+		const size_t first_entry = entries.size();
+		for (; source_index < sources.size() && sources[source_index]->key == key; ++source_index) {
+			entries.push_back({ get_interned(sources[source_index]->entry), sources[source_index]->locale });
+		}
+		key_entries.emplace(
+			get_interned(key),
+			key_entries_t { static_cast<uint32_t>(first_entry), static_cast<uint32_t>(entries.size() - first_entry) }
+		);
+	}
+}
+
+void LocalisationStore::clear() {
+	key_entries.clear();
+	entries.clear();
+	arena.clear();
+}
+
+std::string_view LocalisationStore::get_localisation(std::string_view key, locale_t locale) const {
+	const decltype(key_entries)::const_iterator it = key_entries.find(key);
+	if (it == key_entries.end()) {
+		return {};
+	}
+	const std::span<const locale_entry_t> entries_for_key {
+		entries.data() + it->second.first_entry, it->second.entry_count
+	};
+	for (locale_entry_t const& entry : entries_for_key) {
+		if (entry.locale == locale) {
+			return entry.entry;
+		}
+	}
+	return {};
+}
+
+bool LocalisationStore::has_key(std::string_view key) const {
+	return key_entries.contains(key);
+}
+
+size_t LocalisationStore::get_key_count() const {
+	return key_entries.size();
+}
+
+size_t LocalisationStore::get_entry_count() const {
+	return entries.size();
+}
+
+size_t LocalisationStore::get_arena_size() const {
+	return arena.size();
+}
+
+bool LocalisationStore::for_each_entry(Dataloader::localisation_callback_t& callback) const {
+	bool ret = true;
+	for (auto const& [key, range] : key_entries) {
+		for (uint32_t entry_index = range.first_entry; entry_index < range.first_entry + range.entry_count; ++entry_index) {
+			locale_entry_t const& entry = entries[entry_index];
+			ret &= callback(key, entry.locale, entry.entry);
+		}
+	}
+	return ret;
+}
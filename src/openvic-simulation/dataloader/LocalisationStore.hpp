@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/dataloader/Dataloader.hpp"
+#include "openvic-simulation/types/OrderedContainers.hpp"
+
+namespace OpenVic {
+	/* Read-only localisation loaded from the localisation CSVs. Every key and entry is copied into one arena, with each
+	 * distinct string stored once, so the parsers can be freed and lookups need no per-string allocations. When several
+	 * entries share a key and locale, the one loaded last wins, so later mod roots override earlier ones. */
+	struct LocalisationStore {
+		using locale_t = Dataloader::locale_t;
+
+		/* An entry as it appears in a parsed file, pointing into the file's parser. */
+		struct source_entry_t {
+			std::string_view key;
+			locale_t locale;
+			std::string_view entry;
+		};
+
+	private:
+		struct key_entries_t {
+			uint32_t first_entry;
+			uint32_t entry_count;
+		};
+		struct locale_entry_t {
+			std::string_view entry;
+			locale_t locale;
+		};
+
+		/* Sized once when the store is built and never resized afterwards, so views into it stay valid. */
+		memory::vector<char> arena;
+		/* Keys are views into the arena, in sorted order. Each key's entries are contiguous and sorted by locale. */
+		ordered_map<std::string_view, key_entries_t> key_entries;
+		memory::vector<locale_entry_t> entries;
+
+	public:
+		LocalisationStore() = default;
+		LocalisationStore(LocalisationStore&&) = default;
+		LocalisationStore& operator=(LocalisationStore&&) = default;
+		LocalisationStore(LocalisationStore const&) = delete;
+		LocalisationStore& operator=(LocalisationStore const&) = delete;
+
+		/* Replaces the store's contents with the entries of each file, with the files given in load order. */
+		void build(std::span<const memory::vector<source_entry_t>> file_entries);
+		void clear();
+
+		/* Returns an empty string_view if there is no entry for the key and locale. */
+		std::string_view get_localisation(std::string_view key, locale_t locale) const;
+		bool has_key(std::string_view key) const;
+
+		size_t get_key_count() const;
+		size_t get_entry_count() const;
+		size_t get_arena_size() const;
+
+		/* Calls callback once for every entry, grouped by key, for embedders which keep their own copy of localisation. */
+		bool for_each_entry(Dataloader::localisation_callback_t& callback) const;
+	};
+}
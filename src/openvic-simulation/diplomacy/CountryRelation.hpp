@@ -100,6 +100,8 @@ namespace std {
 
 namespace OpenVic {
 	struct CountryRelationManager {
+		friend struct InstanceSave;
+
 		using relation_value_type = int16_t;
 		class influence_value_type {
 			static constexpr uint16_t MAX_VALUE = 100; // TODO: implement defines.diplomacy.MAX_INFLUENCE
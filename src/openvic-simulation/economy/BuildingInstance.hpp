@@ -12,6 +12,8 @@ namespace OpenVic {
 	struct ProvinceInstance;
 
 	struct BuildingInstance : HasIdentifier { // used in the actual game
+		friend struct InstanceSave;
+
 		enum class ExpansionState { CannotExpand, CanExpand, Preparing, Expanding };
 
 	private:
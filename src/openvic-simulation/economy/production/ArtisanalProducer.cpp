@@ -92,6 +92,7 @@ void ArtisanalProducer::artisan_tick_handler::calculate_inputs(
 
 		if (should_report_input_demand && country_to_report_economy_nullable != nullptr) {
 			country_to_report_economy_nullable->report_input_demand(
+				country_report_buffer,
 				production_type,
 				input_good.index,
 				desired_quantity
@@ -130,7 +131,7 @@ void ArtisanalProducer::artisan_tick_handler::produce(
 	}
 
 	if (country_to_report_economy_nullable != nullptr) {
-		country_to_report_economy_nullable->report_output(production_type, current_production);
+		country_to_report_economy_nullable->report_output(country_report_buffer, production_type, current_production);
 	}
 
 	fixed_point_map_t<GoodDefinition const*> const& input_goods = production_type.input_goods;
@@ -146,6 +147,7 @@ void ArtisanalProducer::artisan_tick_handler::produce(
 
 		if (country_to_report_economy_nullable != nullptr) {
 			country_to_report_economy_nullable->report_input_consumption(
+				country_report_buffer,
 				production_type,
 				input_good.index,
 				consumed_quantity
@@ -184,7 +186,7 @@ void ArtisanalProducer::artisan_tick_handler::allocate_money_for_inputs(
 	PopValuesFromProvince const& values_from_province
 ) {
 	//executed once per pop while nothing else uses it.
-	const fixed_point_t total_cash_to_spend = pop.get_cash().get_copy_of_value() / values_from_province.get_max_cost_multiplier();
+	const fixed_point_t total_cash_to_spend = pop.get_cash() / values_from_province.get_max_cost_multiplier();
 
 	if (total_cash_to_spend <= 0 || distinct_goods_to_buy <= 0) {
 		return;
@@ -289,6 +291,7 @@ void ArtisanalProducer::artisan_tick(
 	Pop& pop,
 	PopValuesFromProvince const& values_from_province,
 	RandomU32& random_number_generator,
+	CountryReportBuffer& country_report_buffer,
 	TypedSpan<good_index_t, char> reusable_goods_mask,
 	memory::vector<fixed_point_t>& pop_max_quantity_to_buy_per_good,
 	memory::vector<fixed_point_t>& pop_money_to_spend_per_good,
@@ -336,6 +339,7 @@ void ArtisanalProducer::artisan_tick(
 
 		artisan_tick_handler tick_handler {
 			country_to_report_economy_nullable,
+			country_report_buffer,
 			demand_per_input,
 			market_instance,
 			max_price_per_input,
@@ -369,6 +373,7 @@ void ArtisanalProducer::artisan_tick(
 
 		artisan_tick_handler tick_handler {
 			country_to_report_economy_nullable,
+			country_report_buffer,
 			demand_per_input,
 			market_instance,
 			max_price_per_input,
@@ -15,6 +15,7 @@
 namespace OpenVic {
 	struct ArtisanalProducerDeps;
 	struct CountryInstance;
+	struct CountryReportBuffer;
 	struct EconomyDefines;
 	struct GoodDefinition;
 	struct GoodInstanceManager;
@@ -28,6 +29,8 @@ namespace OpenVic {
 	struct pop_size_t;
 
 	struct ArtisanalProducer {
+		friend struct InstanceSave;
+
 	private:
 		EconomyDefines const& economy_defines;
 		ModifierEffectCache const& modifier_effect_cache;
@@ -69,6 +72,7 @@ namespace OpenVic {
 			Pop& pop,
 			PopValuesFromProvince const& values_from_province,
 			RandomU32& random_number_generator,
+			CountryReportBuffer& country_report_buffer,
 			TypedSpan<good_index_t, char> reusable_goods_mask,
 			memory::vector<fixed_point_t>& pop_max_quantity_to_buy_per_good,
 			memory::vector<fixed_point_t>& pop_money_to_spend_per_good,
@@ -94,6 +98,7 @@ namespace OpenVic {
 		struct artisan_tick_handler {
 		private:
 			CountryInstance* const country_to_report_economy_nullable;
+			CountryReportBuffer& country_report_buffer;
 			memory::vector<fixed_point_t>& demand_per_input;
 			int32_t distinct_goods_to_buy = 0;
 			Fraction inputs_bought_fraction;
@@ -106,6 +111,7 @@ namespace OpenVic {
 		public:
 			artisan_tick_handler(
 				CountryInstance* const new_country_to_report_economy_nullable,
+				CountryReportBuffer& new_country_report_buffer,
 				memory::vector<fixed_point_t>& new_demand_per_input,
 				MarketInstance const& new_market_instance,
 				memory::vector<fixed_point_t>& new_max_price_per_input,
@@ -113,6 +119,7 @@ namespace OpenVic {
 				ProductionType const& new_production_type,
 				TypedSpan<good_index_t, char> new_wants_more_mask
 			) : country_to_report_economy_nullable { new_country_to_report_economy_nullable },
+				country_report_buffer { new_country_report_buffer },
 				demand_per_input { new_demand_per_input },
 				market_instance { new_market_instance },
 				max_price_per_input { new_max_price_per_input },
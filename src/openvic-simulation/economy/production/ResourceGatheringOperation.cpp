@@ -126,7 +126,11 @@ fixed_point_t ResourceGatheringOperation::calculate_size_modifier() const {
 	return size_modifier > 0 ? size_modifier : fixed_point_t::_0;
 }
 
-void ResourceGatheringOperation::rgo_tick(memory::vector<fixed_point_t>& reusable_vector) {
+void ResourceGatheringOperation::rgo_tick(
+	MarketOrderBuffer& market_order_buffer,
+	CountryReportBuffer& country_report_buffer,
+	memory::vector<fixed_point_t>& reusable_vector
+) {
 	ProvinceInstance& location = *location_ptr;
 	if (production_type_nullable == nullptr || location.get_owner() == nullptr) {
 		output_quantity_yesterday = 0;
@@ -157,7 +161,7 @@ void ResourceGatheringOperation::rgo_tick(memory::vector<fixed_point_t>& reusabl
 	if (output_quantity_yesterday > 0) {
 		CountryInstance* const country_to_report_economy_nullable = location.get_country_to_report_economy();
 		if (country_to_report_economy_nullable != nullptr) {
-			country_to_report_economy_nullable->report_output(production_type, output_quantity_yesterday);
+			country_to_report_economy_nullable->report_output(country_report_buffer, production_type, output_quantity_yesterday);
 		}
 
 		market_instance.place_market_sell_order(
@@ -170,15 +174,22 @@ void ResourceGatheringOperation::rgo_tick(memory::vector<fixed_point_t>& reusabl
 				this,
 				after_sell,
 			},
+			market_order_buffer,
+			country_report_buffer,
 			reusable_vector
 		);
 	}
 }
 
-void ResourceGatheringOperation::after_sell(void* actor, SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector) {
+void ResourceGatheringOperation::after_sell(
+	void* actor,
+	SellResult const& sell_result,
+	CountryReportBuffer& country_report_buffer,
+	memory::vector<fixed_point_t>& reusable_vector
+) {
 	ResourceGatheringOperation& rgo = *static_cast<ResourceGatheringOperation*>(actor);
 	rgo.revenue_yesterday = sell_result.money_gained;
-	rgo.pay_employees(reusable_vector);
+	rgo.pay_employees(country_report_buffer, reusable_vector);
 }
 
 void ResourceGatheringOperation::hire() {
@@ -359,7 +370,7 @@ fixed_point_t ResourceGatheringOperation::produce() {
 		* output_multiplier * output_from_workers;
 }
 
-void ResourceGatheringOperation::pay_employees(memory::vector<fixed_point_t>& reusable_vector) {
+void ResourceGatheringOperation::pay_employees(CountryReportBuffer& country_report_buffer, memory::vector<fixed_point_t>& reusable_vector) {
 	ProvinceInstance& location = *location_ptr;
 	fixed_point_t const& revenue = revenue_yesterday;
 
@@ -395,7 +406,7 @@ void ResourceGatheringOperation::pay_employees(memory::vector<fixed_point_t>& re
 				fixed_point_t::epsilon //revenue > 0 is already checked, so rounding up
 			);
 			Pop& employee_pop = employee.get_pop();
-			employee_pop.add_rgo_worker_income(income_for_this_pop);
+			employee_pop.add_rgo_worker_income(income_for_this_pop, country_report_buffer);
 			total_employee_income_cache += income_for_this_pop;
 		}
 	} else {
@@ -419,7 +430,7 @@ void ResourceGatheringOperation::pay_employees(memory::vector<fixed_point_t>& re
 					),
 					fixed_point_t::epsilon //revenue > 0 is already checked, so rounding up
 				);
-				owner_pop.add_rgo_owner_income(income_for_this_pop);
+				owner_pop.add_rgo_owner_income(income_for_this_pop, country_report_buffer);
 				total_owner_income_cache += income_for_this_pop;
 			}
 			revenue_left -= total_owner_income_cache;
@@ -472,7 +483,7 @@ void ResourceGatheringOperation::pay_employees(memory::vector<fixed_point_t>& re
 				Pop& employee_pop = employee.get_pop();
 				const fixed_point_t income_for_this_pop = incomes[i];
 				if (income_for_this_pop > 0) {
-					employee_pop.add_rgo_worker_income(income_for_this_pop);
+					employee_pop.add_rgo_worker_income(income_for_this_pop, country_report_buffer);
 					total_employee_income_cache += income_for_this_pop;
 				}
 			}
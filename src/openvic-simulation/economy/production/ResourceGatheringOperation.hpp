@@ -12,7 +12,9 @@
 #include "openvic-simulation/utility/Getters.hpp"
 
 namespace OpenVic {
+	struct CountryReportBuffer;
 	struct MarketInstance;
+	struct MarketOrderBuffer;
 	struct ModifierEffectCache;
 	struct Pop;
 	struct PopType;
@@ -22,6 +24,8 @@ namespace OpenVic {
 	struct SellResult;
 
 	struct ResourceGatheringOperation {
+		friend struct InstanceSave;
+
 	private:
 		MarketInstance& market_instance;
 		ModifierEffectCache const& modifier_effect_cache;
@@ -49,8 +53,13 @@ namespace OpenVic {
 		fixed_point_t calculate_size_modifier() const;
 		void hire();
 		fixed_point_t produce();
-		void pay_employees(memory::vector<fixed_point_t>& reusable_vector);
-		static void after_sell(void* actor, SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector);
+		void pay_employees(CountryReportBuffer& country_report_buffer, memory::vector<fixed_point_t>& reusable_vector);
+		static void after_sell(
+			void* actor,
+			SellResult const& sell_result,
+			CountryReportBuffer& country_report_buffer,
+			memory::vector<fixed_point_t>& reusable_vector
+		);
 
 	public:
 		ResourceGatheringOperation(
@@ -71,6 +80,10 @@ namespace OpenVic {
 		void setup_location_ptr(ProvinceInstance& location);
 		void initialise_rgo_size_multiplier();
 		static constexpr size_t VECTORS_FOR_RGO_TICK = 1;
-		void rgo_tick(memory::vector<fixed_point_t>& reusable_vector);
+		void rgo_tick(
+			MarketOrderBuffer& market_order_buffer,
+			CountryReportBuffer& country_report_buffer,
+			memory::vector<fixed_point_t>& reusable_vector
+		);
 	};
 }
\ No newline at end of file
@@ -6,9 +6,11 @@
 #include "openvic-simulation/types/TypedIndices.hpp"
 
 namespace OpenVic {
+	struct CountryReportBuffer;
+
 	struct GoodBuyUpToOrder {
 		using actor_t = void*;
-		using callback_t = void(*)(const actor_t, BuyResult const&);
+		using callback_t = void(*)(const actor_t, BuyResult const&, CountryReportBuffer&);
 
 	private:
 		const actor_t actor;
@@ -32,8 +34,8 @@ namespace OpenVic {
 			after_trade { new_after_trade }
 			{}
 
-		constexpr void call_after_trade(BuyResult const& buy_result) const {
-			after_trade(actor, buy_result);
+		constexpr void call_after_trade(BuyResult const& buy_result, CountryReportBuffer& country_report_buffer) const {
+			after_trade(actor, buy_result, country_report_buffer);
 		}
 
 		//highest price per unit at which the buyer can afford max_quantity
@@ -63,8 +65,8 @@ namespace OpenVic {
 			good_index { new_good_index }
 			{}
 
-			constexpr void call_after_trade(BuyResult const& buy_result) const {
-				GoodBuyUpToOrder::call_after_trade(buy_result);
+			constexpr void call_after_trade(BuyResult const& buy_result, CountryReportBuffer& country_report_buffer) const {
+				GoodBuyUpToOrder::call_after_trade(buy_result, country_report_buffer);
 			}
 	};
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 #include "GoodMarket.hpp"
 
 #include <algorithm>
-#include <mutex>
+#include <cstdint>
+#include <limits>
 
+#include <boost/int128/detail/int128_imp.hpp>
+
+#include "openvic-simulation/core/Typedefs.hpp"
 #include "openvic-simulation/economy/GoodDefinition.hpp"
 #include "openvic-simulation/economy/trading/BuyUpToOrder.hpp"
+#include "openvic-simulation/economy/trading/MarketOrderBuffer.hpp"
 #include "openvic-simulation/economy/trading/MarketSellOrder.hpp"
 #include "openvic-simulation/misc/GameRulesManager.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
@@ -58,23 +63,36 @@ void GoodMarket::update_next_price_limits() {
 }
 
 void GoodMarket::add_buy_up_to_order(GoodBuyUpToOrder&& buy_up_to_order) {
-	const std::lock_guard<spin_mutex> lock_guard { buy_lock };
 	buy_up_to_orders.push_back(std::move(buy_up_to_order));
 }
 
 void GoodMarket::add_market_sell_order(GoodMarketSellOrder&& market_sell_order) {
-	const std::lock_guard<spin_mutex> lock_guard { sell_lock };
 	market_sell_orders.push_back(std::move(market_sell_order));
 }
 
+void GoodMarket::take_orders_from(MarketOrderBuffer& order_buffer) {
+	const good_index_t good_index = good_definition.index;
+	order_buffer.set_first_result_indices(good_index, buy_up_to_orders.size(), market_sell_orders.size());
+
+	//orders have const members so they can't be assigned, which vector::insert requires
+	for (GoodBuyUpToOrder const& buy_up_to_order : order_buffer.get_buy_up_to_orders(good_index)) {
+		buy_up_to_orders.push_back(buy_up_to_order);
+	}
+	for (GoodMarketSellOrder const& market_sell_order : order_buffer.get_market_sell_orders(good_index)) {
+		market_sell_orders.push_back(market_sell_order);
+	}
+}
+
 void GoodMarket::execute_orders(
-	TypedSpan<country_index_t, fixed_point_t> reusable_country_map_0,
-	TypedSpan<country_index_t, fixed_point_t> reusable_country_map_1,
 	std::span<
 		memory::vector<fixed_point_t>,
 		VECTORS_FOR_EXECUTE_ORDERS
 	> reusable_vectors
 ) {
+	//results of the previous execution have been applied by now
+	buy_results.clear();
+	sell_results.clear();
+
 	if (!is_available) {
 		//price remains the same
 		price_change_yesterday
@@ -83,14 +101,14 @@ void GoodMarket::execute_orders(
 			= total_supply_yesterday
 			= 0;
 
-		for (GoodBuyUpToOrder const& buy_up_to_order : buy_up_to_orders) {
-			buy_up_to_order.call_after_trade(BuyResult::no_purchase_result(good_definition.index));
+		for (size_t i = 0; i < buy_up_to_orders.size(); i++) {
+			buy_results.push_back(BuyResult::no_purchase_result(good_definition.index));
 		}
 		buy_up_to_orders.clear();
 
-		for (GoodMarketSellOrder const& market_sell_order : market_sell_orders) {
-			market_sell_order.call_after_trade(SellResult::no_sales_result(good_definition.index), reusable_vectors[0]);
-		}		
+		for (size_t i = 0; i < market_sell_orders.size(); i++) {
+			sell_results.push_back(SellResult::no_sales_result(good_definition.index));
+		}
 		market_sell_orders.clear();
 		
 		return;
@@ -111,7 +129,7 @@ void GoodMarket::execute_orders(
 			}
 
 			demand_sum += buy_up_to_order.max_quantity;
-			buy_up_to_order.call_after_trade(BuyResult::no_purchase_result(good_definition.index));
+			buy_results.push_back(BuyResult::no_purchase_result(good_definition.index));
 		}
 
 		if (game_rules_manager.get_use_optimal_pricing()) {
@@ -125,12 +143,10 @@ void GoodMarket::execute_orders(
 			}
 		}
 	} else {
-		TypedSpan<country_index_t, fixed_point_t> supply_per_country = reusable_country_map_0;
-		TypedSpan<country_index_t, fixed_point_t> actual_bought_per_country = reusable_country_map_1;
 		for (GoodMarketSellOrder const& market_sell_order : market_sell_orders) {
 			const std::optional<country_index_t> country_index_optional = market_sell_order.country_index_optional;
 			if (country_index_optional.has_value()) {
-				supply_per_country[country_index_optional.value()] += market_sell_order.quantity;
+				trade_per_country[country_index_optional.value()].supply += market_sell_order.quantity;
 			}
 			supply_sum += market_sell_order.quantity;
 		}
@@ -185,57 +201,31 @@ void GoodMarket::execute_orders(
 				new_price = max_next_price;
 			}
 
-			bool someone_bought_max_quantity;
-			do {
-				someone_bought_max_quantity = false;
-				for (size_t i = 0; i < buy_up_to_orders.size(); i++) {
-					GoodBuyUpToOrder const& buy_up_to_order = buy_up_to_orders[i];
-					const fixed_point_t max_quantity = buy_up_to_order.max_quantity;
-					fixed_point_t& distributed_supply = quantity_bought_per_order[i];
-					if (distributed_supply == max_quantity) {
-						continue;
-					}
-
-					const std::optional<country_index_t> country_index_optional = buy_up_to_order.country_index_optional;
-					if (country_index_optional.has_value()) {
-						//subtract as it might be updated below
-						actual_bought_per_country[country_index_optional.value()] -= distributed_supply;
-					}
-
-					distributed_supply = fp::mul_div(
-						remaining_supply,
-						purchasing_power_per_order[i],
-						purchasing_power_sum
-					);
-
-					if (distributed_supply >= max_quantity) {
-						someone_bought_max_quantity = true;
-						distributed_supply = max_quantity;
-						remaining_supply -= max_quantity;
-						purchasing_power_sum -= purchasing_power_per_order[i];
-					}
-
-					if (country_index_optional.has_value()) {
-						actual_bought_per_country[country_index_optional.value()] += distributed_supply;
-					}
+			distribute_supply_at_max_price(
+				remaining_supply,
+				purchasing_power_sum,
+				purchasing_power_per_order,
+				quantity_bought_per_order
+			);
 
-					if (someone_bought_max_quantity) {
-						break;
-					}
+			for (size_t i = 0; i < buy_up_to_orders.size(); i++) {
+				const std::optional<country_index_t> country_index_optional = buy_up_to_orders[i].country_index_optional;
+				if (country_index_optional.has_value()) {
+					trade_per_country[country_index_optional.value()].actual_bought += quantity_bought_per_order[i];
 				}
-			} while (someone_bought_max_quantity);
+			}
 
-			execute_buy_orders(
-				new_price,
-				actual_bought_per_country,
-				supply_per_country,
-				quantity_bought_per_order
-			);
+			execute_buy_orders(new_price, quantity_bought_per_order);
 		} else {
 			//sell below max_next_price
 			if (game_rules_manager.get_use_optimal_pricing()) {
 				new_price = price;
 
+				//purchasing power is not needed below max_next_price, reuse its vector
+				memory::vector<fixed_point_t>& max_price_for_max_quantity_per_order = purchasing_power_per_order;
+				bool are_buy_up_to_orders_sorted = false;
+				size_t buy_up_to_orders_bought_max_quantity = 0;
+
 				//drop price while remaining_supply > 0 && new_price > min_next_price
 				while (remaining_supply > 0) {
 					const fixed_point_t possible_price = money_left_to_spend_sum / remaining_supply;
@@ -252,17 +242,22 @@ void GoodMarket::execute_orders(
 
 					new_price = possible_price;
 
-					for (size_t i = 0; i < buy_up_to_orders.size(); i++) {
-						GoodBuyUpToOrder const& buy_up_to_order = buy_up_to_orders[i];
-						if (quantity_bought_per_order[i] == buy_up_to_order.max_quantity) {
-							continue;
-						}
+					if (!are_buy_up_to_orders_sorted) {
+						sort_buy_up_to_orders_by_max_price_for_max_quantity(max_price_for_max_quantity_per_order);
+						are_buy_up_to_orders_sorted = true;
+					}
 
-						if (buy_up_to_order.money_to_spend >= new_price * buy_up_to_order.max_quantity) {
-							quantity_bought_per_order[i] = buy_up_to_order.max_quantity;
-							remaining_supply -= buy_up_to_order.max_quantity;
-							money_left_to_spend_sum -= buy_up_to_order.money_to_spend;
+					//new_price only drops, so every buyer that can afford max_quantity at new_price is next in line
+					while (buy_up_to_orders_bought_max_quantity < buy_up_to_order_indices.size()) {
+						const size_t i = buy_up_to_order_indices[buy_up_to_orders_bought_max_quantity];
+						if (max_price_for_max_quantity_per_order[i] < new_price) {
+							break;
 						}
+
+						GoodBuyUpToOrder const& buy_up_to_order = buy_up_to_orders[i];
+						remaining_supply -= buy_up_to_order.max_quantity;
+						money_left_to_spend_sum -= buy_up_to_order.money_to_spend;
+						++buy_up_to_orders_bought_max_quantity;
 					}
 				}
 			} else {
@@ -287,16 +282,11 @@ void GoodMarket::execute_orders(
 
 				const std::optional<country_index_t> country_index_optional = buy_up_to_order.country_index_optional;
 				if (country_index_optional.has_value()) {
-					actual_bought_per_country[country_index_optional.value()] += quantity_bought_per_order[i];
+					trade_per_country[country_index_optional.value()].actual_bought += quantity_bought_per_order[i];
 				}
 			}
 
-			execute_buy_orders(
-				new_price,
-				actual_bought_per_country,
-				supply_per_country,
-				quantity_bought_per_order
-			);
+			execute_buy_orders(new_price, quantity_bought_per_order);
 		}
 
 		for (auto& reusable_vector : reusable_vectors) {
@@ -317,22 +307,18 @@ void GoodMarket::execute_orders(
 						fixed_point_t::epsilon //round up
 					);
 				}
-				market_sell_order.call_after_trade(
-					{
-						good_definition.index,
-						quantity_sold,
-						money_gained
-					},
-					reusable_vectors[0]
-				);
+				sell_results.push_back({
+					good_definition.index,
+					quantity_sold,
+					money_gained
+				});
 			}
 		} else {
 			//quantity is evenly divided after taking domestic buyers into account
 			fixed_point_t total_quantity_traded_domestically = 0;
-			for (country_index_t country_index(0); country_index < actual_bought_per_country.size(); ++country_index) {
-				const fixed_point_t actual_bought = actual_bought_per_country[country_index];
-				const fixed_point_t supply = supply_per_country[country_index];
-				const fixed_point_t traded_domestically = std::min(supply, actual_bought);
+			//countries without orders for this good have no supply and buy nothing
+			for (auto const& [country_index, country_trade] : trade_per_country) {
+				const fixed_point_t traded_domestically = std::min(country_trade.supply, country_trade.actual_bought);
 				total_quantity_traded_domestically += traded_domestically;
 			}
 
@@ -348,9 +334,10 @@ void GoodMarket::execute_orders(
 					quantity_sold_domestically = 0;
 					quantity_offered_as_export = quantity_offered;
 				} else {
-					const country_index_t country_index = country_index_optional.value();
-					const fixed_point_t total_bought_domestically = actual_bought_per_country[country_index];
-					const fixed_point_t total_domestic_supply = supply_per_country[country_index];
+					//sell orders always have an entry
+					country_trade_t const& country_trade = trade_per_country.find(country_index_optional.value())->second;
+					const fixed_point_t total_bought_domestically = country_trade.actual_bought;
+					const fixed_point_t total_domestic_supply = country_trade.supply;
 					quantity_sold_domestically = total_bought_domestically >= total_domestic_supply
 						? quantity_offered
 						: fp::mul_div(
@@ -377,22 +364,16 @@ void GoodMarket::execute_orders(
 						fixed_point_t::epsilon //round up
 					);
 				}
-				market_sell_order.call_after_trade(
-					{
-						good_definition.index,
-						quantity_sold,
-						money_gained
-					},
-					reusable_vectors[0]
-				);
+				sell_results.push_back({
+					good_definition.index,
+					quantity_sold,
+					money_gained
+				});
 			}
 		}
 
-		std::fill(reusable_country_map_0.begin(), reusable_country_map_0.end(), 0);
-		std::fill(reusable_country_map_1.begin(), reusable_country_map_1.end(), 0);
 		market_sell_orders.clear();
-		std::fill(supply_per_country.begin(), supply_per_country.end(), 0);
-		std::fill(actual_bought_per_country.begin(), actual_bought_per_country.end(), 0);
+		trade_per_country.clear();
 	}
 
 	price_change_yesterday = new_price - price;
@@ -405,10 +386,159 @@ void GoodMarket::execute_orders(
 	}
 }
 
+void GoodMarket::distribute_supply_at_max_price(
+	fixed_point_t remaining_supply,
+	fixed_point_t purchasing_power_sum,
+	std::span<const fixed_point_t> purchasing_power_per_order,
+	std::span<fixed_point_t> quantity_bought_per_order
+) {
+	using int128_t = boost::int128::int128_t;
+
+	//Supply is divided proportionally to purchasing power, buyers that would get more than max_quantity are capped
+	//and the rest is divided again.
+	//Capping a buyer whose share reaches max_quantity never lowers remaining_supply / purchasing_power_sum,
+	//so the capped buyers are exactly those with the lowest max_quantity / purchasing_power ratio.
+	//This holds as long as purchasing_power_sum stays positive, otherwise fall back to the iterative version.
+	buy_up_to_order_indices.clear();
+	for (size_t i = 0; i < buy_up_to_orders.size(); i++) {
+		if (purchasing_power_per_order[i] > 0) {
+			buy_up_to_order_indices.push_back(i);
+		}
+	}
+
+	std::sort(
+		buy_up_to_order_indices.begin(),
+		buy_up_to_order_indices.end(),
+		[this, purchasing_power_per_order](const size_t lhs, const size_t rhs) -> bool {
+			//lhs.max_quantity / lhs.purchasing_power < rhs.max_quantity / rhs.purchasing_power
+			const int128_t lhs_cross_product = static_cast<int128_t>(buy_up_to_orders[lhs].max_quantity.get_raw_value())
+				* purchasing_power_per_order[rhs].get_raw_value();
+			const int128_t rhs_cross_product = static_cast<int128_t>(buy_up_to_orders[rhs].max_quantity.get_raw_value())
+				* purchasing_power_per_order[lhs].get_raw_value();
+			if (lhs_cross_product != rhs_cross_product) {
+				return lhs_cross_product < rhs_cross_product;
+			}
+			return lhs < rhs;
+		}
+	);
+
+	const fixed_point_t initial_remaining_supply = remaining_supply;
+	const fixed_point_t initial_purchasing_power_sum = purchasing_power_sum;
+	size_t capped_count = 0;
+	for (const size_t i : buy_up_to_order_indices) {
+		const fixed_point_t max_quantity = buy_up_to_orders[i].max_quantity;
+		const fixed_point_t purchasing_power = purchasing_power_per_order[i];
+
+		//fp::mul_div(remaining_supply, purchasing_power, purchasing_power_sum) >= max_quantity
+		if (
+			static_cast<int128_t>(remaining_supply.get_raw_value()) * purchasing_power.get_raw_value()
+			< static_cast<int128_t>(max_quantity.get_raw_value()) * purchasing_power_sum.get_raw_value()
+		) {
+			break;
+		}
+
+		remaining_supply -= max_quantity;
+		purchasing_power_sum -= purchasing_power;
+		++capped_count;
+
+		if (OV_unlikely(purchasing_power_sum <= 0)) {
+			distribute_supply_at_max_price_iteratively(
+				initial_remaining_supply,
+				initial_purchasing_power_sum,
+				purchasing_power_per_order,
+				quantity_bought_per_order
+			);
+			return;
+		}
+	}
+
+	for (size_t sorted_index = 0; sorted_index < capped_count; ++sorted_index) {
+		const size_t i = buy_up_to_order_indices[sorted_index];
+		quantity_bought_per_order[i] = buy_up_to_orders[i].max_quantity;
+	}
+
+	for (size_t i = 0; i < buy_up_to_orders.size(); i++) {
+		fixed_point_t& distributed_supply = quantity_bought_per_order[i];
+		if (distributed_supply != buy_up_to_orders[i].max_quantity) {
+			distributed_supply = fp::mul_div(
+				remaining_supply,
+				purchasing_power_per_order[i],
+				purchasing_power_sum
+			);
+		}
+	}
+}
+
+void GoodMarket::distribute_supply_at_max_price_iteratively(
+	fixed_point_t remaining_supply,
+	fixed_point_t purchasing_power_sum,
+	std::span<const fixed_point_t> purchasing_power_per_order,
+	std::span<fixed_point_t> quantity_bought_per_order
+) {
+	bool someone_bought_max_quantity;
+	do {
+		someone_bought_max_quantity = false;
+		for (size_t i = 0; i < buy_up_to_orders.size(); i++) {
+			const fixed_point_t max_quantity = buy_up_to_orders[i].max_quantity;
+			fixed_point_t& distributed_supply = quantity_bought_per_order[i];
+			if (distributed_supply == max_quantity) {
+				continue;
+			}
+
+			distributed_supply = fp::mul_div(
+				remaining_supply,
+				purchasing_power_per_order[i],
+				purchasing_power_sum
+			);
+
+			if (distributed_supply >= max_quantity) {
+				someone_bought_max_quantity = true;
+				distributed_supply = max_quantity;
+				remaining_supply -= max_quantity;
+				purchasing_power_sum -= purchasing_power_per_order[i];
+			}
+
+			if (someone_bought_max_quantity) {
+				break;
+			}
+		}
+	} while (someone_bought_max_quantity);
+}
+
+void GoodMarket::sort_buy_up_to_orders_by_max_price_for_max_quantity(
+	std::span<fixed_point_t> max_price_for_max_quantity_per_order
+) {
+	using int128_t = boost::int128::int128_t;
+
+	buy_up_to_order_indices.clear();
+	for (size_t i = 0; i < buy_up_to_orders.size(); i++) {
+		GoodBuyUpToOrder const& buy_up_to_order = buy_up_to_orders[i];
+		//highest price for which money_to_spend >= price * max_quantity still holds with truncating multiplication
+		const int128_t max_price_raw = (
+			(static_cast<int128_t>(buy_up_to_order.money_to_spend.get_raw_value()) + 1) * fixed_point_t::_1.get_raw_value() - 1
+		) / buy_up_to_order.max_quantity.get_raw_value();
+		max_price_for_max_quantity_per_order[i] = fixed_point_t::parse_raw(
+			max_price_raw > std::numeric_limits<int64_t>::max()
+				? std::numeric_limits<int64_t>::max()
+				: static_cast<int64_t>(max_price_raw)
+		);
+		buy_up_to_order_indices.push_back(i);
+	}
+
+	std::sort(
+		buy_up_to_order_indices.begin(),
+		buy_up_to_order_indices.end(),
+		[max_price_for_max_quantity_per_order](const size_t lhs, const size_t rhs) -> bool {
+			if (max_price_for_max_quantity_per_order[lhs] != max_price_for_max_quantity_per_order[rhs]) {
+				return max_price_for_max_quantity_per_order[lhs] > max_price_for_max_quantity_per_order[rhs];
+			}
+			return lhs < rhs;
+		}
+	);
+}
+
 void GoodMarket::execute_buy_orders(
 	const fixed_point_t new_price,
-	TypedSpan<country_index_t, const fixed_point_t> actual_bought_per_country,
-	TypedSpan<country_index_t, const fixed_point_t> supply_per_country,
 	std::span<const fixed_point_t> quantity_bought_per_order
 ) {
 	quantity_traded_yesterday = 0;
@@ -417,7 +547,7 @@ void GoodMarket::execute_buy_orders(
 		const fixed_point_t quantity_bought = quantity_bought_per_order[i];
 
 		if (quantity_bought == 0) {
-			buy_up_to_order.call_after_trade(BuyResult::no_purchase_result(good_definition.index));
+			buy_results.push_back(BuyResult::no_purchase_result(good_definition.index));
 		} else {
 			quantity_traded_yesterday += quantity_bought;
 			const fixed_point_t money_spent_total = std::max(
@@ -431,10 +561,10 @@ void GoodMarket::execute_buy_orders(
 				//could be trade between native Americans and tribal Africa, so it's all imported
 				money_spent_on_imports = money_spent_total;
 			} else {
-				const country_index_t country_index = country_index_optional.value();
-				//must be > 0, since quantity_bought > 0
-				const fixed_point_t actual_bought_in_my_country = actual_bought_per_country[country_index];
-				const fixed_point_t supply_in_my_country = supply_per_country[country_index];
+				//actual_bought must be > 0, since quantity_bought > 0
+				country_trade_t const& country_trade = trade_per_country.find(country_index_optional.value())->second;
+				const fixed_point_t actual_bought_in_my_country = country_trade.actual_bought;
+				const fixed_point_t supply_in_my_country = country_trade.supply;
 
 				if (supply_in_my_country >= actual_bought_in_my_country) {
 					//no imports
@@ -449,7 +579,7 @@ void GoodMarket::execute_buy_orders(
 					money_spent_on_imports = money_spent_total - money_spent_domestically;
 				}
 			}
-			buy_up_to_order.call_after_trade({
+			buy_results.push_back({
 				good_definition.index,
 				quantity_bought,
 				money_spent_total,
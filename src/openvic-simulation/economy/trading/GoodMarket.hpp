@@ -3,11 +3,12 @@
 #include <span>
 
 #include "openvic-simulation/core/memory/Vector.hpp"
-#include "openvic-simulation/core/stl/containers/TypedSpan.hpp"
-#include "openvic-simulation/core/thread/SpinMutex.hpp"
+#include "openvic-simulation/economy/trading/BuyResult.hpp"
 #include "openvic-simulation/economy/trading/BuyUpToOrder.hpp"
 #include "openvic-simulation/economy/trading/MarketSellOrder.hpp"
+#include "openvic-simulation/economy/trading/SellResult.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/types/OrderedContainers.hpp"
 #include "openvic-simulation/types/TypedIndices.hpp"
 #include "openvic-simulation/types/ValueHistory.hpp"
 #include "openvic-simulation/utility/Getters.hpp"
@@ -15,12 +16,13 @@
 namespace OpenVic {
 	struct GameRulesManager;
 	struct GoodDefinition;
+	struct MarketOrderBuffer;
 
 	struct GoodMarket {
+		friend struct InstanceSave;
+
 	private:
 		static constexpr int32_t exponential_price_change_shift = 7;
-		spin_mutex buy_lock;
-		spin_mutex sell_lock;
 		GameRulesManager const& game_rules_manager;
 		fixed_point_t absolute_maximum_price;
 		fixed_point_t absolute_minimum_price;
@@ -28,11 +30,35 @@ namespace OpenVic {
 		//only used during day tick (from actors placing order until execute_orders())
 		memory::vector<GoodBuyUpToOrder> buy_up_to_orders;
 		memory::vector<GoodMarketSellOrder> market_sell_orders;
+		struct country_trade_t {
+			fixed_point_t supply;
+			fixed_point_t actual_bought;
+		};
+
+		//only used during execute_orders()
+		memory::vector<size_t> buy_up_to_order_indices;
+		//only countries with orders for this good, so clearing scales with the orders rather than the country count
+		ordered_map<country_index_t, country_trade_t> trade_per_country;
+
+		void distribute_supply_at_max_price(
+			fixed_point_t remaining_supply,
+			fixed_point_t purchasing_power_sum,
+			std::span<const fixed_point_t> purchasing_power_per_order,
+			std::span<fixed_point_t> quantity_bought_per_order
+		);
+		void distribute_supply_at_max_price_iteratively(
+			fixed_point_t remaining_supply,
+			fixed_point_t purchasing_power_sum,
+			std::span<const fixed_point_t> purchasing_power_per_order,
+			std::span<fixed_point_t> quantity_bought_per_order
+		);
+		//fills buy_up_to_order_indices from highest to lowest max price
+		void sort_buy_up_to_orders_by_max_price_for_max_quantity(
+			std::span<fixed_point_t> max_price_for_max_quantity_per_order
+		);
 
 		void execute_buy_orders(
 			const fixed_point_t new_price,
-			TypedSpan<country_index_t, const fixed_point_t> actual_bought_per_country,
-			TypedSpan<country_index_t, const fixed_point_t> supply_per_country,
 			std::span<const fixed_point_t> quantity_bought_per_order
 		);
 
@@ -49,6 +75,9 @@ namespace OpenVic {
 		fixed_point_t PROPERTY(total_supply_yesterday);
 		fixed_point_t PROPERTY(quantity_traded_yesterday);
 		ValueHistory<fixed_point_t> PROPERTY(price_history);
+		//one per order in the order they were taken, valid from execute_orders() until the next execute_orders()
+		memory::vector<BuyResult> SPAN_PROPERTY(buy_results);
+		memory::vector<SellResult> SPAN_PROPERTY(sell_results);
 
 		void update_next_price_limits();
 	public:
@@ -60,15 +89,14 @@ namespace OpenVic {
 		GoodMarket(GoodMarket&&) = delete;
 		GoodMarket& operator=(GoodMarket&&) = delete;
 
-		//thread safe
+		//not thread safe
 		void add_buy_up_to_order(GoodBuyUpToOrder&& buy_up_to_order);
 		void add_market_sell_order(GoodMarketSellOrder&& market_sell_order);
+		//appends the orders for this good, call for each buffer in canonical (WorkBundle) order
+		void take_orders_from(MarketOrderBuffer& order_buffer);
 
-		//not thread safe
 		static constexpr size_t VECTORS_FOR_EXECUTE_ORDERS = 2;
 		void execute_orders(
-			TypedSpan<country_index_t, fixed_point_t> reusable_country_map_0,
-			TypedSpan<country_index_t, fixed_point_t> reusable_country_map_1,
 			std::span<
 				memory::vector<fixed_point_t>,
 				VECTORS_FOR_EXECUTE_ORDERS
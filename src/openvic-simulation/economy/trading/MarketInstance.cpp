@@ -4,6 +4,7 @@
 #include "openvic-simulation/economy/GoodDefinition.hpp"
 #include "openvic-simulation/economy/GoodInstance.hpp"
 #include "openvic-simulation/economy/trading/BuyUpToOrder.hpp"
+#include "openvic-simulation/economy/trading/MarketOrderBuffer.hpp"
 #include "openvic-simulation/economy/trading/MarketSellOrder.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
 #include "openvic-simulation/utility/ThreadPool.hpp"
@@ -33,22 +34,30 @@ GoodInstance const& MarketInstance::get_good_instance(const good_index_t good_in
 	return *good_instance_manager.get_good_instance_by_index(good_index);
 }
 
-void MarketInstance::place_buy_up_to_order(BuyUpToOrder&& buy_up_to_order) {
+void MarketInstance::place_buy_up_to_order(
+	BuyUpToOrder&& buy_up_to_order,
+	MarketOrderBuffer& order_buffer,
+	CountryReportBuffer& country_report_buffer
+) {
 	const good_index_t good_index = buy_up_to_order.good_index;
 	if (OV_unlikely(buy_up_to_order.max_quantity <= 0)) {
 		spdlog::error_s(
 			"Received BuyUpToOrder for {} with max quantity {}",
 			good_index, buy_up_to_order.max_quantity
 		);
-		buy_up_to_order.call_after_trade(BuyResult::no_purchase_result(good_index));
+		buy_up_to_order.call_after_trade(BuyResult::no_purchase_result(good_index), country_report_buffer);
 		return;
 	}
 
-	GoodMarket& good_instance = *good_instance_manager.get_good_instance_by_index(good_index);
-	good_instance.add_buy_up_to_order(std::move(buy_up_to_order));
+	order_buffer.add_buy_up_to_order(good_index, std::move(buy_up_to_order));
 }
 
-void MarketInstance::place_market_sell_order(MarketSellOrder&& market_sell_order, memory::vector<fixed_point_t>& reusable_vector) {
+void MarketInstance::place_market_sell_order(
+	MarketSellOrder&& market_sell_order,
+	MarketOrderBuffer& order_buffer,
+	CountryReportBuffer& country_report_buffer,
+	memory::vector<fixed_point_t>& reusable_vector
+) {
 	const good_index_t good_index = market_sell_order.good_index;
 	const fixed_point_t quantity = market_sell_order.quantity;
 
@@ -57,7 +66,7 @@ void MarketInstance::place_market_sell_order(MarketSellOrder&& market_sell_order
 			"Received MarketSellOrder for {} with quantity {}",
 			good_index, quantity
 		);
-		market_sell_order.call_after_trade(SellResult::no_sales_result(good_index), reusable_vector);
+		market_sell_order.call_after_trade(SellResult::no_sales_result(good_index), country_report_buffer, reusable_vector);
 		return;
 	}
 
@@ -69,12 +78,13 @@ void MarketInstance::place_market_sell_order(MarketSellOrder&& market_sell_order
 				quantity,
 				quantity * country_defines.get_gold_to_worker_pay_rate() * good_instance.good_definition.base_price
 			},
+			country_report_buffer,
 			reusable_vector
 		);
 		return;
 	}
 
-	good_instance.add_market_sell_order(std::move(market_sell_order));
+	order_buffer.add_market_sell_order(good_index, std::move(market_sell_order));
 }
 
 void MarketInstance::execute_orders() {
@@ -7,8 +7,10 @@
 namespace OpenVic {
 	struct BuyUpToOrder;
 	struct CountryDefines;
+	struct CountryReportBuffer;
 	struct GoodInstance;
 	struct GoodInstanceManager;
+	struct MarketOrderBuffer;
 	struct MarketSellOrder;
 	struct ThreadPool;
 
@@ -31,8 +33,19 @@ namespace OpenVic {
 		fixed_point_t get_min_next_price(const good_index_t good_index) const;
 		fixed_point_t get_max_money_to_allocate_to_buy_quantity(const good_index_t good_index, const fixed_point_t quantity) const;
 		GoodInstance const& get_good_instance(const good_index_t good_index) const;
-		void place_buy_up_to_order(BuyUpToOrder&& buy_up_to_order);
-		void place_market_sell_order(MarketSellOrder&& market_sell_order, memory::vector<fixed_point_t>& reusable_vector);
+		//Orders are buffered in the MarketOrderBuffer of the WorkBundle placing them.
+		//Orders which are settled right away report to that WorkBundle's CountryReportBuffer.
+		void place_buy_up_to_order(
+			BuyUpToOrder&& buy_up_to_order,
+			MarketOrderBuffer& order_buffer,
+			CountryReportBuffer& country_report_buffer
+		);
+		void place_market_sell_order(
+			MarketSellOrder&& market_sell_order,
+			MarketOrderBuffer& order_buffer,
+			CountryReportBuffer& country_report_buffer,
+			memory::vector<fixed_point_t>& reusable_vector
+		);
 		void execute_orders();
 		void record_price_history();
 	};
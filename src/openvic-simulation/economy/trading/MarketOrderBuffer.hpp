@@ -0,0 +1,107 @@
+#pragma once
+
+#include <span>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/economy/trading/BuyUpToOrder.hpp"
+#include "openvic-simulation/economy/trading/GoodMarket.hpp"
+#include "openvic-simulation/economy/trading/MarketSellOrder.hpp"
+#include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
+
+namespace OpenVic {
+	struct CountryReportBuffer;
+
+	//Orders placed by a single WorkBundle during a tick, split per good.
+	//Only the thread processing the owning WorkBundle writes to it, so no locking is required.
+	//GoodMarket merges the buffers of all bundles in bundle order, which makes the order book independent of thread count.
+	//After clearing, the owning WorkBundle applies the results to the actors in the order the orders were placed.
+	struct MarketOrderBuffer {
+	private:
+		struct good_orders_t {
+			memory::vector<GoodBuyUpToOrder> buy_up_to_orders;
+			memory::vector<GoodMarketSellOrder> market_sell_orders;
+			//position of this buffer's orders in the GoodMarket, set when the GoodMarket takes them
+			size_t first_buy_result_index = 0;
+			size_t first_sell_result_index = 0;
+			//only used during apply_results()
+			size_t applied_buy_up_to_order_count = 0;
+			size_t applied_market_sell_order_count = 0;
+		};
+
+		struct placed_order_t {
+			good_index_t good_index;
+			bool is_buy_up_to_order;
+		};
+
+		memory::vector<good_orders_t> orders_per_good;
+		memory::vector<placed_order_t> orders_in_placement_order;
+
+	public:
+		void set_good_count(const good_index_t good_count) {
+			orders_per_good.resize(type_safe::get(good_count));
+		}
+
+		void add_buy_up_to_order(const good_index_t good_index, GoodBuyUpToOrder&& buy_up_to_order) {
+			orders_per_good[type_safe::get(good_index)].buy_up_to_orders.push_back(std::move(buy_up_to_order));
+			orders_in_placement_order.push_back({ good_index, true });
+		}
+		void add_market_sell_order(const good_index_t good_index, GoodMarketSellOrder&& market_sell_order) {
+			orders_per_good[type_safe::get(good_index)].market_sell_orders.push_back(std::move(market_sell_order));
+			orders_in_placement_order.push_back({ good_index, false });
+		}
+
+		std::span<const GoodBuyUpToOrder> get_buy_up_to_orders(const good_index_t good_index) const {
+			return orders_per_good[type_safe::get(good_index)].buy_up_to_orders;
+		}
+		std::span<const GoodMarketSellOrder> get_market_sell_orders(const good_index_t good_index) const {
+			return orders_per_good[type_safe::get(good_index)].market_sell_orders;
+		}
+
+		void set_first_result_indices(
+			const good_index_t good_index,
+			const size_t first_buy_result_index,
+			const size_t first_sell_result_index
+		) {
+			good_orders_t& good_orders = orders_per_good[type_safe::get(good_index)];
+			good_orders.first_buy_result_index = first_buy_result_index;
+			good_orders.first_sell_result_index = first_sell_result_index;
+		}
+
+		//Calls after_trade for every order in placement order, so each actor's results are handled together.
+		//Call once all goods have executed their orders, then the buffer is empty again.
+		template<typename GoodMarketLookup>
+		void apply_results(
+			GoodMarketLookup&& get_good_market,
+			CountryReportBuffer& country_report_buffer,
+			memory::vector<fixed_point_t>& reusable_vector
+		) {
+			for (placed_order_t const& placed_order : orders_in_placement_order) {
+				good_orders_t& good_orders = orders_per_good[type_safe::get(placed_order.good_index)];
+				GoodMarket const& good_market = get_good_market(placed_order.good_index);
+
+				if (placed_order.is_buy_up_to_order) {
+					const size_t i = good_orders.applied_buy_up_to_order_count++;
+					good_orders.buy_up_to_orders[i].call_after_trade(
+						good_market.get_buy_results()[good_orders.first_buy_result_index + i],
+						country_report_buffer
+					);
+				} else {
+					const size_t i = good_orders.applied_market_sell_order_count++;
+					good_orders.market_sell_orders[i].call_after_trade(
+						good_market.get_sell_results()[good_orders.first_sell_result_index + i],
+						country_report_buffer,
+						reusable_vector
+					);
+				}
+			}
+
+			orders_in_placement_order.clear();
+			for (good_orders_t& good_orders : orders_per_good) {
+				good_orders.buy_up_to_orders.clear();
+				good_orders.market_sell_orders.clear();
+				good_orders.applied_buy_up_to_order_count = good_orders.applied_market_sell_order_count = 0;
+			}
+		}
+	};
+}
@@ -7,9 +7,11 @@
 #include "openvic-simulation/types/TypedIndices.hpp"
 
 namespace OpenVic {
+	struct CountryReportBuffer;
+
 	struct GoodMarketSellOrder {
 		using actor_t = void*;
-		using callback_t = void (*)(actor_t, SellResult const&, memory::vector<fixed_point_t>&);
+		using callback_t = void (*)(actor_t, SellResult const&, CountryReportBuffer&, memory::vector<fixed_point_t>&);
 
 	private:
 		const actor_t actor;
@@ -30,8 +32,12 @@ namespace OpenVic {
 			after_trade { new_after_trade }
 			{}
 
-		constexpr void call_after_trade(SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector) const {
-			after_trade(actor, sell_result, reusable_vector);
+		constexpr void call_after_trade(
+			SellResult const& sell_result,
+			CountryReportBuffer& country_report_buffer,
+			memory::vector<fixed_point_t>& reusable_vector
+		) const {
+			after_trade(actor, sell_result, country_report_buffer, reusable_vector);
 		}
 	};
 
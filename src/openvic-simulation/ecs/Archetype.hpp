@@ -254,10 +254,43 @@ namespace OpenVic::ecs {
 					::operator new(CHUNK_BLOCK_BYTES, std::align_val_t { CHUNK_BLOCK_ALIGN })
 				);
 			}
+			fresh.changed_ticks.assign(signature.size(), 0);
 			chunks.push_back(std::move(fresh));
 			return chunks.size() - 1;
 		}
 
+		// === Change ticks (see DataChunk and QueryFilter.hpp Changed<C> / Added<C>) ===
+		// Every stamp is a max, so a stamp never moves backwards whatever order writers
+		// report in.
+
+		// Column `col` of the chunk may have been written at `tick`.
+		void stamp_column_written(std::size_t chunk_index, std::size_t col, uint64_t tick) {
+			uint64_t& stamp = chunks[chunk_index].changed_ticks[col];
+			stamp = std::max(stamp, tick);
+		}
+
+		// Rows entered the chunk at `tick`: every column holds new values.
+		void stamp_rows_entered(std::size_t chunk_index, uint64_t tick) {
+			DataChunk& chunk = chunks[chunk_index];
+			for (uint64_t& stamp : chunk.changed_ticks) {
+				stamp = std::max(stamp, tick);
+			}
+			chunk.added_tick = std::max(chunk.added_tick, tick);
+			chunk.rows_tick = std::max(chunk.rows_tick, tick);
+		}
+
+		// A swap-pop moved a row from `src_chunk` into `dst_chunk` at `tick`. The row's slot
+		// now holds different values, and the row keeps its source chunk's added stamp so an
+		// Added<C> system that has not yet seen it still finds it after the move.
+		void stamp_row_relocated(std::size_t dst_chunk, std::size_t src_chunk, uint64_t tick) {
+			DataChunk& dst = chunks[dst_chunk];
+			for (uint64_t& stamp : dst.changed_ticks) {
+				stamp = std::max(stamp, tick);
+			}
+			dst.added_tick = std::max(dst.added_tick, chunks[src_chunk].added_tick);
+			dst.rows_tick = std::max(dst.rows_tick, tick);
+		}
+
 		// Drops the trailing chunk if it's empty, returning its block to the pool (or to
 		// ::operator delete if no pool is wired). No-op if there are no chunks or the
 		// trailing chunk still holds rows. No retain-one rule — a fully-drained archetype
@@ -304,12 +337,12 @@ namespace OpenVic::ecs {
 		// allocates a new one), bumps that chunk's `count`, and returns (chunk_index, row).
 		// Caller must placement-new component values into each non-tag column at this slot
 		// AFTER calling reserve_row, then push the EntityID via `entity_array(chunk_index)[row] = eid`.
-		// Bumps every column_version.
+		// Bumps every column_version and stamps the chunk's change ticks with `tick`.
 		struct RowLocation {
 			std::size_t chunk_index;
 			std::size_t row;
 		};
-		RowLocation reserve_row() {
+		RowLocation reserve_row(uint64_t tick) {
 			std::size_t chunk_index;
 			if (chunks.empty() || chunks.back().count >= chunk_capacity) {
 				chunk_index = allocate_chunk();
@@ -322,6 +355,7 @@ namespace OpenVic::ecs {
 			for (uint64_t& v : column_versions) {
 				++v;
 			}
+			stamp_rows_entered(chunk_index, tick);
 			return { chunk_index, row };
 		}
 
@@ -343,9 +377,10 @@ namespace OpenVic::ecs {
 		//
 		// Each column_version is bumped once per TOUCHED CHUNK, not once per row as the
 		// reserve_row loop would — versions only signal "this column changed" (CachedRef
-		// revalidation); nothing compares their numeric values across runs.
+		// revalidation); nothing compares their numeric values across runs. Every touched
+		// chunk's change ticks are stamped with `tick`.
 		// No-op when n == 0.
-		void reserve_rows(std::size_t n, std::vector<RowRange>& out) {
+		void reserve_rows(std::size_t n, std::vector<RowRange>& out, uint64_t tick) {
 			out.clear();
 			if (n == 0) {
 				return;
@@ -361,6 +396,7 @@ namespace OpenVic::ecs {
 				std::size_t const row_begin = chunks[chunk_index].count;
 				std::size_t const take = std::min(remaining, chunk_capacity - row_begin);
 				chunks[chunk_index].count += take;
+				stamp_rows_entered(chunk_index, tick);
 				out.push_back({ chunk_index, row_begin, take });
 				remaining -= take;
 			}
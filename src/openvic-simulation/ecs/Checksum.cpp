@@ -8,19 +8,70 @@
 
 #include "openvic-simulation/ecs/Archetype.hpp"
 #include "openvic-simulation/ecs/ChecksumTraits.hpp"
+#include "openvic-simulation/ecs/Chunk.hpp"
 #include "openvic-simulation/ecs/ComponentTypeID.hpp"
 #include "openvic-simulation/ecs/EntityID.hpp"
 #include "openvic-simulation/ecs/World.hpp"
 
 namespace OpenVic::ecs {
 
-	// The one friend of World for checksum purposes (declared in World.hpp). Read-only:
-	// walks `archetypes` and `singletons` directly, never the query cache.
+	// The one friend of World for checksum purposes (declared in World.hpp). Read-only apart
+	// from the cached entry points advancing the change tick: walks `archetypes` and
+	// `singletons` directly, never the query cache.
 	struct WorldChecksumAccess {
-		// Single walk shared by world_checksum (out == nullptr) and
-		// world_checksum_breakdown (entries filled).
-		static uint64_t walk(World const& world, WorldChecksumBreakdown* out) {
+		// Sub-hash of chunk `ci`'s EntityIDs, row-ascending.
+		static uint64_t hash_chunk_ids(Archetype const& arch, std::size_t ci) {
+			uint64_t h = CHECKSUM_SEED;
+			EntityID const* eids = arch.entity_array(ci);
+			for (std::size_t row = 0; row < arch.chunks[ci].count; ++row) {
+				h = fold_uint64(eids[row].to_uint64(), h);
+			}
+			return h;
+		}
+
+		// Sub-hash of data column `col` of chunk `ci`.
+		static uint64_t hash_chunk_column(Archetype const& arch, std::size_t ci, std::size_t col) {
+			return arch.vtables[col]->hash_rows(arch.column_array(ci, col), arch.chunks[ci].count, CHECKSUM_SEED);
+		}
+
+		// Brings `entry` up to date with chunk `ci`: a sub-hash is recomputed when the entry
+		// was never filled, the row count moved, or the chunk was stamped at or after the
+		// tick the entry was computed at. Returns the number of sub-hashes recomputed.
+		static std::size_t refresh_chunk(
+			Archetype const& arch, std::size_t ci, WorldChecksumCache::ChunkEntry& entry, uint64_t computed_at
+		) {
+			DataChunk const& chunk = arch.chunks[ci];
+			bool const stale = entry.computed_at == 0 || entry.count != chunk.count;
+			std::size_t rehashed = 0;
+			if (stale || chunk.rows_tick >= entry.computed_at) {
+				entry.ids_hash = hash_chunk_ids(arch, ci);
+				++rehashed;
+			}
+			entry.column_hashes.resize(arch.signature.size());
+			for (std::size_t col = 0; col < arch.signature.size(); ++col) {
+				if (arch.vtables[col]->hash_rows == nullptr) {
+					continue;
+				}
+				if (stale || chunk.changed_ticks[col] >= entry.computed_at) {
+					entry.column_hashes[col] = hash_chunk_column(arch, ci, col);
+					++rehashed;
+				}
+			}
+			entry.count = chunk.count;
+			entry.computed_at = computed_at;
+			return rehashed;
+		}
+
+		// Single walk shared by every entry point: `out` (breakdown) may be null; `cache`
+		// is null for the uncached walk, else refreshed and read as of `computed_at`.
+		static uint64_t walk(
+			World const& world, WorldChecksumBreakdown* out, WorldChecksumCache* cache, uint64_t computed_at
+		) {
 			uint64_t total = CHECKSUM_SEED;
+			if (cache != nullptr) {
+				cache->archetypes_.resize(world.archetypes.size());
+				cache->rehashed_last_call_ = 0;
+			}
 
 			// --- entity state: archetypes by index, chunks ascending, rows ascending ---
 			for (std::size_t archetype_index = 0; archetype_index < world.archetypes.size(); ++archetype_index) {
@@ -34,17 +85,28 @@ namespace OpenVic::ecs {
 				for (component_type_id_t id : arch.signature) {
 					h = fold_uint64(id, h);
 				}
-				for (std::size_t ci = 0; ci < arch.chunks.size(); ++ci) {
-					std::size_t const count = arch.chunks[ci].count;
-					EntityID const* eids = arch.entity_array(ci);
-					for (std::size_t row = 0; row < count; ++row) {
-						h = fold_uint64(eids[row].to_uint64(), h);
+				if (cache != nullptr) {
+					std::vector<WorldChecksumCache::ChunkEntry>& entries = cache->archetypes_[archetype_index];
+					entries.resize(arch.chunks.size());
+					for (std::size_t ci = 0; ci < arch.chunks.size(); ++ci) {
+						WorldChecksumCache::ChunkEntry& entry = entries[ci];
+						cache->rehashed_last_call_ += refresh_chunk(arch, ci, entry, computed_at);
+						h = fold_uint64(entry.ids_hash, h);
+						for (std::size_t col = 0; col < arch.signature.size(); ++col) {
+							if (arch.vtables[col]->hash_rows != nullptr) {
+								h = fold_uint64(entry.column_hashes[col], h);
+							}
+						}
 					}
-					for (std::size_t col = 0; col < arch.signature.size(); ++col) {
-						if (arch.vtables[col]->hash_rows == nullptr) {
-							continue; // tag column — presence already folded via the signature
+				} else {
+					for (std::size_t ci = 0; ci < arch.chunks.size(); ++ci) {
+						h = fold_uint64(hash_chunk_ids(arch, ci), h);
+						for (std::size_t col = 0; col < arch.signature.size(); ++col) {
+							if (arch.vtables[col]->hash_rows == nullptr) {
+								continue; // tag column — presence already folded via the signature
+							}
+							h = fold_uint64(hash_chunk_column(arch, ci, col), h);
 						}
-						h = arch.vtables[col]->hash_rows(arch.column_array(ci, col), count, h);
 					}
 				}
 				total = fold_uint64(h, total);
@@ -82,15 +144,38 @@ namespace OpenVic::ecs {
 			}
 			return total;
 		}
+
+		// Every stamp so far is below the returned tick and every later one at or above it,
+		// which is exactly the split refresh_chunk keys on.
+		static uint64_t begin_cached_walk(World& world) {
+			return world.advance_change_tick_();
+		}
 	};
 
 	uint64_t world_checksum(World const& world) {
-		return WorldChecksumAccess::walk(world, nullptr);
+		return WorldChecksumAccess::walk(world, nullptr, nullptr, 0);
 	}
 
 	WorldChecksumBreakdown world_checksum_breakdown(World const& world) {
 		WorldChecksumBreakdown breakdown;
-		WorldChecksumAccess::walk(world, &breakdown);
+		WorldChecksumAccess::walk(world, &breakdown, nullptr, 0);
+		return breakdown;
+	}
+
+	void WorldChecksumCache::clear() {
+		archetypes_.clear();
+		rehashed_last_call_ = 0;
+	}
+
+	uint64_t world_checksum(World& world, WorldChecksumCache& cache) {
+		uint64_t const computed_at = WorldChecksumAccess::begin_cached_walk(world);
+		return WorldChecksumAccess::walk(world, nullptr, &cache, computed_at);
+	}
+
+	WorldChecksumBreakdown world_checksum_breakdown(World& world, WorldChecksumCache& cache) {
+		uint64_t const computed_at = WorldChecksumAccess::begin_cached_walk(world);
+		WorldChecksumBreakdown breakdown;
+		WorldChecksumAccess::walk(world, &breakdown, &cache, computed_at);
 		return breakdown;
 	}
 
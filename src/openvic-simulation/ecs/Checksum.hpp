@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -22,8 +23,10 @@ namespace OpenVic::ecs {
 	//   - archetypes by index (archetypes with no live entities are SKIPPED, so the digest
 	//     is insensitive to dead archetype-creation history a loader would not replay);
 	//   - per archetype: sorted signature first (tags contribute here, presence only), then
-	//     chunks ascending — per chunk the EntityID (index, generation) pairs row-ascending,
-	//     then component data column by column via ColumnVTable::hash_rows;
+	//     chunks ascending — per chunk the sub-hash of its EntityID (index, generation) pairs
+	//     row-ascending, then the sub-hash of each data column via ColumnVTable::hash_rows.
+	//     Every sub-hash starts from CHECKSUM_SEED and is folded into the archetype hash as
+	//     one value, so a sub-hash can be cached and refolded (see WorldChecksumCache);
 	//   - after all entity state: singletons in ascending component-id order, regardless of
 	//     set_singleton call order.
 	//
@@ -42,7 +45,7 @@ namespace OpenVic::ecs {
 		uint32_t archetype_index = 0;
 		// Sorted component ids — copied so breakdown dumps are self-describing.
 		std::vector<component_type_id_t> signature;
-		// Self-contained: folded from CHECKSUM_SEED over the signature, then the rows.
+		// Self-contained: folded from CHECKSUM_SEED over the signature, then each chunk's sub-hashes.
 		uint64_t hash = 0;
 	};
 
@@ -70,4 +73,56 @@ namespace OpenVic::ecs {
 	// Recomputes the total from the entries alone (fold entry hashes in stored order,
 	// archetypes then singletons, starting from CHECKSUM_SEED).
 	uint64_t fold_checksum_breakdown(WorldChecksumBreakdown const& breakdown);
+
+	// === Cached checksum ===
+	// Per-tick desync detection can't afford rehashing every row each tick. A
+	// WorldChecksumCache remembers the sub-hash of every (archetype, chunk, column) — and of
+	// every chunk's EntityIDs — together with the World change tick it was computed at. A
+	// cached call rehashes only sub-hashes whose chunk was stamped since (DataChunk change
+	// ticks: a system holding the column mutably, extra_writes, mutable access outside a
+	// tick, rows entering or being swapped in) or whose row count moved, then refolds the
+	// rest. Hashing cost is O(changed chunks); the fold itself is O(chunks). Singletons are
+	// always rehashed — there are few of them and they carry no change ticks.
+	//
+	// The result is bit-identical to the uncached walk: total and breakdown equal
+	// world_checksum / world_checksum_breakdown, provided every write went through a path
+	// that stamps. Writes through a pointer held across the cached call — a CachedRef, or a
+	// get_component result fetched before it — are not seen; fetch again after a checksum.
+	// The uncached walk stays the reference to cross-check against when in doubt.
+	//
+	// Takes World& because it advances the change tick (so writes after the call are newer
+	// than every cached sub-hash); World state is otherwise untouched. Main thread, between
+	// tick_systems calls only. A cache serves one World for its whole life.
+	class WorldChecksumCache {
+	public:
+		// Forget every sub-hash; the next cached call rehashes everything.
+		void clear();
+
+		// Sub-hashes (EntityID arrays and data columns) the last cached call recomputed.
+		std::size_t rehashed_last_call() const {
+			return rehashed_last_call_;
+		}
+
+	private:
+		friend struct WorldChecksumAccess;
+
+		struct ChunkEntry {
+			// Change tick of the call that last refreshed this entry; 0 = never computed.
+			uint64_t computed_at = 0;
+			std::size_t count = 0;
+			uint64_t ids_hash = 0;
+			std::vector<uint64_t> column_hashes; // per archetype column; tag columns unused
+		};
+
+		std::vector<std::vector<ChunkEntry>> archetypes_; // by archetype index, then chunk
+		std::size_t rehashed_last_call_ = 0;
+	};
+
+	// The checksum, rehashing only what changed since `cache` last saw `world`.
+	// Invariant: equals world_checksum(world).
+	uint64_t world_checksum(World& world, WorldChecksumCache& cache);
+
+	// Cached walk with the per-part breakdown filled in.
+	// Invariant: equals world_checksum_breakdown(world), entry for entry.
+	WorldChecksumBreakdown world_checksum_breakdown(World& world, WorldChecksumCache& cache);
 }
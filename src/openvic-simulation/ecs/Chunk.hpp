@@ -3,6 +3,8 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace OpenVic::ecs {
 
@@ -56,18 +58,37 @@ namespace OpenVic::ecs {
 	// `count` is rows-currently-in-this-chunk; `chunk_capacity` is rows-per-chunk for the
 	// owning archetype (constant for the chunk's lifetime). Tag (zero-size) columns get a
 	// sentinel offset (size_t(-1)) and contribute no slab — they are tracked at the
-	// archetype level only via `column_versions`.
+	// archetype level via `column_versions` and per chunk via the change ticks below.
+	//
+	// Change ticks (World change-tick values, see World::change_tick) feed the Changed<C> /
+	// Added<C> system filters in QueryFilter.hpp. `changed_ticks[col]` is the latest tick at
+	// which column `col` of this chunk may have been written — by a system holding the
+	// column mutably, a mutable access outside a tick, or a row entering the chunk.
+	// `added_tick` is the latest tick at which a row entered the chunk (creation or
+	// migration). `rows_tick` is the latest tick at which the chunk's EntityID array changed
+	// (a row entered or was swapped in); rows leaving from the tail show only in `count`.
+	// All three only ever grow; a chunk whose ticks are <= a system's last run holds
+	// nothing that system has not already seen. The cached checksum (Checksum.hpp) keys its
+	// per-chunk sub-hashes on the same ticks.
 	struct DataChunk {
 		unsigned char* data = nullptr;
 		std::size_t count = 0;
+		std::vector<uint64_t> changed_ticks; // one per archetype column
+		uint64_t added_tick = 0;
+		uint64_t rows_tick = 0;
 
 		DataChunk() = default;
 		DataChunk(DataChunk const&) = delete;
 		DataChunk& operator=(DataChunk const&) = delete;
 
-		DataChunk(DataChunk&& other) noexcept : data { other.data }, count { other.count } {
+		DataChunk(DataChunk&& other) noexcept
+			: data { other.data }, count { other.count },
+			  changed_ticks { std::move(other.changed_ticks) }, added_tick { other.added_tick },
+			  rows_tick { other.rows_tick } {
 			other.data = nullptr;
 			other.count = 0;
+			other.added_tick = 0;
+			other.rows_tick = 0;
 		}
 		DataChunk& operator=(DataChunk&& other) noexcept {
 			if (this != &other) {
@@ -76,8 +97,13 @@ namespace OpenVic::ecs {
 				assert(data == nullptr && "DataChunk move-assign over live block");
 				data = other.data;
 				count = other.count;
+				changed_ticks = std::move(other.changed_ticks);
+				added_tick = other.added_tick;
+				rows_tick = other.rows_tick;
 				other.data = nullptr;
 				other.count = 0;
+				other.added_tick = 0;
+				other.rows_tick = 0;
 			}
 			return *this;
 		}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <vector>
 
 #include "openvic-simulation/ecs/ChunkView.hpp"
@@ -40,12 +41,15 @@ namespace OpenVic::ecs {
 
 		// Sorted-unique component ids defining the iteration query. ChunkSystem doesn't
 		// derive from System<>, so it needs its own version — but the result is the same
-		// shape: just Cs... folded through component_type_id_of, sorted, deduped.
-		// Consumed by the scheduler's query-cache prewarm for multi-system stages.
+		// shape: Cs... plus the Changed<C> / Added<C> filter ids, folded through
+		// component_type_id_of, sorted, deduped. Consumed by the scheduler's query-cache
+		// prewarm for multi-system stages.
 		static std::vector<component_type_id_t> compute_tick_query_require_ids() {
 			std::vector<component_type_id_t> ids = {
 				component_type_id_of<std::remove_cvref_t<Cs>>()...
 			};
+			std::vector<component_type_id_t> const filtered = system_filters_t<Derived>::require_ids();
+			ids.insert(ids.end(), filtered.begin(), filtered.end());
 			std::sort(ids.begin(), ids.end());
 			ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
 			return ids;
@@ -60,10 +64,13 @@ namespace OpenVic::ecs {
 
 		void tick_all(World& world, TickContext const& ctx) {
 			Derived& self = static_cast<Derived&>(*this);
-			Query const q = detail::build_tick_query<Derived>();
-			world.template for_each_chunk<std::remove_cvref_t<Cs>...>(q,
-				[&](ChunkView<std::remove_cvref_t<Cs>...> view) {
-					self.tick_chunk(view, ctx);
+			detail::for_each_dispatch_chunk<Derived>(world, ctx.last_run_tick,
+				[&](uint32_t archetype_idx, uint32_t chunk_idx) {
+					world.template view_one_chunk<std::remove_cvref_t<Cs>...>(archetype_idx, chunk_idx,
+						[&](ChunkView<std::remove_cvref_t<Cs>...> view) {
+							self.tick_chunk(view, ctx);
+						});
+					detail::mark_dispatch_chunk_written<Derived>(world, ctx, archetype_idx, chunk_idx);
 				});
 		}
 	};
@@ -1,6 +1,10 @@
 #include "openvic-simulation/ecs/CommandBuffer.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <span>
 #include <vector>
 
@@ -12,13 +16,165 @@
 
 using namespace OpenVic::ecs;
 
+std::size_t CommandArena::best_free_block(std::size_t min_capacity) const {
+	std::size_t best = free_.size();
+	for (std::size_t i = 0; i < free_.size(); ++i) {
+		if (free_[i].capacity >= min_capacity
+			&& (best == free_.size() || free_[i].capacity < free_[best].capacity)) {
+			best = i;
+		}
+	}
+	return best;
+}
+
+void* CommandArena::allocate(std::size_t size, std::size_t align) {
+	if (size == 0) {
+		return nullptr;
+	}
+	if (!used_.empty()) {
+		Block const& block = used_.back();
+		std::uintptr_t const base = reinterpret_cast<std::uintptr_t>(block.data.get());
+		std::uintptr_t const aligned = (base + offset_ + (align - 1)) & ~(static_cast<std::uintptr_t>(align) - 1);
+		std::size_t const end = static_cast<std::size_t>(aligned - base) + size;
+		if (end <= block.capacity) {
+			offset_ = end;
+			return reinterpret_cast<void*>(aligned);
+		}
+	}
+
+	// Current block is full: continue in the smallest retained free block that fits (with
+	// worst-case alignment padding), else allocate a new one.
+	std::size_t const needed = size + align - 1;
+	std::size_t const reuse = best_free_block(needed);
+	if (reuse != free_.size()) {
+		used_.push_back(std::move(free_[reuse]));
+		free_[reuse] = std::move(free_.back());
+		free_.pop_back();
+	} else {
+		std::size_t const capacity = std::max(BLOCK_SIZE, needed);
+		used_.push_back(Block { std::make_unique_for_overwrite<std::byte[]>(capacity), capacity });
+	}
+	offset_ = 0;
+	return allocate(size, align);
+}
+
+void CommandArena::reset() {
+	for (Block& block : used_) {
+		free_.push_back(std::move(block));
+	}
+	used_.clear();
+	offset_ = 0;
+}
+
+void CommandArena::adopt(CommandArena& other) {
+	if (other.used_.empty()) {
+		return;
+	}
+	// Give back, for each adopted block, our smallest free block at least as large — so an
+	// oversized block we keep for our own use (e.g. apply()'s placeholder map) is not traded
+	// away for a small one.
+	for (Block const& block : other.used_) {
+		std::size_t const give = best_free_block(block.capacity);
+		if (give != free_.size()) {
+			other.free_.push_back(std::move(free_[give]));
+			free_[give] = std::move(free_.back());
+			free_.pop_back();
+		}
+	}
+	if (used_.empty()) {
+		// Nothing of ours in flight: keep bumping where `other` left off.
+		used_ = std::move(other.used_);
+		offset_ = other.offset_;
+	} else {
+		// Adopted blocks go underneath our current block so it stays the bump target.
+		used_.insert(
+			used_.end() - 1,
+			std::make_move_iterator(other.used_.begin()), std::make_move_iterator(other.used_.end())
+		);
+	}
+	other.used_.clear();
+	other.offset_ = 0;
+}
+
+std::size_t CommandArena::reserved_bytes() const {
+	std::size_t total = 0;
+	for (Block const& block : used_) {
+		total += block.capacity;
+	}
+	for (Block const& block : free_) {
+		total += block.capacity;
+	}
+	return total;
+}
+
+CommandBuffer::~CommandBuffer() {
+	destroy_pending_payloads();
+}
+
+CommandBuffer::CommandBuffer(CommandBuffer&& other) noexcept
+	: ops { std::move(other.ops) }, arena_ { std::move(other.arena_) },
+	parallel_mode_ { other.parallel_mode_ }, deferred_count_ { other.deferred_count_ } {
+	other.ops.clear();
+	other.deferred_count_ = 0;
+}
+
+CommandBuffer& CommandBuffer::operator=(CommandBuffer&& other) noexcept {
+	if (this != &other) {
+		destroy_pending_payloads();
+		ops = std::move(other.ops);
+		arena_ = std::move(other.arena_);
+		parallel_mode_ = other.parallel_mode_;
+		deferred_count_ = other.deferred_count_;
+		other.ops.clear();
+		other.deferred_count_ = 0;
+	}
+	return *this;
+}
+
+void CommandBuffer::destroy_pending_payloads() {
+	for (Op& op : ops) {
+		if (op.payload == nullptr) {
+			continue;
+		}
+		switch (op.kind) {
+			case OpKind::CreateEntity: {
+				void* const* const value_slots = static_cast<void* const*>(op.payload);
+				for (std::size_t i = 0; i < op.signature->sorted_vtables.size(); ++i) {
+					if (value_slots[i] != nullptr) {
+						op.signature->sorted_vtables[i]->destroy(value_slots[i]);
+					}
+				}
+				break;
+			}
+			case OpKind::CreateEntitiesBulk: {
+				BulkCreatePayload const& bulk = *static_cast<BulkCreatePayload const*>(op.payload);
+				for (std::size_t i = 0; i < op.signature->sorted_vtables.size(); ++i) {
+					if (bulk.columns[i] != nullptr) {
+						op.signature->sorted_vtables[i]->destroy_n(bulk.columns[i], bulk.count);
+					}
+				}
+				break;
+			}
+			case OpKind::AddComponent: {
+				op.vtable->destroy(op.payload);
+				break;
+			}
+			case OpKind::DestroyEntity:
+			case OpKind::RemoveComponent:
+				break;
+		}
+		op.payload = nullptr;
+	}
+}
+
 void CommandBuffer::apply(World& world) {
-	// Resolution map for deferred placeholders. Indexed by placeholder local_seq (= op.eid.index
-	// for any deferred eid). Empty when the buffer holds no deferred ops — the common case for
-	// serial-system buffers, where this allocation is a no-op.
-	std::vector<EntityID> placeholder_to_real;
+	// Resolution map for deferred placeholders, in the arena like everything else apply()
+	// rewinds. Indexed by placeholder local_seq (= op.eid.index for any deferred eid). Empty
+	// when the buffer holds no deferred ops — the common case for serial-system buffers.
+	std::span<EntityID> placeholder_to_real;
 	if (deferred_count_ > 0) {
-		placeholder_to_real.assign(deferred_count_, INVALID_ENTITY_ID);
+		placeholder_to_real = { arena_.allocate_array<EntityID>(deferred_count_), deferred_count_ };
+		std::fill(placeholder_to_real.begin(), placeholder_to_real.end(), INVALID_ENTITY_ID);
 	}
 	auto resolve = [&](EntityID eid) -> EntityID {
 		if (!eid.is_deferred()) {
@@ -46,40 +202,27 @@ void CommandBuffer::apply(World& world) {
 						placeholder_to_real[op.eid.index] = real_eid;
 					}
 				}
-				// Hand the World move-only payload pointers; finalize_reserved_entity moves
-				// them into the archetype's column slabs. After the call, the payload slots
-				// are moved-from but still need their allocations freed.
-				std::vector<void*> raw_slots;
-				raw_slots.reserve(op.create.sorted_values.size());
-				for (PayloadSlot& slot : op.create.sorted_values) {
-					raw_slots.push_back(slot.data);
-				}
+				// Hand the World the arena value pointers; finalize_reserved_entity moves them
+				// into the archetype's column slabs. The move-construct destructively transfers
+				// each value, so the op no longer owns anything — the bytes go back with the
+				// arena rewind at the end of apply().
+				CommandSignature const& signature = *op.signature;
 				world.finalize_reserved_entity(
-					real_eid, op.create.sorted_sig, op.create.sorted_vtables, raw_slots
+					real_eid, signature.sorted_sig, signature.sorted_vtables,
+					{ static_cast<void* const*>(op.payload), signature.sorted_sig.size() }
 				);
+				op.payload = nullptr;
 				// Stamp immutability onto the freshly-finalised slot (covers both the deferred
 				// and serial create_immutable_entity paths in one place). CommandBuffer is a
 				// friend of World, so entity_slots is reachable here.
-				if (op.create.immutable && real_eid.index < world.entity_slots.size()) {
+				if (op.immutable && real_eid.index < world.entity_slots.size()) {
 					world.entity_slots[real_eid.index].immutable = true;
 				}
-				// Free the moved-from payload allocations. We don't call destroy() on them —
-				// the move-construct already destructively transferred the value. Capture
-				// `align` into a local BEFORE `release_data()` — `release_data()` clears the
-				// slot's `vtable` pointer, and the argument-evaluation order for the delete
-				// call below is unspecified, so any access to `slot.vtable->align` in the
-				// same expression is undefined.
-				for (PayloadSlot& slot : op.create.sorted_values) {
-					if (slot.data != nullptr && slot.vtable != nullptr && slot.vtable->size > 0) {
-						std::size_t const align = slot.vtable->align;
-						::operator delete(slot.release_data(), std::align_val_t { align });
-						slot.vtable = nullptr;
-					}
-				}
 				break;
 			}
 			case OpKind::CreateEntitiesBulk: {
-				BulkCreatePayload& bulk = *op.bulk;
+				BulkCreatePayload const& bulk = *static_cast<BulkCreatePayload const*>(op.payload);
+				CommandSignature const& signature = *op.signature;
 				std::size_t const n = bulk.count;
 
 				// Resolve the batch to real ids in creation order. Parallel-recorded batches
@@ -87,34 +230,35 @@ void CommandBuffer::apply(World& world) {
 				// `n` individual CreateEntity ops would do, so id assignment matches the
 				// loop equivalent. Serial-recorded batches reserved at record time.
 				std::span<EntityID const> ids;
-				std::vector<EntityID> resolved;
 				if (op.eid.is_deferred()) {
-					resolved.reserve(n);
+					EntityID* const resolved = arena_.allocate_array<EntityID>(n);
 					for (std::size_t i = 0; i < n; ++i) {
 						EntityID const real = world.reserve_entity_slot();
 						std::size_t const ph = static_cast<std::size_t>(op.eid.index) + i;
 						if (ph < placeholder_to_real.size()) {
 							placeholder_to_real[ph] = real;
 						}
-						resolved.push_back(real);
+						resolved[i] = real;
 					}
-					ids = resolved;
+					ids = { resolved, n };
 				} else {
-					ids = bulk.reserved_ids;
+					ids = { bulk.reserved_ids, n };
 				}
 
-				// Column block base pointers, parallel to sorted_sig (nullptr for tags).
-				std::vector<void*> blocks;
-				blocks.reserve(bulk.columns.size());
-				for (PayloadColumn& col : bulk.columns) {
-					blocks.push_back(col.data);
-				}
-				world.finalize_reserved_entities_bulk(ids, bulk.sorted_sig, bulk.sorted_vtables, blocks);
+				// Column blocks are parallel to sorted_sig (nullptr for tags). Every staged
+				// value is consumed — finalize_reserved_entities_bulk either move-constructs it
+				// out (sources destroyed by move_construct_n / move_construct) or destroys it on
+				// the skip path — so the op stops owning them here.
+				world.finalize_reserved_entities_bulk(
+					ids, signature.sorted_sig, signature.sorted_vtables,
+					{ bulk.columns, signature.sorted_sig.size() }
+				);
+				op.payload = nullptr;
 
 				// Stamp immutability per entity. Unlike the single-create branch, re-check
 				// liveness + generation so a slot that was destroyed and reused between
 				// record and apply (serial-mode misuse) can't stamp an unrelated occupant.
-				if (bulk.immutable) {
+				if (op.immutable) {
 					for (EntityID const eid : ids) {
 						if (eid.index < world.entity_slots.size()
 							&& world.entity_slots[eid.index].alive
@@ -123,19 +267,6 @@ void CommandBuffer::apply(World& world) {
 						}
 					}
 				}
-
-				// Free the raw blocks. Every staged value has been consumed —
-				// finalize_reserved_entities_bulk either move-constructed it out (sources
-				// destroyed by move_construct_n / move_construct) or destroyed it on the
-				// skip path — so release WITHOUT destroy_n. Capture `align` before
-				// release_data() clears the vtable (same order-of-evaluation rationale as
-				// the CreateEntity branch).
-				for (PayloadColumn& col : bulk.columns) {
-					if (col.data != nullptr && col.vtable != nullptr && col.vtable->size > 0) {
-						std::size_t const align = col.vtable->align;
-						::operator delete(col.release_data(), std::align_val_t { align });
-					}
-				}
 				break;
 			}
 			case OpKind::DestroyEntity: {
@@ -179,15 +310,15 @@ void CommandBuffer::apply(World& world) {
 					spdlog::error_s(
 						"CommandBuffer::apply refused add_component: entity {}:{} is immutable "
 						"(component id {:#x})",
-						eid.index, eid.generation, op.add.id
+						eid.index, eid.generation, op.component_id
 					);
 					break;
 				}
 				// Immutability backstop (deferred path): apply() migrates type-erased below,
 				// NOT through World::add_component, so the refusal is repeated. The intact
-				// op.add.value payload is freed by its PayloadSlot destructor at ops.clear().
-				ColumnVTable const* new_vt = op.add.value.vtable;
-				component_type_id_t const new_id = op.add.id;
+				// payload is still owned by the op and destroyed by destroy_pending_payloads.
+				ColumnVTable const* new_vt = op.vtable;
+				component_type_id_t const new_id = op.component_id;
 				uint32_t const src_idx = slot.archetype_index;
 				uint32_t const src_chunk = slot.chunk_index;
 				uint32_t const src_row = slot.row;
@@ -200,20 +331,12 @@ void CommandBuffer::apply(World& world) {
 						if (src.column_offsets[existing_col] != NO_COLUMN_OFFSET) {
 							void* dst = src.row_in_column(src_chunk, existing_col, src_row);
 							src.vtables[existing_col]->destroy(dst);
-							src.vtables[existing_col]->move_construct(dst, op.add.value.data);
+							src.vtables[existing_col]->move_construct(dst, op.payload);
 							++src.column_versions[existing_col];
+							src.stamp_column_written(src_chunk, existing_col, world.change_tick_);
 						}
-						// Free the moved-from payload allocation. Capture `align` BEFORE
-						// `release_data()` clears the vtable pointer — see CreateEntity branch
-						// for the order-of-evaluation rationale.
-						if (op.add.value.data != nullptr && op.add.value.vtable != nullptr
-							&& op.add.value.vtable->size > 0) {
-							std::size_t const align = op.add.value.vtable->align;
-							::operator delete(
-								op.add.value.release_data(), std::align_val_t { align }
-							);
-							op.add.value.vtable = nullptr;
-						}
+						// Consumed by the move-construct (tags carry no payload).
+						op.payload = nullptr;
 						break;
 					}
 				}
@@ -245,7 +368,7 @@ void CommandBuffer::apply(World& world) {
 				uint32_t const target_idx
 					= world.find_or_create_archetype(target_sig, target_vtables.data());
 
-				Archetype::RowLocation target_loc = world.archetypes[target_idx].reserve_row();
+				Archetype::RowLocation target_loc = world.archetypes[target_idx].reserve_row(world.change_tick_);
 				world.archetypes[target_idx].entity_array(target_loc.chunk_index)[target_loc.row] = eid;
 
 				{
@@ -260,7 +383,7 @@ void CommandBuffer::apply(World& world) {
 							target_loc.chunk_index, i, target_loc.row
 						);
 						if (tid == new_id) {
-							target.vtables[i]->move_construct(dst, op.add.value.data);
+							target.vtables[i]->move_construct(dst, op.payload);
 						} else {
 							std::size_t const src_col_idx = src.column_index_for(tid);
 							void* srcp = src.row_in_column(src_chunk, src_col_idx, src_row);
@@ -276,17 +399,7 @@ void CommandBuffer::apply(World& world) {
 				mutable_slot.chunk_index = static_cast<uint32_t>(target_loc.chunk_index);
 				mutable_slot.row = static_cast<uint32_t>(target_loc.row);
 
-				// Free the moved-from payload allocation. Capture `align` BEFORE
-				// `release_data()` clears the vtable pointer — see CreateEntity branch
-				// for the order-of-evaluation rationale.
-				if (op.add.value.data != nullptr && op.add.value.vtable != nullptr
-					&& op.add.value.vtable->size > 0) {
-					std::size_t const align = op.add.value.vtable->align;
-					::operator delete(
-						op.add.value.release_data(), std::align_val_t { align }
-					);
-					op.add.value.vtable = nullptr;
-				}
+				op.payload = nullptr; // moved into the target column
 				break;
 			}
 			case OpKind::RemoveComponent: {
@@ -312,7 +425,7 @@ void CommandBuffer::apply(World& world) {
 					spdlog::error_s(
 						"CommandBuffer::apply refused remove_component: entity {}:{} is immutable "
 						"(component id {:#x})",
-						eid.index, eid.generation, op.remove_id
+						eid.index, eid.generation, op.component_id
 					);
 					break;
 				}
@@ -322,7 +435,7 @@ void CommandBuffer::apply(World& world) {
 				std::size_t drop_col_idx = NO_COLUMN_INDEX;
 				{
 					Archetype const& src = world.archetypes[src_idx];
-					drop_col_idx = src.column_index_for(op.remove_id);
+					drop_col_idx = src.column_index_for(op.component_id);
 					if (drop_col_idx == NO_COLUMN_INDEX) {
 						break; // entity doesn't carry it — silent no-op
 					}
@@ -339,7 +452,7 @@ void CommandBuffer::apply(World& world) {
 					target_sig.reserve(src.signature.size() - 1);
 					target_vtables.reserve(src.signature.size() - 1);
 					for (std::size_t i = 0; i < src.signature.size(); ++i) {
-						if (src.signature[i] == op.remove_id) {
+						if (src.signature[i] == op.component_id) {
 							continue;
 						}
 						target_sig.push_back(src.signature[i]);
@@ -350,7 +463,7 @@ void CommandBuffer::apply(World& world) {
 				uint32_t const target_idx
 					= world.find_or_create_archetype(target_sig, target_vtables.data());
 
-				Archetype::RowLocation target_loc = world.archetypes[target_idx].reserve_row();
+				Archetype::RowLocation target_loc = world.archetypes[target_idx].reserve_row(world.change_tick_);
 				world.archetypes[target_idx].entity_array(target_loc.chunk_index)[target_loc.row] = eid;
 
 				{
@@ -383,13 +496,18 @@ void CommandBuffer::apply(World& world) {
 			}
 		}
 	}
+	// Payloads of ops that were skipped (dead target, immutability refusal, ...) are still
+	// owned by their op; destroy them before the arena rewinds over their bytes.
+	destroy_pending_payloads();
 	ops.clear();
+	arena_.reset();
 	deferred_count_ = 0;
 }
 
 void CommandBuffer::clear() {
-	// PayloadSlot destructors clean up any remaining values via their vtables.
+	destroy_pending_payloads();
 	ops.clear();
+	arena_.reset();
 	deferred_count_ = 0;
 }
 
@@ -402,6 +520,9 @@ void CommandBuffer::merge_from(CommandBuffer&& other) {
 		return;
 	}
 	ops.reserve(ops.size() + other.ops.size());
+	// Payload pointers in the incoming ops stay valid: the blocks they point into move with
+	// them.
+	arena_.adopt(other.arena_);
 	uint32_t const base = deferred_count_;
 	// Rebase incoming placeholder local_seqs by `base` so placeholders stay unique post-merge.
 	// CreateEntity ops carry their own placeholder in op.eid; AddComponent / DestroyEntity /
@@ -416,7 +537,7 @@ void CommandBuffer::merge_from(CommandBuffer&& other) {
 		if (op.eid.is_deferred()) {
 			op.eid.index += base;
 		}
-		ops.push_back(std::move(op));
+		ops.push_back(op);
 	}
 	deferred_count_ += other.deferred_count_;
 	other.ops.clear();
@@ -17,145 +17,123 @@
 
 namespace OpenVic::ecs {
 
-	// Type-erased holder for one component value queued in a CommandBuffer. Owns the
-	// allocation; destructor cleans up correctly regardless of payload type. Move-only.
-	struct PayloadSlot {
-		void* data = nullptr;
-		ColumnVTable const* vtable = nullptr;
-
-		PayloadSlot() = default;
+	// Chunked bump arena backing one CommandBuffer's payload bytes: queued component values,
+	// per-op value-pointer tables, bulk batch headers. Allocation is a pointer bump; a value
+	// never moves once placed, so pointers into the arena stay valid until reset(). Blocks are
+	// never handed back to the system while the arena lives — reset() rewinds so the next
+	// recording reuses them, which makes a steady-state tick malloc-free. The arena only owns
+	// bytes: constructing and destroying the values in it is the CommandBuffer's job.
+	// Not thread-safe — a buffer is recorded by one thread at a time.
+	class CommandArena {
+	public:
+		// Default block size. A request larger than this gets a dedicated block of its own
+		// size, which is then retained and reused like any other.
+		static constexpr std::size_t BLOCK_SIZE = 16 * 1024;
+
+		CommandArena() = default;
+
+		CommandArena(CommandArena const&) = delete;
+		CommandArena& operator=(CommandArena const&) = delete;
+		CommandArena(CommandArena&&) noexcept = default;
+		CommandArena& operator=(CommandArena&&) noexcept = default;
+
+		// Uninitialised storage for `size` bytes aligned to `align` (a power of two).
+		// size == 0 returns nullptr.
+		void* allocate(std::size_t size, std::size_t align);
+
+		template<typename T>
+		T* allocate_array(std::size_t count) {
+			static_assert(std::is_trivially_destructible_v<T>, "CommandArena never runs destructors");
+			return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+		}
 
-		PayloadSlot(PayloadSlot const&) = delete;
-		PayloadSlot& operator=(PayloadSlot const&) = delete;
+		// Every block becomes free for reuse; nothing is freed.
+		void reset();
 
-		PayloadSlot(PayloadSlot&& other) noexcept : data { other.data }, vtable { other.vtable } {
-			other.data = nullptr;
-			other.vtable = nullptr;
-		}
-		PayloadSlot& operator=(PayloadSlot&& other) noexcept {
-			if (this != &other) {
-				reset();
-				data = other.data;
-				vtable = other.vtable;
-				other.data = nullptr;
-				other.vtable = nullptr;
-			}
-			return *this;
-		}
+		// Take over every block `other` has handed out — values placed there stay where they
+		// are — and give `other` a free block of at least the same size for each one we can
+		// match, so a per-chunk buffer merged into a pending buffer every tick keeps its
+		// footprint instead of reallocating. `other` is left reset.
+		void adopt(CommandArena& other);
 
-		~PayloadSlot() {
-			reset();
-		}
+		// Total bytes held across in-use and free blocks.
+		std::size_t reserved_bytes() const;
 
-		void reset() {
-			if (data != nullptr && vtable != nullptr && vtable->size > 0) {
-				vtable->destroy(data);
-				::operator delete(data, std::align_val_t { vtable->align });
-			}
-			data = nullptr;
-			vtable = nullptr;
-		}
+	private:
+		struct Block {
+			std::unique_ptr<std::byte[]> data;
+			std::size_t capacity = 0;
+		};
 
-		// Allocate aligned storage for one value of vt, but do not construct anything.
-		// Caller placement-news into `data`. For tag types (size == 0) data stays nullptr.
-		void allocate(ColumnVTable const* vt) {
-			vtable = vt;
-			if (vt != nullptr && vt->size > 0) {
-				data = ::operator new(vt->size, std::align_val_t { vt->align });
-			}
-		}
+		// Index of the smallest free block with at least `min_capacity` bytes, or
+		// free_.size() when none fits.
+		std::size_t best_free_block(std::size_t min_capacity) const;
 
-		// Release ownership of the payload (caller must destroy the value or move it
-		// onwards). Used during apply() — the archetype's column move-constructs from
-		// `data`, then we still need to free the now-moved-from allocation.
-		void* release_data() {
-			void* d = data;
-			data = nullptr;
-			vtable = nullptr;
-			return d;
-		}
+		// Blocks holding live allocations; back() is the one being bumped.
+		std::vector<Block> used_;
+		std::vector<Block> free_;
+		std::size_t offset_ = 0; // bump offset into used_.back()
 	};
 
-	// Type-erased holder for ONE contiguous block of `count` component values queued by a
-	// bulk create — the batch analogue of PayloadSlot (one allocation per column per batch
-	// instead of one per component per entity). Move-only. Tag columns (vtable->size == 0)
-	// keep data == nullptr.
-	//
-	// Ownership protocol mirrors PayloadSlot: the destructor destroys any still-owned values
-	// (via ColumnVTable::destroy_n) and frees the block — that covers the un-applied paths
-	// (clear(), dropped buffer). apply() instead transfers the values out via
-	// World::finalize_reserved_entities_bulk (whose move_construct_n destroys the sources)
-	// and then frees the raw memory through release_data() — at that point no constructed
-	// values remain, so destroy_n must NOT run again.
-	struct PayloadColumn {
-		void* data = nullptr;
-		ColumnVTable const* vtable = nullptr;
-		uint32_t count = 0;
-
-		PayloadColumn() = default;
-
-		PayloadColumn(PayloadColumn const&) = delete;
-		PayloadColumn& operator=(PayloadColumn const&) = delete;
-
-		PayloadColumn(PayloadColumn&& other) noexcept
-			: data { other.data }, vtable { other.vtable }, count { other.count } {
-			other.data = nullptr;
-			other.vtable = nullptr;
-			other.count = 0;
-		}
-		PayloadColumn& operator=(PayloadColumn&& other) noexcept {
-			if (this != &other) {
-				reset();
-				data = other.data;
-				vtable = other.vtable;
-				count = other.count;
-				other.data = nullptr;
-				other.vtable = nullptr;
-				other.count = 0;
-			}
-			return *this;
-		}
-
-		~PayloadColumn() {
-			reset();
-		}
+	// Sorted signature of one component pack, shared by every create op recorded with that
+	// pack instead of being copied into each op. Interned per pack type, so it is built once
+	// per process (thread-safe function-local static) and is immutable afterwards — safe to
+	// reference from any buffer on any thread.
+	struct CommandSignature {
+		std::vector<component_type_id_t> sorted_sig;
+		std::vector<ColumnVTable const*> sorted_vtables; // parallel to sorted_sig
+	};
 
-		void reset() {
-			if (data != nullptr && vtable != nullptr && vtable->size > 0) {
-				vtable->destroy_n(data, count);
-				::operator delete(data, std::align_val_t { vtable->align });
-			}
-			data = nullptr;
-			vtable = nullptr;
-			count = 0;
+	namespace detail {
+		template<typename... Cs>
+		CommandSignature const& command_signature_for() {
+			static CommandSignature const signature = [] {
+				constexpr std::size_t const N = sizeof...(Cs);
+				component_type_id_t sorted_ids[N] = { component_type_id_of<Cs>()... };
+				ColumnVTable const* sorted_vtables[N] = { &column_vtable_for<Cs>()... };
+				for (std::size_t i = 0; i < N; ++i) {
+					for (std::size_t j = i + 1; j < N; ++j) {
+						if (sorted_ids[j] < sorted_ids[i]) {
+							std::swap(sorted_ids[i], sorted_ids[j]);
+							std::swap(sorted_vtables[i], sorted_vtables[j]);
+						}
+					}
+				}
+				return CommandSignature {
+					std::vector<component_type_id_t>(sorted_ids, sorted_ids + N),
+					std::vector<ColumnVTable const*>(sorted_vtables, sorted_vtables + N)
+				};
+			}();
+			return signature;
 		}
 
-		// Allocate aligned storage for `n` values of vt, but construct nothing — the caller
-		// placement-news each element into the block. For tag types (size == 0) data stays
-		// nullptr.
-		void allocate(ColumnVTable const* vt, uint32_t n) {
-			vtable = vt;
-			count = n;
-			if (vt != nullptr && vt->size > 0 && n > 0) {
-				data = ::operator new(vt->size * n, std::align_val_t { vt->align });
+		// Index of `id` in `sig` (sig.size() when absent).
+		inline std::size_t command_signature_index(CommandSignature const& sig, component_type_id_t id) {
+			for (std::size_t i = 0; i < sig.sorted_sig.size(); ++i) {
+				if (sig.sorted_sig[i] == id) {
+					return i;
+				}
 			}
+			return sig.sorted_sig.size();
 		}
-
-		// Release ownership of the block WITHOUT destroying elements (they must already be
-		// moved-from / destroyed). Caller frees the returned memory.
-		void* release_data() {
-			void* d = data;
-			data = nullptr;
-			vtable = nullptr;
-			count = 0;
-			return d;
-		}
-	};
+	}
 
 	struct CommandBuffer {
+		// Every queued payload — component values, per-op value tables, bulk batch headers —
+		// lives in the buffer's CommandArena; the op list only points into it. apply() and
+		// clear() rewind the arena instead of freeing it, so a buffer that is reused tick
+		// after tick stops allocating once it has seen its largest tick.
+		CommandBuffer() = default;
+		~CommandBuffer();
+
+		CommandBuffer(CommandBuffer const&) = delete;
+		CommandBuffer& operator=(CommandBuffer const&) = delete;
+		CommandBuffer(CommandBuffer&& other) noexcept;
+		CommandBuffer& operator=(CommandBuffer&& other) noexcept;
+
 		// In **serial mode** (default): reserves a slot in `world` synchronously and returns its
 		// real EntityID. `world.is_alive(eid)` returns false until `apply()` finalises it.
-		// Components are copied / moved into a type-erased PayloadSlot per component.
+		// Components are copied / moved into the buffer's arena.
 		//
 		// In **parallel mode** (`set_parallel_mode(true)` — set by SystemThreaded on every
 		// per-chunk buffer): no World mutation. Returns a *deferred placeholder* EntityID
@@ -177,8 +155,8 @@ namespace OpenVic::ecs {
 
 		// === Bulk entity creation (ECS_SIM_ARCHITECTURE §9 item 4) ===
 		// Deferred analogue of World::create_entities: records ONE batch op whose payload is
-		// a single contiguous block per non-tag component column (PayloadColumn) instead of
-		// count × components PayloadSlots. Same input contract as the World API: one span per
+		// a single contiguous arena block per non-tag component column instead of count ×
+		// components individual values. Same input contract as the World API: one span per
 		// non-empty component (pack order, length == count; tags take no span) or no spans to
 		// default-construct; input spans are MOVED-FROM at record time. The handles written
 		// to `out_ids` (length must equal count) follow the single-create rules per mode:
@@ -209,7 +187,7 @@ namespace OpenVic::ecs {
 			Op op;
 			op.kind = OpKind::DestroyEntity;
 			op.eid = id;
-			ops.push_back(std::move(op));
+			ops.push_back(op);
 		}
 
 		template<typename C>
@@ -232,11 +210,12 @@ namespace OpenVic::ecs {
 		// Splice `other`'s queued ops onto the end of our op vector. After return, `other`
 		// is empty (op_count() == 0). Used by `SystemThreaded::tick_all` to combine the
 		// per-chunk buffers into the system's pending buffer in chunk_idx ascending order.
-		// PayloadSlot moves are zero-copy (just pointer transfer).
+		// Payloads are not copied: our arena adopts `other`'s blocks wholesale.
 		void merge_from(CommandBuffer&& other);
 
-		// Resets without applying — every queued payload is destroyed via its vtable. After
-		// clear(), op_count() == 0 and empty() == true.
+		// Resets without applying — every queued payload is destroyed via its vtable and the
+		// arena rewound. After clear(), op_count() == 0 and empty() == true. Dropping a buffer
+		// with ops still queued destroys their payloads the same way.
 		void clear();
 
 		// When set, `create_entity` switches to deferred mode: no World mutation, returns a
@@ -266,6 +245,12 @@ namespace OpenVic::ecs {
 			return ops.empty();
 		}
 
+		// Bytes held by the payload arena, in use or retained for reuse. Diagnostic only — it
+		// stays flat across apply() cycles once the buffer has seen its largest tick.
+		std::size_t reserved_payload_bytes() const {
+			return arena_.reserved_bytes();
+		}
+
 	private:
 		// Shared body of create_entity / create_immutable_entity — records a CreateEntity op,
 		// stamping CreatePayload::immutable. Returns the (real or deferred) raw EntityID.
@@ -281,54 +266,46 @@ namespace OpenVic::ecs {
 		);
 
 		enum class OpKind {
-			CreateEntity, // payload: full archetype signature + per-component slots
-			CreateEntitiesBulk, // payload: boxed BulkCreatePayload (op.bulk)
+			CreateEntity, // payload: void*[signature size] of value pointers (nullptr for tags)
+			CreateEntitiesBulk, // payload: BulkCreatePayload
 			DestroyEntity, // no payload
-			AddComponent, // payload: 1 component slot (tag-aware)
+			AddComponent, // payload: the component value (nullptr for tags)
 			RemoveComponent // no payload — only the type id
 		};
 
-		struct CreatePayload {
-			std::vector<component_type_id_t> sorted_sig;
-			std::vector<ColumnVTable const*> sorted_vtables;
-			std::vector<PayloadSlot> sorted_values; // length == sorted_sig.size()
-			// When true, apply() stamps the finalised entity's slot immutable. Default false keeps
-			// every plain create_entity recording mutable.
-			bool immutable = false;
-		};
-
-		// Payload of one CreateEntitiesBulk op. Boxed behind a unique_ptr on Op so ordinary
-		// ops only pay 8 bytes for it — one heap allocation per BATCH, never per entity.
+		// Payload of one CreateEntitiesBulk op, placed in the arena. Trivially destructible —
+		// the staged values it points at are destroyed through `signature` when discarded.
 		struct BulkCreatePayload {
-			std::vector<component_type_id_t> sorted_sig;
-			std::vector<ColumnVTable const*> sorted_vtables;
-			// Parallel to sorted_sig; tag columns hold data == nullptr.
-			std::vector<PayloadColumn> columns;
+			// Parallel to signature->sorted_sig: one block of `count` values per non-tag
+			// column, nullptr for tag columns.
+			void** columns = nullptr;
 			// Serial mode only: the count real slots reserved at record time, in creation
-			// order. Empty in parallel mode (op.eid carries the base placeholder instead;
+			// order. nullptr in parallel mode (op.eid carries the base placeholder instead;
 			// the batch spans placeholders [op.eid.index, op.eid.index + count)).
-			std::vector<EntityID> reserved_ids;
+			EntityID* reserved_ids = nullptr;
 			uint32_t count = 0;
-			// When true, apply() stamps every finalised entity's slot immutable.
-			bool immutable = false;
-		};
-
-		struct AddPayload {
-			component_type_id_t id = 0UL;
-			PayloadSlot value; // .vtable always set (even for tag — size==0); .data null for tag/default
-			bool is_default = false; // true when add_component<C>() with no value
 		};
 
+		// Trivially copyable: ownership of the arena-resident payload is tracked by `payload`
+		// alone, which apply() nulls once the values have been moved into the World. Anything
+		// still non-null when the buffer is cleared or dropped is destroyed through its vtables.
 		struct Op {
 			OpKind kind;
 			EntityID eid;
-			component_type_id_t remove_id = 0; // RemoveComponent only
-			CreatePayload create; // CreateEntity only
-			AddPayload add; // AddComponent only
-			std::unique_ptr<BulkCreatePayload> bulk; // CreateEntitiesBulk only
+			component_type_id_t component_id = 0; // AddComponent / RemoveComponent
+			CommandSignature const* signature = nullptr; // CreateEntity / CreateEntitiesBulk
+			ColumnVTable const* vtable = nullptr; // AddComponent (set even for tags)
+			void* payload = nullptr; // see OpKind
+			// Create ops: apply() stamps the finalised entity's slot(s) immutable.
+			bool immutable = false;
+			bool is_default = false; // AddComponent: add_component<C>() with no value
 		};
 
+		// Destroys every payload still owned by a queued op (see Op).
+		void destroy_pending_payloads();
+
 		std::vector<Op> ops;
+		CommandArena arena_;
 		bool parallel_mode_ = false;
 		// Count of deferred (placeholder) CreateEntity ops queued in this buffer. When two
 		// buffers are spliced via `merge_from`, the receiver rebases incoming placeholder
@@ -344,27 +321,10 @@ namespace OpenVic::ecs {
 	EntityID CommandBuffer::record_create_entity(bool immutable, World& world, Cs&&... values) {
 		static_assert(sizeof...(Cs) > 0, "CommandBuffer::create_entity requires at least one component");
 
-		// Build the same sorted signature as World::create_entity does, recording the
-		// vtable pointer alongside each id.
-		component_type_id_t const raw_ids[] = { component_type_id_of<std::remove_cvref_t<Cs>>()... };
-		ColumnVTable const* const raw_vtables[] = { &column_vtable_for<std::remove_cvref_t<Cs>>()... };
+		// The same sorted signature World::create_entity builds, interned per pack.
+		CommandSignature const& signature = detail::command_signature_for<std::remove_cvref_t<Cs>...>();
 		constexpr std::size_t const N = sizeof...(Cs);
 
-		component_type_id_t sorted_ids[N];
-		ColumnVTable const* sorted_vtables[N];
-		for (std::size_t i = 0; i < N; ++i) {
-			sorted_ids[i] = raw_ids[i];
-			sorted_vtables[i] = raw_vtables[i];
-		}
-		for (std::size_t i = 0; i < N; ++i) {
-			for (std::size_t j = i + 1; j < N; ++j) {
-				if (sorted_ids[j] < sorted_ids[i]) {
-					std::swap(sorted_ids[i], sorted_ids[j]);
-					std::swap(sorted_vtables[i], sorted_vtables[j]);
-				}
-			}
-		}
-
 		// In parallel mode (SystemThreaded per-chunk buffers), defer slot reservation: no World
 		// mutation here, just hand back a placeholder EntityID with DEFERRED_GENERATION_BIT set.
 		// `apply()` allocates the real slot at the stage barrier and rewrites the placeholder.
@@ -374,39 +334,32 @@ namespace OpenVic::ecs {
 			? EntityID { deferred_count_++, DEFERRED_GENERATION_BIT }
 			: world.reserve_entity_slot();
 
-		Op op;
-		op.kind = OpKind::CreateEntity;
-		op.eid = eid;
-		op.create.immutable = immutable;
-		op.create.sorted_sig.assign(sorted_ids, sorted_ids + N);
-		op.create.sorted_vtables.assign(sorted_vtables, sorted_vtables + N);
-		op.create.sorted_values.resize(N);
+		void** const value_slots = arena_.allocate_array<void*>(N);
 		for (std::size_t i = 0; i < N; ++i) {
-			op.create.sorted_values[i].allocate(sorted_vtables[i]);
+			ColumnVTable const* const vt = signature.sorted_vtables[i];
+			value_slots[i] = arena_.allocate(vt->size, vt->align);
 		}
 
 		// Move each value into the corresponding sorted slot. Use a fold expression with the
 		// raw (unsorted) parameter pack and look up the sorted index.
 		auto place = [&]<typename C>(C&& value) {
 			using TC = std::remove_cvref_t<C>;
-			component_type_id_t const id = component_type_id_of<TC>();
-			std::size_t target = N;
-			for (std::size_t i = 0; i < N; ++i) {
-				if (op.create.sorted_sig[i] == id) {
-					target = i;
-					break;
-				}
-			}
 			if constexpr (!std::is_empty_v<TC>) {
-				::new (op.create.sorted_values[target].data) TC(std::forward<C>(value));
+				std::size_t const target = detail::command_signature_index(signature, component_type_id_of<TC>());
+				::new (value_slots[target]) TC(std::forward<C>(value));
 			} else {
 				(void) value;
-				(void) target;
 			}
 		};
 		(place(std::forward<Cs>(values)), ...);
 
-		ops.push_back(std::move(op));
+		Op op;
+		op.kind = OpKind::CreateEntity;
+		op.eid = eid;
+		op.signature = &signature;
+		op.payload = value_slots;
+		op.immutable = immutable;
+		ops.push_back(op);
 		return eid;
 	}
 
@@ -471,38 +424,24 @@ namespace OpenVic::ecs {
 			return true; // record nothing — loop-equivalent
 		}
 
-		// Sorted signature + parallel vtable list, paid once per batch.
-		component_type_id_t const raw_ids[] = { component_type_id_of<Cs>()... };
-		ColumnVTable const* const raw_vtables[] = { &column_vtable_for<Cs>()... };
+		// Interned sorted signature — shared, not copied, by every batch of this pack.
+		CommandSignature const& signature = detail::command_signature_for<Cs...>();
 		constexpr std::size_t const N = sizeof...(Cs);
 
-		component_type_id_t sorted_ids[N];
-		ColumnVTable const* sorted_vtables[N];
+		BulkCreatePayload* const bulk
+			= ::new (arena_.allocate_array<BulkCreatePayload>(1)) BulkCreatePayload {};
+		bulk->count = static_cast<uint32_t>(count);
+		bulk->columns = arena_.allocate_array<void*>(N);
 		for (std::size_t i = 0; i < N; ++i) {
-			sorted_ids[i] = raw_ids[i];
-			sorted_vtables[i] = raw_vtables[i];
-		}
-		for (std::size_t i = 0; i < N; ++i) {
-			for (std::size_t j = i + 1; j < N; ++j) {
-				if (sorted_ids[j] < sorted_ids[i]) {
-					std::swap(sorted_ids[i], sorted_ids[j]);
-					std::swap(sorted_vtables[i], sorted_vtables[j]);
-				}
-			}
+			ColumnVTable const* const vt = signature.sorted_vtables[i];
+			bulk->columns[i] = arena_.allocate(vt->size * count, vt->align);
 		}
 
 		Op op;
 		op.kind = OpKind::CreateEntitiesBulk;
-		op.bulk = std::make_unique<BulkCreatePayload>();
-		BulkCreatePayload& bulk = *op.bulk;
-		bulk.count = static_cast<uint32_t>(count);
-		bulk.immutable = immutable;
-		bulk.sorted_sig.assign(sorted_ids, sorted_ids + N);
-		bulk.sorted_vtables.assign(sorted_vtables, sorted_vtables + N);
-		bulk.columns.resize(N);
-		for (std::size_t i = 0; i < N; ++i) {
-			bulk.columns[i].allocate(sorted_vtables[i], bulk.count);
-		}
+		op.signature = &signature;
+		op.payload = bulk;
+		op.immutable = immutable;
 
 		// Stage the values: per non-empty component, move-construct (or default-construct)
 		// `count` elements from its input span into the column's contiguous block — typed
@@ -512,15 +451,8 @@ namespace OpenVic::ecs {
 			auto stage_column = [&]<std::size_t I>() {
 				using TC = std::tuple_element_t<I, std::tuple<Cs...>>;
 				if constexpr (!std::is_empty_v<TC>) {
-					component_type_id_t const id = component_type_id_of<TC>();
-					std::size_t target = N;
-					for (std::size_t i = 0; i < N; ++i) {
-						if (bulk.sorted_sig[i] == id) {
-							target = i;
-							break;
-						}
-					}
-					TC* const block = static_cast<TC*>(bulk.columns[target].data);
+					std::size_t const target = detail::command_signature_index(signature, component_type_id_of<TC>());
+					TC* const block = static_cast<TC*>(bulk->columns[target]);
 					if constexpr (use_spans) {
 						std::span<TC> const src = std::get<span_map[I]>(typed_spans);
 						for (std::size_t k = 0; k < count; ++k) {
@@ -547,18 +479,18 @@ namespace OpenVic::ecs {
 			for (std::size_t i = 0; i < count; ++i) {
 				out_ids[i] = OutIdT { base + static_cast<uint32_t>(i), DEFERRED_GENERATION_BIT };
 			}
-			deferred_count_ += bulk.count;
+			deferred_count_ += bulk->count;
 		} else {
 			op.eid = INVALID_ENTITY_ID;
-			bulk.reserved_ids.reserve(count);
+			bulk->reserved_ids = arena_.allocate_array<EntityID>(count);
 			for (std::size_t i = 0; i < count; ++i) {
 				EntityID const eid = world.reserve_entity_slot();
-				bulk.reserved_ids.push_back(eid);
+				bulk->reserved_ids[i] = eid;
 				out_ids[i] = OutIdT { eid.index, eid.generation };
 			}
 		}
 
-		ops.push_back(std::move(op));
+		ops.push_back(op);
 		return true;
 	}
 
@@ -583,33 +515,35 @@ namespace OpenVic::ecs {
 	template<typename C>
 	void CommandBuffer::add_component(EntityID id, C&& value) {
 		using TC = std::remove_cvref_t<C>;
+		ColumnVTable const& vt = column_vtable_for<TC>();
 		Op op;
 		op.kind = OpKind::AddComponent;
 		op.eid = id;
-		op.add.id = component_type_id_of<TC>();
-		op.add.is_default = false;
-		op.add.value.allocate(&column_vtable_for<TC>());
+		op.component_id = component_type_id_of<TC>();
+		op.vtable = &vt;
+		op.is_default = false;
 		if constexpr (!std::is_empty_v<TC>) {
-			::new (op.add.value.data) TC(std::forward<C>(value));
+			op.payload = ::new (arena_.allocate(vt.size, vt.align)) TC(std::forward<C>(value));
 		} else {
 			(void) value;
 		}
-		ops.push_back(std::move(op));
+		ops.push_back(op);
 	}
 
 	template<typename C>
 	void CommandBuffer::add_component(EntityID id) {
 		using TC = std::remove_cvref_t<C>;
+		ColumnVTable const& vt = column_vtable_for<TC>();
 		Op op;
 		op.kind = OpKind::AddComponent;
 		op.eid = id;
-		op.add.id = component_type_id_of<TC>();
-		op.add.is_default = true;
-		op.add.value.allocate(&column_vtable_for<TC>());
+		op.component_id = component_type_id_of<TC>();
+		op.vtable = &vt;
+		op.is_default = true;
 		if constexpr (!std::is_empty_v<TC>) {
-			::new (op.add.value.data) TC {};
+			op.payload = ::new (arena_.allocate(vt.size, vt.align)) TC {};
 		}
-		ops.push_back(std::move(op));
+		ops.push_back(op);
 	}
 
 	template<typename C>
@@ -618,7 +552,7 @@ namespace OpenVic::ecs {
 		Op op;
 		op.kind = OpKind::RemoveComponent;
 		op.eid = id;
-		op.remove_id = component_type_id_of<TC>();
-		ops.push_back(std::move(op));
+		op.component_id = component_type_id_of<TC>();
+		ops.push_back(op);
 	}
 }
@@ -5,8 +5,114 @@
 
 using namespace OpenVic::ecs;
 
+namespace {
+	// Identifies the pool (and worker slot) the current thread belongs to, so a dispatch
+	// issued from inside a body goes to that worker's own deque and the worker helps
+	// instead of parking. A worker of one pool submitting to another counts as external.
+	thread_local void const* tl_pool = nullptr;
+	thread_local uint32_t tl_worker_id = 0;
+
+	// Failed find_work rounds a worker spins through before going to sleep. Short — a
+	// tick's stages arrive back to back, but an idle pool must not burn cores for long.
+	constexpr uint32_t IDLE_SPIN_ROUNDS = 64;
+
+	constexpr std::size_t INITIAL_DEQUE_CAPACITY = 64;
+}
+
+EcsThreadPool::WorkDeque::Buffer::Buffer(std::size_t capacity)
+	: mask { capacity - 1 }, slots { std::make_unique<Slot[]>(capacity) } {}
+
+void EcsThreadPool::WorkDeque::Buffer::put(int64_t i, Range const& range) {
+	Slot& slot = slots[static_cast<std::size_t>(i) & mask];
+	slot.dispatch.store(range.dispatch, std::memory_order_relaxed);
+	slot.begin.store(range.begin, std::memory_order_relaxed);
+	slot.end.store(range.end, std::memory_order_relaxed);
+}
+
+EcsThreadPool::Range EcsThreadPool::WorkDeque::Buffer::get(int64_t i) const {
+	Slot const& slot = slots[static_cast<std::size_t>(i) & mask];
+	return Range {
+		slot.dispatch.load(std::memory_order_relaxed),
+		slot.begin.load(std::memory_order_relaxed),
+		slot.end.load(std::memory_order_relaxed)
+	};
+}
+
+EcsThreadPool::WorkDeque::WorkDeque() {
+	buffers_.push_back(std::make_unique<Buffer>(INITIAL_DEQUE_CAPACITY));
+	buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+}
+
+void EcsThreadPool::WorkDeque::push(Range const& range) {
+	int64_t const b = bottom_.load(std::memory_order_relaxed);
+	int64_t const t = top_.load(std::memory_order_acquire);
+	Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+	if (b - t > static_cast<int64_t>(buffer->capacity()) - 1) {
+		// Full — double into a fresh buffer. The old one stays alive in buffers_ because
+		// a thief that loaded it before the swap may still read a slot from it.
+		std::unique_ptr<Buffer> grown = std::make_unique<Buffer>(buffer->capacity() * 2);
+		for (int64_t i = t; i < b; ++i) {
+			grown->put(i, buffer->get(i));
+		}
+		buffer = grown.get();
+		buffers_.push_back(std::move(grown));
+		buffer_.store(buffer, std::memory_order_release);
+	}
+	buffer->put(b, range);
+	bottom_.store(b + 1, std::memory_order_release);
+}
+
+bool EcsThreadPool::WorkDeque::pop(Range& out) {
+	int64_t const b = bottom_.load(std::memory_order_relaxed) - 1;
+	Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+	bottom_.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = top_.load(std::memory_order_relaxed);
+	if (t > b) {
+		// Empty.
+		bottom_.store(b + 1, std::memory_order_relaxed);
+		return false;
+	}
+	out = buffer->get(b);
+	if (t == b) {
+		// Last element — race any thief for it.
+		bool const won = top_.compare_exchange_strong(
+			t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+		);
+		bottom_.store(b + 1, std::memory_order_relaxed);
+		return won;
+	}
+	return true;
+}
+
+bool EcsThreadPool::WorkDeque::steal(Range& out) {
+	for (;;) {
+		int64_t t = top_.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t const b = bottom_.load(std::memory_order_acquire);
+		if (t >= b) {
+			return false;
+		}
+		Range const range = buffer_.load(std::memory_order_acquire)->get(t);
+		if (top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			out = range;
+			return true;
+		}
+		// Lost to the owner or another thief; the deque may still hold more — retry.
+	}
+}
+
+bool EcsThreadPool::WorkDeque::empty() const {
+	return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+}
+
 EcsThreadPool::EcsThreadPool(uint32_t worker_count) {
 	uint32_t const n = std::max<uint32_t>(1u, worker_count);
+	// Every deque exists before any worker starts — workers steal from each other's.
+	deques_.reserve(n);
+	for (uint32_t i = 0; i < n; ++i) {
+		deques_.push_back(std::make_unique<WorkDeque>());
+	}
 	workers_.reserve(n);
 	for (uint32_t i = 0; i < n; ++i) {
 		workers_.emplace_back([this, i]() { worker_loop(i); });
@@ -14,11 +120,8 @@ EcsThreadPool::EcsThreadPool(uint32_t worker_count) {
 }
 
 EcsThreadPool::~EcsThreadPool() {
-	{
-		std::lock_guard<std::mutex> lock(queue_mutex_);
-		stop_ = true;
-	}
-	cv_.notify_all();
+	stop_.store(true, std::memory_order_seq_cst);
+	wake_workers(/*all=*/true);
 	for (std::thread& t : workers_) {
 		if (t.joinable()) {
 			t.join();
@@ -26,79 +129,227 @@ EcsThreadPool::~EcsThreadPool() {
 	}
 }
 
+void EcsThreadPool::wake_workers(bool all) {
+	// Paired with the epoch-load → sleepers_ increment → find_work → wait sequence in
+	// worker_loop: either the sleeper's epoch load already sees this bump (and its
+	// find_work sees the pushed range), or its wait compares against a stale epoch and
+	// returns at once, or it registered in sleepers_ before we read it and gets notified.
+	wake_epoch_.fetch_add(1, std::memory_order_seq_cst);
+	if (sleepers_.load(std::memory_order_seq_cst) != 0) {
+		if (all) {
+			wake_epoch_.notify_all();
+		} else {
+			wake_epoch_.notify_one();
+		}
+	}
+}
+
+bool EcsThreadPool::find_work(uint32_t worker_id, Range& out) {
+	if (deques_[worker_id]->pop(out)) {
+		return true;
+	}
+	if (inject_size_.load(std::memory_order_seq_cst) != 0) {
+		std::lock_guard<std::mutex> lock(inject_mutex_);
+		if (!inject_.empty()) {
+			out = inject_.back();
+			inject_.pop_back();
+			inject_size_.store(inject_.size(), std::memory_order_seq_cst);
+			return true;
+		}
+	}
+	std::size_t const n = deques_.size();
+	for (std::size_t k = 1; k < n; ++k) {
+		if (deques_[(worker_id + k) % n]->steal(out)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void EcsThreadPool::execute(Range range, uint32_t worker_id) {
+	Dispatch& dispatch = *range.dispatch;
+	WorkDeque& own = *deques_[worker_id];
+	std::size_t begin = range.begin;
+	std::size_t end = range.end;
+	std::size_t ran = 0;
+	while (begin < end) {
+		// Lazy binary splitting: only offer work when nothing of ours is already up for
+		// grabs. Uncontended, a range of n indices costs ~log2(n) deque pushes; when
+		// thieves keep emptying the deque it degrades gracefully towards per-index steals.
+		if (end - begin > 1 && own.empty()) {
+			std::size_t const mid = begin + (end - begin + 1) / 2;
+			own.push(Range { &dispatch, mid, end });
+			end = mid;
+			wake_workers(/*all=*/false);
+		}
+		bool const release = dispatch.invoke(dispatch.ctx, begin, worker_id);
+		if (release && dispatch.graph != nullptr) {
+			// Graph ranges are single tasks. Count each newly ready successor into
+			// `remaining` BEFORE publishing it, so a thief finishing it cannot drive the
+			// counter to zero while this task is still accounted for.
+			TaskGraph const& graph = *dispatch.graph;
+			for (uint32_t i = graph.successor_offsets[begin]; i < graph.successor_offsets[begin + 1]; ++i) {
+				uint32_t const successor = graph.successors[i];
+				if (dispatch.pending_predecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					dispatch.remaining.fetch_add(1, std::memory_order_relaxed);
+					own.push(Range { &dispatch, successor, successor + 1 });
+					wake_workers(/*all=*/false);
+				}
+			}
+		}
+		++begin;
+		++ran;
+	}
+	if (dispatch.remaining.fetch_sub(ran, std::memory_order_acq_rel) == ran) {
+		dispatch.remaining.notify_all();
+		// Last touch of the dispatch — the waiter may destroy it as soon as this lands.
+		dispatch.released.store(true, std::memory_order_release);
+	}
+}
+
 void EcsThreadPool::worker_loop(uint32_t worker_id) {
+	tl_pool = this;
+	tl_worker_id = worker_id;
+
+	Range range;
 	for (;;) {
-		Job job;
-		bool have_job = false;
-		{
-			std::unique_lock<std::mutex> lock(queue_mutex_);
-			cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
-			if (stop_ && queue_.empty()) {
-				return;
-			}
-			if (!queue_.empty()) {
-				job = std::move(queue_.back());
-				queue_.pop_back();
-				have_job = true;
+		bool found = false;
+		for (uint32_t spin = 0; spin < IDLE_SPIN_ROUNDS && !found; ++spin) {
+			found = find_work(worker_id, range);
+			if (!found) {
+				std::this_thread::yield();
 			}
 		}
-		if (!have_job) {
+		if (found) {
+			execute(range, worker_id);
 			continue;
 		}
 
-		if (job.parallel_body != nullptr) {
-			(*job.parallel_body)(job.chunk_idx, worker_id);
-		} else if (job.concurrent_body) {
-			job.concurrent_body();
+		// Sleep protocol — see wake_workers for the other half.
+		uint32_t const epoch = wake_epoch_.load(std::memory_order_seq_cst);
+		sleepers_.fetch_add(1, std::memory_order_seq_cst);
+		if (stop_.load(std::memory_order_seq_cst)) {
+			sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+			return;
+		}
+		if (find_work(worker_id, range)) {
+			sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+			execute(range, worker_id);
+			continue;
 		}
+		wake_epoch_.wait(epoch, std::memory_order_seq_cst);
+		sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+	}
+}
 
-		// Decrement the dispatch's own DoneState under its mutex so the caller's
-		// predicate (evaluated under the same mutex inside cv.wait) cannot observe
-		// count == 0 until the decrement-and-notify sequence has completed — that
-		// is what allows the caller's DoneState to live on the caller's stack
-		// without lifetime races.
-		DoneState* const done = job.done;
-		std::lock_guard<std::mutex> lock(done->mutex);
-		--done->count;
-		if (done->count == 0) {
-			done->cv.notify_all();
+void EcsThreadPool::submit(Dispatch& dispatch, std::size_t count) {
+	// One range per worker up front so every worker can start without first stealing;
+	// execute() splits further on demand.
+	std::size_t const pieces = std::min(count, workers_.size());
+	if (tl_pool == this) {
+		WorkDeque& own = *deques_[tl_worker_id];
+		for (std::size_t p = pieces; p-- > 0;) {
+			own.push(Range { &dispatch, count * p / pieces, count * (p + 1) / pieces });
+		}
+	} else {
+		std::lock_guard<std::mutex> lock(inject_mutex_);
+		for (std::size_t p = pieces; p-- > 0;) {
+			inject_.push_back(Range { &dispatch, count * p / pieces, count * (p + 1) / pieces });
 		}
+		inject_size_.store(inject_.size(), std::memory_order_seq_cst);
 	}
+	wake_workers(/*all=*/true);
 }
 
-void EcsThreadPool::run_parallel_for_impl(std::size_t chunk_count, ParallelForBody body) {
-	// Per-call DoneState — separate counter+CV for each dispatch lets a System
-	// dispatched via run_concurrent itself call parallel_for without trampling the
-	// outer dispatch's accounting. Lives on this stack frame; workers hold its
-	// mutex while decrementing so we cannot return (and destroy it) until the
-	// last worker has fully released the mutex.
-	DoneState done;
-	done.count = chunk_count;
+void EcsThreadPool::submit_tasks(Dispatch& dispatch, std::span<uint32_t const> tasks) {
+	if (tl_pool == this) {
+		WorkDeque& own = *deques_[tl_worker_id];
+		for (uint32_t task : tasks) {
+			own.push(Range { &dispatch, task, task + 1u });
+		}
+	} else {
+		std::lock_guard<std::mutex> lock(inject_mutex_);
+		for (uint32_t task : tasks) {
+			inject_.push_back(Range { &dispatch, task, task + 1u });
+		}
+		inject_size_.store(inject_.size(), std::memory_order_seq_cst);
+	}
+	wake_workers(/*all=*/true);
+}
 
-	// Push every chunk index as a separate Job into the queue. The `body` lives on the
-	// caller's stack for the duration of this call; jobs hold a non-owning pointer to it.
-	{
-		std::lock_guard<std::mutex> lock(queue_mutex_);
-		queue_.reserve(queue_.size() + chunk_count);
-		for (std::size_t i = 0; i < chunk_count; ++i) {
-			Job j;
-			j.parallel_body = &body;
-			j.chunk_idx = i;
-			j.done = &done;
-			queue_.push_back(std::move(j));
+void EcsThreadPool::wait(Dispatch& dispatch) {
+	if (tl_pool == this) {
+		// Nested dispatch — keep this worker productive. It pops its own deque first, so
+		// it usually ends up running most of the ranges it just submitted.
+		uint32_t const worker_id = tl_worker_id;
+		Range range;
+		uint32_t idle = 0;
+		while (dispatch.remaining.load(std::memory_order_acquire) != 0 && idle < IDLE_SPIN_ROUNDS) {
+			if (find_work(worker_id, range)) {
+				execute(range, worker_id);
+				idle = 0;
+			} else {
+				++idle;
+				std::this_thread::yield();
+			}
 		}
 	}
-	cv_.notify_all();
+	for (std::size_t remaining = dispatch.remaining.load(std::memory_order_acquire); remaining != 0;
+		remaining = dispatch.remaining.load(std::memory_order_acquire)) {
+		dispatch.remaining.wait(remaining, std::memory_order_acquire);
+	}
+	// The finishing worker may still be inside notify_all — wait for its release store.
+	while (!dispatch.released.load(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
+}
+
+void EcsThreadPool::run_dispatch(Dispatch& dispatch, std::size_t count) {
+	dispatch.remaining.store(count, std::memory_order_relaxed);
+	submit(dispatch, count);
+	wait(dispatch);
+}
+
+void EcsThreadPool::run_graph_dispatch(Dispatch& dispatch, TaskGraph const& graph) {
+	std::size_t const task_count = graph.task_count();
+	if (task_count == 0) {
+		return;
+	}
+	std::unique_ptr<std::atomic<uint32_t>[]> pending = std::make_unique<std::atomic<uint32_t>[]>(task_count);
+	std::vector<uint32_t> ready;
+	for (std::size_t t = 0; t < task_count; ++t) {
+		pending[t].store(graph.predecessor_counts[t], std::memory_order_relaxed);
+		if (graph.predecessor_counts[t] == 0) {
+			ready.push_back(static_cast<uint32_t>(t));
+		}
+	}
+	if (ready.empty()) {
+		return;
+	}
 
-	// Wait until every job has decremented its way down to zero. Predicate is
-	// evaluated under done.mutex (cv.wait acquires it), serialising with the
-	// worker_loop decrement-under-lock above.
-	{
-		std::unique_lock<std::mutex> lock(done.mutex);
-		done.cv.wait(lock, [&done]() {
-			return done.count == 0;
-		});
+	if (workers_.size() <= 1) {
+		// Single-thread fall-through, same observable behaviour: a worklist on the caller.
+		while (!ready.empty()) {
+			uint32_t const task = ready.back();
+			ready.pop_back();
+			if (!dispatch.invoke(dispatch.ctx, task, /*worker_id=*/0u)) {
+				continue;
+			}
+			for (uint32_t i = graph.successor_offsets[task]; i < graph.successor_offsets[task + 1]; ++i) {
+				uint32_t const successor = graph.successors[i];
+				if (pending[successor].fetch_sub(1, std::memory_order_relaxed) == 1) {
+					ready.push_back(successor);
+				}
+			}
+		}
+		return;
 	}
+
+	dispatch.graph = &graph;
+	dispatch.pending_predecessors = pending.get();
+	dispatch.remaining.store(ready.size(), std::memory_order_relaxed);
+	submit_tasks(dispatch, ready);
+	wait(dispatch);
 }
 
 void EcsThreadPool::run_concurrent(std::span<std::function<void()> const> bodies) {
@@ -111,24 +362,13 @@ void EcsThreadPool::run_concurrent(std::span<std::function<void()> const> bodies
 		}
 		return;
 	}
-	DoneState done;
-	done.count = bodies.size();
-
-	{
-		std::lock_guard<std::mutex> lock(queue_mutex_);
-		queue_.reserve(queue_.size() + bodies.size());
-		for (auto const& fn : bodies) {
-			Job j;
-			j.concurrent_body = fn; // copy
-			j.done = &done;
-			queue_.push_back(std::move(j));
-		}
-	}
-	cv_.notify_all();
-	{
-		std::unique_lock<std::mutex> lock(done.mutex);
-		done.cv.wait(lock, [&done]() {
-			return done.count == 0;
-		});
-	}
+	// Bodies are borrowed, not copied — the span outlives the blocking call.
+	Dispatch dispatch {
+		[](void const* ctx, std::size_t idx, uint32_t /*worker_id*/) -> bool {
+			(*static_cast<std::span<std::function<void()> const> const*>(ctx))[idx]();
+			return true;
+		},
+		static_cast<void const*>(&bodies)
+	};
+	run_dispatch(dispatch, bodies.size());
 }
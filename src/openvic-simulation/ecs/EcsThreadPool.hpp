@@ -1,13 +1,14 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <span>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace OpenVic::ecs {
@@ -20,10 +21,21 @@ namespace OpenVic::ecs {
 	// for determinism — per-chunk CommandBuffers are keyed by chunk_idx, not worker_id —
 	// but it is exposed for diagnostic or thread-local-scratch uses.
 	//
+	// Scheduling: every worker owns a Chase-Lev work-stealing deque of index ranges. A
+	// dispatch submits a handful of [begin, end) ranges (not one job per chunk); whoever
+	// runs a range peels indices off its front and, while its own deque is empty, pushes
+	// the back half of the remainder so idle workers can steal it. The owner pushes/pops
+	// the bottom of its deque without locks; thieves CAS the top. Completion is an atomic
+	// per-dispatch counter the caller waits on with std::atomic::wait (a futex on Linux).
+	//
 	// Hard invariants:
 	//   * `parallel_for` is blocking — does not return until every chunk's body has run.
 	//   * `run_concurrent` is blocking — does not return until every supplied function
 	//     has completed.
+	//   * `run_graph` is blocking — does not return until no task is running or ready.
+	//   * Any of them may be called from inside a body running on this pool. The calling
+	//     worker keeps executing queued ranges while it waits, so nesting never parks a
+	//     worker on work nobody else will pick up.
 	//   * No work is ever silently dropped; bodies that throw will std::terminate (we do
 	//     not guarantee exception-safety from inside system bodies — they should be noexcept).
 	class EcsThreadPool {
@@ -42,8 +54,22 @@ namespace OpenVic::ecs {
 			return static_cast<uint32_t>(workers_.size());
 		}
 
+		// Directed acyclic task graph in CSR form, borrowed for one `run_graph` call.
+		// Task t becomes ready once `predecessor_counts[t]` of its predecessors have
+		// released it; its successors are `successors[successor_offsets[t] ..
+		// successor_offsets[t + 1])`. successor_offsets.size() == task_count + 1.
+		struct TaskGraph {
+			std::span<uint32_t const> predecessor_counts;
+			std::span<uint32_t const> successor_offsets;
+			std::span<uint32_t const> successors;
+
+			std::size_t task_count() const noexcept {
+				return predecessor_counts.size();
+			}
+		};
+
 		// Run body(chunk_idx, worker_id) for every chunk_idx in [0, chunk_count). Blocking.
-		// The internal scheduling strategy (work-queue, modulo, stealing) is opaque and
+		// The internal scheduling strategy (range splitting, stealing) is opaque and
 		// deliberately not exposed — the only externally observable property is "every
 		// chunk's body runs exactly once and parallel_for does not return early".
 		template<typename Body>
@@ -53,61 +79,153 @@ namespace OpenVic::ecs {
 			}
 			if (workers_.size() <= 1 || chunk_count == 1) {
 				// Fast path: single-thread fall-through. Same observable behaviour as the
-				// parallel path; saves the queue/cv overhead in degenerate cases.
+				// parallel path; saves the submit/wait overhead in degenerate cases.
 				for (std::size_t i = 0; i < chunk_count; ++i) {
 					body(i, /*worker_id=*/0u);
 				}
 				return;
 			}
-			run_parallel_for_impl(chunk_count, [&body](std::size_t chunk_idx, uint32_t worker_id) {
-				body(chunk_idx, worker_id);
-			});
+			using BodyT = std::remove_reference_t<Body>;
+			Dispatch dispatch {
+				[](void const* ctx, std::size_t chunk_idx, uint32_t worker_id) -> bool {
+					(*static_cast<BodyT*>(const_cast<void*>(ctx)))(chunk_idx, worker_id);
+					return true;
+				},
+				static_cast<void const*>(&body)
+			};
+			run_dispatch(dispatch, chunk_count);
 		}
 
 		// Run each supplied function exactly once across the pool — used for inter-system
 		// parallelism within a scheduler stage. Blocking.
 		void run_concurrent(std::span<std::function<void()> const> bodies);
 
+		// Run body(task, worker_id) for every task of `graph` as soon as all its predecessors
+		// have finished, tracked with one atomic counter per task — no barrier between
+		// "levels". The body returns true to release its successors; returning false holds
+		// them (and everything downstream) back, which lets the caller do serial work such as
+		// a structural apply before resuming them in a later call. Returns once no task is
+		// running or ready; tasks never released are simply not run. Blocking.
+		template<typename Body>
+		void run_graph(TaskGraph const& graph, Body&& body) {
+			using BodyT = std::remove_reference_t<Body>;
+			Dispatch dispatch {
+				[](void const* ctx, std::size_t task, uint32_t worker_id) -> bool {
+					return (*static_cast<BodyT*>(const_cast<void*>(ctx)))(task, worker_id);
+				},
+				static_cast<void const*>(&body)
+			};
+			run_graph_dispatch(dispatch, graph);
+		}
+
 	private:
-		// Type-erased body for parallel_for. Templated wrapper above forwards to this.
-		using ParallelForBody = std::function<void(std::size_t /*chunk_idx*/, uint32_t /*worker_id*/)>;
-
-		// Per-call completion tracker. Stored on the caller's stack inside parallel_for /
-		// run_concurrent and pointed-to by every Job that dispatch submits. Workers
-		// decrement the *job's* DoneState — not a shared pool counter — so a System
-		// dispatched via run_concurrent can itself call parallel_for without the inner
-		// dispatch corrupting the outer dispatch's accounting (pre-fix, both used a
-		// single pool-wide `remaining_` atomic, which caused spurious wakeups and
-		// SIZE_MAX underflow when a `SystemThreaded` shared a stage with another System).
-		// Lifetime is enforced by the worker taking `done->mutex` while decrementing
-		// `done->count` — the caller's `done.cv.wait` predicate is also evaluated under
-		// the same mutex, so the caller can't return (and destroy the DoneState) until
-		// the decrement-and-notify sequence has completed.
-		struct DoneState {
-			std::mutex mutex;
-			std::condition_variable cv;
-			std::size_t count = 0; // Always touched while holding `mutex`.
+		// Per-call dispatch state. Lives on the caller's stack for the duration of
+		// parallel_for / run_concurrent / run_graph and is pointed-to by every Range that
+		// dispatch submits, so nested dispatches (a run_concurrent body calling
+		// parallel_for) each keep their own accounting.
+		//
+		// `remaining` counts indices (for run_graph: ready tasks) not yet executed. The
+		// worker that drops it to zero notifies the waiter and only THEN sets `released`;
+		// the waiter returns (and the Dispatch dies) only once it observes `released`, so
+		// the final notify never touches a dead stack frame.
+		struct Dispatch {
+			// Returns whether a graph task releases its successors; ignored otherwise.
+			bool (*invoke)(void const* ctx, std::size_t chunk_idx, uint32_t worker_id);
+			void const* ctx;
+			// run_graph only: the graph and its per-task outstanding-predecessor counters.
+			// Null for index-space dispatches.
+			TaskGraph const* graph = nullptr;
+			std::atomic<uint32_t>* pending_predecessors = nullptr;
+			std::atomic<std::size_t> remaining { 0 };
+			std::atomic<bool> released { false };
+		};
+
+		// Unit of stealable work: indices [begin, end) of one dispatch.
+		struct Range {
+			Dispatch* dispatch = nullptr;
+			std::size_t begin = 0;
+			std::size_t end = 0;
 		};
 
-		void run_parallel_for_impl(std::size_t chunk_count, ParallelForBody body);
+		// Chase-Lev deque (Lê, Pop, Cohen & Zappa Nardelli, "Correct and Efficient
+		// Work-Stealing for Weak Memory Models", PPoPP 2013). push/pop are owner-only;
+		// steal may be called from any thread. Slots are relaxed atomics so a thief's read
+		// racing an owner's overwrite is well-defined — the thief's CAS on `top_` then
+		// fails and the torn value is discarded. Grown buffers are retired, not freed,
+		// until the deque dies since a thief may still be reading the old one.
+		class WorkDeque {
+		public:
+			WorkDeque();
+
+			void push(Range const& range);
+			bool pop(Range& out);
+			bool steal(Range& out);
+			bool empty() const;
+
+		private:
+			struct Slot {
+				std::atomic<Dispatch*> dispatch { nullptr };
+				std::atomic<std::size_t> begin { 0 };
+				std::atomic<std::size_t> end { 0 };
+			};
+
+			struct Buffer {
+				std::size_t mask;
+				std::unique_ptr<Slot[]> slots;
+
+				explicit Buffer(std::size_t capacity);
+
+				std::size_t capacity() const {
+					return mask + 1;
+				}
+				void put(int64_t i, Range const& range);
+				Range get(int64_t i) const;
+			};
+
+			// Padded apart so thieves hammering `top_` don't bounce the owner's `bottom_`.
+			alignas(64) std::atomic<int64_t> top_ { 0 };
+			alignas(64) std::atomic<int64_t> bottom_ { 0 };
+			std::atomic<Buffer*> buffer_ { nullptr };
+			std::vector<std::unique_ptr<Buffer>> buffers_; // owner-only; back() is current
+		};
+
+		void run_dispatch(Dispatch& dispatch, std::size_t count);
+		void run_graph_dispatch(Dispatch& dispatch, TaskGraph const& graph);
+
+		// Push single-task ranges for every entry of `tasks`, same placement rule as submit.
+		void submit_tasks(Dispatch& dispatch, std::span<uint32_t const> tasks);
+
+		// Push `count` indices of `dispatch` as up to worker_count ranges — onto the calling
+		// worker's own deque when called from inside the pool, else onto the inject queue.
+		void submit(Dispatch& dispatch, std::size_t count);
+
+		// Block until `dispatch.remaining` hits zero. A worker caller keeps draining work
+		// while it waits; an external caller sleeps on the counter.
+		void wait(Dispatch& dispatch);
+
+		// Run one range on `worker_id`, splitting off the back half whenever the worker's
+		// deque is empty so idle workers have something to steal. For a graph dispatch the
+		// range is one task; successors it releases are pushed onto the worker's deque.
+		void execute(Range range, uint32_t worker_id);
+
+		bool find_work(uint32_t worker_id, Range& out);
+		void wake_workers(bool all);
 
 		void worker_loop(uint32_t worker_id);
 
+		std::vector<std::unique_ptr<WorkDeque>> deques_; // one per worker, indexed by worker_id
 		std::vector<std::thread> workers_;
 
-		// Work item: either a parallel_for slice or a run_concurrent function.
-		struct Job {
-			// For parallel_for: pointer-back to the shared body + the chunk_idx assigned
-			// to this job. For run_concurrent: a one-shot function to invoke; chunk_idx is 0.
-			ParallelForBody const* parallel_body = nullptr; // borrowed; lives on caller stack
-			std::function<void()> concurrent_body; // owned
-			std::size_t chunk_idx = 0;
-			DoneState* done = nullptr; // borrowed; lives on caller stack until count hits 0
-		};
+		// Ranges submitted from threads outside the pool. Locked once per dispatch (not per
+		// chunk); `inject_size_` lets workers skip the lock when it is empty.
+		std::mutex inject_mutex_;
+		std::vector<Range> inject_;
+		std::atomic<std::size_t> inject_size_ { 0 };
 
-		std::mutex queue_mutex_;
-		std::condition_variable cv_;
-		std::vector<Job> queue_; // FIFO; back-popped under queue_mutex_
-		bool stop_ = false;
+		// Idle workers sleep on `wake_epoch_`; submitters bump it and notify only while
+		// `sleepers_` is non-zero, so a busy pool never enters the kernel to hand off work.
+		std::atomic<uint32_t> wake_epoch_ { 0 };
+		std::atomic<uint32_t> sleepers_ { 0 };
+		std::atomic<bool> stop_ { false };
 	};
 }
@@ -27,14 +27,39 @@ namespace OpenVic::ecs {
 	// That shared-builder discipline is load-bearing: if the prewarmed key and the dispatch key ever
 	// disagreed, a worker thread would mutate the World's `mutable` query_cache concurrently.
 	//
+	// `Changed<C>` / `Added<C>` are change-detection filters. They work at CHUNK granularity: a
+	// dispatch skips every chunk in which column C has not been written (Changed) or no row has
+	// entered (Added) since this system's previous run, using the per-chunk change ticks on
+	// DataChunk and the last_run_tick / this_run_tick pair the scheduler keeps per system. A
+	// chunk that passes is iterated in full — rows in it that did not change are visited too, so
+	// tick bodies must stay correct when re-run on unchanged rows. Several change filters must
+	// all pass. Each implies the archetype carries C (C joins the require set) and a read of C
+	// (C joins the access set), so the scheduler orders the system against every writer of C;
+	// without that edge, whether a co-staged write landed before the check would depend on
+	// thread timing.
+	//
+	// "Written" is conservative: a system taking C mutably (`C&` in its tick, non-const in a
+	// ChunkSystem list) marks every chunk it visits, whether or not any row changed; a system
+	// declaring C in extra_writes() marks every chunk carrying C; outside a tick every mutable
+	// World access to C marks its chunk. A system never sees its own writes as changes. "Entered"
+	// covers creation and migration by add_component / remove_component (not only rows whose C
+	// is new), and a row moved by a swap-pop carries its stamp along.
+	//
 	// The shape is intentionally extensible — a future `With<C>` (presence-only require) or
-	// `Optional<C>` (nullable data) marker can join `Filter<...>` without changing this surface — but
-	// only `Without<C>` is wired today.
+	// `Optional<C>` (nullable data) marker can join `Filter<...>` without changing this surface.
 
 	// Exclusion marker: archetypes containing C are not iterated.
 	template<typename C>
 	struct Without {};
 
+	// Change marker: only chunks whose C column was written since the system last ran.
+	template<typename C>
+	struct Changed {};
+
+	// Addition marker: only chunks that rows carrying C entered since the system last ran.
+	template<typename C>
+	struct Added {};
+
 	// True iff F is a Without<...> marker.
 	template<typename F>
 	struct is_without : std::false_type {};
@@ -51,19 +76,68 @@ namespace OpenVic::ecs {
 		}
 	};
 
-	// A system's filter set. Currently only Without<C> entries are supported; the static_assert
+	// True iff F is a Changed<...> / Added<...> marker.
+	template<typename F>
+	struct is_changed : std::false_type {};
+	template<typename C>
+	struct is_changed<Changed<C>> : std::true_type {};
+
+	template<typename F>
+	struct is_added : std::false_type {};
+	template<typename C>
+	struct is_added<Added<C>> : std::true_type {};
+
+	// Maps a Without / Changed / Added marker to the component it names.
+	template<typename F>
+	struct filter_component;
+	template<template<typename> typename Marker, typename C>
+	struct filter_component<Marker<C>> {
+		using type = C;
+	};
+
+	// A system's filter set of Without<C>, Changed<C> and Added<C> entries; the static_assert
 	// turns any other marker into a clear compile error rather than a silent no-op.
 	template<typename... Fs>
 	struct Filter {
 		static_assert(
-			(is_without<Fs>::value && ...),
-			"ecs::Filter currently supports only ecs::Without<C> entries."
+			((is_without<Fs>::value || is_changed<Fs>::value || is_added<Fs>::value) && ...),
+			"ecs::Filter supports only ecs::Without<C>, ecs::Changed<C> and ecs::Added<C> entries."
 		);
 
 		// Sorted-unique exclude ids. Runtime (not constexpr) to mirror
 		// System<>::compute_tick_query_require_ids — both feed Query::*_ids vectors.
 		static std::vector<component_type_id_t> exclude_ids() {
-			std::vector<component_type_id_t> ids = { without_id<Fs>::value()... };
+			return ids_where<is_without>();
+		}
+
+		// Sorted-unique ids of the Changed<C> entries.
+		static std::vector<component_type_id_t> changed_ids() {
+			return ids_where<is_changed>();
+		}
+
+		// Sorted-unique ids of the Added<C> entries.
+		static std::vector<component_type_id_t> added_ids() {
+			return ids_where<is_added>();
+		}
+
+		// Sorted-unique ids every matched archetype must carry because a change filter names
+		// them — folded into the system's require set and, as reads, into its access set.
+		static std::vector<component_type_id_t> require_ids() {
+			std::vector<component_type_id_t> ids = changed_ids();
+			std::vector<component_type_id_t> const added = added_ids();
+			ids.insert(ids.end(), added.begin(), added.end());
+			std::sort(ids.begin(), ids.end());
+			ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+			return ids;
+		}
+
+	private:
+		template<template<typename> typename Pred>
+		static std::vector<component_type_id_t> ids_where() {
+			std::vector<component_type_id_t> ids;
+			((Pred<Fs>::value
+				? ids.push_back(component_type_id_of<typename filter_component<Fs>::type>())
+				: void()), ...);
 			std::sort(ids.begin(), ids.end());
 			ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
 			return ids;
@@ -37,10 +37,17 @@ namespace OpenVic::ecs {
 	// CommandBuffer for deferred structural mutations. For SystemThreaded, the `cmd`
 	// reference points at the per-chunk CommandBuffer the driver allocates for the row's
 	// chunk.
+	//
+	// `last_run_tick` / `this_run_tick` are the system's change ticks (World::change_tick):
+	// the tick of its previous run (0 before the first) and of this one. The Changed<C> /
+	// Added<C> filters skip chunks stamped no later than last_run_tick, and the drivers stamp
+	// the chunks a run writes with this_run_tick. Both stay 0 outside the scheduler.
 	struct TickContext {
 		World& world;
 		Date today;
 		CommandBuffer& cmd;
+		uint64_t last_run_tick = 0;
+		uint64_t this_run_tick = 0;
 	};
 
 	// Stable handle returned by `register_system`. Generation is bumped on `unregister_system`
@@ -323,12 +330,18 @@ namespace OpenVic::ecs {
 		static constexpr std::array<component_type_id_t, 0> extra_writes() { return {}; }
 
 		// Sorted-unique component ids that define this system's iteration query — the tick
-		// parameter pack only, NOT extra_reads. Read by the scheduler at registration time
-		// and again per-tick to prewarm the World's query cache before a multi-system stage
-		// dispatches workers, so resolve_query_cache never has to mutate its hashmap from a
-		// worker thread.
+		// parameter pack plus any component named by a Changed<C> / Added<C> filter, NOT
+		// extra_reads. Read by the scheduler at registration time and again per-tick to
+		// prewarm the World's query cache before a multi-system stage dispatches workers, so
+		// resolve_query_cache never has to mutate its hashmap from a worker thread.
 		static std::vector<component_type_id_t> compute_tick_query_require_ids() {
-			return detail::require_ids_from_tuple<detail::component_pack_t<Derived>>::compute();
+			std::vector<component_type_id_t> ids
+				= detail::require_ids_from_tuple<detail::component_pack_t<Derived>>::compute();
+			std::vector<component_type_id_t> const filtered = system_filters_t<Derived>::require_ids();
+			ids.insert(ids.end(), filtered.begin(), filtered.end());
+			std::sort(ids.begin(), ids.end());
+			ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+			return ids;
 		}
 
 		// Sorted-unique component ids the iteration query EXCLUDES — archetypes carrying any of
@@ -363,10 +376,11 @@ namespace OpenVic::ecs {
 		void tick_all(World& world, TickContext const& ctx);
 
 		// Multi-system-stage entry points. The scheduler calls collect_chunks once on the
-		// main thread to enumerate matched chunks (in (arch_idx, chunk_idx) ascending order),
-		// then dispatches one work item per chunk via the outer parallel_for. Each work item
+		// main thread to enumerate matched chunks (in (arch_idx, chunk_idx) ascending order,
+		// minus those the system's change filters reject since `last_run_tick`), then
+		// dispatches one work item per chunk via the outer parallel_for. Each work item
 		// invokes tick_one_chunk with that chunk's per_chunk_cmds_ slot as TickContext::cmd.
-		static std::vector<ChunkLocation> collect_chunks(World& world);
+		static std::vector<ChunkLocation> collect_chunks(World& world, uint64_t last_run_tick);
 		static void tick_one_chunk(
 			Derived& self, World& world, TickContext const& ctx,
 			uint32_t archetype_idx, uint32_t chunk_idx
@@ -398,7 +412,7 @@ namespace OpenVic::ecs {
 		// Multi-system-stage entry points. Set only for SystemThreaded (is_threaded == true);
 		// null on plain System<>. The scheduler uses these to drive one outer parallel_for
 		// over a combined work-item list across every system in a multi-system stage.
-		std::vector<ChunkLocation> (*collect_chunks_fn)(World& world) = nullptr;
+		std::vector<ChunkLocation> (*collect_chunks_fn)(World& world, uint64_t last_run_tick) = nullptr;
 		void (*tick_one_chunk_fn)(
 			void* /*instance*/, World&, TickContext const&,
 			uint32_t /*archetype_idx*/, uint32_t /*chunk_idx*/
@@ -437,6 +451,13 @@ namespace OpenVic::ecs {
 		// mutate the World's mutable query_cache concurrently.
 		std::vector<component_type_id_t> tick_query_exclude_ids;
 
+		// Change ticks for the Changed<C> / Added<C> filters (see TickContext). The scheduler
+		// draws this_run_tick from World::advance_change_tick_ before the system runs and
+		// copies it into last_run_tick once the run is over; a system skipped by should_run
+		// keeps its last_run_tick, so its next run still sees everything since its last one.
+		uint64_t last_run_tick = 0;
+		uint64_t this_run_tick = 0;
+
 		// Pending command buffer for this system this tick. Drained by the scheduler at
 		// the stage barrier in the stage's deterministic emit order — ascending
 		// system_type_id_t across the stage, independent of registration order.
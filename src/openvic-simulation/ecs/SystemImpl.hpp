@@ -8,7 +8,9 @@
 // header rather than System.hpp directly, so that the templated `tick_all` methods on
 // the CRTP base can be instantiated correctly.
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -17,14 +19,16 @@
 #include "openvic-simulation/ecs/CommandBuffer.hpp"
 #include "openvic-simulation/ecs/EcsThreadPool.hpp"
 #include "openvic-simulation/ecs/EntityID.hpp"
+#include "openvic-simulation/ecs/QueryFilter.hpp"
+#include "openvic-simulation/ecs/SystemAccess.hpp"
 #include "openvic-simulation/ecs/System.hpp"
 #include "openvic-simulation/ecs/World.hpp"
 
 namespace OpenVic::ecs::detail {
 
 	// Builds the archetype-matching Query for Derived's tick: required ids from the tick parameter
-	// pack (System<>) / template list (ChunkSystem<>), exclude ids from the optional `Filters`
-	// alias. CRITICAL: this is the single source of the (require, exclude) pair. register_system
+	// pack (System<>) / template list (ChunkSystem<>) plus any Changed<C> / Added<C> component,
+	// exclude ids from the optional `Filters` alias. CRITICAL: this is the single source of the (require, exclude) pair. register_system
 	// stores the same two id-lists (from the same compute_tick_query_* statics), and the scheduler
 	// prewarms query_cache with them before a multi-system parallel stage. Every dispatch path MUST
 	// build its query here so the prewarmed key matches the key it later looks up — otherwise a
@@ -38,6 +42,77 @@ namespace OpenVic::ecs::detail {
 		return q;
 	}
 
+	// Change-detection ids of Derived, computed once per system type: its Changed<C> /
+	// Added<C> filter ids, and the components it holds mutably (Write entries of
+	// declared_access — the tick pack for System<>, the template list for ChunkSystem<>).
+	struct TickChangeIds {
+		std::vector<component_type_id_t> changed;
+		std::vector<component_type_id_t> added;
+		std::vector<component_type_id_t> written;
+	};
+
+	template<typename Derived>
+	TickChangeIds const& tick_change_ids() {
+		static TickChangeIds const ids = [] {
+			TickChangeIds out;
+			out.changed = system_filters_t<Derived>::changed_ids();
+			out.added = system_filters_t<Derived>::added_ids();
+			for (ComponentAccess const& access : Derived::declared_access()) {
+				if (access.mode == AccessMode::Write) {
+					out.written.push_back(access.component_id);
+				}
+			}
+			std::sort(out.written.begin(), out.written.end());
+			out.written.erase(std::unique(out.written.begin(), out.written.end()), out.written.end());
+			return out;
+		}();
+		return ids;
+	}
+
+	// Visits every chunk one dispatch of Derived covers: the non-empty chunks of the archetypes
+	// matched by build_tick_query<Derived>, in (archetype_idx, chunk_idx) ascending order —
+	// deterministic — minus the chunks its Changed<C> / Added<C> filters reject since
+	// `last_run_tick`. A rejected chunk costs one tick comparison per filter; its rows are never
+	// touched. Calls fn(archetype_idx, chunk_idx). Uses the query-cache key the scheduler
+	// prewarmed, so a worker-side call only reads the cache.
+	template<typename Derived, typename Fn>
+	void for_each_dispatch_chunk(World& world, uint64_t last_run_tick, Fn&& fn) {
+		Query const query = build_tick_query<Derived>();
+		TickChangeIds const& ids = tick_change_ids<Derived>();
+		bool const filtered = !ids.changed.empty() || !ids.added.empty();
+		QueryCacheKey key { query.require_ids, query.exclude_ids };
+		std::vector<uint32_t> const& matched
+			= world.resolve_query_cache_for_threaded(key).archetype_indices;
+
+		for (uint32_t arch_idx : matched) {
+			std::size_t const chunk_count = world.archetype_chunk_count(arch_idx);
+			for (std::size_t c = 0; c < chunk_count; ++c) {
+				if (world.archetype_chunk_row_count(arch_idx, c) == 0) {
+					continue;
+				}
+				if (filtered
+					&& !world.chunk_passes_change_filters(arch_idx, c, ids.changed, ids.added, last_run_tick)) {
+					continue;
+				}
+				fn(arch_idx, static_cast<uint32_t>(c));
+			}
+		}
+	}
+
+	// Stamps the columns Derived holds mutably in one visited chunk with the run's tick. A
+	// context without a scheduler-assigned tick (tick_all called directly) stamps the World's
+	// current one, like any other write outside a tick.
+	template<typename Derived>
+	void mark_dispatch_chunk_written(
+		World& world, TickContext const& ctx, uint32_t archetype_idx, uint32_t chunk_idx
+	) {
+		std::vector<component_type_id_t> const& written = tick_change_ids<Derived>().written;
+		if (!written.empty()) {
+			uint64_t const tick = ctx.this_run_tick != 0 ? ctx.this_run_tick : world.change_tick();
+			world.mark_chunk_written(archetype_idx, chunk_idx, written, tick);
+		}
+	}
+
 	// Tuple-unpacking helper for serial dispatch.
 	template<typename Derived, bool WithEntity, typename Tuple>
 	struct dispatch_serial_impl;
@@ -47,9 +122,14 @@ namespace OpenVic::ecs::detail {
 		static void run(Derived& self, World& world, TickContext const& ctx) {
 			static_assert(sizeof...(Cs) > 0,
 				"System::tick must have at least one component parameter after TickContext");
-			world.template for_each<std::remove_cvref_t<Cs>...>(build_tick_query<Derived>(),
-				[&self, &ctx](std::remove_cvref_t<Cs>&... cs) {
-					self.tick(ctx, cs...);
+			for_each_dispatch_chunk<Derived>(world, ctx.last_run_tick,
+				[&self, &world, &ctx](uint32_t archetype_idx, uint32_t chunk_idx) {
+					world.template iterate_one_chunk_for_threaded<std::remove_cvref_t<Cs>...>(
+						archetype_idx, chunk_idx,
+						[&self, &ctx](std::remove_cvref_t<Cs>&... cs) {
+							self.tick(ctx, cs...);
+						});
+					mark_dispatch_chunk_written<Derived>(world, ctx, archetype_idx, chunk_idx);
 				});
 		}
 	};
@@ -57,9 +137,14 @@ namespace OpenVic::ecs::detail {
 	template<typename Derived, typename... Cs>
 	struct dispatch_serial_impl<Derived, /*WithEntity=*/true, std::tuple<Cs...>> {
 		static void run(Derived& self, World& world, TickContext const& ctx) {
-			world.template for_each_with_entity<std::remove_cvref_t<Cs>...>(build_tick_query<Derived>(),
-				[&self, &ctx](EntityID eid, std::remove_cvref_t<Cs>&... cs) {
-					invoke_tick_with_entity(self, ctx, eid, cs...);
+			for_each_dispatch_chunk<Derived>(world, ctx.last_run_tick,
+				[&self, &world, &ctx](uint32_t archetype_idx, uint32_t chunk_idx) {
+					world.template iterate_one_chunk_with_entity_for_threaded<std::remove_cvref_t<Cs>...>(
+						archetype_idx, chunk_idx,
+						[&self, &ctx](EntityID eid, std::remove_cvref_t<Cs>&... cs) {
+							invoke_tick_with_entity(self, ctx, eid, cs...);
+						});
+					mark_dispatch_chunk_written<Derived>(world, ctx, archetype_idx, chunk_idx);
 				});
 		}
 	};
@@ -80,31 +165,23 @@ namespace OpenVic::ecs::detail {
 	struct dispatch_threaded_impl;
 
 	// Per-chunk-iteration helpers reach into World's internals for the chunk-by-chunk
-	// raw view; serial path uses `world.for_each<...>` which already does this internally.
-	// For the threaded path we need a flat list of (archetype_idx, chunk_idx) pairs so we
-	// can dispatch them across workers.
+	// raw view; the serial path walks for_each_dispatch_chunk directly. For the threaded
+	// path we need a flat list of (archetype_idx, chunk_idx) pairs so we can dispatch them
+	// across workers.
 	//
 	// `ChunkLocation` lives at namespace scope in System.hpp (so SystemRegistration's
 	// function-pointer signatures can name it) — this file just uses it.
 
-	// Collect all chunks matching `query`. Sorted by (archetype_idx ascending, chunk_idx ascending)
-	// — deterministic. The caller builds `query` via build_tick_query<Derived> so its cache key is
-	// the one the scheduler prewarmed; this both reuses that prewarmed entry and keeps the require +
-	// exclude sets identical between the main-thread collect and any worker-side dispatch.
-	inline std::vector<ChunkLocation> collect_matching_chunks(World& world, Query const& query) {
-		QueryCacheKey key { query.require_ids, query.exclude_ids };
-		std::vector<uint32_t> const& matched
-			= world.resolve_query_cache_for_threaded(key).archetype_indices;
-
+	// Collect the chunks one dispatch of Derived covers (for_each_dispatch_chunk) as a flat list.
+	// Sorted by (archetype_idx ascending, chunk_idx ascending) — deterministic. Chunks rejected by
+	// the change filters never become work items, so they cost neither a parallel_for slot nor a
+	// per-chunk CommandBuffer.
+	template<typename Derived>
+	std::vector<ChunkLocation> collect_matching_chunks(World& world, uint64_t last_run_tick) {
 		std::vector<ChunkLocation> out;
-		for (uint32_t arch_idx : matched) {
-			std::size_t const chunk_count = world.archetype_chunk_count(arch_idx);
-			for (std::size_t c = 0; c < chunk_count; ++c) {
-				if (world.archetype_chunk_row_count(arch_idx, c) > 0) {
-					out.push_back(ChunkLocation { arch_idx, static_cast<uint32_t>(c) });
-				}
-			}
-		}
+		for_each_dispatch_chunk<Derived>(world, last_run_tick, [&out](uint32_t archetype_idx, uint32_t chunk_idx) {
+			out.push_back(ChunkLocation { archetype_idx, chunk_idx });
+		});
 		return out;
 	}
 
@@ -116,7 +193,7 @@ namespace OpenVic::ecs::detail {
 			CommandBuffer& pending_cmd
 		) {
 			std::vector<ChunkLocation> const chunks
-				= collect_matching_chunks(world, build_tick_query<Derived>());
+				= collect_matching_chunks<Derived>(world, ctx_template.last_run_tick);
 			std::size_t const N = chunks.size();
 			if (N == 0) {
 				return;
@@ -134,12 +211,16 @@ namespace OpenVic::ecs::detail {
 			pool.parallel_for(N, [&](std::size_t chunk_idx, uint32_t /*worker_id*/) {
 				ChunkLocation const& loc = chunks[chunk_idx];
 				CommandBuffer& cmd = per_chunk_cmds[chunk_idx];
-				TickContext per_chunk { ctx_template.world, ctx_template.today, cmd };
+				TickContext per_chunk {
+					ctx_template.world, ctx_template.today, cmd,
+					ctx_template.last_run_tick, ctx_template.this_run_tick
+				};
 				world.template iterate_one_chunk_for_threaded<std::remove_cvref_t<Cs>...>(
 					loc.archetype_idx, loc.chunk_idx,
 					[&self, &per_chunk](std::remove_cvref_t<Cs>&... cs) {
 						self.tick(per_chunk, cs...);
 					});
+				mark_dispatch_chunk_written<Derived>(world, per_chunk, loc.archetype_idx, loc.chunk_idx);
 			});
 
 			// Merge in chunk_idx ascending order — deterministic regardless of worker_count.
@@ -158,7 +239,7 @@ namespace OpenVic::ecs::detail {
 			CommandBuffer& pending_cmd
 		) {
 			std::vector<ChunkLocation> const chunks
-				= collect_matching_chunks(world, build_tick_query<Derived>());
+				= collect_matching_chunks<Derived>(world, ctx_template.last_run_tick);
 			std::size_t const N = chunks.size();
 			if (N == 0) {
 				return;
@@ -175,13 +256,17 @@ namespace OpenVic::ecs::detail {
 			pool.parallel_for(N, [&](std::size_t chunk_idx, uint32_t /*worker_id*/) {
 				ChunkLocation const& loc = chunks[chunk_idx];
 				CommandBuffer& cmd = per_chunk_cmds[chunk_idx];
-				TickContext per_chunk { ctx_template.world, ctx_template.today, cmd };
+				TickContext per_chunk {
+					ctx_template.world, ctx_template.today, cmd,
+					ctx_template.last_run_tick, ctx_template.this_run_tick
+				};
 				world.template iterate_one_chunk_with_entity_for_threaded<
 					std::remove_cvref_t<Cs>...>(
 					loc.archetype_idx, loc.chunk_idx,
 					[&self, &per_chunk](EntityID eid, std::remove_cvref_t<Cs>&... cs) {
 						invoke_tick_with_entity(self, per_chunk, eid, cs...);
 					});
+				mark_dispatch_chunk_written<Derived>(world, per_chunk, loc.archetype_idx, loc.chunk_idx);
 			});
 
 			for (std::size_t i = 0; i < N; ++i) {
@@ -233,12 +318,12 @@ namespace OpenVic::ecs {
 	// These are invoked by SystemScheduler when this SystemThreaded shares a stage with
 	// one or more other systems. `collect_chunks` runs on the main thread before dispatch;
 	// `tick_one_chunk` is invoked per chunk by the outer parallel_for. The combined work-
-	// item list across every system in the stage prevents nested parallel_for (which would
-	// deadlock workers blocked in cv.wait while the inner jobs sit unowned in the queue).
+	// item list across every system in the stage avoids nested parallel_for, which would
+	// leave each outer work item's inner chunks to whichever worker happens to steal them.
 
 	template<typename Derived>
-	std::vector<ChunkLocation> SystemThreaded<Derived>::collect_chunks(World& world) {
-		return detail::collect_matching_chunks(world, detail::build_tick_query<Derived>());
+	std::vector<ChunkLocation> SystemThreaded<Derived>::collect_chunks(World& world, uint64_t last_run_tick) {
+		return detail::collect_matching_chunks<Derived>(world, last_run_tick);
 	}
 
 	template<typename Derived>
@@ -267,5 +352,6 @@ namespace OpenVic::ecs {
 				);
 			}
 		}(static_cast<Components*>(nullptr));
+		detail::mark_dispatch_chunk_written<Derived>(world, ctx, archetype_idx, chunk_idx);
 	}
 }
@@ -159,6 +159,11 @@ namespace {
 
 void SystemScheduler::rebuild(std::vector<SystemRegistration>& registry) {
 	std::size_t const N = registry.size();
+	emit_order_.clear();
+	predecessor_counts_.clear();
+	successor_offsets_.clear();
+	successors_.clear();
+
 	DAG dag;
 	dag.resize(N);
 
@@ -361,6 +366,29 @@ void SystemScheduler::rebuild(std::vector<SystemRegistration>& registry) {
 	}
 	schedule_hash_ = h;
 
+	// Phase 8: the same DAG in emit-position CSR form for dependency-mode execution.
+	// Edges come straight from the DAG (declared + auto-oriented conflicts), so a system
+	// waits on exactly the predecessors that forced it into a later stage.
+	emit_order_ = order;
+	std::vector<uint32_t> position_of(N, UINT32_MAX);
+	for (uint32_t pos = 0; pos < emit_order_.size(); ++pos) {
+		position_of[emit_order_[pos]] = pos;
+	}
+	predecessor_counts_.assign(emit_order_.size(), 0);
+	successor_offsets_.reserve(emit_order_.size() + 1);
+	successor_offsets_.push_back(0);
+	for (uint32_t reg_idx : emit_order_) {
+		std::size_t const first = successors_.size();
+		for (uint32_t v : dag.out_edges[reg_idx]) {
+			if (position_of[v] != UINT32_MAX) {
+				successors_.push_back(position_of[v]);
+				++predecessor_counts_[position_of[v]];
+			}
+		}
+		std::sort(successors_.begin() + first, successors_.end());
+		successor_offsets_.push_back(static_cast<uint32_t>(successors_.size()));
+	}
+
 	built_ = true;
 }
 
@@ -381,7 +409,7 @@ namespace {
 	// Work item descriptor for the multi-system-stage parallel branch. The scheduler
 	// builds a flat list mixing per-chunk SystemThreaded items and per-system plain
 	// System<> items, then dispatches via ONE outer parallel_for. No nested parallel_for
-	// (which would deadlock workers blocked in cv.wait while inner jobs sit unowned), no
+	// (one flat index space balances across workers better than ranges-within-ranges), no
 	// reliance on World::current_system_registration_ (which can't be a single pointer
 	// across concurrent systems).
 	enum class WorkKind : uint8_t {
@@ -403,15 +431,75 @@ namespace {
 		uint32_t reg_idx;
 		uint32_t threaded_chunk_count;
 	};
+
+	// Populate / refresh the World's query-cache entry for `reg`'s iteration query on the
+	// calling (main) thread, so workers dispatching the system only ever read the cache.
+	void prewarm_tick_query(World& world, SystemRegistration const& reg) {
+		if (!reg.tick_query_require_ids.empty()) {
+			QueryCacheKey key { reg.tick_query_require_ids, reg.tick_query_exclude_ids };
+			(void) world.resolve_query_cache_for_threaded(key);
+		}
+	}
+
+	// The TickContext for one run of `reg`, carrying its change ticks.
+	TickContext run_context(SystemRegistration const& reg, World& world, OpenVic::Date today, CommandBuffer& cmd) {
+		return TickContext { world, today, cmd, reg.last_run_tick, reg.this_run_tick };
+	}
+
+	// A system's extra_writes() may land on any row carrying the component, so once it has
+	// run, every chunk of those columns counts as written at its tick. Safe while other
+	// systems run: any system touching the same column's ticks conflicts with this one.
+	void mark_extra_writes(World& world, SystemRegistration const& reg) {
+		for (component_type_id_t id : reg.extra_writes) {
+			world.mark_component_written(id, reg.this_run_tick);
+		}
+	}
+
+	// One whole system as a single dependency-mode task, run on a pool worker. A
+	// SystemThreaded fans its chunks out with a nested parallel_for (the worker helps
+	// while it waits) and merges the per-chunk buffers in chunk_local_idx order, exactly
+	// like the multi-system stage branch; it never goes through tick_all, which relies on
+	// the single current_system_registration_ pointer.
+	void run_system_task(
+		SystemRegistration& reg, World& world, OpenVic::Date today, EcsThreadPool& pool
+	) {
+		if (!(reg.is_threaded && reg.collect_chunks_fn != nullptr
+			&& reg.per_chunk_cmds_accessor != nullptr && reg.tick_one_chunk_fn != nullptr)) {
+			TickContext const ctx = run_context(reg, world, today, *reg.pending_cmd);
+			reg.tick_all_fn(reg.instance, world, ctx);
+			return;
+		}
+		std::vector<ChunkLocation> const chunks = reg.collect_chunks_fn(world, reg.last_run_tick);
+		std::vector<CommandBuffer>& cbs = *reg.per_chunk_cmds_accessor(reg.instance);
+		if (cbs.size() < chunks.size()) {
+			cbs.resize(chunks.size());
+		}
+		for (std::size_t i = 0; i < chunks.size(); ++i) {
+			cbs[i].clear();
+			cbs[i].set_parallel_mode(true);
+		}
+		pool.parallel_for(chunks.size(), [&](std::size_t i, uint32_t /*worker_id*/) {
+			TickContext const ctx = run_context(reg, world, today, cbs[i]);
+			reg.tick_one_chunk_fn(reg.instance, world, ctx, chunks[i].archetype_idx, chunks[i].chunk_idx);
+		});
+		for (std::size_t i = 0; i < chunks.size(); ++i) {
+			cbs[i].set_parallel_mode(false);
+			reg.pending_cmd->merge_from(std::move(cbs[i]));
+		}
+	}
 }
 
 void SystemScheduler::run(
 	World& world, Date today, std::vector<SystemRegistration>& registry,
-	EcsThreadPool& pool, bool serial_mode
+	EcsThreadPool& pool, bool serial_mode, bool dependency_mode
 ) {
 	if (!built_) {
 		return;
 	}
+	if (dependency_mode && !serial_mode) {
+		run_dependency_rounds(world, today, registry, pool);
+		return;
+	}
 
 	for (ScheduledStage const& stage : stages_) {
 		if (stage.registration_indices.empty()) {
@@ -439,6 +527,15 @@ void SystemScheduler::run(
 			}
 		}
 
+		// Draw each running system's change tick in emit order, on the main thread — the
+		// same ticks at every worker count.
+		for (std::size_t i = 0; i < stage.registration_indices.size(); ++i) {
+			SystemRegistration& reg = registry[stage.registration_indices[i]];
+			if (reg.alive && reg.tick_all_fn != nullptr && run_flags[i] != 0u) {
+				reg.this_run_tick = world.advance_change_tick_();
+			}
+		}
+
 		// Execute every system in the stage. Serial mode or single-system stages run on
 		// the calling thread with current_system_registration_ set, so SystemThreaded
 		// systems take the existing dispatch_threaded path (one parallel_for over their
@@ -453,7 +550,7 @@ void SystemScheduler::run(
 					continue;
 				}
 				world.set_current_registration_(&reg);
-				TickContext ctx { world, today, *reg.pending_cmd };
+				TickContext const ctx = run_context(reg, world, today, *reg.pending_cmd);
 				reg.tick_all_fn(reg.instance, world, ctx);
 			}
 		} else {
@@ -482,10 +579,7 @@ void SystemScheduler::run(
 				if (!reg.alive || run_flags[i] == 0u) {
 					continue;
 				}
-				if (!reg.tick_query_require_ids.empty()) {
-					QueryCacheKey key { reg.tick_query_require_ids, reg.tick_query_exclude_ids };
-					(void) world.resolve_query_cache_for_threaded(key);
-				}
+				prewarm_tick_query(world, reg);
 			}
 
 			// Step 2: build the combined work-item list. Iteration order:
@@ -512,7 +606,7 @@ void SystemScheduler::run(
 				if (reg.is_threaded && reg.collect_chunks_fn != nullptr
 					&& reg.per_chunk_cmds_accessor != nullptr
 					&& reg.tick_one_chunk_fn != nullptr) {
-					std::vector<ChunkLocation> chunks = reg.collect_chunks_fn(world);
+					std::vector<ChunkLocation> chunks = reg.collect_chunks_fn(world, reg.last_run_tick);
 					std::vector<CommandBuffer>* cbs = reg.per_chunk_cmds_accessor(reg.instance);
 					if (cbs->size() < chunks.size()) {
 						cbs->resize(chunks.size());
@@ -551,8 +645,8 @@ void SystemScheduler::run(
 			}
 
 			// Step 3: outer parallel_for. Each work item runs straight-line code — no
-			// nested parallel_for, no run_concurrent — so the pool's per-call DoneState
-			// is the only counter touched and workers never block on inner dispatches.
+			// nested parallel_for, no run_concurrent — so the pool's per-call completion
+			// counter is the only one touched and workers never wait on inner dispatches.
 			if (!work_items.empty()) {
 				pool.parallel_for(work_items.size(),
 					[&work_items, &registry, &world, today]
@@ -562,13 +656,14 @@ void SystemScheduler::run(
 						if (item.kind == WorkKind::ThreadedChunk) {
 							std::vector<CommandBuffer>* cbs
 								= reg.per_chunk_cmds_accessor(reg.instance);
-							TickContext ctx { world, today, (*cbs)[item.chunk_local_idx] };
+							TickContext const ctx
+								= run_context(reg, world, today, (*cbs)[item.chunk_local_idx]);
 							reg.tick_one_chunk_fn(
 								reg.instance, world, ctx,
 								item.archetype_idx, item.chunk_idx
 							);
 						} else {
-							TickContext ctx { world, today, *reg.pending_cmd };
+							TickContext const ctx = run_context(reg, world, today, *reg.pending_cmd);
 							reg.tick_all_fn(reg.instance, world, ctx);
 						}
 					}
@@ -589,6 +684,18 @@ void SystemScheduler::run(
 			}
 		}
 
+		// The stage's runs are over: stamp extra_writes columns and roll each run's tick into
+		// last_run_tick. Then advance the change tick so whatever the apply below stamps is
+		// newer than every run so far, and older than every run still to come.
+		for (std::size_t i = 0; i < stage.registration_indices.size(); ++i) {
+			SystemRegistration& reg = registry[stage.registration_indices[i]];
+			if (reg.alive && reg.tick_all_fn != nullptr && run_flags[i] != 0u) {
+				mark_extra_writes(world, reg);
+				reg.last_run_tick = reg.this_run_tick;
+			}
+		}
+		world.advance_change_tick_();
+
 		// Stage barrier: apply each system's pending CommandBuffer in the stage's
 		// deterministic emit order — stage.registration_indices as emitted by the Phase 5
 		// topological sort, i.e. ascending system_type_id_t within the stage, independent
@@ -605,3 +712,114 @@ void SystemScheduler::run(
 		world.set_in_apply_phase_(false);
 	}
 }
+
+void SystemScheduler::run_dependency_rounds(
+	World& world, Date today, std::vector<SystemRegistration>& registry, EcsThreadPool& pool
+) {
+	std::size_t const N = emit_order_.size();
+
+	// should_run for every system up front, on the main thread, before anything runs —
+	// a predicate sees the previous tick's end state, never a concurrently running
+	// system's writes. Indexed by emit position.
+	std::vector<uint8_t> run_flags(N, 1u);
+	for (std::size_t pos = 0; pos < N; ++pos) {
+		SystemRegistration& reg = registry[emit_order_[pos]];
+		if (reg.alive && reg.tick_all_fn != nullptr && reg.should_run_fn != nullptr) {
+			TickContext ctx { world, today, *reg.pending_cmd };
+			run_flags[pos] = reg.should_run_fn(ctx) ? 1u : 0u;
+		}
+	}
+
+	std::vector<uint8_t> done(N, 0u); // ran, and its buffer (if any) has been applied
+	std::vector<uint32_t> round; // emit positions still to run, ascending
+	std::vector<uint32_t> local_of(N, 0);
+	std::vector<uint32_t> predecessor_counts;
+	std::vector<uint32_t> successor_offsets;
+	std::vector<uint32_t> successors;
+	std::vector<uint8_t> ran;
+
+	for (;;) {
+		round.clear();
+		for (uint32_t pos = 0; pos < N; ++pos) {
+			if (done[pos] == 0u) {
+				local_of[pos] = static_cast<uint32_t>(round.size());
+				round.push_back(pos);
+			}
+		}
+		if (round.empty()) {
+			break;
+		}
+
+		// The sub-DAG of systems not yet done. Edges from done systems are already
+		// satisfied, so only edges between pending systems are counted. The pending set
+		// is closed under successors, which keeps local_of valid for every successor.
+		predecessor_counts.assign(round.size(), 0);
+		successor_offsets.assign(1, 0);
+		successors.clear();
+		for (uint32_t pos : round) {
+			for (uint32_t i = successor_offsets_[pos]; i < successor_offsets_[pos + 1]; ++i) {
+				uint32_t const local_successor = local_of[successors_[i]];
+				successors.push_back(local_successor);
+				++predecessor_counts[local_successor];
+			}
+			successor_offsets.push_back(static_cast<uint32_t>(successors.size()));
+		}
+
+		// Structural applies between rounds can add archetypes, so the query cache is
+		// refreshed for every pending system before workers read it.
+		for (uint32_t pos : round) {
+			SystemRegistration& reg = registry[emit_order_[pos]];
+			if (reg.alive && run_flags[pos] != 0u) {
+				prewarm_tick_query(world, reg);
+			}
+		}
+
+		// Change ticks in emit order: a DAG predecessor always draws a lower tick than its
+		// successors, so a writer that runs after a Changed<C> reader in this round stamps
+		// newer than that reader's run and the reader sees the write on its next run.
+		for (uint32_t pos : round) {
+			SystemRegistration& reg = registry[emit_order_[pos]];
+			if (reg.alive && reg.tick_all_fn != nullptr && run_flags[pos] != 0u) {
+				reg.this_run_tick = world.advance_change_tick_();
+			}
+		}
+
+		ran.assign(round.size(), 0u);
+		EcsThreadPool::TaskGraph const graph { predecessor_counts, successor_offsets, successors };
+		pool.run_graph(graph, [&](std::size_t local, uint32_t /*worker_id*/) -> bool {
+			uint32_t const pos = round[local];
+			SystemRegistration& reg = registry[emit_order_[pos]];
+			ran[local] = 1u;
+			if (reg.alive && reg.tick_all_fn != nullptr && run_flags[pos] != 0u) {
+				run_system_task(reg, world, today, pool);
+				mark_extra_writes(world, reg);
+			}
+			return reg.pending_cmd == nullptr || reg.pending_cmd->empty();
+		});
+
+		for (std::size_t local = 0; local < round.size(); ++local) {
+			uint32_t const pos = round[local];
+			SystemRegistration& reg = registry[emit_order_[pos]];
+			if (ran[local] != 0u && reg.alive && reg.tick_all_fn != nullptr && run_flags[pos] != 0u) {
+				reg.last_run_tick = reg.this_run_tick;
+			}
+		}
+		world.advance_change_tick_();
+
+		// Round barrier: apply every non-empty buffer produced this round in emit order —
+		// the same relative order the staged path applies them in.
+		world.set_in_apply_phase_(true);
+		for (std::size_t local = 0; local < round.size(); ++local) {
+			if (ran[local] == 0u) {
+				continue;
+			}
+			uint32_t const pos = round[local];
+			done[pos] = 1u;
+			SystemRegistration& reg = registry[emit_order_[pos]];
+			if (reg.pending_cmd != nullptr && !reg.pending_cmd->empty()) {
+				reg.pending_cmd->apply(world);
+			}
+		}
+		world.set_in_apply_phase_(false);
+	}
+}
@@ -34,9 +34,13 @@ namespace OpenVic::ecs {
 		// stage has only one system). After each stage joins, applies each system's
 		// pending CommandBuffer in the stage's deterministic emit order — ascending
 		// system_type_id_t within the stage, independent of registration order.
+		//
+		// With `dependency_mode == true` (and serial_mode off) stages are not barriers:
+		// each system starts as soon as its DAG predecessors are done — see
+		// run_dependency_rounds. serial_mode takes precedence.
 		void run(
 			World& world, Date today, std::vector<SystemRegistration>& registry,
-			EcsThreadPool& pool, bool serial_mode
+			EcsThreadPool& pool, bool serial_mode, bool dependency_mode = false
 		);
 
 		// FNV-1a hash over the (stage_index, system_type_id_t) pairs of the schedule.
@@ -59,8 +63,28 @@ namespace OpenVic::ecs {
 		) const noexcept;
 
 	private:
+		// Barrier-free execution over the DAG. Each system holds an atomic count of its
+		// unfinished predecessors on the pool and starts when it reaches zero. A system
+		// whose pending CommandBuffer is empty releases its successors on completion; a
+		// non-empty one holds them. Once nothing is runnable the round ends: held buffers
+		// apply on the calling thread in emit order, and the next round resumes the held
+		// systems. A system therefore always observes its predecessors' structural
+		// commands, and which systems run in which round depends only on which buffers
+		// are empty — so results are identical at every worker count. should_run is
+		// evaluated once for every system at the start of the tick.
+		void run_dependency_rounds(
+			World& world, Date today, std::vector<SystemRegistration>& registry, EcsThreadPool& pool
+		);
+
 		bool built_ = false;
 		std::vector<ScheduledStage> stages_;
 		uint64_t schedule_hash_ = 0;
+
+		// The DAG over alive systems, indexed by emit position (stages flattened in order)
+		// in CSR form for EcsThreadPool::run_graph. Rebuilt with the stages.
+		std::vector<uint32_t> emit_order_; // emit position -> registration index
+		std::vector<uint32_t> predecessor_counts_;
+		std::vector<uint32_t> successor_offsets_;
+		std::vector<uint32_t> successors_; // emit positions
 	};
 }
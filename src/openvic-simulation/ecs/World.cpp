@@ -251,6 +251,7 @@ void World::compact_archetype_after_external_move(
 		entity_slots[moved.index].chunk_index = static_cast<uint32_t>(chunk_index);
 		entity_slots[moved.index].row = static_cast<uint32_t>(row);
 		arch.entity_array(chunk_index)[row] = moved;
+		arch.stamp_row_relocated(chunk_index, last_chunk, change_tick_);
 	}
 
 	// Drop the trailing row from the last chunk.
@@ -509,7 +510,7 @@ void World::finalize_reserved_entity(
 	EntityID eid,
 	std::vector<component_type_id_t> const& sorted_sig,
 	std::vector<ColumnVTable const*> const& sorted_vtables,
-	std::vector<void*> const& sorted_value_slots
+	std::span<void* const> sorted_value_slots
 ) {
 	if (eid.index >= entity_slots.size()) {
 		return;
@@ -523,7 +524,7 @@ void World::finalize_reserved_entity(
 	}
 
 	uint32_t const arch_idx = find_or_create_archetype(sorted_sig, sorted_vtables.data());
-	Archetype::RowLocation loc = archetypes[arch_idx].reserve_row();
+	Archetype::RowLocation loc = archetypes[arch_idx].reserve_row(change_tick_);
 	archetypes[arch_idx].entity_array(loc.chunk_index)[loc.row] = eid;
 
 	for (std::size_t i = 0; i < sorted_sig.size(); ++i) {
@@ -621,7 +622,7 @@ void World::finalize_reserved_entities_bulk(
 	// Fast path: one archetype lookup, bulk row reservation, column-contiguous moves.
 	uint32_t const arch_idx = find_or_create_archetype(sorted_sig, sorted_vtables.data());
 	Archetype& arch = archetypes[arch_idx];
-	arch.reserve_rows(count, bulk_rows_scratch_);
+	arch.reserve_rows(count, bulk_rows_scratch_, change_tick_);
 
 	{
 		std::size_t i = 0;
@@ -742,7 +743,7 @@ void World::tick_systems(Date today) {
 		scheduler_dirty_ = false;
 	}
 	in_tick_ = true;
-	scheduler_->run(*this, today, system_registry_, ecs_thread_pool(), serial_mode_);
+	scheduler_->run(*this, today, system_registry_, ecs_thread_pool(), serial_mode_, dependency_mode_);
 	in_tick_ = false;
 	current_system_registration_ = nullptr;
 	// Advance the chunk pool's aging clock — frees blocks whose release tick is older
@@ -805,6 +806,10 @@ void World::set_serial_mode(bool enabled) {
 	serial_mode_ = enabled;
 }
 
+void World::set_dependency_mode(bool enabled) {
+	dependency_mode_ = enabled;
+}
+
 void World::set_ecs_worker_count(uint32_t count) {
 	ecs_worker_count_ = count;
 	// If pool already exists, rebuild it next access.
@@ -838,6 +843,50 @@ std::size_t World::archetype_chunk_row_count(uint32_t archetype_idx, std::size_t
 	return archetypes[archetype_idx].chunks[chunk_idx].count;
 }
 
+bool World::chunk_passes_change_filters(
+	uint32_t archetype_idx, std::size_t chunk_idx,
+	std::span<component_type_id_t const> changed_ids,
+	std::span<component_type_id_t const> added_ids, uint64_t last_run_tick
+) const {
+	Archetype const& arch = archetypes[archetype_idx];
+	DataChunk const& chunk = arch.chunks[chunk_idx];
+	if (!added_ids.empty() && chunk.added_tick <= last_run_tick) {
+		return false;
+	}
+	for (component_type_id_t id : changed_ids) {
+		std::size_t const col = arch.column_index_for(id);
+		if (col == NO_COLUMN_INDEX || chunk.changed_ticks[col] <= last_run_tick) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void World::mark_chunk_written(
+	uint32_t archetype_idx, std::size_t chunk_idx,
+	std::span<component_type_id_t const> ids, uint64_t tick
+) {
+	Archetype& arch = archetypes[archetype_idx];
+	for (component_type_id_t id : ids) {
+		std::size_t const col = arch.column_index_for(id);
+		if (col != NO_COLUMN_INDEX) {
+			arch.stamp_column_written(chunk_idx, col, tick);
+		}
+	}
+}
+
+void World::mark_component_written(component_type_id_t id, uint64_t tick) {
+	for (Archetype& arch : archetypes) {
+		std::size_t const col = arch.column_index_for(id);
+		if (col == NO_COLUMN_INDEX) {
+			continue;
+		}
+		for (std::size_t ci = 0; ci < arch.chunks.size(); ++ci) {
+			arch.stamp_column_written(ci, col, tick);
+		}
+	}
+}
+
 World::CachedQuery const& World::resolve_query_cache_for_threaded(QueryCacheKey const& key) const {
 	return resolve_query_cache(key);
 }
@@ -364,6 +364,13 @@ namespace OpenVic::ecs {
 		// to validate "parallel result == serial result". Default false.
 		void set_serial_mode(bool enabled);
 
+		// Run the schedule without stage barriers: each system starts as soon as its DAG
+		// predecessors (and their command-buffer applies) are done. Structural commands
+		// become visible to a system's descendants rather than to every later stage — see
+		// SystemScheduler::run_dependency_rounds. Deterministic across worker counts; default
+		// false. Ignored while serial mode is on.
+		void set_dependency_mode(bool enabled);
+
 		// Returns the EcsThreadPool used by the scheduler. Lazily constructed with the
 		// default worker count on first access.
 		EcsThreadPool& ecs_thread_pool();
@@ -391,6 +398,46 @@ namespace OpenVic::ecs {
 		std::size_t archetype_chunk_count(uint32_t archetype_idx) const;
 		std::size_t archetype_chunk_row_count(uint32_t archetype_idx, std::size_t chunk_idx) const;
 
+		// === Change detection (Changed<C> / Added<C> in QueryFilter.hpp) ===
+		// The change tick is a monotonic counter stamped into DataChunk::changed_ticks /
+		// added_tick. The scheduler draws each system run's tick from it (in emit order, on
+		// the main thread) and advances it again before every CommandBuffer apply, so a stamp
+		// is always newer than the last run of every system that has not observed it.
+		// Structural changes, and mutable access (get_component, for_each, for_each_chunk)
+		// outside tick_systems, stamp the current value. Inside a tick only the system
+		// drivers stamp — writes a system makes through ctx.world to rows it does not
+		// iterate are covered by its extra_writes() declaration instead.
+		uint64_t change_tick() const {
+			return change_tick_;
+		}
+
+		// Internal: advances and returns the change tick. Called by SystemScheduler and the
+		// cached checksum (Checksum.hpp) only.
+		uint64_t advance_change_tick_() {
+			return ++change_tick_;
+		}
+
+		// True iff the chunk passes every Changed<C> (column C written after
+		// `last_run_tick`) and Added<C> (a row entered after `last_run_tick`) filter. The
+		// archetype must carry every id in `changed_ids`. Read-only; safe from workers.
+		bool chunk_passes_change_filters(
+			uint32_t archetype_idx, std::size_t chunk_idx,
+			std::span<component_type_id_t const> changed_ids,
+			std::span<component_type_id_t const> added_ids, uint64_t last_run_tick
+		) const;
+
+		// Stamps the chunk's columns for `ids` (those the archetype carries) as written at
+		// `tick`. Used by the system drivers after running a chunk with mutable parameters.
+		void mark_chunk_written(
+			uint32_t archetype_idx, std::size_t chunk_idx,
+			std::span<component_type_id_t const> ids, uint64_t tick
+		);
+
+		// Stamps column `id` of every chunk of every archetype carrying it as written at
+		// `tick` — the conservative stamp for an extra_writes() declaration, whose writes
+		// may land on any row.
+		void mark_component_written(component_type_id_t id, uint64_t tick);
+
 		struct CachedQuery {
 			uint32_t epoch = 0;
 			uint64_t require_matcher = 0;
@@ -410,6 +457,11 @@ namespace OpenVic::ecs {
 		void iterate_one_chunk_with_entity_for_threaded(
 			uint32_t archetype_idx, uint32_t chunk_idx, Body&& body);
 
+		// Invokes body(ChunkView<Cs...>) once for one chunk — the ChunkSystem<> analogue of
+		// the two per-row walks above.
+		template<typename... Cs, typename Body>
+		void view_one_chunk(uint32_t archetype_idx, uint32_t chunk_idx, Body&& body);
+
 		// === Reserved-but-unfinalised slot ===
 		// Reserves an entity slot without placing it in any archetype. The returned EntityID
 		// is real (its index/generation are addressable), but `is_alive` returns false until
@@ -428,7 +480,7 @@ namespace OpenVic::ecs {
 			EntityID eid,
 			std::vector<component_type_id_t> const& sorted_sig,
 			std::vector<ColumnVTable const*> const& sorted_vtables,
-			std::vector<void*> const& sorted_value_slots
+			std::span<void* const> sorted_value_slots
 		);
 
 		// Bulk analogue of finalize_reserved_entity, used by CommandBuffer::apply for batch
@@ -580,6 +632,25 @@ namespace OpenVic::ecs {
 		// scheduler_->run().
 		bool in_apply_phase_ = false;
 
+		// Current change tick — see change_tick(). Starts at 1 so everything stamped before a
+		// system's first run is newer than its initial last_run_tick of 0.
+		uint64_t change_tick_ = 1;
+
+		// Outside a tick, hands-on mutable access to the given columns of one chunk counts
+		// as a write for change detection. Inside a tick the system drivers stamp instead:
+		// a read-intent access from a worker must not write a stamp a co-staged reader of
+		// the same column is checking.
+		void stamp_mutable_access_(
+			Archetype& arch, std::size_t chunk_idx, std::size_t const* cols, std::size_t col_count
+		) {
+			if (in_tick_) {
+				return;
+			}
+			for (std::size_t i = 0; i < col_count; ++i) {
+				arch.stamp_column_written(chunk_idx, cols[i], change_tick_);
+			}
+		}
+
 		// Pointer to the SystemRegistration currently being driven. Used by
 		// SystemThreaded::tick_all to access its pending_cmd. Set/cleared by the scheduler.
 		SystemRegistration* current_system_registration_ = nullptr;
@@ -588,6 +659,9 @@ namespace OpenVic::ecs {
 		// in deterministic order regardless of inter-system parallelism.
 		bool serial_mode_ = false;
 
+		// Barrier-free DAG execution instead of stage-by-stage — see set_dependency_mode.
+		bool dependency_mode_ = false;
+
 		// EcsThreadPool — owned. Lazily constructed on first `ecs_thread_pool()` access.
 		std::unique_ptr<EcsThreadPool> ecs_thread_pool_;
 		uint32_t ecs_worker_count_ = 0; // 0 = use default at construction time
@@ -737,7 +811,7 @@ namespace OpenVic::ecs {
 		EntityID const eid = allocate_entity_slot();
 
 		// Reserve a row in the archetype.
-		Archetype::RowLocation loc = archetypes[archetype_idx].reserve_row();
+		Archetype::RowLocation loc = archetypes[archetype_idx].reserve_row(change_tick_);
 		archetypes[archetype_idx].entity_array(loc.chunk_index)[loc.row] = eid;
 
 		// Construct each provided component into its column slot, finding the column by raw id.
@@ -885,7 +959,7 @@ namespace OpenVic::ecs {
 
 		// No further archetype creation below — this reference stays valid.
 		Archetype& arch = archetypes[archetype_idx];
-		arch.reserve_rows(count, bulk_rows_scratch_);
+		arch.reserve_rows(count, bulk_rows_scratch_, change_tick_);
 
 		// Allocate entity slots one-by-one in creation order: identical free-list pops to
 		// the create_entity loop, which is what keeps bulk id assignment bit-identical to
@@ -1026,6 +1100,7 @@ namespace OpenVic::ecs {
 		if constexpr (std::is_empty_v<C>) {
 			return nullptr;
 		} else {
+			stamp_mutable_access_(arch, slot.chunk_index, &col, 1);
 			return static_cast<C*>(arch.row_in_column(slot.chunk_index, col, slot.row));
 		}
 	}
@@ -1102,6 +1177,7 @@ namespace OpenVic::ecs {
 				} else {
 					TC* dst_ptr = static_cast<TC*>(src.row_in_column(src_chunk, existing_col, src_row));
 					*dst_ptr = std::forward<C>(value);
+					src.stamp_column_written(src_chunk, existing_col, change_tick_);
 					return dst_ptr;
 				}
 			}
@@ -1136,7 +1212,7 @@ namespace OpenVic::ecs {
 		uint32_t const target_idx = find_or_create_archetype(target_sig, target_vtables.data());
 
 		// Reserve a row on the target archetype.
-		Archetype::RowLocation target_loc = archetypes[target_idx].reserve_row();
+		Archetype::RowLocation target_loc = archetypes[target_idx].reserve_row(change_tick_);
 		archetypes[target_idx].entity_array(target_loc.chunk_index)[target_loc.row] = id;
 
 		// Move every existing component from src to target, and construct the new one.
@@ -1235,7 +1311,7 @@ namespace OpenVic::ecs {
 		uint32_t const target_idx = find_or_create_archetype(target_sig, target_vtables.data());
 
 		// Reserve a row in the target archetype.
-		Archetype::RowLocation target_loc = archetypes[target_idx].reserve_row();
+		Archetype::RowLocation target_loc = archetypes[target_idx].reserve_row(change_tick_);
 		archetypes[target_idx].entity_array(target_loc.chunk_index)[target_loc.row] = id;
 
 		// Destroy the dropped component on the src side, move the rest to target.
@@ -1353,6 +1429,7 @@ namespace OpenVic::ecs {
 
 			for (std::size_t chunk_idx = 0; chunk_idx < arch.chunks.size(); ++chunk_idx) {
 				std::size_t const row_count = arch.chunks[chunk_idx].count;
+				stamp_mutable_access_(arch, chunk_idx, cols, sizeof...(Cs));
 				[&]<std::size_t... Is>(std::index_sequence<Is...>) {
 					// Hoist typed column-base pointers — computed once per chunk. The row
 					// loop indexes these directly; per-row pointer rederivation through
@@ -1384,6 +1461,7 @@ namespace OpenVic::ecs {
 
 			for (std::size_t chunk_idx = 0; chunk_idx < arch.chunks.size(); ++chunk_idx) {
 				std::size_t const row_count = arch.chunks[chunk_idx].count;
+				stamp_mutable_access_(arch, chunk_idx, cols, sizeof...(Cs));
 				EntityID const* OV_RESTRICT eids = arch.entity_array(chunk_idx);
 				[&]<std::size_t... Is>(std::index_sequence<Is...>) {
 					auto arrs = std::tuple { detail::chunk_array_for<Cs>(
@@ -1423,6 +1501,7 @@ namespace OpenVic::ecs {
 				if (row_count == 0) {
 					continue;
 				}
+				stamp_mutable_access_(arch, chunk_idx, cols, sizeof...(Cs));
 				[&]<std::size_t... Is>(std::index_sequence<Is...>) {
 					ChunkView<Cs...> view {
 						row_count,
@@ -1576,6 +1655,12 @@ namespace OpenVic::ecs {
 		);
 		merge_extra_reads(reg.access, reg.extra_reads);
 		merge_extra_writes(reg.access, reg.extra_writes);
+		// Changed<C> / Added<C> read C's change ticks, so C counts as read even when it is
+		// not a tick parameter — that orders the system against every writer of C. Not added
+		// to reg.extra_reads: the read stays on the system's own iterated chunks, which keeps
+		// the disjoint-iteration override applicable.
+		std::vector<component_type_id_t> const change_filter_ids = system_filters_t<S>::require_ids();
+		merge_extra_reads(reg.access, change_filter_ids);
 		canonicalise_access_set(reg.access);
 
 		// Iteration-query ids — tick parameter pack only, separate from `access` (which
@@ -1592,8 +1677,8 @@ namespace OpenVic::ecs {
 		// Multi-system-stage entry points — set only for SystemThreaded. Plain System<>
 		// stays with null pointers; the scheduler distinguishes via reg.is_threaded.
 		if constexpr (S::is_threaded) {
-			reg.collect_chunks_fn = +[](World& w) -> std::vector<ChunkLocation> {
-				return S::collect_chunks(w);
+			reg.collect_chunks_fn = +[](World& w, uint64_t last_run_tick) -> std::vector<ChunkLocation> {
+				return S::collect_chunks(w, last_run_tick);
 			};
 			reg.tick_one_chunk_fn = +[](
 				void* inst, World& w, TickContext const& tc,
@@ -1650,6 +1735,22 @@ namespace OpenVic::ecs {
 		}(std::index_sequence_for<Cs...> {});
 	}
 
+	template<typename... Cs, typename Body>
+	void World::view_one_chunk(uint32_t archetype_idx, uint32_t chunk_idx, Body&& body) {
+		Archetype& arch = archetypes[archetype_idx];
+		std::size_t cols[sizeof...(Cs)];
+		std::size_t i = 0;
+		((cols[i++] = arch.column_index_for(component_type_id_of<Cs>())), ...);
+		[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+			ChunkView<Cs...> view {
+				arch.chunks[chunk_idx].count,
+				arch.entity_array(chunk_idx),
+				{ detail::chunk_array_for<Cs>(arch, cols[Is], chunk_idx)... }
+			};
+			body(view);
+		}(std::index_sequence_for<Cs...> {});
+	}
+
 	template<typename... Cs, typename Body>
 	void World::iterate_one_chunk_with_entity_for_threaded(uint32_t archetype_idx, uint32_t chunk_idx, Body&& body) {
 		Archetype& arch = archetypes[archetype_idx];
@@ -6,8 +6,11 @@
 #include <charconv>
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <limits>
+#include <string_view>
 #include <system_error>
+#include <utility>
 
 #include <fmt/std.h>
 
@@ -17,18 +20,22 @@
 #include <type_safe/strong_typedef.hpp>
 
 #include "openvic-simulation/core/FormatValidate.hpp"
+#include "openvic-simulation/core/io/BinaryStream.hpp"
 #include "openvic-simulation/core/io/BMP.hpp"
+#include "openvic-simulation/core/memory/FixedVector.hpp"
 #include "openvic-simulation/core/object/Vector.hpp"
 #include "openvic-simulation/core/stl/containers/TypedSpan.hpp"
 #include "openvic-simulation/core/string/CharConv.hpp"
+#include "openvic-simulation/core/thread/ForEachIndexConcurrently.hpp"
 #include "openvic-simulation/core/Typedefs.hpp"
 #include "openvic-simulation/dataloader/NodeTools.hpp"
+#include "openvic-simulation/ecs/ChecksumTraits.hpp"
+#include "openvic-simulation/gen/commit_info.gen.hpp"
 #include "openvic-simulation/map/ProvinceDefinition.hpp"
 #include "openvic-simulation/modifier/ModifierManager.hpp"
 #include "openvic-simulation/types/Colour.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
 #include "openvic-simulation/types/fixed_point/Math.hpp"
-#include "openvic-simulation/types/OrderedContainersMath.hpp"
 #include "openvic-simulation/utility/Logger.hpp"
 
 using namespace OpenVic;
@@ -791,7 +798,201 @@ void MapDefinition::_trace_river(BMP& rivers_bmp, ivec2_t start, river_t& river)
 	}
 }
 
-bool MapDefinition::load_map_images(fs::path const& province_path, fs::path const& terrain_path, fs::path const& rivers_path, bool detailed_errors) {
+/* Hashes bytes in chunks concurrently, then folds the chunk hashes together in order. */
+static uint64_t hash_bytes_concurrently(std::span<const uint8_t> bytes, const uint64_t seed) {
+	static constexpr size_t chunk_size = 1 << 20;
+	const size_t chunk_count = (bytes.size() + chunk_size - 1) / chunk_size;
+	memory::vector<uint64_t> chunk_hashes(chunk_count);
+	for_each_index_concurrently(chunk_count, [bytes, &chunk_hashes](const size_t chunk_index) -> void {
+		const std::span<const uint8_t> chunk = bytes.subspan(
+			chunk_index * chunk_size, std::min(chunk_size, bytes.size() - chunk_index * chunk_size)
+		);
+		chunk_hashes[chunk_index] = ecs::fnv1a_64_bytes(chunk.data(), chunk.size(), ecs::CHECKSUM_SEED);
+	});
+
+	uint64_t hash = ecs::fold_uint64(bytes.size(), seed);
+	for (const uint64_t chunk_hash : chunk_hashes) {
+		hash = ecs::fold_uint64(chunk_hash, hash);
+	}
+	return hash;
+}
+
+static constexpr uint32_t DERIVED_MAP_CACHE_MAGIC = 0x434D564F; // "OVMC"
+/* Part of the cache key, as SIM_COMMIT_HASH doesn't change for uncommitted changes. Bump this whenever the layout of
+ * the cache or the results stored in it change. */
+static constexpr uint32_t DERIVED_MAP_CACHE_FORMAT_VERSION = 1;
+static constexpr uint64_t NO_DEFAULT_TERRAIN_TYPE = std::numeric_limits<uint64_t>::max();
+
+bool MapDefinition::_load_derived_map_cache() {
+	std::error_code ec;
+	if (!fs::is_regular_file(derived_map_cache_path, ec)) {
+		return false;
+	}
+	MappedFile cache_file;
+	if (!cache_file.open(derived_map_cache_path)) {
+		return false;
+	}
+
+	BinaryReader reader { cache_file.get_data() };
+	uint32_t magic = 0;
+	uint64_t key = 0;
+	if (!reader.read(magic) || magic != DERIVED_MAP_CACHE_MAGIC || !reader.read(key) || key != derived_map_cache_key) {
+		return false;
+	}
+
+	const size_t province_count = province_definitions.size();
+	const size_t terrain_type_count = terrain_type_manager.get_terrain_type_count();
+
+	std::span<const uint8_t> shape_image_bytes;
+	memory::vector<uint8_t> on_map_per_province;
+	memory::vector<fvec2_t> centre_per_province;
+	memory::vector<uint64_t> default_terrain_type_per_province;
+	memory::vector<unrecognised_province_colour_t> cached_unrecognised_province_colours;
+	reader.read_byte_span(shape_image_bytes);
+	reader.read_vector(on_map_per_province);
+	reader.read_vector(centre_per_province);
+	reader.read_vector(default_terrain_type_per_province);
+	reader.read_vector(cached_unrecognised_province_colours);
+
+	uint64_t river_count = 0;
+	memory::vector<river_t> cached_rivers;
+	if (reader.read(river_count)) {
+		for (uint64_t river_index = 0; river_index < river_count && !reader.has_failed(); ++river_index) {
+			uint64_t segment_count = 0;
+			river_t& river = cached_rivers.emplace_back();
+			reader.read(segment_count);
+			for (uint64_t segment_index = 0; segment_index < segment_count && !reader.has_failed(); ++segment_index) {
+				uint8_t size = 0;
+				memory::vector<ivec2_t> points;
+				if (reader.read(size) && reader.read_vector(points)) {
+					river.push_back({ size, std::move(points) });
+				}
+			}
+		}
+	}
+
+	memory::vector<standard_adjacency_t> standard_adjacencies;
+	reader.read_vector(standard_adjacencies);
+
+	if (reader.has_failed() || !reader.is_at_end() ||
+		shape_image_bytes.size() != static_cast<size_t>(dims.x) * dims.y * sizeof(shape_pixel_t) || std::any_of(
+			reinterpret_cast<shape_pixel_t const*>(shape_image_bytes.data()),
+			reinterpret_cast<shape_pixel_t const*>(shape_image_bytes.data() + shape_image_bytes.size()),
+			[province_count](shape_pixel_t const& pixel) -> bool {
+				return pixel.province_number > province_count;
+			}
+		) || on_map_per_province.size() != province_count || centre_per_province.size() != province_count ||
+		default_terrain_type_per_province.size() != province_count || std::any_of(
+			default_terrain_type_per_province.begin(), default_terrain_type_per_province.end(),
+			[terrain_type_count](const uint64_t index) -> bool {
+				return index != NO_DEFAULT_TERRAIN_TYPE && index >= terrain_type_count;
+			}
+		) || std::any_of(
+			standard_adjacencies.begin(), standard_adjacencies.end(),
+			[province_count](standard_adjacency_t const& adjacency) -> bool {
+				return adjacency.from == ProvinceDefinition::NULL_PROVINCE_NUMBER || adjacency.from > province_count ||
+					adjacency.to == ProvinceDefinition::NULL_PROVINCE_NUMBER || adjacency.to > province_count;
+			}
+		)) {
+		spdlog::warn_s("Ignoring corrupted derived map cache \"{}\"", derived_map_cache_path);
+		return false;
+	}
+
+	province_shape_image_storage.clear();
+	province_shape_image = {
+		reinterpret_cast<shape_pixel_t const*>(shape_image_bytes.data()), shape_image_bytes.size() / sizeof(shape_pixel_t)
+	};
+	for (ProvinceDefinition& province : province_definitions.get_items()) {
+		const size_t province_index = type_safe::get(province.index);
+		province.on_map = on_map_per_province[province_index] != 0;
+		province.centre = centre_per_province[province_index];
+		const uint64_t default_terrain_type_index = default_terrain_type_per_province[province_index];
+		province.default_terrain_type = default_terrain_type_index != NO_DEFAULT_TERRAIN_TYPE
+			? terrain_type_manager.get_terrain_type_by_index(terrain_type_index_t(default_terrain_type_index))
+			: nullptr;
+	}
+	unrecognised_province_colours = std::move(cached_unrecognised_province_colours);
+	rivers = std::move(cached_rivers);
+	cached_standard_adjacencies = std::move(standard_adjacencies);
+	derived_map_cache_file = std::move(cache_file);
+	return true;
+}
+
+bool MapDefinition::_save_derived_map_cache(std::span<const standard_adjacency_t> standard_adjacencies) const {
+	BinaryWriter writer;
+	writer.write(DERIVED_MAP_CACHE_MAGIC);
+	writer.write(derived_map_cache_key);
+
+	writer.write_span<uint8_t>({
+		reinterpret_cast<uint8_t const*>(province_shape_image.data()), province_shape_image.size_bytes()
+	});
+
+	const size_t province_count = province_definitions.size();
+	memory::vector<uint8_t> on_map_per_province;
+	memory::vector<fvec2_t> centre_per_province;
+	memory::vector<uint64_t> default_terrain_type_per_province;
+	on_map_per_province.reserve(province_count);
+	centre_per_province.reserve(province_count);
+	default_terrain_type_per_province.reserve(province_count);
+	for (ProvinceDefinition const& province : province_definitions.get_items()) {
+		on_map_per_province.push_back(province.on_map);
+		centre_per_province.push_back(province.centre);
+		default_terrain_type_per_province.push_back(
+			province.default_terrain_type != nullptr
+				? type_safe::get(province.default_terrain_type->index)
+				: NO_DEFAULT_TERRAIN_TYPE
+		);
+	}
+	writer.write_span<uint8_t>(on_map_per_province);
+	writer.write_span<fvec2_t>(centre_per_province);
+	writer.write_span<uint64_t>(default_terrain_type_per_province);
+	writer.write_span<unrecognised_province_colour_t>(unrecognised_province_colours);
+
+	writer.write<uint64_t>(rivers.size());
+	for (river_t const& river : rivers) {
+		writer.write<uint64_t>(river.size());
+		for (RiverSegment const& segment : river) {
+			writer.write(segment.size);
+			writer.write_span<ivec2_t>(segment.points);
+		}
+	}
+
+	writer.write_span<standard_adjacency_t>(standard_adjacencies);
+
+	return writer.save_to_file(derived_map_cache_path);
+}
+
+void MapDefinition::_warn_about_map_image_problems(bool detailed_errors) const {
+	if (!unrecognised_province_colours.empty()) {
+		if (detailed_errors) {
+			for (unrecognised_province_colour_t const& unrecognised_colour : unrecognised_province_colours) {
+				spdlog::warn_s(
+					"Unrecognised province colour {} at {}",
+					colour_t::from_integer(unrecognised_colour.colour), unrecognised_colour.pos
+				);
+			}
+		}
+		spdlog::warn_s("Province image contains {} unrecognised province colours", unrecognised_province_colours.size());
+	}
+
+	size_t missing = 0;
+	for (ProvinceDefinition const& province : province_definitions.get_items()) {
+		if (!province.on_map) {
+			if (detailed_errors) {
+				spdlog::warn_s("Province missing from shape image: {}", province.to_string());
+			}
+			missing++;
+		}
+	}
+	if (missing > 0) {
+		spdlog::warn_s("Province image is missing {} province colours", missing);
+	}
+}
+
+bool MapDefinition::load_map_images(
+	fs::path const& province_path, fs::path const& terrain_path, fs::path const& rivers_path, bool detailed_errors,
+	fs::path const& new_derived_map_cache_path
+) {
 	if (!province_definitions_are_locked()) {
 		spdlog::error_s("Province index image cannot be generated until after provinces are locked!");
 		return false;
@@ -859,116 +1060,200 @@ bool MapDefinition::load_map_images(fs::path const& province_path, fs::path cons
 
 	dims.x = province_bmp.get_width();
 	dims.y = province_bmp.get_height();
-	province_shape_image.resize(dims.x * dims.y);
 
-	uint8_t const* province_data = province_bmp.get_pixel_data().data();
-	uint8_t const* terrain_data = terrain_bmp.get_pixel_data().data();
-
-	const province_index_t province_count(province_definitions.size());
-	memory::FixedVector<fixed_point_map_t<TerrainType const*>, province_index_t> terrain_type_pixels_list(
-		province_count,
-		[](const province_index_t i) { return fixed_point_map_t<TerrainType const*>{}; }
-	);
+	const size_t province_count = province_definitions.size();
+	const size_t terrain_type_count = terrain_type_manager.get_terrain_type_count();
 
-	bool ret = true;
-	ordered_set<colour_t> unrecognised_province_colours;
+	/* The terrain type index (or terrain_type_count if there is no mapping) and shape image terrain for every possible
+	 * terrain image value, so they don't need to be looked up per pixel. */
+	struct terrain_lookup_t {
+		size_t terrain_type_index;
+		TerrainTypeMapping::index_t shape_terrain;
+	};
+	std::array<terrain_lookup_t, std::numeric_limits<TerrainTypeMapping::index_t>::max() + 1> terrain_lookup;
+	for (size_t terrain = 0; terrain < terrain_lookup.size(); ++terrain) {
+		TerrainTypeMapping const* mapping = terrain_type_manager.get_terrain_type_mapping_for(
+			static_cast<TerrainTypeMapping::index_t>(terrain)
+		);
+		if (mapping != nullptr) {
+			terrain_lookup[terrain] = {
+				type_safe::get(mapping->type.index),
+				static_cast<TerrainTypeMapping::index_t>(
+					mapping->has_texture && terrain < terrain_type_manager.get_terrain_texture_limit() ? terrain + 1 : 0
+				)
+			};
+		} else {
+			terrain_lookup[terrain] = { terrain_type_count, 0 };
+		}
+	}
 
-	memory::FixedVector<fixed_point_t, province_index_t> pixels_per_province(
-		province_count,
-		[](const province_index_t i) { return fixed_point_t::_0; }
-	);
-	memory::FixedVector<fvec2_t, province_index_t> pixel_position_sum_per_province(
-		province_count,
-		[](const province_index_t i) { return fvec2_t{}; }
-	);
+	derived_map_cache_path = new_derived_map_cache_path;
+	if (!derived_map_cache_path.empty()) {
+		/* Everything the cached results depend on. Special adjacencies are still loaded every time, so the adjacencies
+		 * file isn't included. */
+		const std::string_view commit_hash = SIM_COMMIT_HASH;
+		uint64_t key = ecs::fnv1a_64_bytes(commit_hash.data(), commit_hash.size(), ecs::CHECKSUM_SEED);
+		key = ecs::fold_uint64(DERIVED_MAP_CACHE_FORMAT_VERSION, key);
+		key = ecs::fold_uint64(static_cast<uint32_t>(dims.x), key);
+		key = ecs::fold_uint64(static_cast<uint32_t>(dims.y), key);
+		for (BMP const* bmp : { &province_bmp, &terrain_bmp, &rivers_bmp }) {
+			key = hash_bytes_concurrently(bmp->get_pixel_data(), key);
+		}
+		key = ecs::fold_uint64(province_count, key);
+		for (ProvinceDefinition const& province : province_definitions.get_items()) {
+			key = ecs::fold_uint64(province.get_colour().as_rgb(), key);
+		}
+		key = ecs::fold_uint64(terrain_type_count, key);
+		for (terrain_lookup_t const& terrain : terrain_lookup) {
+			key = ecs::fold_uint64(terrain.terrain_type_index, key);
+			key = ecs::fold_uint64(terrain.shape_terrain, key);
+		}
+		derived_map_cache_key = key;
 
-	for (ivec2_t pos {}; pos.y < get_height(); ++pos.y) {
-		for (pos.x = 0; pos.x < get_width(); ++pos.x) {
-			const size_t pixel_index = get_pixel_index_from_pos(pos);
-			const colour_t province_colour = colour_at(province_data, pixel_index);
-			ProvinceDefinition::province_number_t province_number = ProvinceDefinition::NULL_PROVINCE_NUMBER;
-
-			if (pos.x > 0) {
-				const size_t jdx = pixel_index - 1;
-				if (colour_at(province_data, jdx) == province_colour) {
-					province_number = province_shape_image[jdx].province_number;
-					goto index_found;
-				}
-			}
+		if (_load_derived_map_cache()) {
+			SPDLOG_INFO("Loaded map image results from derived map cache {}", derived_map_cache_path);
+			_warn_about_map_image_problems(detailed_errors);
+			return true;
+		}
+	}
 
-			if (pos.y > 0) {
-				const size_t jdx = pixel_index - get_width();
-				if (colour_at(province_data, jdx) == province_colour) {
-					province_number = province_shape_image[jdx].province_number;
-					goto index_found;
-				}
-			}
+	province_shape_image_storage.resize(dims.x * dims.y);
+	province_shape_image = province_shape_image_storage;
 
-			province_number = get_province_number_from_colour(province_colour);
+	uint8_t const* province_data = province_bmp.get_pixel_data().data();
+	uint8_t const* terrain_data = terrain_bmp.get_pixel_data().data();
 
-			if (province_number == ProvinceDefinition::NULL_PROVINCE_NUMBER && !unrecognised_province_colours.contains(province_colour)) {
-				unrecognised_province_colours.insert(province_colour);
-				if (detailed_errors) {
-					spdlog::warn_s(
-						"Unrecognised province colour {} at {}",
-						province_colour, pos
-					);
+	/* The image is split into bands of rows which are processed concurrently, each tallying into its own band_tally_t.
+	 * The tallies are then merged in band order, which gives exactly the same results as a single pass over the image. */
+	struct band_tally_t {
+		memory::vector<uint32_t> pixels_per_province;
+		memory::vector<int64_t> pixel_x_sum_per_province;
+		memory::vector<int64_t> pixel_y_sum_per_province;
+		// Indexed by province index * terrain_type_count + terrain type index
+		memory::vector<uint32_t> terrain_type_pixels;
+		// The index of the first pixel counted in terrain_type_pixels, only valid where the count is non-zero
+		memory::vector<uint32_t> first_terrain_type_pixel;
+		// Unrecognised colours and where they first appear, in the order they first appear
+		ordered_map<colour_t, ivec2_t> unrecognised_province_colours;
+	};
+	const size_t band_count = std::min<size_t>(get_height(), get_concurrent_task_limit());
+	memory::vector<band_tally_t> band_tallies(band_count);
+
+	for_each_index_concurrently(band_count, [&](const size_t band_index) -> void {
+		band_tally_t& tally = band_tallies[band_index];
+		tally.pixels_per_province.resize(province_count);
+		tally.pixel_x_sum_per_province.resize(province_count);
+		tally.pixel_y_sum_per_province.resize(province_count);
+		tally.terrain_type_pixels.resize(province_count * terrain_type_count);
+		tally.first_terrain_type_pixel.resize(province_count * terrain_type_count);
+
+		const int32_t band_start = get_height() * band_index / band_count;
+		const int32_t band_end = get_height() * (band_index + 1) / band_count;
+
+		for (ivec2_t pos { 0, band_start }; pos.y < band_end; ++pos.y) {
+			for (pos.x = 0; pos.x < get_width(); ++pos.x) {
+				const size_t pixel_index = get_pixel_index_from_pos(pos);
+				const colour_t province_colour = colour_at(province_data, pixel_index);
+				ProvinceDefinition::province_number_t province_number;
+
+				// The row above is only reused within this band, as other bands' rows may not have been processed yet
+				if (pos.x > 0 && colour_at(province_data, pixel_index - 1) == province_colour) {
+					province_number = province_shape_image_storage[pixel_index - 1].province_number;
+				} else if (pos.y > band_start && colour_at(province_data, pixel_index - get_width()) == province_colour) {
+					province_number = province_shape_image_storage[pixel_index - get_width()].province_number;
+				} else {
+					province_number = get_province_number_from_colour(province_colour);
+					if (province_number == ProvinceDefinition::NULL_PROVINCE_NUMBER) {
+						tally.unrecognised_province_colours.emplace(province_colour, pos);
+					}
 				}
-			}
-
-		index_found:
-			province_shape_image[pixel_index].province_number = province_number;
 
-			if (province_number != ProvinceDefinition::NULL_PROVINCE_NUMBER) {
-				const province_index_t province_index = ProvinceDefinition::get_index_from_province_number(province_number);
-				pixels_per_province[province_index]++;
-				pixel_position_sum_per_province[province_index] += static_cast<fvec2_t>(pos);
-			}
+				const terrain_lookup_t terrain = terrain_lookup[terrain_data[pixel_index]];
+				province_shape_image_storage[pixel_index] = { province_number, terrain.shape_terrain };
 
-			const TerrainTypeMapping::index_t terrain = terrain_data[pixel_index];
-			TerrainTypeMapping const* mapping = terrain_type_manager.get_terrain_type_mapping_for(terrain);
-			if (mapping != nullptr) {
 				if (province_number != ProvinceDefinition::NULL_PROVINCE_NUMBER) {
-					const province_index_t province_index = ProvinceDefinition::get_index_from_province_number(province_number);
-					terrain_type_pixels_list[province_index][&mapping->type]++;
+					const size_t province_index = type_safe::get(
+						ProvinceDefinition::get_index_from_province_number(province_number)
+					);
+					tally.pixels_per_province[province_index]++;
+					tally.pixel_x_sum_per_province[province_index] += pos.x;
+					tally.pixel_y_sum_per_province[province_index] += pos.y;
+
+					if (terrain.terrain_type_index < terrain_type_count) {
+						const size_t terrain_pixels_index = province_index * terrain_type_count + terrain.terrain_type_index;
+						if (tally.terrain_type_pixels[terrain_pixels_index]++ == 0) {
+							tally.first_terrain_type_pixel[terrain_pixels_index] = static_cast<uint32_t>(pixel_index);
+						}
+					}
 				}
-				if (mapping->has_texture && terrain < terrain_type_manager.get_terrain_texture_limit()) {
-					province_shape_image[pixel_index].terrain = terrain + 1;
-				} else {
-					province_shape_image[pixel_index].terrain = 0;
+			}
+		}
+	});
+
+	band_tally_t& total_tally = band_tallies.front();
+	for (size_t band_index = 1; band_index < band_count; ++band_index) {
+		band_tally_t const& tally = band_tallies[band_index];
+		for (size_t province_index = 0; province_index < province_count; ++province_index) {
+			total_tally.pixels_per_province[province_index] += tally.pixels_per_province[province_index];
+			total_tally.pixel_x_sum_per_province[province_index] += tally.pixel_x_sum_per_province[province_index];
+			total_tally.pixel_y_sum_per_province[province_index] += tally.pixel_y_sum_per_province[province_index];
+		}
+		for (size_t terrain_pixels_index = 0; terrain_pixels_index < tally.terrain_type_pixels.size(); ++terrain_pixels_index) {
+			const uint32_t terrain_pixels = tally.terrain_type_pixels[terrain_pixels_index];
+			if (terrain_pixels > 0) {
+				if (total_tally.terrain_type_pixels[terrain_pixels_index] == 0) {
+					total_tally.first_terrain_type_pixel[terrain_pixels_index] = tally.first_terrain_type_pixel[terrain_pixels_index];
 				}
-			} else {
-				province_shape_image[pixel_index].terrain = 0;
+				total_tally.terrain_type_pixels[terrain_pixels_index] += terrain_pixels;
 			}
 		}
+		for (auto const& [colour, pos] : tally.unrecognised_province_colours) {
+			total_tally.unrecognised_province_colours.emplace(colour, pos);
+		}
 	}
 
-	if (!unrecognised_province_colours.empty()) {
-		spdlog::warn_s("Province image contains {} unrecognised province colours", unrecognised_province_colours.size());
+	bool ret = true;
+
+	unrecognised_province_colours.clear();
+	unrecognised_province_colours.reserve(total_tally.unrecognised_province_colours.size());
+	for (auto const& [colour, pos] : total_tally.unrecognised_province_colours) {
+		unrecognised_province_colours.push_back({ colour.as_rgb(), pos });
 	}
 
-	size_t missing = 0;
 	for (ProvinceDefinition& province : province_definitions.get_items()) {
-		const province_index_t province_index = province.index;
-		fixed_point_map_t<TerrainType const*> const& terrain_type_pixels = terrain_type_pixels_list[province_index];
-		const fixed_point_map_const_iterator_t<TerrainType const*> largest = get_largest_item(terrain_type_pixels);
-		province.default_terrain_type = largest != terrain_type_pixels.end() ? largest->first : nullptr;
+		const size_t province_index = type_safe::get(province.index);
+
+		// Ties go to the terrain type which appears first, matching max_element over terrain types in order of appearance
+		province.default_terrain_type = nullptr;
+		uint32_t largest_terrain_pixels = 0, largest_first_pixel = 0;
+		for (size_t terrain_type_index = 0; terrain_type_index < terrain_type_count; ++terrain_type_index) {
+			const size_t terrain_pixels_index = province_index * terrain_type_count + terrain_type_index;
+			const uint32_t terrain_pixels = total_tally.terrain_type_pixels[terrain_pixels_index];
+			const uint32_t first_pixel = total_tally.first_terrain_type_pixel[terrain_pixels_index];
+			if (terrain_pixels > largest_terrain_pixels || (
+				terrain_pixels > 0 && terrain_pixels == largest_terrain_pixels && first_pixel < largest_first_pixel
+			)) {
+				province.default_terrain_type = terrain_type_manager.get_terrain_type_by_index(
+					terrain_type_index_t(terrain_type_index)
+				);
+				largest_terrain_pixels = terrain_pixels;
+				largest_first_pixel = first_pixel;
+			}
+		}
 
-		const fixed_point_t pixel_count = pixels_per_province[province_index];
+		const fixed_point_t pixel_count = total_tally.pixels_per_province[province_index];
 		province.on_map = pixel_count > 0;
 
 		if (province.on_map) {
-			province.centre = pixel_position_sum_per_province[province_index] / pixel_count;
-		} else {
-			if (detailed_errors) {
-				spdlog::warn_s("Province missing from shape image: {}", province.to_string());
-			}
-			missing++;
+			// Sums of whole pixel positions are exact, so summing integers and converting once matches summing fvec2_ts
+			province.centre = fvec2_t {
+				fixed_point_t { total_tally.pixel_x_sum_per_province[province_index] },
+				fixed_point_t { total_tally.pixel_y_sum_per_province[province_index] }
+			} / pixel_count;
 		}
 	}
-	if (missing > 0) {
-		spdlog::warn_s("Province image is missing {} province colours", missing);
-	}
+
+	_warn_about_map_image_problems(detailed_errors);
 
 	/** Generating River Segments
 		1. check pixels up, right, down, and left from last_segment_end for a colour <12
@@ -1007,27 +1292,140 @@ bool MapDefinition::load_map_images(fs::path const& province_path, fs::path cons
 /* REQUIREMENTS:
  * MAP-19, MAP-84
  */
-bool MapDefinition::_generate_standard_province_adjacencies() {
-	bool changed = false;
+memory::vector<MapDefinition::standard_adjacency_t> MapDefinition::_find_standard_province_adjacencies() const {
+	using province_number_t = ProvinceDefinition::province_number_t;
+
+	/* A pair of different provinces found next to each other, either horizontally (wrapping around the map's width) or
+	 * vertically. encounter orders edges the way a row by row scan would meet them: pixel index * 2, plus 1 for the
+	 * neighbour below rather than the one to the right. */
+	struct province_edge_t {
+		uint64_t encounter;
+		province_number_t from, to;
+
+		constexpr std::pair<province_number_t, province_number_t> get_unordered_pair() const {
+			return std::minmax(from, to);
+		}
+	};
+	// Keeps only the first encounter of each unordered pair, leaving edges sorted by pair
+	const auto deduplicate_edges = [](memory::vector<province_edge_t>& edges) -> void {
+		std::sort(edges.begin(), edges.end(), [](province_edge_t const& lhs, province_edge_t const& rhs) -> bool {
+			const std::pair<province_number_t, province_number_t> lhs_pair = lhs.get_unordered_pair();
+			const std::pair<province_number_t, province_number_t> rhs_pair = rhs.get_unordered_pair();
+			return lhs_pair < rhs_pair || (lhs_pair == rhs_pair && lhs.encounter < rhs.encounter);
+		});
+		edges.erase(
+			std::unique(edges.begin(), edges.end(), [](province_edge_t const& lhs, province_edge_t const& rhs) -> bool {
+				return lhs.get_unordered_pair() == rhs.get_unordered_pair();
+			}),
+			edges.end()
+		);
+	};
+
+	const size_t band_count = std::min<size_t>(get_height(), get_concurrent_task_limit());
+	memory::vector<memory::vector<province_edge_t>> band_edges(band_count);
+
+	const auto collect_band_edges = [this, band_count, &band_edges, &deduplicate_edges](const size_t band_index) -> void {
+		memory::vector<province_edge_t>& edges = band_edges[band_index];
+
+		const int32_t band_start = get_height() * band_index / band_count;
+		const int32_t band_end = get_height() * (band_index + 1) / band_count;
+
+		// Most edges repeat the one before them in the same direction along a shared border, so those are skipped early
+		province_edge_t previous_edges[2] {};
+		const auto add_edge = [&edges, &previous_edges](
+			const uint64_t encounter, const province_number_t from, const province_number_t to
+		) -> void {
+			if (from == to || to == ProvinceDefinition::NULL_PROVINCE_NUMBER) {
+				return;
+			}
+			province_edge_t& previous_edge = previous_edges[encounter & 1];
+			if (previous_edge.from == from && previous_edge.to == to) {
+				return;
+			}
+			previous_edge = { encounter, from, to };
+			edges.push_back(previous_edge);
+		};
 
-	const auto generate_adjacency = [this](ProvinceDefinition* current, ivec2_t pos) -> bool {
-		ProvinceDefinition* neighbour = get_province_definition_at(pos);
-		if (neighbour != nullptr) {
-			return add_standard_adjacency(*current, *neighbour);
+		for (ivec2_t pos { 0, band_start }; pos.y < band_end; ++pos.y) {
+			for (pos.x = 0; pos.x < get_width(); ++pos.x) {
+				const province_number_t province_number = get_province_number_at(pos);
+
+				if (province_number != ProvinceDefinition::NULL_PROVINCE_NUMBER) {
+					const uint64_t encounter = static_cast<uint64_t>(get_pixel_index_from_pos(pos)) * 2;
+					add_edge(encounter, province_number, get_province_number_at({ (pos.x + 1) % get_width(), pos.y }));
+					add_edge(encounter + 1, province_number, get_province_number_at({ pos.x, pos.y + 1 }));
+				}
+			}
 		}
-		return false;
+
+		deduplicate_edges(edges);
 	};
+	for_each_index_concurrently(band_count, collect_band_edges);
 
-	for (ivec2_t pos {}; pos.y < get_height(); ++pos.y) {
-		for (pos.x = 0; pos.x < get_width(); ++pos.x) {
-			ProvinceDefinition* cur = get_province_definition_at(pos);
+	memory::vector<province_edge_t> edges;
+	size_t total_edge_count = 0;
+	for (memory::vector<province_edge_t> const& edges_in_band : band_edges) {
+		total_edge_count += edges_in_band.size();
+	}
+	edges.reserve(total_edge_count);
+	for (memory::vector<province_edge_t> const& edges_in_band : band_edges) {
+		edges.insert(edges.end(), edges_in_band.begin(), edges_in_band.end());
+	}
+	band_edges.clear();
+
+	deduplicate_edges(edges);
+	// Adding adjacencies in the order a row by row scan meets them keeps adjacency lists and pathfinding points in that order
+	std::sort(edges.begin(), edges.end(), [](province_edge_t const& lhs, province_edge_t const& rhs) -> bool {
+		return lhs.encounter < rhs.encounter;
+	});
+
+	memory::vector<standard_adjacency_t> standard_adjacencies;
+	standard_adjacencies.reserve(edges.size());
+	for (province_edge_t const& edge : edges) {
+		standard_adjacencies.push_back({ edge.from, edge.to });
+	}
+	return standard_adjacencies;
+}
 
-			if (cur != nullptr) {
-				changed |= generate_adjacency(cur, { (pos.x + 1) % get_width(), pos.y });
-				changed |= generate_adjacency(cur, { pos.x, pos.y + 1 });
+bool MapDefinition::_generate_standard_province_adjacencies() {
+	memory::vector<standard_adjacency_t> standard_adjacencies;
+	if (cached_standard_adjacencies.has_value()) {
+		standard_adjacencies = std::move(*cached_standard_adjacencies);
+		cached_standard_adjacencies.reset();
+	} else {
+		standard_adjacencies = _find_standard_province_adjacencies();
+		if (!derived_map_cache_path.empty()) {
+			if (_save_derived_map_cache(standard_adjacencies)) {
+				SPDLOG_INFO("Saved map image results to derived map cache {}", derived_map_cache_path);
+			} else {
+				spdlog::warn_s(
+					"Failed to save derived map cache {}, map images will be processed again next time", derived_map_cache_path
+				);
 			}
 		}
 	}
+	unrecognised_province_colours.clear();
+
+	memory::FixedVector<size_t, province_index_t> new_adjacency_count_per_province(
+		province_index_t(province_definitions.size()),
+		[](const province_index_t i) { return size_t { 0 }; }
+	);
+	for (standard_adjacency_t const& adjacency : standard_adjacencies) {
+		++new_adjacency_count_per_province[ProvinceDefinition::get_index_from_province_number(adjacency.from)];
+		++new_adjacency_count_per_province[ProvinceDefinition::get_index_from_province_number(adjacency.to)];
+	}
+	for (ProvinceDefinition& province : province_definitions.get_items()) {
+		province.adjacencies.reserve(province.adjacencies.size() + new_adjacency_count_per_province[province.index]);
+	}
+
+	bool changed = false;
+	for (standard_adjacency_t const& adjacency : standard_adjacencies) {
+		ProvinceDefinition* from = get_province_definition_from_number(adjacency.from);
+		ProvinceDefinition* to = get_province_definition_from_number(adjacency.to);
+		if (from != nullptr && to != nullptr) {
+			changed |= add_standard_adjacency(*from, *to);
+		}
+	}
 
 	return changed;
 }
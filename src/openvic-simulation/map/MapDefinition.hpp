@@ -3,11 +3,14 @@
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <optional>
+#include <span>
 #include <string_view>
 
 #include <openvic-dataloader/csv/LineObject.hpp>
 
 #include "openvic-simulation/core/io/BMP.hpp"
+#include "openvic-simulation/core/io/MappedFile.hpp"
 #include "openvic-simulation/core/memory/Vector.hpp"
 #include "openvic-simulation/core/object/Vector.hpp"
 #include "openvic-simulation/map/ProvinceDefinition.hpp"
@@ -62,15 +65,43 @@ namespace OpenVic {
 		void _trace_river(BMP& rivers_bmp, ivec2_t start, river_t& river);
 
 		ivec2_t PROPERTY(dims, { 0, 0 });
-		memory::vector<shape_pixel_t> SPAN_PROPERTY(province_shape_image);
+		memory::vector<shape_pixel_t> province_shape_image_storage;
+		/* Views either province_shape_image_storage or, if it was loaded from the derived map cache, derived_map_cache_file. */
+		std::span<const shape_pixel_t> SPAN_PROPERTY(province_shape_image);
 		colour_index_map_t colour_index_map;
 
+		/* A standard adjacency found in the shape image, in the orientation add_standard_adjacency is called with. */
+		struct standard_adjacency_t {
+			ProvinceDefinition::province_number_t from, to;
+		};
+		/* A colour in the province image with no province and where it first appears, in the order they first appear. */
+		struct unrecognised_province_colour_t {
+			colour_t::integer_type colour;
+			ivec2_t pos;
+		};
+		memory::vector<unrecognised_province_colour_t> unrecognised_province_colours;
+		void _warn_about_map_image_problems(bool detailed_errors) const;
+
+		/* The products of load_map_images and the standard adjacencies depend only on the map images, the provinces' colours
+		 * and the terrain type mappings, so they can be cached between runs, keyed by a hash of those. The cache file stays
+		 * mapped while it is in use so the shape image can be read from it in place. */
+		fs::path derived_map_cache_path;
+		uint64_t derived_map_cache_key = 0;
+		MappedFile derived_map_cache_file;
+		/* Set if the standard adjacencies were loaded from the cache, until they are added. */
+		std::optional<memory::vector<standard_adjacency_t>> cached_standard_adjacencies;
+
+		bool _load_derived_map_cache();
+		bool _save_derived_map_cache(std::span<const standard_adjacency_t> standard_adjacencies) const;
+
 		ProvinceDefinition::index_t PROPERTY(max_provinces);
 
 		PointMap PROPERTY_REF(path_map_land);
 		PointMap PROPERTY_REF(path_map_sea);
 
 		ProvinceDefinition::province_number_t get_province_number_from_colour(colour_t colour) const;
+		/* Standard adjacencies in the order a row by row scan of the shape image first meets them. */
+		memory::vector<standard_adjacency_t> _find_standard_province_adjacencies() const;
 		bool _generate_standard_province_adjacencies();
 
 		inline constexpr int32_t get_pixel_index_from_pos(ivec2_t pos) const {
@@ -138,7 +169,12 @@ namespace OpenVic {
 		bool load_province_positions(BuildingTypeManager const& building_type_manager, ast::NodeCPtr root);
 		static bool load_region_colours(ast::NodeCPtr root, memory::vector<colour_t>& colours);
 		bool load_region_file(ast::NodeCPtr root, std::span<const colour_t> colours);
-		bool load_map_images(fs::path const& province_path, fs::path const& terrain_path, fs::path const& rivers_path, bool detailed_errors);
+		/* If new_derived_map_cache_path is not empty, the results are loaded from the cache there when it matches the images,
+		 * otherwise they are saved to it once the standard adjacencies have been generated. */
+		bool load_map_images(
+			fs::path const& province_path, fs::path const& terrain_path, fs::path const& rivers_path, bool detailed_errors,
+			fs::path const& new_derived_map_cache_path = {}
+		);
 		bool generate_and_load_province_adjacencies(std::span<const ovdl::csv::LineObject> additional_adjacencies);
 		bool load_climate_file(ModifierManager const& modifier_manager, ast::NodeCPtr root);
 		bool load_continent_file(ModifierManager const& modifier_manager, ast::NodeCPtr root);
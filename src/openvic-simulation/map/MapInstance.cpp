@@ -1,9 +1,12 @@
 #include "MapInstance.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <optional>
 #include <tuple>
 
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/country/CountryInstance.hpp"
 #include "openvic-simulation/history/ProvinceHistory.hpp"
 #include "openvic-simulation/map/MapDefinition.hpp"
 #include "openvic-simulation/politics/Reform.hpp"
@@ -146,8 +149,24 @@ bool MapInstance::apply_history_to_provinces(
 }
 
 void MapInstance::update_modifier_sums(const Date today, StaticModifierCache const& static_modifier_cache) {
+	// Only provinces whose modifiers or controller changed have their contributions to country sums replaced
+	memory::vector<CountryInstance*> countries_with_stale_contributions;
 	for (ProvinceInstance& province : get_province_instances()) {
 		province.update_modifier_sum(today, static_modifier_cache);
+
+		CountryInstance* const contributed_to = province.get_modifier_sum_contributed_to();
+		if (province.is_modifier_sum_contribution_stale() && contributed_to != nullptr) {
+			countries_with_stale_contributions.push_back(contributed_to);
+		}
+	}
+
+	std::sort(countries_with_stale_contributions.begin(), countries_with_stale_contributions.end());
+	countries_with_stale_contributions.erase(
+		std::unique(countries_with_stale_contributions.begin(), countries_with_stale_contributions.end()),
+		countries_with_stale_contributions.end()
+	);
+	for (CountryInstance* country : countries_with_stale_contributions) {
+		country->remove_stale_province_modifier_sums();
 	}
 
 	for (ProvinceInstance& province : get_province_instances()) {
@@ -155,14 +174,14 @@ void MapInstance::update_modifier_sums(const Date today, StaticModifierCache con
 	}
 }
 
-void MapInstance::update_gamestate(InstanceManager const& instance_manager) {
+void MapInstance::update_gamestate() {
 	highest_province_population = 0;
 	total_map_population = 0;
 
-	for (ProvinceInstance& province : get_province_instances()) {
-		province.update_gamestate(instance_manager);
+	thread_pool.process_province_update_gamestate();
 
-		// Update population stats
+	// Update population stats
+	for (ProvinceInstance const& province : get_province_instances()) {
 		const pop_sum_t province_population = province.get_total_population();
 		if (highest_province_population < province_population) {
 			highest_province_population = province_population;
@@ -170,7 +189,7 @@ void MapInstance::update_gamestate(InstanceManager const& instance_manager) {
 
 		total_map_population += province_population;
 	}
-	state_manager.update_gamestate();
+	state_manager.update_gamestate(thread_pool);
 }
 
 void MapInstance::map_tick() {
@@ -180,7 +199,7 @@ void MapInstance::map_tick() {
 	//state tick will update pop employment via factories
 }
 
-void MapInstance::initialise_for_new_game(InstanceManager const& instance_manager) {
-	update_gamestate(instance_manager);
+void MapInstance::initialise_for_new_game() {
+	update_gamestate();
 	thread_pool.process_province_initialise_for_new_game();
 }
\ No newline at end of file
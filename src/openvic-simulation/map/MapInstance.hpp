@@ -86,8 +86,8 @@ namespace OpenVic {
 		);
 
 		void update_modifier_sums(const Date today, StaticModifierCache const& static_modifier_cache);
-		void update_gamestate(InstanceManager const& instance_manager);
+		void update_gamestate();
 		void map_tick();
-		void initialise_for_new_game(InstanceManager const& instance_manager);
+		void initialise_for_new_game();
 	};
 }
@@ -2,6 +2,7 @@
 #include "ProvinceInstanceDeps.hpp"
 #include "population/PopsAggregateDeps.hpp"
 
+#include <algorithm>
 #include <type_traits>
 
 #include "openvic-simulation/country/CountryDefinition.hpp"
@@ -96,6 +97,8 @@ bool ProvinceInstance::set_owner(CountryInstance* new_owner) {
 		}
 
 		owner = new_owner;
+		// is_owner_core may have changed
+		modifier_sum_dirty = true;
 
 		update_parties_for_votes(new_owner);
 
@@ -145,8 +148,16 @@ bool ProvinceInstance::set_controller(CountryInstance* new_controller) {
 	return ret;
 }
 
+void ProvinceInstance::set_crime(Crime const* new_crime) {
+	if (crime != new_crime) {
+		crime = new_crime;
+		modifier_sum_dirty = true;
+	}
+}
+
 bool ProvinceInstance::add_core(CountryInstance& new_core, bool warn) {
 	if (cores.emplace(&new_core).second) {
+		modifier_sum_dirty = true;
 		return new_core.add_core_province(*this);
 	} else if (warn) {
 		spdlog::warn_s(
@@ -159,6 +170,7 @@ bool ProvinceInstance::add_core(CountryInstance& new_core, bool warn) {
 
 bool ProvinceInstance::remove_core(CountryInstance& core_to_remove, bool warn) {
 	if (cores.erase(&core_to_remove) > 0) {
+		modifier_sum_dirty = true;
 		return core_to_remove.remove_core_province(*this);
 	} else if (warn) {
 		spdlog::warn_s(
@@ -234,6 +246,27 @@ void ProvinceInstance::_update_pops(MilitaryDefines const& military_defines) {
 }
 
 void ProvinceInstance::update_modifier_sum(Date today, StaticModifierCache const& static_modifier_cache) {
+	const bool has_expired_event_modifier = std::any_of(
+		event_modifiers.begin(), event_modifiers.end(),
+		[today](ModifierInstance const& modifier) -> bool {
+			return today > modifier.get_expiry_date();
+		}
+	);
+
+	if (modifier_sum_dirty || has_expired_event_modifier) {
+		_rebuild_modifier_sum(today, static_modifier_cache);
+		modifier_sum_dirty = false;
+		modifier_sum_contribution_stale = true;
+	} else if (controller != modifier_sum_contributed_to) {
+		modifier_sum_contribution_stale = true;
+	}
+
+	if (modifier_sum_contribution_stale && controller != nullptr) {
+		controller->make_room_for_province_modifier_sum(modifier_sum);
+	}
+}
+
+void ProvinceInstance::_rebuild_modifier_sum(Date today, StaticModifierCache const& static_modifier_cache) {
 	// Update sum of direct province modifiers
 	modifier_sum.clear();
 
@@ -282,16 +315,18 @@ void ProvinceInstance::update_modifier_sum(Date today, StaticModifierCache const
 	if (crime != nullptr) {
 		modifier_sum.add_modifier(*crime);
 	}
-
-	if (controller != nullptr) {
-		controller->make_room_for_province_modifier_sum(modifier_sum);
-	}
 }
 
 void ProvinceInstance::update_country_modifier_sum() {
+	if (!modifier_sum_contribution_stale) {
+		return;
+	}
+
 	if (controller != nullptr) {
 		controller->contribute_province_modifier_sum(modifier_sum);
 	}
+	modifier_sum_contributed_to = controller;
+	modifier_sum_contribution_stale = false;
 }
 
 fixed_point_t ProvinceInstance::get_modifier_effect_value(ModifierEffect const& effect) const {
@@ -332,12 +367,15 @@ bool ProvinceInstance::convert_rgo_worker_pops_to_equivalent(
 	return is_valid_operation;
 }
 
-void ProvinceInstance::update_gamestate(InstanceManager const& instance_manager) {
+void ProvinceInstance::update_gamestate(
+	const Date today,
+	MapInstance const& map_instance,
+	MilitaryDefines const& military_defines
+) {
 	has_empty_adjacent_province = false;
 	// We assume there are no duplicate province adjacencies, so each adjacency.get_to() is unique in the loop below
 	adjacent_nonempty_land_provinces.clear();
 
-	MapInstance const& map_instance = instance_manager.get_map_instance();
 	for (ProvinceDefinition::adjacency_t const& adjacency : province_definition.get_adjacencies()) {
 		ProvinceDefinition const& adjacent_to_definition = adjacency.get_to();
 		ProvinceInstance const& adjacent_to_instance = map_instance.get_province_instance_by_definition(adjacent_to_definition);
@@ -363,18 +401,19 @@ void ProvinceInstance::update_gamestate(InstanceManager const& instance_manager)
 		occupation_duration = 0;
 	}
 
-	const Date today = instance_manager.get_today();
-
 	for (BuildingInstance& building : buildings) {
 		building.update_gamestate(today);
 	}
-	_update_pops(instance_manager.definition_manager.get_define_manager().get_military_defines());
+	_update_pops(military_defines);
 }
 
 void ProvinceInstance::province_tick(
 	const Date today,
 	PopValuesFromProvince& reusable_pop_values,
 	RandomU32& random_number_generator,
+	MarketOrderBuffer& market_order_buffer,
+	MarketOrderBuffer& rgo_market_order_buffer,
+	CountryReportBuffer& country_report_buffer,
 	TypedSpan<good_index_t, char> reusable_goods_mask,
 	forwardable_span<
 		memory::vector<fixed_point_t>,
@@ -391,6 +430,8 @@ void ProvinceInstance::province_tick(
 			pop.pop_tick(
 				reusable_pop_values,
 				random_number_generator,
+				market_order_buffer,
+				country_report_buffer,
 				reusable_goods_mask,
 				reusable_vectors
 			);
@@ -400,7 +441,7 @@ void ProvinceInstance::province_tick(
 	for (BuildingInstance& building : buildings) {
 		building.tick(today);
 	}
-	rgo.rgo_tick(reusable_vectors[0]);
+	rgo.rgo_tick(rgo_market_order_buffer, country_report_buffer, reusable_vectors[0]);
 }
 
 bool ProvinceInstance::add_unit_instance_group(UnitInstanceGroup& group) {
@@ -487,6 +528,8 @@ bool ProvinceInstance::apply_history_to_province(ProvinceHistoryEntry const& ent
 
 	set_optional(life_rating, entry.get_life_rating());
 	set_optional(terrain_type, entry.get_terrain_type());
+	// History can change the terrain, which has no dirty hook of its own
+	modifier_sum_dirty = true;
 	for (province_building_index_t i(0); i < entry.get_province_building_levels().size(); ++i) {
 		const building_level_t level = entry.get_province_building_levels()[i];
 		BuildingInstance& building = buildings[i];
@@ -506,6 +549,9 @@ void ProvinceInstance::initialise_for_new_game(
 	const Date today,
 	PopValuesFromProvince& reusable_pop_values,
 	RandomU32& random_number_generator,
+	MarketOrderBuffer& market_order_buffer,
+	MarketOrderBuffer& rgo_market_order_buffer,
+	CountryReportBuffer& country_report_buffer,
 	TypedSpan<good_index_t, char> reusable_goods_mask,
 	forwardable_span<
 		memory::vector<fixed_point_t>,
@@ -517,6 +563,9 @@ void ProvinceInstance::initialise_for_new_game(
 		today,
 		reusable_pop_values,
 		random_number_generator,
+		market_order_buffer,
+		rgo_market_order_buffer,
+		country_report_buffer,
 		reusable_goods_mask,
 		reusable_vectors
 	);
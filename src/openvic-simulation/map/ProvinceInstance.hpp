@@ -29,12 +29,14 @@ namespace OpenVic {
 	struct CountryInstance;
 	struct CountryInstanceManager;
 	struct CountryParty;
+	struct CountryReportBuffer;
 	struct Crime;
 	struct Culture;
 	struct GameRulesManager;
 	struct GoodDefinition;
 	struct Ideology;
 	struct InstanceManager;
+	struct MarketOrderBuffer;
 	struct MapInstance;
 	struct MilitaryDefines;
 	struct PopDeps;
@@ -56,6 +58,7 @@ namespace OpenVic {
 		FlagStrings,
 		PopsAggregate {
 		friend struct MapInstance;
+		friend struct InstanceSave;
 
 		static constexpr std::string_view get_colony_status_string(colony_status_t colony_status) {
 			using enum colony_status_t;
@@ -88,6 +91,11 @@ namespace OpenVic {
 		// The total/resultant modifier of local effects on this province (global effects come from the province's owner)
 		ModifierSum PROPERTY(modifier_sum);
 		memory::vector<ModifierInstance> SPAN_PROPERTY(event_modifiers);
+		// Set by anything changing which modifiers apply to the province, so update_modifier_sum can skip unchanged provinces.
+		bool modifier_sum_dirty = true;
+		// Whether modifier_sum_contributed_to's sum is missing this province's current modifier_sum.
+		bool PROPERTY_CUSTOM_PREFIX(modifier_sum_contribution_stale, is, true);
+		CountryInstance* PROPERTY_PTR(modifier_sum_contributed_to, nullptr);
 
 		bool PROPERTY(slave, false);
 		// Used for "minorities = yes/no" condition
@@ -96,7 +104,7 @@ namespace OpenVic {
 		bool PROPERTY_RW(is_overseas, false);
 		bool PROPERTY(has_empty_adjacent_province, false);
 		memory::vector<std::reference_wrapper<const ProvinceInstance>> SPAN_PROPERTY(adjacent_nonempty_land_provinces);
-		Crime const* PROPERTY_RW(crime, nullptr);
+		Crime const* PROPERTY(crime, nullptr);
 		ResourceGatheringOperation PROPERTY(rgo);
 		memory::FixedVector<BuildingInstance, province_building_index_t> buildings;
 	public:
@@ -123,6 +131,7 @@ namespace OpenVic {
 			ProductionType const& production_type
 		);
 		void initialise_rgo();
+		void _rebuild_modifier_sum(Date today, StaticModifierCache const& static_modifier_cache);
 
 		memory::FixedVector<
 			memory::vector<std::reference_wrapper<Pop>>,
@@ -154,6 +163,7 @@ namespace OpenVic {
 
 		bool set_owner(CountryInstance* new_owner);
 		bool set_controller(CountryInstance* new_controller);
+		void set_crime(Crime const* new_crime);
 
 		// The warn argument controls whether a log message is emitted when a core already does/doesn't exist, e.g. we may
 		// want to know if there are redundant province history instructions setting a core multiple times, but we may not
@@ -189,7 +199,10 @@ namespace OpenVic {
 		);
 		size_t get_pop_count() const;
 
+		// Only rebuilds modifier_sum if the province's modifiers changed since the last update.
 		void update_modifier_sum(Date today, StaticModifierCache const& static_modifier_cache);
+		// Adds modifier_sum to the controller's sum if it isn't already there, expects the stale contribution
+		// to have been removed via CountryInstance::remove_stale_province_modifier_sums.
 		void update_country_modifier_sum();
 		fixed_point_t get_modifier_effect_value(ModifierEffect const& effect) const;
 
@@ -205,7 +218,8 @@ namespace OpenVic {
 				get_owner_modifier_sum().for_each_contributing_modifier(effect, std::move(callback));
 			}
 		}
-		void update_gamestate(InstanceManager const& instance_manager);
+		// Only writes to this province and its pops, so provinces can be updated in parallel.
+		void update_gamestate(const Date today, MapInstance const& map_instance, MilitaryDefines const& military_defines);
 		static constexpr size_t VECTORS_FOR_PROVINCE_TICK = std::max(
 			ResourceGatheringOperation::VECTORS_FOR_RGO_TICK,
 			Pop::VECTORS_FOR_POP_TICK
@@ -214,6 +228,9 @@ namespace OpenVic {
 			const Date today,
 			PopValuesFromProvince& reusable_pop_values,
 			RandomU32& random_number_generator,
+			MarketOrderBuffer& market_order_buffer,
+			MarketOrderBuffer& rgo_market_order_buffer,
+			CountryReportBuffer& country_report_buffer,
 			TypedSpan<good_index_t, char> reusable_goods_mask,
 			forwardable_span<
 				memory::vector<fixed_point_t>,
@@ -224,6 +241,9 @@ namespace OpenVic {
 			const Date today,
 			PopValuesFromProvince& reusable_pop_values,
 			RandomU32& random_number_generator,
+			MarketOrderBuffer& market_order_buffer,
+			MarketOrderBuffer& rgo_market_order_buffer,
+			CountryReportBuffer& country_report_buffer,
 			TypedSpan<good_index_t, char> reusable_goods_mask,
 			forwardable_span<
 				memory::vector<fixed_point_t>,
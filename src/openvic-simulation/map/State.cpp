@@ -11,6 +11,7 @@
 #include "openvic-simulation/population/PopType.hpp"
 #include "openvic-simulation/types/ConstructorTags.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/utility/ThreadPool.hpp"
 
 using namespace OpenVic;
 
@@ -91,7 +92,6 @@ void State::update_gamestate() {
 	}
 
 	industrial_power = total_factory_levels_in_state * workforce_scalar;
-	_update_country();
 }
 
 void State::_update_country() {
@@ -223,9 +223,14 @@ void StateManager::reset() {
 	state_sets.clear();
 }
 
-void StateManager::update_gamestate() {
+void StateManager::update_gamestate(ThreadPool& thread_pool) {
+	thread_pool.process_state_set_update_gamestate(state_sets);
+
+	// Adding and removing states from countries touches country state sets, so is done serially
 	for (StateSet& state_set : state_sets) {
-		state_set.update_gamestate();
+		for (State& state : state_set.states) {
+			state._update_country();
+		}
 	}
 }
 
@@ -28,9 +28,11 @@ namespace OpenVic {
 	struct StateManager;
 	struct StateSet;
 	struct Strata;
+	struct ThreadPool;
 
 	struct State : PopsAggregate {
 		friend struct StateManager;
+		friend struct InstanceSave;
 
 	private:
 		CountryInstance* previous_country_ptr = nullptr;
@@ -70,6 +72,7 @@ namespace OpenVic {
 			return is_colonial(colony_status);
 		}
 
+		// Only aggregates this state's provinces, owner changes are applied serially by StateManager::update_gamestate.
 		void update_gamestate();
 	};
 
@@ -77,6 +80,7 @@ namespace OpenVic {
 
 	struct StateSet {
 		friend struct StateManager;
+		friend struct InstanceSave;
 
 		using states_t = memory::colony<State>;
 
@@ -97,6 +101,8 @@ namespace OpenVic {
 
 	/* Contains all current states.*/
 	struct StateManager {
+		friend struct InstanceSave;
+
 	private:
 		memory::vector<StateSet> SPAN_PROPERTY(state_sets);
 
@@ -121,7 +127,8 @@ namespace OpenVic {
 
 		void reset();
 
-		void update_gamestate();
+		// State sets are aggregated in parallel, then owner changes are applied in state set order.
+		void update_gamestate(ThreadPool& thread_pool);
 	};
 }
 
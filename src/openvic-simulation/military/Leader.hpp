@@ -16,6 +16,7 @@ namespace OpenVic {
 	struct LeaderBase {
 		friend struct DeploymentManager;
 		friend struct UnitInstanceManager;
+		friend struct InstanceSave;
 
 	private:
 		memory::string PROPERTY(name);
@@ -48,6 +49,7 @@ namespace OpenVic {
 
 		friend struct UnitInstanceManager;
 		friend struct UnitInstanceGroup;
+		friend struct InstanceSave;
 
 	private:
 		UnitInstanceGroup* PROPERTY_PTR(unit_instance_group, nullptr);
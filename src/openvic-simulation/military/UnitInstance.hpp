@@ -11,6 +11,8 @@
 namespace OpenVic {
 
 	struct UnitInstance {
+		friend struct InstanceSave;
+
 	private:
 		memory::string PROPERTY(name);
 		fixed_point_t PROPERTY(organisation);
@@ -50,6 +52,7 @@ namespace OpenVic {
 	template<>
 	struct UnitInstanceBranched<unit_branch_t::LAND> : UnitInstance {
 		friend struct UnitInstanceManager;
+		friend struct InstanceSave;
 
 	private:
 		Pop* PROPERTY_PTR(pop);
@@ -74,6 +77,7 @@ namespace OpenVic {
 	template<>
 	struct UnitInstanceBranched<unit_branch_t::NAVAL> : UnitInstance {
 		friend struct UnitInstanceManager;
+		friend struct InstanceSave;
 
 	private:
 		UnitInstanceBranched(
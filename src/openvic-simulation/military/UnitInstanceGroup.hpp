@@ -19,6 +19,8 @@ namespace OpenVic {
 	struct MapInstance;
 
 	struct UnitInstanceGroup {
+		friend struct InstanceSave;
+
 	private:
 		memory::string PROPERTY(name);
 		memory::vector<std::reference_wrapper<UnitInstance>> SPAN_PROPERTY(units);
@@ -91,6 +93,8 @@ namespace OpenVic {
 
 	template<>
 	struct UnitInstanceGroupBranched<unit_branch_t::LAND> : UnitInstanceGroup {
+		friend struct InstanceSave;
+
 		using dig_in_level_t = uint8_t;
 
 	private:
@@ -161,6 +165,8 @@ namespace OpenVic {
 	struct Pop;
 
 	struct UnitInstanceManager {
+		friend struct InstanceSave;
+
 	private:
 		// Used for leader pictures and names
 		CultureManager const& culture_manager;
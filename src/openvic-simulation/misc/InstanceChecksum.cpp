@@ -0,0 +1,162 @@
+#include "InstanceChecksum.hpp"
+
+#include <span>
+
+#include "openvic-simulation/country/CountryInstance.hpp"
+#include "openvic-simulation/ecs/ChecksumTraits.hpp"
+#include "openvic-simulation/InstanceManager.hpp"
+#include "openvic-simulation/map/ProvinceInstance.hpp"
+#include "openvic-simulation/military/UnitInstanceGroup.hpp"
+#include "openvic-simulation/utility/Logger.hpp"
+
+using namespace OpenVic;
+
+namespace {
+	uint64_t fold_checksums(std::span<const uint64_t> checksums, uint64_t checksum = ecs::CHECKSUM_SEED) {
+		for (const uint64_t value : checksums) {
+			checksum = ecs::fold_uint64(value, checksum);
+		}
+		return checksum;
+	}
+
+	std::optional<size_t> find_first_difference(std::span<const uint64_t> lhs, std::span<const uint64_t> rhs) {
+		if (lhs.size() != rhs.size()) {
+			return std::nullopt;
+		}
+		for (size_t index = 0; index < lhs.size(); ++index) {
+			if (lhs[index] != rhs[index]) {
+				return index;
+			}
+		}
+		return std::nullopt;
+	}
+}
+
+bool InstanceChecksum::compute(
+	InstanceManager& instance_manager, InstanceChecksum& checksum, const size_t province_sample_stride
+) {
+	if (
+		instance_manager.currently_updating_gamestate || instance_manager.currently_executing_game_actions ||
+		!instance_manager.is_bookmark_loaded()
+	) {
+		spdlog::error_s("Cannot compute checksum - the game must have a bookmark loaded and be between ticks!");
+		return false;
+	}
+	if (province_sample_stride == 0) {
+		spdlog::error_s("Cannot compute checksum with a province sample stride of 0!");
+		return false;
+	}
+
+	const InstanceSave::write_context_t context { instance_manager };
+
+	const auto hash_with = [](auto write_contents) -> uint64_t {
+		hash_writer_t writer;
+		write_contents(writer);
+		return writer.digest;
+	};
+	const auto section_checksum = [&checksum](const section_t section) -> uint64_t& {
+		return checksum.section_checksums[static_cast<size_t>(section)];
+	};
+
+	section_checksum(section_t::GLOBAL) = hash_with([&instance_manager](hash_writer_t& section_writer) -> void {
+		InstanceSave::write_global(instance_manager, section_writer);
+	});
+
+	checksum.market_checksums.clear();
+	for (GoodMarket const& market : instance_manager.good_instance_manager.get_good_instances()) {
+		checksum.market_checksums.push_back(hash_with([&market](hash_writer_t& section_writer) -> void {
+			InstanceSave::write_market(market, section_writer);
+		}));
+	}
+	section_checksum(section_t::MARKETS) = fold_checksums(checksum.market_checksums);
+
+	checksum.country_checksums.clear();
+	for (CountryInstance const& country : context.countries) {
+		checksum.country_checksums.push_back(hash_with([&context, &country](hash_writer_t& section_writer) -> void {
+			InstanceSave::write_country(context, country, section_writer);
+		}));
+	}
+	section_checksum(section_t::COUNTRIES) = fold_checksums(checksum.country_checksums);
+
+	// Provinces are sampled by index, so which ones are rehashed doesn't depend on how they're split between threads
+	const size_t province_sample_offset =
+		static_cast<size_t>((instance_manager.today - Date {}).to_int()) % province_sample_stride;
+	if (checksum.province_checksums.size() != context.provinces.size()) {
+		checksum.province_checksums.assign(context.provinces.size(), NOT_SAMPLED);
+	}
+	std::span<const uint64_t> previous_province_checksums = checksum.province_checksums;
+	const auto hash_province = [&context, province_sample_stride, province_sample_offset, previous_province_checksums](
+		ProvinceInstance const& province
+	) -> uint64_t {
+		const size_t province_index = type_safe::get(province.index);
+		if (province_index % province_sample_stride != province_sample_offset) {
+			return previous_province_checksums[province_index];
+		}
+		hash_writer_t province_writer;
+		InstanceSave::write_province(context, province, province_writer);
+		return province_writer.digest;
+	};
+	instance_manager.thread_pool.process_province_checksums(
+		ThreadPool::province_checksum_func_t { hash_province }, checksum.province_checksums
+	);
+	section_checksum(section_t::PROVINCES) = fold_checksums(checksum.province_checksums);
+
+	section_checksum(section_t::STATES) = hash_with([&context](hash_writer_t& section_writer) -> void {
+		InstanceSave::write_states(context, section_writer);
+	});
+
+	UnitInstanceManager const& unit_instance_manager = instance_manager.unit_instance_manager;
+	checksum.unit_group_checksums.clear();
+	for (ArmyInstance const& army : unit_instance_manager.get_armies()) {
+		checksum.unit_group_checksums.push_back(hash_with([&context, &army](hash_writer_t& section_writer) -> void {
+			InstanceSave::write_army(context, army, section_writer);
+		}));
+	}
+	for (NavyInstance const& navy : unit_instance_manager.get_navies()) {
+		checksum.unit_group_checksums.push_back(hash_with([&context, &navy](hash_writer_t& section_writer) -> void {
+			InstanceSave::write_navy(context, navy, section_writer);
+		}));
+	}
+	// The army count separates the armies from the navies
+	uint64_t units_checksum = hash_with([&context](hash_writer_t& section_writer) -> void {
+		InstanceSave::write_unit_instances(context, section_writer);
+	});
+	units_checksum = ecs::fold_uint64(unit_instance_manager.get_armies().size(), units_checksum);
+	section_checksum(section_t::UNITS) = fold_checksums(checksum.unit_group_checksums, units_checksum);
+
+	section_checksum(section_t::RELATIONS) = hash_with([&context](hash_writer_t& section_writer) -> void {
+		InstanceSave::write_relations(context, section_writer);
+	});
+
+	checksum.total = fold_checksums(checksum.section_checksums);
+	return true;
+}
+
+std::optional<InstanceChecksum::divergence_t> InstanceChecksum::find_first_divergence(InstanceChecksum const& other) const {
+	if (total == other.total) {
+		return std::nullopt;
+	}
+
+	for (size_t section_index = 0; section_index < SECTION_COUNT; ++section_index) {
+		if (section_checksums[section_index] == other.section_checksums[section_index]) {
+			continue;
+		}
+
+		const section_t section = static_cast<section_t>(section_index);
+		switch (section) {
+			case section_t::MARKETS:
+				return divergence_t { section, find_first_difference(market_checksums, other.market_checksums) };
+			case section_t::COUNTRIES:
+				return divergence_t { section, find_first_difference(country_checksums, other.country_checksums) };
+			case section_t::PROVINCES:
+				return divergence_t { section, find_first_difference(province_checksums, other.province_checksums) };
+			case section_t::UNITS:
+				return divergence_t { section, find_first_difference(unit_group_checksums, other.unit_group_checksums) };
+			default:
+				return divergence_t { section, std::nullopt };
+		}
+	}
+
+	// Only reachable if the totals were folded from different section checksums than the ones stored
+	return divergence_t { section_t::_COUNT, std::nullopt };
+}
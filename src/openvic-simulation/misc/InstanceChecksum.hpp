@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "openvic-simulation/core/io/BinaryStream.hpp"
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/ecs/ChecksumTraits.hpp"
+#include "openvic-simulation/misc/InstanceSave.hpp"
+
+namespace OpenVic {
+	struct InstanceManager;
+
+	/* Deterministic 64-bit digest of an InstanceManager's state, for detecting when two instances which should be in lockstep
+	 * have diverged. Everything InstanceSave writes is hashed, in the same sections, so equal checksums mean equal saves.
+	 * That includes each country's and province's event modifiers and each unit group's units. Values which gamestate
+	 * updates recalculate aren't hashed directly, but a divergence in them shows up in the saved state by the following tick.
+	 *
+	 * Values are folded into the hash as InstanceSave's write functions produce them, rather than being serialised first.
+	 * Markets, countries, provinces and unit groups are also hashed individually, so a divergence can be bisected down to the
+	 * first entity that differs. Provinces are hashed in parallel on the instance's thread pool and folded in index order,
+	 * so the result doesn't depend on the number of threads.
+	 *
+	 * With a province sample stride above 1, only every stride-th province is rehashed, starting from an offset which
+	 * rotates with the date so every province is rehashed over any stride consecutive days. The other provinces keep the
+	 * checksums they had when the checksum was last computed, so a checksum should only be reused for the same instance,
+	 * and checksums are only comparable if they were computed on the same dates with the same stride. Provinces which
+	 * haven't been hashed yet have a checksum of NOT_SAMPLED. */
+	struct InstanceChecksum {
+		using section_t = InstanceSave::section_t;
+
+		static constexpr size_t SECTION_COUNT = static_cast<size_t>(section_t::_COUNT);
+		static constexpr uint64_t NOT_SAMPLED = 0;
+
+		/* Has BinaryWriter's writing interface, but folds the bytes straight into an FNV-1a digest instead of storing them,
+		 * so the digest is the same as hashing a BinaryWriter's data after the same writes. */
+		struct hash_writer_t {
+			uint64_t digest = ecs::CHECKSUM_SEED;
+
+			template<binary_streamable T>
+			void write(T const& value) {
+				digest = ecs::fnv1a_64_bytes(&value, sizeof(T), digest);
+			}
+
+			template<binary_streamable T>
+			void write_span(std::span<const T> values) {
+				write<uint64_t>(values.size());
+				digest = ecs::fnv1a_64_bytes(values.data(), values.size_bytes(), digest);
+			}
+
+			void write_string(std::string_view string) {
+				write_span<char>(string);
+			}
+		};
+
+		struct divergence_t {
+			section_t section;
+			/* Index of the first differing market, country, province or unit group, or std::nullopt for the other sections,
+			 * if the sections have different entity counts and if a units section's unit groups are all the same. Unit groups
+			 * are indexed with the armies first, followed by the navies. */
+			std::optional<size_t> entity_index;
+		};
+
+		uint64_t total = 0;
+		std::array<uint64_t, SECTION_COUNT> section_checksums {};
+		memory::vector<uint64_t> market_checksums;
+		memory::vector<uint64_t> country_checksums;
+		memory::vector<uint64_t> province_checksums;
+		memory::vector<uint64_t> unit_group_checksums;
+
+		/* Must be called between ticks and gamestate updates, like InstanceSave::write. Blocks until the instance's thread
+		 * pool has hashed the provinces. Updates checksum in place, so reusing one avoids reallocating its vectors and lets
+		 * a sampled computation keep the unsampled provinces' checksums. */
+		static bool compute(
+			InstanceManager& instance_manager, InstanceChecksum& checksum, const size_t province_sample_stride = 1
+		);
+
+		/* Returns the first section whose checksums differ, in save order, or std::nullopt if the totals are equal. */
+		std::optional<divergence_t> find_first_divergence(InstanceChecksum const& other) const;
+	};
+}
@@ -0,0 +1,1695 @@
+#include "InstanceSave.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string_view>
+
+#include "openvic-simulation/country/CountryDefinition.hpp"
+#include "openvic-simulation/country/CountryInstance.hpp"
+#include "openvic-simulation/country/CountryParty.hpp"
+#include "openvic-simulation/DefinitionManager.hpp"
+#include "openvic-simulation/ecs/ChecksumTraits.hpp"
+#include "openvic-simulation/history/Bookmark.hpp"
+#include "openvic-simulation/InstanceManager.hpp"
+#include "openvic-simulation/map/Crime.hpp"
+#include "openvic-simulation/map/ProvinceInstance.hpp"
+#include "openvic-simulation/map/Region.hpp"
+#include "openvic-simulation/map/State.hpp"
+#include "openvic-simulation/misc/InstanceChecksum.hpp"
+#include "openvic-simulation/modifier/Modifier.hpp"
+#include "openvic-simulation/politics/Government.hpp"
+#include "openvic-simulation/politics/NationalValue.hpp"
+#include "openvic-simulation/politics/Rebel.hpp"
+#include "openvic-simulation/politics/Reform.hpp"
+#include "openvic-simulation/population/Culture.hpp"
+#include "openvic-simulation/population/Pop.hpp"
+#include "openvic-simulation/population/Religion.hpp"
+#include "openvic-simulation/research/Invention.hpp"
+#include "openvic-simulation/research/Technology.hpp"
+#include "openvic-simulation/types/OrderedContainers.hpp"
+#include "openvic-simulation/utility/Logger.hpp"
+
+using namespace OpenVic;
+
+namespace {
+	/* Items must be contiguous, with item pointing into them or null. */
+	template<typename Items, typename T>
+	uint32_t index_of(Items const& items, T const* item) {
+		return item != nullptr ? static_cast<uint32_t>(item - items.data()) : InstanceSave::NULL_INDEX;
+	}
+
+	template<typename Writer, typename Items, typename T>
+	void write_pointer(Writer& writer, Items const& items, T const* item) {
+		writer.write(index_of(items, item));
+	}
+
+	template<typename Items, typename T>
+	bool read_pointer(BinaryReader& reader, Items& items, T*& item) {
+		uint32_t index = InstanceSave::NULL_INDEX;
+		if (!reader.read(index)) {
+			return false;
+		}
+		if (index == InstanceSave::NULL_INDEX) {
+			item = nullptr;
+			return true;
+		}
+		if (index >= items.size()) {
+			return false;
+		}
+		item = items.data() + index;
+		return true;
+	}
+
+	template<typename Items, typename T>
+	bool read_non_null_pointer(BinaryReader& reader, Items& items, T*& item) {
+		return read_pointer(reader, items, item) && item != nullptr;
+	}
+
+	bool read_count(BinaryReader& reader, uint64_t& count) {
+		return reader.read(count);
+	}
+
+	/* Reads an element count and checks it matches the number of elements in the instance. */
+	bool read_expected_count(BinaryReader& reader, const size_t expected_count) {
+		uint64_t count = 0;
+		return reader.read(count) && count == expected_count;
+	}
+
+	template<typename Writer, typename T>
+	void write_value_history(Writer& writer, ValueHistory<T> const& history) {
+		writer.template write<uint64_t>(history.size());
+		for (T const& value : history) {
+			writer.write(value);
+		}
+	}
+
+	template<typename T>
+	bool read_value_history(BinaryReader& reader, ValueHistory<T>& history) {
+		uint64_t count = 0;
+		if (!reader.read(count) || count > history.capacity()) {
+			return false;
+		}
+		history.clear();
+		for (uint64_t index = 0; index < count; ++index) {
+			T value {};
+			if (!reader.read(value)) {
+				return false;
+			}
+			history.push_back(value);
+		}
+		return true;
+	}
+
+	template<typename Writer>
+	void write_flags(Writer& writer, FlagStrings const& flag_strings) {
+		writer.template write<uint64_t>(flag_strings.get_flags().size());
+		for (std::string_view flag : flag_strings.get_flags()) {
+			writer.write_string(flag);
+		}
+	}
+
+	bool read_flags(BinaryReader& reader, FlagStrings& flag_strings) {
+		const string_set_t old_flags = flag_strings.get_flags();
+		for (std::string_view flag : old_flags) {
+			flag_strings.clear_flag(flag, false);
+		}
+
+		uint64_t count = 0;
+		if (!read_count(reader, count)) {
+			return false;
+		}
+		for (uint64_t index = 0; index < count; ++index) {
+			std::string_view flag;
+			if (!reader.read_string(flag) || !flag_strings.set_flag(flag, false)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename Writer, typename T>
+	void write_state(Writer& writer, MutableState<T> const& state) {
+		writer.write(state.get_untracked());
+	}
+
+	template<typename T>
+	bool read_state(BinaryReader& reader, MutableState<T>& state) {
+		T value = state.get_untracked();
+		if (!reader.read(value)) {
+			return false;
+		}
+		state.set(value);
+		return true;
+	}
+
+	template<typename Writer, typename Items, typename T>
+	void write_state_pointer(Writer& writer, Items const& items, MutableState<T const*> const& state) {
+		write_pointer(writer, items, state.get_untracked());
+	}
+
+	template<typename Items, typename T>
+	bool read_state_pointer(BinaryReader& reader, Items const& items, MutableState<T const*>& state) {
+		T const* value = nullptr;
+		if (!read_pointer(reader, items, value)) {
+			return false;
+		}
+		state.set(value);
+		return true;
+	}
+
+	template<typename Items>
+	uint64_t fold_identifiers(Items const& items, uint64_t fingerprint) {
+		fingerprint = ecs::fold_uint64(items.size(), fingerprint);
+		for (auto const& item : items) {
+			const std::string_view identifier = item.get_identifier();
+			fingerprint = ecs::fold_uint64(identifier.size(), fingerprint);
+			fingerprint = ecs::fnv1a_64_bytes(identifier.data(), identifier.size(), fingerprint);
+		}
+		return fingerprint;
+	}
+
+	/* Event modifiers are stored by their index in the event modifier registry, or NULL_INDEX if they aren't in it. */
+	template<typename EventModifiers>
+	uint32_t event_modifier_index_of(EventModifiers const& event_modifiers, Modifier const* modifier) {
+		for (size_t index = 0; index < event_modifiers.size(); ++index) {
+			if (&event_modifiers[index] == modifier) {
+				return static_cast<uint32_t>(index);
+			}
+		}
+		return InstanceSave::NULL_INDEX;
+	}
+
+	template<typename Writer, typename Map>
+	void write_country_pair_map(Writer& writer, std::span<const CountryInstance> countries, Map const& map) {
+		writer.template write<uint64_t>(map.size());
+		for (auto const& [pair, value] : map) {
+			write_pointer(writer, countries, pair.first);
+			write_pointer(writer, countries, pair.second);
+			writer.write(value);
+		}
+	}
+
+	template<typename Map>
+	bool read_country_pair_map(BinaryReader& reader, std::span<const CountryInstance> countries, Map& map) {
+		using pair_type = typename Map::key_type;
+		using value_type = typename Map::mapped_type;
+
+		map.clear();
+
+		uint64_t count = 0;
+		if (!read_count(reader, count)) {
+			return false;
+		}
+		for (uint64_t index = 0; index < count; ++index) {
+			CountryInstance const* first = nullptr;
+			CountryInstance const* second = nullptr;
+			value_type value {};
+			if (
+				!read_non_null_pointer(reader, countries, first) || !read_non_null_pointer(reader, countries, second) ||
+				!reader.read(value) || !map.emplace(pair_type { first, second }, value).second
+			) {
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+template<typename Instance>
+InstanceSave::context_t<Instance>::context_t(Instance& new_instance_manager) : instance_manager { new_instance_manager },
+	definition_manager { new_instance_manager.definition_manager },
+	countries { new_instance_manager.country_instance_manager.get_country_instances() },
+	provinces { new_instance_manager.map_instance.get_province_instances() } {}
+
+template struct InstanceSave::context_t<InstanceManager const>;
+template struct InstanceSave::context_t<InstanceManager>;
+
+uint64_t InstanceSave::get_definitions_fingerprint(DefinitionManager const& definition_manager) {
+	EconomyManager const& economy_manager = definition_manager.get_economy_manager();
+	MilitaryManager const& military_manager = definition_manager.get_military_manager();
+	PoliticsManager const& politics_manager = definition_manager.get_politics_manager();
+	PopManager const& pop_manager = definition_manager.get_pop_manager();
+	ResearchManager const& research_manager = definition_manager.get_research_manager();
+
+	uint64_t fingerprint = ecs::CHECKSUM_SEED;
+	fingerprint = fold_identifiers(
+		definition_manager.get_history_manager().get_bookmark_manager().get_bookmarks(), fingerprint
+	);
+	fingerprint = fold_identifiers(definition_manager.get_map_definition().get_province_definitions(), fingerprint);
+	fingerprint = fold_identifiers(economy_manager.get_building_type_manager().get_building_types(), fingerprint);
+	fingerprint = fold_identifiers(economy_manager.get_good_definition_manager().get_good_definitions(), fingerprint);
+	fingerprint = fold_identifiers(economy_manager.get_production_type_manager().get_production_types(), fingerprint);
+	fingerprint = fold_identifiers(definition_manager.get_crime_manager().get_crime_modifiers(), fingerprint);
+	fingerprint = fold_identifiers(definition_manager.get_modifier_manager().get_event_modifiers(), fingerprint);
+	fingerprint = fold_identifiers(military_manager.get_leader_trait_manager().get_leader_traits(), fingerprint);
+	fingerprint = fold_identifiers(military_manager.get_unit_type_manager().get_regiment_types(), fingerprint);
+	fingerprint = fold_identifiers(military_manager.get_unit_type_manager().get_ship_types(), fingerprint);
+	fingerprint = fold_identifiers(politics_manager.get_government_type_manager().get_government_types(), fingerprint);
+	fingerprint = fold_identifiers(politics_manager.get_issue_manager().get_reforms(), fingerprint);
+	fingerprint = fold_identifiers(politics_manager.get_national_value_manager().get_national_values(), fingerprint);
+	fingerprint = fold_identifiers(politics_manager.get_rebel_manager().get_rebel_types(), fingerprint);
+	fingerprint = fold_identifiers(pop_manager.get_stratas(), fingerprint);
+	fingerprint = fold_identifiers(pop_manager.get_pop_types(), fingerprint);
+	fingerprint = fold_identifiers(pop_manager.get_culture_manager().get_cultures(), fingerprint);
+	fingerprint = fold_identifiers(pop_manager.get_religion_manager().get_religions(), fingerprint);
+	fingerprint = fold_identifiers(research_manager.get_technology_manager().get_technologies(), fingerprint);
+	fingerprint = fold_identifiers(research_manager.get_invention_manager().get_inventions(), fingerprint);
+
+	memory::vector<CountryDefinition> const& country_definitions =
+		definition_manager.get_country_definition_manager().get_country_definitions();
+	fingerprint = fold_identifiers(country_definitions, fingerprint);
+	for (CountryDefinition const& country_definition : country_definitions) {
+		fingerprint = fold_identifiers(country_definition.get_parties(), fingerprint);
+	}
+	return fingerprint;
+}
+
+bool InstanceSave::read_header(BinaryReader& reader, header_t& header) {
+	if (!reader.read(header)) {
+		spdlog::error_s("Save is too short to contain a header!");
+		return false;
+	}
+	if (header.magic != MAGIC) {
+		spdlog::error_s("Save has an invalid header - it is not an OpenVic save!");
+		return false;
+	}
+	if (header.version != VERSION) {
+		spdlog::error_s("Save has version {}, but only version {} saves can be loaded!", header.version, VERSION);
+		return false;
+	}
+	return true;
+}
+
+/* Global */
+
+template<typename Writer>
+void InstanceSave::write_global(InstanceManager const& instance_manager, Writer& writer) {
+	write_flags(writer, instance_manager.global_flags);
+}
+
+bool InstanceSave::read_global(InstanceManager& instance_manager, BinaryReader& reader) {
+	return read_flags(reader, instance_manager.global_flags);
+}
+
+/* Markets */
+
+template<typename Writer>
+void InstanceSave::write_market(GoodMarket const& market, Writer& writer) {
+	writer.write(market.is_available);
+	writer.write(market.price);
+	writer.write(market.price_inverse);
+	writer.write(market.price_change_yesterday);
+	writer.write(market.max_next_price);
+	writer.write(market.min_next_price);
+	writer.write(market.total_demand_yesterday);
+	writer.write(market.total_supply_yesterday);
+	writer.write(market.quantity_traded_yesterday);
+	write_value_history(writer, market.price_history);
+}
+
+bool InstanceSave::read_market(GoodMarket& market, BinaryReader& reader) {
+	return reader.read(market.is_available) && reader.read(market.price) && reader.read(market.price_inverse) &&
+		reader.read(market.price_change_yesterday) && reader.read(market.max_next_price) &&
+		reader.read(market.min_next_price) && reader.read(market.total_demand_yesterday) &&
+		reader.read(market.total_supply_yesterday) && reader.read(market.quantity_traded_yesterday) &&
+		read_value_history(reader, market.price_history);
+}
+
+void InstanceSave::write_markets(InstanceManager const& instance_manager, BinaryWriter& writer) {
+	forwardable_span<const GoodInstance> good_instances = instance_manager.good_instance_manager.get_good_instances();
+
+	writer.write<uint64_t>(good_instances.size());
+	for (GoodMarket const& market : good_instances) {
+		write_market(market, writer);
+	}
+}
+
+bool InstanceSave::read_markets(InstanceManager& instance_manager, BinaryReader& reader) {
+	forwardable_span<GoodInstance> good_instances = instance_manager.good_instance_manager.get_good_instances();
+
+	if (!read_expected_count(reader, good_instances.size())) {
+		return false;
+	}
+	for (GoodMarket& market : good_instances) {
+		if (!read_market(market, reader)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Event modifiers */
+
+bool InstanceSave::can_write_event_modifiers(write_context_t const& context) {
+	memory::vector<IconModifier> const& registered_event_modifiers =
+		context.definition_manager.get_modifier_manager().get_event_modifiers();
+
+	bool ret = true;
+	const auto check_event_modifiers = [&registered_event_modifiers, &ret](
+		std::span<const ModifierInstance> event_modifiers, auto const& owner
+	) -> void {
+		for (ModifierInstance const& event_modifier : event_modifiers) {
+			if (event_modifier_index_of(registered_event_modifiers, event_modifier.get_modifier()) == NULL_INDEX) {
+				spdlog::error_s(
+					"Cannot save {}'s event modifier {} as it isn't in the event modifier registry!", owner,
+					*event_modifier.get_modifier()
+				);
+				ret = false;
+			}
+		}
+	};
+
+	for (CountryInstance const& country : context.countries) {
+		check_event_modifiers(country.event_modifiers, country);
+	}
+	for (ProvinceInstance const& province : context.provinces) {
+		check_event_modifiers(province.event_modifiers, province);
+	}
+	return ret;
+}
+
+template<typename Writer>
+void InstanceSave::write_event_modifiers(
+	write_context_t const& context, std::span<const ModifierInstance> event_modifiers, Writer& writer
+) {
+	ModifierManager const& modifier_manager = context.definition_manager.get_modifier_manager();
+
+	writer.template write<uint64_t>(event_modifiers.size());
+	for (ModifierInstance const& event_modifier : event_modifiers) {
+		writer.write(event_modifier_index_of(modifier_manager.get_event_modifiers(), event_modifier.get_modifier()));
+		writer.write(event_modifier.get_expiry_date());
+	}
+}
+
+bool InstanceSave::read_event_modifiers(
+	read_context_t const& context, memory::vector<ModifierInstance>& event_modifiers, BinaryReader& reader
+) {
+	ModifierManager const& modifier_manager = context.definition_manager.get_modifier_manager();
+
+	event_modifiers.clear();
+
+	uint64_t count = 0;
+	if (!read_count(reader, count)) {
+		return false;
+	}
+	event_modifiers.reserve(count);
+	for (uint64_t index = 0; index < count; ++index) {
+		IconModifier const* event_modifier = nullptr;
+		Date expiry_date;
+		if (
+			!read_non_null_pointer(reader, modifier_manager.get_event_modifiers(), event_modifier) ||
+			!reader.read(expiry_date)
+		) {
+			return false;
+		}
+		event_modifiers.emplace_back(*event_modifier, expiry_date);
+	}
+	return true;
+}
+
+/* Countries */
+
+template<typename Writer>
+void InstanceSave::write_country(write_context_t const& context, CountryInstance const& country, Writer& writer) {
+	DefinitionManager const& definition_manager = context.definition_manager;
+	PoliticsManager const& politics_manager = definition_manager.get_politics_manager();
+	CultureManager const& culture_manager = definition_manager.get_pop_manager().get_culture_manager();
+
+	write_flags(writer, country);
+	write_pointer(writer, context.provinces, country.capital);
+	writer.write(country.ai);
+	writer.write(country.country_status);
+	writer.write(country.civilisation_progress);
+	writer.write(country.lose_great_power_date);
+
+	/* Budget */
+	writer.write(country.cash_stockpile.load());
+	write_value_history(writer, country.balance_history);
+	writer.template write<uint64_t>(country.tax_rate_slider_value_by_strata.get_values().size());
+	for (ClampedValue const& tax_rate_slider_value : country.tax_rate_slider_value_by_strata.get_values()) {
+		writer.write(tax_rate_slider_value.get_value_untracked());
+	}
+	for (ClampedValue const* slider_value : {
+		&country.army_spending_slider_value, &country.navy_spending_slider_value,
+		&country.construction_spending_slider_value, &country.education_spending_slider_value,
+		&country.administration_spending_slider_value, &country.social_spending_slider_value,
+		&country.military_spending_slider_value, &country.tariff_rate_slider_value
+	}) {
+		writer.write(slider_value->get_value_untracked());
+	}
+
+	/* Technology */
+	writer.template write<uint64_t>(country.technology_unlock_levels.get_values().size());
+	for (const technology_unlock_level_t unlock_level : country.technology_unlock_levels.get_values()) {
+		writer.write(unlock_level);
+	}
+	writer.template write<uint64_t>(country.invention_unlock_levels.get_values().size());
+	for (const technology_unlock_level_t unlock_level : country.invention_unlock_levels.get_values()) {
+		writer.write(unlock_level);
+	}
+	write_state_pointer(
+		writer, definition_manager.get_research_manager().get_technology_manager().get_technologies(),
+		country.current_research
+	);
+	write_state(writer, country.invested_research_points);
+	write_state(writer, country.research_point_stockpile);
+
+	/* Politics */
+	write_state_pointer(
+		writer, politics_manager.get_national_value_manager().get_national_values(), country.national_value
+	);
+	write_state_pointer(
+		writer, politics_manager.get_government_type_manager().get_government_types(), country.government_type
+	);
+	writer.write(country.last_election);
+	write_state_pointer(writer, country.country_definition.get_parties(), country.ruling_party);
+	writer.template write<uint64_t>(country.reforms.get_values().size());
+	for (Reform const* reform : country.reforms.get_values()) {
+		write_pointer(writer, politics_manager.get_issue_manager().get_reforms(), reform);
+	}
+	write_state(writer, country.suppression_points);
+	write_state(writer, country.infamy);
+	write_state(writer, country.plurality);
+	write_state(writer, country.revanchism);
+	write_pointer(writer, culture_manager.get_cultures(), country.primary_culture);
+	writer.template write<uint64_t>(country.accepted_cultures.size());
+	for (Culture const* culture : country.accepted_cultures) {
+		write_pointer(writer, culture_manager.get_cultures(), culture);
+	}
+	write_pointer(
+		writer, definition_manager.get_pop_manager().get_religion_manager().get_religions(), country.religion
+	);
+
+	/* Diplomacy and military */
+	write_state(writer, country.prestige);
+	writer.write(country.diplomatic_points);
+	writer.write(country.last_war_loss_date);
+	writer.write(country.war_exhaustion);
+	writer.write(country.leadership_point_stockpile);
+	writer.write(country.create_leader_count);
+	writer.write(country.mobilised);
+	writer.write(country.auto_create_leaders);
+	writer.write(country.auto_assign_leaders);
+
+	/* Trade */
+	writer.template write<uint64_t>(country.goods_data.get_values().size());
+	for (CountryInstance::good_data_t const& good_data : country.goods_data.get_values()) {
+		writer.write(good_data.stockpile_amount);
+		writer.write(good_data.is_automated);
+		writer.write(good_data.is_selling);
+		writer.write(good_data.stockpile_cutoff);
+	}
+
+	writer.template write<uint64_t>(country.script_variables.size());
+	for (auto const& [variable_name, value] : country.script_variables) {
+		writer.write_string(variable_name);
+		writer.write(value);
+	}
+
+	write_event_modifiers(context, country.event_modifiers, writer);
+}
+
+bool InstanceSave::read_country(read_context_t const& context, CountryInstance& country, BinaryReader& reader) {
+	using enum CountryInstance::country_status_t;
+
+	DefinitionManager const& definition_manager = context.definition_manager;
+	PoliticsManager const& politics_manager = definition_manager.get_politics_manager();
+	CultureManager const& culture_manager = definition_manager.get_pop_manager().get_culture_manager();
+
+	if (
+		!read_flags(reader, country) || !read_pointer(reader, context.provinces, country.capital) ||
+		!reader.read(country.ai) || !reader.read(country.country_status) ||
+		country.country_status > COUNTRY_STATUS_PRIMITIVE || !reader.read(country.civilisation_progress) ||
+		!reader.read(country.lose_great_power_date)
+	) {
+		return false;
+	}
+
+	/* Budget */
+	fixed_point_t cash_stockpile;
+	if (!reader.read(cash_stockpile) || !read_value_history(reader, country.balance_history)) {
+		return false;
+	}
+	country.cash_stockpile = cash_stockpile;
+	if (!read_expected_count(reader, country.tax_rate_slider_value_by_strata.get_values().size())) {
+		return false;
+	}
+	for (ClampedValue& tax_rate_slider_value : country.tax_rate_slider_value_by_strata.get_values()) {
+		fixed_point_t value;
+		if (!reader.read(value)) {
+			return false;
+		}
+		tax_rate_slider_value.set_value(value);
+	}
+	for (ClampedValue* slider_value : {
+		&country.army_spending_slider_value, &country.navy_spending_slider_value,
+		&country.construction_spending_slider_value, &country.education_spending_slider_value,
+		&country.administration_spending_slider_value, &country.social_spending_slider_value,
+		&country.military_spending_slider_value, &country.tariff_rate_slider_value
+	}) {
+		fixed_point_t value;
+		if (!reader.read(value)) {
+			return false;
+		}
+		slider_value->set_value(value);
+	}
+
+	/* Technology, unlocked through the usual functions so that everything they unlock is updated too. */
+	TechnologyManager const& technology_manager = definition_manager.get_research_manager().get_technology_manager();
+	if (!read_expected_count(reader, technology_manager.get_technology_count())) {
+		return false;
+	}
+	bool ret = true;
+	for (Technology const& technology : technology_manager.get_technologies()) {
+		technology_unlock_level_t unlock_level { 0 };
+		if (!reader.read(unlock_level)) {
+			return false;
+		}
+		ret &= country.set_technology_unlock_level(technology, unlock_level);
+	}
+	InventionManager const& invention_manager = definition_manager.get_research_manager().get_invention_manager();
+	if (!read_expected_count(reader, invention_manager.get_invention_count())) {
+		return false;
+	}
+	for (Invention const& invention : invention_manager.get_inventions()) {
+		technology_unlock_level_t unlock_level { 0 };
+		if (!reader.read(unlock_level)) {
+			return false;
+		}
+		ret &= country.set_invention_unlock_level(invention, unlock_level);
+	}
+	if (
+		!read_state_pointer(reader, technology_manager.get_technologies(), country.current_research) ||
+		!read_state(reader, country.invested_research_points) || !read_state(reader, country.research_point_stockpile)
+	) {
+		return false;
+	}
+
+	/* Politics */
+	CountryParty const* ruling_party = nullptr;
+	if (
+		!read_state_pointer(
+			reader, politics_manager.get_national_value_manager().get_national_values(), country.national_value
+		) ||
+		!read_state_pointer(
+			reader, politics_manager.get_government_type_manager().get_government_types(), country.government_type
+		) ||
+		!reader.read(country.last_election) ||
+		!read_pointer(reader, country.country_definition.get_parties(), ruling_party) ||
+		!read_expected_count(reader, country.reforms.get_values().size())
+	) {
+		return false;
+	}
+	if (ruling_party != nullptr) {
+		ret &= country.set_ruling_party(*ruling_party);
+	} else if (country.ruling_party.get_untracked() != nullptr) {
+		country.ruling_party.set(nullptr);
+		ret &= country.update_rule_set();
+	}
+	for (Reform const* current_reform : country.reforms.get_values()) {
+		Reform const* reform = nullptr;
+		if (!read_pointer(reader, politics_manager.get_issue_manager().get_reforms(), reform)) {
+			return false;
+		}
+		if (reform != nullptr) {
+			ret &= country.add_reform(*reform);
+		} else if (current_reform != nullptr) {
+			// Reforms can only be replaced, so a reform group can't have gone back to having no reform since the bookmark
+			spdlog::error_s("Save has no reform for country {}'s {} reform group!", country, current_reform->group);
+			ret = false;
+		}
+	}
+
+	Culture const* primary_culture = nullptr;
+	uint64_t accepted_culture_count = 0;
+	if (
+		!read_state(reader, country.suppression_points) || !read_state(reader, country.infamy) ||
+		!read_state(reader, country.plurality) || !read_state(reader, country.revanchism) ||
+		!read_pointer(reader, culture_manager.get_cultures(), primary_culture) ||
+		!read_count(reader, accepted_culture_count)
+	) {
+		return false;
+	}
+	country.primary_culture = primary_culture;
+	memory::vector<Culture const*> accepted_cultures;
+	for (uint64_t index = 0; index < accepted_culture_count; ++index) {
+		if (!read_non_null_pointer(reader, culture_manager.get_cultures(), accepted_cultures.emplace_back())) {
+			return false;
+		}
+	}
+	memory::vector<Culture const*> old_accepted_cultures {
+		country.accepted_cultures.begin(), country.accepted_cultures.end()
+	};
+	for (Culture const* culture : old_accepted_cultures) {
+		if (std::find(accepted_cultures.begin(), accepted_cultures.end(), culture) == accepted_cultures.end()) {
+			ret &= country.remove_accepted_culture(*culture);
+		}
+	}
+	for (Culture const* culture : accepted_cultures) {
+		if (!country.is_accepted_culture(*culture)) {
+			ret &= country.add_accepted_culture(*culture);
+		}
+	}
+	if (!read_pointer(
+		reader, definition_manager.get_pop_manager().get_religion_manager().get_religions(), country.religion
+	)) {
+		return false;
+	}
+
+	/* Diplomacy and military */
+	if (
+		!read_state(reader, country.prestige) || !reader.read(country.diplomatic_points) ||
+		!reader.read(country.last_war_loss_date) || !reader.read(country.war_exhaustion) ||
+		!reader.read(country.leadership_point_stockpile) || !reader.read(country.create_leader_count) ||
+		!reader.read(country.mobilised) || !reader.read(country.auto_create_leaders) ||
+		!reader.read(country.auto_assign_leaders)
+	) {
+		return false;
+	}
+
+	/* Trade */
+	if (!read_expected_count(reader, country.goods_data.get_values().size())) {
+		return false;
+	}
+	for (CountryInstance::good_data_t& good_data : country.goods_data.get_values()) {
+		if (
+			!reader.read(good_data.stockpile_amount) || !reader.read(good_data.is_automated) ||
+			!reader.read(good_data.is_selling) || !reader.read(good_data.stockpile_cutoff)
+		) {
+			return false;
+		}
+	}
+
+	country.script_variables.clear();
+	uint64_t script_variable_count = 0;
+	if (!read_count(reader, script_variable_count)) {
+		return false;
+	}
+	for (uint64_t index = 0; index < script_variable_count; ++index) {
+		std::string_view variable_name;
+		fixed_point_t value;
+		if (!reader.read_string(variable_name) || !reader.read(value)) {
+			return false;
+		}
+		country.script_variables.emplace(variable_name, value);
+	}
+
+	if (!read_event_modifiers(context, country.event_modifiers, reader)) {
+		return false;
+	}
+
+	country.national_modifiers_dirty = true;
+	return ret;
+}
+
+/* Provinces */
+
+template<typename Writer>
+void InstanceSave::write_pop(write_context_t const& context, Pop const& pop, Writer& writer) {
+	DefinitionManager const& definition_manager = context.definition_manager;
+	PopManager const& pop_manager = definition_manager.get_pop_manager();
+
+	writer.write(pop.id_in_province);
+	write_pointer(writer, pop_manager.get_pop_types(), &pop.get_type());
+	write_pointer(writer, pop_manager.get_culture_manager().get_cultures(), &pop.culture);
+	write_pointer(writer, pop_manager.get_religion_manager().get_religions(), &pop.religion);
+	writer.write(pop.size);
+	writer.write(pop.militancy);
+	writer.write(pop.consciousness);
+	write_pointer(writer, definition_manager.get_politics_manager().get_rebel_manager().get_rebel_types(), pop.rebel_type);
+
+	writer.write(pop.literacy);
+	writer.write(pop.employed);
+	writer.write(pop.income);
+	writer.write(pop.savings);
+	writer.write(pop.cash);
+	writer.write(pop.expenses);
+	writer.write(pop.yesterdays_import_value);
+
+	writer.write(pop.artisanal_producer_optional.has_value());
+	if (pop.artisanal_producer_optional.has_value()) {
+		ArtisanalProducer const& artisanal_producer = *pop.artisanal_producer_optional;
+		write_pointer(
+			writer, definition_manager.get_economy_manager().get_production_type_manager().get_production_types(),
+			artisanal_producer.production_type_nullable
+		);
+		write_pointer(
+			writer, definition_manager.get_economy_manager().get_good_definition_manager().get_good_definitions(),
+			artisanal_producer.last_produced_good
+		);
+		writer.write(artisanal_producer.current_production);
+		writer.write(artisanal_producer.costs_of_production);
+		writer.template write<uint64_t>(artisanal_producer.stockpile.get_values().size());
+		for (const fixed_point_t amount : artisanal_producer.stockpile.get_values()) {
+			writer.write(amount);
+		}
+	}
+}
+
+bool InstanceSave::read_pop(read_context_t const& context, ProvinceInstance& province, BinaryReader& reader) {
+	DefinitionManager const& definition_manager = context.definition_manager;
+	PopManager const& pop_manager = definition_manager.get_pop_manager();
+
+	pop_id_in_province_t id_in_province { 0 };
+	PopType const* type = nullptr;
+	Culture const* culture = nullptr;
+	Religion const* religion = nullptr;
+	pop_size_t size { 0 };
+	fixed_point_t militancy, consciousness;
+	RebelType const* rebel_type = nullptr;
+	if (
+		!reader.read(id_in_province) || id_in_province.is_null() || id_in_province > province.last_pop_id ||
+		!read_non_null_pointer(reader, pop_manager.get_pop_types(), type) ||
+		!read_non_null_pointer(reader, pop_manager.get_culture_manager().get_cultures(), culture) ||
+		!read_non_null_pointer(reader, pop_manager.get_religion_manager().get_religions(), religion) ||
+		!reader.read(size) || size <= pop_size_t { 0 } || !reader.read(militancy) || !reader.read(consciousness) ||
+		!read_pointer(reader, definition_manager.get_politics_manager().get_rebel_manager().get_rebel_types(), rebel_type)
+	) {
+		return false;
+	}
+
+	Pop& pop = *province.pops.emplace(
+		province,
+		PopBase { *type, *culture, *religion, size, militancy, consciousness, rebel_type },
+		context.instance_manager.pop_deps,
+		id_in_province
+	);
+
+	bool has_artisanal_producer = false;
+	if (
+		!reader.read(pop.literacy) || !reader.read(pop.employed) || pop.employed > pop.size ||
+		!reader.read(pop.income) || !reader.read(pop.savings) || !reader.read(pop.cash) ||
+		!reader.read(pop.expenses) || !reader.read(pop.yesterdays_import_value) ||
+		!reader.read(has_artisanal_producer) || has_artisanal_producer != pop.artisanal_producer_optional.has_value()
+	) {
+		return false;
+	}
+	if (has_artisanal_producer) {
+		ArtisanalProducer& artisanal_producer = *pop.artisanal_producer_optional;
+		ProductionType const* production_type = nullptr;
+		if (
+			!read_pointer(
+				reader, definition_manager.get_economy_manager().get_production_type_manager().get_production_types(),
+				production_type
+			) ||
+			!read_pointer(
+				reader, definition_manager.get_economy_manager().get_good_definition_manager().get_good_definitions(),
+				artisanal_producer.last_produced_good
+			) ||
+			!reader.read(artisanal_producer.current_production) || !reader.read(artisanal_producer.costs_of_production) ||
+			!read_expected_count(reader, artisanal_producer.stockpile.get_values().size())
+		) {
+			return false;
+		}
+		artisanal_producer.set_production_type(production_type);
+		for (fixed_point_t& amount : artisanal_producer.stockpile.get_values()) {
+			if (!reader.read(amount)) {
+				return false;
+			}
+		}
+	}
+
+	pop.update_location_based_attributes();
+	return true;
+}
+
+template<typename Writer>
+void InstanceSave::write_province(write_context_t const& context, ProvinceInstance const& province, Writer& writer) {
+	write_flags(writer, province);
+	write_pointer(writer, context.countries, province.owner);
+	write_pointer(writer, context.countries, province.controller);
+	writer.template write<uint64_t>(province.cores.size());
+	for (CountryInstance const* core : province.cores) {
+		write_pointer(writer, context.countries, core);
+	}
+	writer.write(province.life_rating);
+	writer.write(province.colony_status);
+	write_pointer(writer, context.definition_manager.get_crime_manager().get_crime_modifiers(), province.crime);
+	writer.write(province.slave);
+	writer.write(province.occupation_duration);
+	write_event_modifiers(context, province.event_modifiers, writer);
+
+	writer.template write<uint64_t>(province.buildings.size());
+	for (BuildingInstance const& building : province.buildings) {
+		writer.write(building.level);
+		writer.write(building.expansion_state);
+		writer.write(building.start_date);
+		writer.write(building.end_date);
+		writer.write(building.expansion_progress);
+	}
+
+	writer.write(province.last_pop_id);
+	writer.template write<uint64_t>(province.pops.size());
+	for (Pop const& pop : province.pops) {
+		write_pop(context, pop, writer);
+	}
+
+	ResourceGatheringOperation const& rgo = province.rgo;
+	writer.write(rgo.revenue_yesterday);
+	writer.write(rgo.output_quantity_yesterday);
+	writer.write(rgo.unsold_quantity_yesterday);
+	writer.write(rgo.total_employees_count_cache);
+	writer.write(rgo.total_paid_employees_count_cache);
+	writer.write(rgo.total_owner_income_cache);
+	writer.write(rgo.total_employee_income_cache);
+	writer.template write<uint64_t>(rgo.employee_count_per_type_cache.size());
+	for (const pop_size_t employee_count : rgo.employee_count_per_type_cache) {
+		writer.write(employee_count);
+	}
+	writer.template write<uint64_t>(rgo.employees.size());
+	for (Employee const& employee : rgo.employees) {
+		writer.write(employee.get_pop().id_in_province);
+		writer.write(employee.get_size());
+		writer.write(employee.get_minimum_wage_cached());
+	}
+}
+
+bool InstanceSave::read_province(read_context_t const& context, ProvinceInstance& province, BinaryReader& reader) {
+	using enum colony_status_t;
+
+	CountryInstance* owner = nullptr;
+	CountryInstance* controller = nullptr;
+	uint64_t core_count = 0;
+	if (
+		!read_flags(reader, province) || !read_pointer(reader, context.countries, owner) ||
+		!read_pointer(reader, context.countries, controller) || !read_count(reader, core_count)
+	) {
+		return false;
+	}
+
+	bool ret = province.set_owner(owner);
+	ret &= province.set_controller(controller);
+
+	memory::vector<CountryInstance*> cores;
+	for (uint64_t index = 0; index < core_count; ++index) {
+		if (!read_non_null_pointer(reader, context.countries, cores.emplace_back())) {
+			return false;
+		}
+	}
+	memory::vector<CountryInstance*> old_cores { province.cores.begin(), province.cores.end() };
+	for (CountryInstance* core : old_cores) {
+		if (std::find(cores.begin(), cores.end(), core) == cores.end()) {
+			ret &= province.remove_core(*core, false);
+		}
+	}
+	for (CountryInstance* core : cores) {
+		ret &= province.add_core(*core, false);
+	}
+
+	Crime const* crime = nullptr;
+	if (
+		!reader.read(province.life_rating) || !reader.read(province.colony_status) || province.colony_status > COLONY ||
+		!read_pointer(reader, context.definition_manager.get_crime_manager().get_crime_modifiers(), crime) ||
+		!reader.read(province.slave) || !reader.read(province.occupation_duration) ||
+		!read_event_modifiers(context, province.event_modifiers, reader) ||
+		!read_expected_count(reader, province.buildings.size())
+	) {
+		return false;
+	}
+	province.set_crime(crime);
+	province.modifier_sum_dirty = true;
+
+	using enum BuildingInstance::ExpansionState;
+	for (BuildingInstance& building : province.buildings) {
+		if (
+			!reader.read(building.level) || !reader.read(building.expansion_state) || building.expansion_state > Expanding ||
+			!reader.read(building.start_date) || !reader.read(building.end_date) ||
+			!reader.read(building.expansion_progress)
+		) {
+			return false;
+		}
+	}
+
+	/* The province's pops are replaced by the saved ones, so everything referring to them must be cleared or relinked. */
+	uint64_t pop_count = 0;
+	if (!reader.read(province.last_pop_id) || !read_count(reader, pop_count)) {
+		return false;
+	}
+	if (pop_count > 0 && province.province_definition.is_water()) {
+		spdlog::error_s("Save has pops in water province {}!", province);
+		return false;
+	}
+	ResourceGatheringOperation& rgo = province.rgo;
+	rgo.employees.clear();
+	for (memory::vector<std::reference_wrapper<Pop>>& pops_cache : province.pops_cache_by_type) {
+		pops_cache.clear();
+	}
+	province.pops.clear();
+	province.pops.reserve(pop_count);
+	for (uint64_t index = 0; index < pop_count; ++index) {
+		if (!read_pop(context, province, reader)) {
+			return false;
+		}
+	}
+
+	uint64_t employee_count = 0;
+	if (
+		!reader.read(rgo.revenue_yesterday) || !reader.read(rgo.output_quantity_yesterday) ||
+		!reader.read(rgo.unsold_quantity_yesterday) || !reader.read(rgo.total_employees_count_cache) ||
+		!reader.read(rgo.total_paid_employees_count_cache) || !reader.read(rgo.total_owner_income_cache) ||
+		!reader.read(rgo.total_employee_income_cache) ||
+		!read_expected_count(reader, rgo.employee_count_per_type_cache.size())
+	) {
+		return false;
+	}
+	for (pop_size_t& employee_count_of_type : rgo.employee_count_per_type_cache) {
+		if (!reader.read(employee_count_of_type)) {
+			return false;
+		}
+	}
+	if (!read_count(reader, employee_count)) {
+		return false;
+	}
+	rgo.employees.reserve(employee_count);
+	for (uint64_t index = 0; index < employee_count; ++index) {
+		pop_id_in_province_t pop_id { 0 };
+		pop_size_t size { 0 };
+		fixed_point_t minimum_wage_cached;
+		if (!reader.read(pop_id) || !reader.read(size) || !reader.read(minimum_wage_cached)) {
+			return false;
+		}
+		Pop* pop = province.find_pop_by_id(pop_id);
+		if (pop == nullptr) {
+			return false;
+		}
+		rgo.employees.emplace_back(*pop, size).set_minimum_wage_cached(minimum_wage_cached);
+	}
+
+	return ret;
+}
+
+/* States */
+
+template<typename Writer>
+void InstanceSave::write_states(write_context_t const& context, Writer& writer) {
+	StateManager const& state_manager = context.instance_manager.map_instance.get_state_manager();
+
+	// Countries refer to their states by their index across all state sets
+	ordered_map<State const*, uint32_t> state_indices;
+	writer.template write<uint64_t>(state_manager.state_sets.size());
+	for (StateSet const& state_set : state_manager.state_sets) {
+		writer.template write<uint64_t>(state_set.states.size());
+		for (State const& state : state_set.states) {
+			state_indices.emplace(&state, static_cast<uint32_t>(state_indices.size()));
+			write_pointer(writer, context.provinces, state.capital);
+			writer.write(state.colony_status);
+			writer.template write<uint64_t>(state.provinces.size());
+			for (ProvinceInstance const& province : state.provinces) {
+				write_pointer(writer, context.provinces, &province);
+			}
+		}
+	}
+
+	for (CountryInstance const& country : context.countries) {
+		writer.template write<uint64_t>(country.states.size());
+		for (State const* state : country.states) {
+			writer.write(state_indices.at(state));
+		}
+	}
+}
+
+/* The states are rebuilt from the saved partition, then each country is given its saved states in the order it gained
+ * them, so states whose owner has changed since the last gamestate update are moved on the next one, as they would have
+ * been in the saved game. */
+bool InstanceSave::read_states(read_context_t const& context, BinaryReader& reader) {
+	using enum colony_status_t;
+
+	StateManager& state_manager = context.instance_manager.map_instance.get_state_manager();
+
+	if (!read_expected_count(reader, state_manager.state_sets.size())) {
+		return false;
+	}
+
+	for (CountryInstance& country : context.countries) {
+		country.states.clear();
+	}
+	for (ProvinceInstance& province : context.provinces) {
+		province.set_state(nullptr);
+	}
+
+	memory::vector<State*> states;
+	for (StateSet& state_set : state_manager.state_sets) {
+		state_set.states.clear();
+
+		uint64_t state_count = 0;
+		if (!read_count(reader, state_count) || state_count > state_set.region.size()) {
+			return false;
+		}
+		state_set.states.reserve(state_count);
+		for (uint64_t state_index = 0; state_index < state_count; ++state_index) {
+			ProvinceInstance* capital = nullptr;
+			colony_status_t colony_status = STATE;
+			uint64_t province_count = 0;
+			if (
+				!read_non_null_pointer(reader, context.provinces, capital) || !reader.read(colony_status) ||
+				colony_status > COLONY || !read_count(reader, province_count) || province_count > state_set.region.size()
+			) {
+				return false;
+			}
+			memory::vector<std::reference_wrapper<ProvinceInstance>> provinces;
+			provinces.reserve(province_count);
+			for (uint64_t province_index = 0; province_index < province_count; ++province_index) {
+				ProvinceInstance* province = nullptr;
+				if (
+					!read_non_null_pointer(reader, context.provinces, province) ||
+					!state_set.region.contains_province(province->province_definition)
+				) {
+					return false;
+				}
+				provinces.emplace_back(*province);
+			}
+
+			State& state = *state_set.states.emplace(
+				state_set, capital, std::move(provinces), colony_status, context.instance_manager.pops_aggregate_deps
+			);
+			for (ProvinceInstance& province : state.provinces) {
+				if (province.get_state() != nullptr) {
+					spdlog::error_s("Save has province {} in more than one state!", province);
+					return false;
+				}
+				province.set_state(&state);
+			}
+			states.push_back(&state);
+		}
+	}
+
+	// Constructing the states added them to their capitals' owners, which are replaced by the saved assignments
+	for (CountryInstance& country : context.countries) {
+		country.states.clear();
+	}
+	for (State* state : states) {
+		state->previous_country_ptr = nullptr;
+	}
+	bool ret = true;
+	for (CountryInstance& country : context.countries) {
+		uint64_t country_state_count = 0;
+		if (!read_count(reader, country_state_count)) {
+			return false;
+		}
+		for (uint64_t index = 0; index < country_state_count; ++index) {
+			uint32_t state_index = NULL_INDEX;
+			if (!reader.read(state_index) || state_index >= states.size()) {
+				return false;
+			}
+			State& state = *states[state_index];
+			if (state.previous_country_ptr != nullptr) {
+				spdlog::error_s("Save has state {} in more than one country!", state);
+				return false;
+			}
+			ret &= country.add_state(state);
+			state.previous_country_ptr = &country;
+		}
+	}
+	for (State* state : states) {
+		state->update_parties_for_votes(state->previous_country_ptr);
+	}
+
+	for (ProvinceInstance const& province : context.provinces) {
+		if (!province.province_definition.is_water() && province.get_state() == nullptr) {
+			spdlog::error_s("Save has no state for province {}!", province);
+			ret = false;
+		}
+	}
+	return ret;
+}
+
+/* Units */
+
+template<typename Writer>
+void InstanceSave::write_unit_instances(write_context_t const& context, Writer& writer) {
+	UnitInstanceManager const& unit_instance_manager = context.instance_manager.unit_instance_manager;
+	LeaderTraitManager const& leader_trait_manager = context.definition_manager.get_military_manager().get_leader_trait_manager();
+
+	writer.write(unit_instance_manager.unique_id_counter);
+
+	writer.template write<uint64_t>(unit_instance_manager.leaders.size());
+	for (LeaderInstance const& leader : unit_instance_manager.leaders) {
+		writer.write(leader.unique_id);
+		write_pointer(writer, context.countries, &leader.country);
+		writer.write(leader.branch);
+		writer.write(leader.date);
+		writer.write_string(leader.name);
+		write_pointer(writer, leader_trait_manager.get_leader_traits(), leader.personality);
+		write_pointer(writer, leader_trait_manager.get_leader_traits(), leader.background);
+		writer.write(leader.prestige);
+		writer.write_string(leader.picture);
+		writer.write(leader.can_be_used);
+	}
+
+	UnitTypeManager const& unit_type_manager = context.definition_manager.get_military_manager().get_unit_type_manager();
+
+	writer.template write<uint64_t>(unit_instance_manager.regiments.size());
+	for (RegimentInstance const& regiment : unit_instance_manager.regiments) {
+		writer.write(regiment.unique_id);
+		writer.write_string(regiment.name);
+		write_pointer(writer, unit_type_manager.get_regiment_types(), &regiment.get_regiment_type());
+		writer.write(regiment.organisation);
+		writer.write(regiment.max_organisation);
+		writer.write(regiment.strength);
+		writer.write(regiment.mobilised);
+		if (regiment.pop != nullptr) {
+			write_pointer(writer, context.provinces, &regiment.pop->get_location());
+			writer.write(regiment.pop->id_in_province);
+		} else {
+			writer.write(InstanceSave::NULL_INDEX);
+		}
+	}
+
+	writer.template write<uint64_t>(unit_instance_manager.ships.size());
+	for (ShipInstance const& ship : unit_instance_manager.ships) {
+		writer.write(ship.unique_id);
+		writer.write_string(ship.name);
+		write_pointer(writer, unit_type_manager.get_ship_types(), &ship.get_ship_type());
+		writer.write(ship.organisation);
+		writer.write(ship.max_organisation);
+		writer.write(ship.strength);
+	}
+}
+
+template<typename Writer>
+void InstanceSave::write_unit_instance_group(
+	write_context_t const& context, UnitInstanceGroup const& unit_instance_group, Writer& writer
+) {
+	writer.write(unit_instance_group.unique_id);
+	writer.write_string(unit_instance_group.name);
+	write_pointer(writer, context.countries, &unit_instance_group.country.get());
+	write_pointer(writer, context.provinces, &unit_instance_group.location.get());
+	writer.template write<unique_id_t>(unit_instance_group.leader != nullptr ? unit_instance_group.leader->unique_id : 0);
+	writer.write(unit_instance_group.movement_progress);
+	writer.template write<uint64_t>(unit_instance_group.path.size());
+	for (ProvinceInstance const& province : unit_instance_group.path) {
+		write_pointer(writer, context.provinces, &province);
+	}
+	writer.template write<uint64_t>(unit_instance_group.units.size());
+	for (UnitInstance const& unit : unit_instance_group.units) {
+		writer.write(unit.unique_id);
+	}
+}
+
+template<typename Writer>
+void InstanceSave::write_army(write_context_t const& context, ArmyInstance const& army, Writer& writer) {
+	write_unit_instance_group(context, army, writer);
+	writer.write(army.dig_in_level);
+	writer.write(army.exiled);
+}
+
+template<typename Writer>
+void InstanceSave::write_navy(write_context_t const& context, NavyInstance const& navy, Writer& writer) {
+	write_unit_instance_group(context, navy, writer);
+}
+
+template<typename Writer>
+void InstanceSave::write_units(write_context_t const& context, Writer& writer) {
+	UnitInstanceManager const& unit_instance_manager = context.instance_manager.unit_instance_manager;
+
+	write_unit_instances(context, writer);
+
+	writer.template write<uint64_t>(unit_instance_manager.armies.size());
+	for (ArmyInstance const& army : unit_instance_manager.armies) {
+		write_army(context, army, writer);
+	}
+	writer.template write<uint64_t>(unit_instance_manager.navies.size());
+	for (NavyInstance const& navy : unit_instance_manager.navies) {
+		write_navy(context, navy, writer);
+	}
+}
+
+/* Leaders, regiments, ships and unit groups missing from the bookmark are recreated in the order they were saved, which is
+ * the order they were created in as none can have been removed. Each group's units are then replaced by its saved ones. */
+bool InstanceSave::read_units(read_context_t const& context, BinaryReader& reader) {
+	UnitInstanceManager& unit_instance_manager = context.instance_manager.unit_instance_manager;
+	LeaderTraitManager const& leader_trait_manager = context.definition_manager.get_military_manager().get_leader_trait_manager();
+
+	uint64_t leader_count = 0;
+	if (!reader.read(unit_instance_manager.unique_id_counter) || !read_count(reader, leader_count)) {
+		return false;
+	}
+
+	bool ret = true;
+	for (uint64_t index = 0; index < leader_count; ++index) {
+		unique_id_t unique_id = 0;
+		CountryInstance* country = nullptr;
+		unit_branch_t branch = unit_branch_t::INVALID_BRANCH;
+		Date date;
+		std::string_view name, picture;
+		LeaderTrait const* personality = nullptr;
+		LeaderTrait const* background = nullptr;
+		fixed_point_t prestige;
+		bool can_be_used = true;
+		if (
+			!reader.read(unique_id) || unique_id == 0 || unique_id >= unit_instance_manager.unique_id_counter ||
+			!read_non_null_pointer(reader, context.countries, country) || !reader.read(branch) ||
+			(branch != unit_branch_t::LAND && branch != unit_branch_t::NAVAL) || !reader.read(date) ||
+			!reader.read_string(name) || !read_pointer(reader, leader_trait_manager.get_leader_traits(), personality) ||
+			!read_pointer(reader, leader_trait_manager.get_leader_traits(), background) || !reader.read(prestige) ||
+			!reader.read_string(picture) || !reader.read(can_be_used)
+		) {
+			return false;
+		}
+
+		LeaderInstance* leader = unit_instance_manager.get_leader_instance_by_unique_id(unique_id);
+		if (leader == nullptr) {
+			leader = &*unit_instance_manager.leaders.emplace(
+				unique_id, LeaderBase { name, branch, date, personality, background, prestige, picture }, *country
+			);
+			unit_instance_manager.leader_instance_map.emplace(unique_id, *leader);
+			ret &= country->add_leader(*leader);
+		} else if (&leader->country != country || leader->branch != branch) {
+			spdlog::error_s("Save has leader {} with a different country or branch to the bookmark's!", unique_id);
+			return false;
+		}
+		leader->name = name;
+		leader->prestige = prestige;
+		leader->picture = picture;
+		leader->can_be_used = can_be_used;
+	}
+	if (unit_instance_manager.leaders.size() != leader_count) {
+		spdlog::error_s(
+			"Save has {} leaders but the game has {}, leaders cannot be removed!", leader_count,
+			unit_instance_manager.leaders.size()
+		);
+		return false;
+	}
+
+	UnitTypeManager const& unit_type_manager = context.definition_manager.get_military_manager().get_unit_type_manager();
+
+	const auto read_unit_instance = [&unit_instance_manager, &unit_type_manager, &reader]<unit_branch_t Branch>(
+		UnitInstanceBranched<Branch>*& unit_instance
+	) -> bool {
+		unique_id_t unique_id = 0;
+		std::string_view name;
+		UnitTypeBranched<Branch> const* unit_type = nullptr;
+		bool type_read = false;
+		if constexpr (Branch == unit_branch_t::LAND) {
+			type_read = reader.read(unique_id) && reader.read_string(name) &&
+				read_non_null_pointer(reader, unit_type_manager.get_regiment_types(), unit_type);
+		} else {
+			type_read = reader.read(unique_id) && reader.read_string(name) &&
+				read_non_null_pointer(reader, unit_type_manager.get_ship_types(), unit_type);
+		}
+		if (!type_read || unique_id == 0 || unique_id >= unit_instance_manager.unique_id_counter) {
+			return false;
+		}
+
+		UnitInstance* unit_instance_base = unit_instance_manager.get_unit_instance_by_unique_id(unique_id);
+		if (unit_instance_base == nullptr) {
+			if constexpr (Branch == unit_branch_t::LAND) {
+				unit_instance = &*unit_instance_manager.regiments.insert(
+					RegimentInstance { unique_id, name, *unit_type, nullptr, false }
+				);
+			} else {
+				unit_instance = &*unit_instance_manager.ships.insert(ShipInstance { unique_id, name, *unit_type });
+			}
+			unit_instance_manager.unit_instance_map.emplace(unique_id, *unit_instance);
+		} else if (unit_instance_base->get_branch() != Branch || &unit_instance_base->unit_type != unit_type) {
+			spdlog::error_s(
+				"Save has {} {} with a different type to the bookmark's!", get_branched_unit_name(Branch), unique_id
+			);
+			return false;
+		} else {
+			unit_instance = static_cast<UnitInstanceBranched<Branch>*>(unit_instance_base);
+		}
+		unit_instance->name = name;
+		return reader.read(unit_instance->organisation) && reader.read(unit_instance->max_organisation) &&
+			reader.read(unit_instance->strength);
+	};
+
+	// Units and unit groups, like leaders, can't have been removed since the bookmark
+	const auto check_saved_count = [](
+		const std::string_view plural_name, const uint64_t saved_count, const size_t count
+	) -> bool {
+		if (saved_count != count) {
+			spdlog::error_s(
+				"Save has {} {} but the game has {}, {} cannot be removed!", saved_count, plural_name, count, plural_name
+			);
+			return false;
+		}
+		return true;
+	};
+
+	uint64_t regiment_count = 0;
+	if (!read_count(reader, regiment_count)) {
+		return false;
+	}
+	for (uint64_t index = 0; index < regiment_count; ++index) {
+		RegimentInstance* regiment = nullptr;
+		ProvinceInstance* pop_location = nullptr;
+		if (
+			!read_unit_instance(regiment) || !reader.read(regiment->mobilised) ||
+			!read_pointer(reader, context.provinces, pop_location)
+		) {
+			return false;
+		}
+		regiment->pop = nullptr;
+		if (pop_location != nullptr) {
+			pop_id_in_province_t pop_id { 0 };
+			if (!reader.read(pop_id)) {
+				return false;
+			}
+			regiment->pop = pop_location->find_pop_by_id(pop_id);
+			if (regiment->pop == nullptr) {
+				return false;
+			}
+		}
+	}
+	if (!check_saved_count("regiments", regiment_count, unit_instance_manager.regiments.size())) {
+		return false;
+	}
+
+	uint64_t ship_count = 0;
+	if (!read_count(reader, ship_count)) {
+		return false;
+	}
+	for (uint64_t index = 0; index < ship_count; ++index) {
+		ShipInstance* ship = nullptr;
+		if (!read_unit_instance(ship)) {
+			return false;
+		}
+	}
+	if (!check_saved_count("ships", ship_count, unit_instance_manager.ships.size())) {
+		return false;
+	}
+
+	const auto read_unit_instance_group = [&context, &unit_instance_manager, &reader, &ret]<unit_branch_t Branch>(
+		UnitInstanceGroupBranched<Branch>*& unit_instance_group
+	) -> bool {
+		unique_id_t unique_id = 0;
+		std::string_view name;
+		CountryInstance* country = nullptr;
+		ProvinceInstance* location = nullptr;
+		unique_id_t leader_id = 0;
+		uint64_t path_length = 0;
+		if (
+			!reader.read(unique_id) || !reader.read_string(name) || !read_non_null_pointer(reader, context.countries, country) ||
+			!read_non_null_pointer(reader, context.provinces, location) || !reader.read(leader_id)
+		) {
+			return false;
+		}
+		if (unique_id == 0 || unique_id >= unit_instance_manager.unique_id_counter) {
+			return false;
+		}
+		UnitInstanceGroup* unit_instance_group_base = unit_instance_manager.get_unit_instance_group_by_unique_id(unique_id);
+		if (unit_instance_group_base == nullptr) {
+			unit_instance_group = &*unit_instance_manager.get_unit_instance_groups<Branch>().emplace(
+				unique_id, name, *country, *location
+			);
+			unit_instance_manager.unit_instance_group_map.emplace(unique_id, *unit_instance_group);
+		} else if (unit_instance_group_base->branch != Branch) {
+			spdlog::error_s(
+				"Save has {} {} with a different branch to the bookmark's!", get_branched_unit_group_name(Branch), unique_id
+			);
+			return false;
+		} else {
+			unit_instance_group = static_cast<UnitInstanceGroupBranched<Branch>*>(unit_instance_group_base);
+		}
+
+		LeaderInstance* leader = nullptr;
+		if (leader_id != 0) {
+			leader = unit_instance_manager.get_leader_instance_by_unique_id(leader_id);
+			if (leader == nullptr) {
+				return false;
+			}
+		}
+		unit_instance_group->set_name(name);
+		ret &= unit_instance_group->set_country(*country);
+		ret &= unit_instance_group->set_location(*location);
+		ret &= unit_instance_group->set_leader(leader);
+
+		if (!reader.read(unit_instance_group->movement_progress) || !read_count(reader, path_length)) {
+			return false;
+		}
+		unit_instance_group->path.clear();
+		for (uint64_t index = 0; index < path_length; ++index) {
+			ProvinceInstance* province = nullptr;
+			if (!read_non_null_pointer(reader, context.provinces, province)) {
+				return false;
+			}
+			unit_instance_group->path.emplace_back(*province);
+		}
+
+		uint64_t unit_count = 0;
+		if (!read_count(reader, unit_count)) {
+			return false;
+		}
+		unit_instance_group->units.clear();
+		for (uint64_t index = 0; index < unit_count; ++index) {
+			unique_id_t unit_id = 0;
+			if (!reader.read(unit_id)) {
+				return false;
+			}
+			UnitInstance* unit = unit_instance_manager.get_unit_instance_by_unique_id(unit_id);
+			if (unit == nullptr) {
+				spdlog::error_s(
+					"Save has {} {} with unit {} which isn't in the game!", get_branched_unit_group_name(Branch), unique_id,
+					unit_id
+				);
+				return false;
+			}
+			ret &= unit_instance_group->add_unit(*unit);
+		}
+		return true;
+	};
+
+	uint64_t army_count = 0;
+	if (!read_count(reader, army_count)) {
+		return false;
+	}
+	for (uint64_t index = 0; index < army_count; ++index) {
+		ArmyInstance* army = nullptr;
+		if (
+			!read_unit_instance_group(army) || !reader.read(army->dig_in_level) ||
+			!reader.read(army->exiled)
+		) {
+			return false;
+		}
+	}
+	if (!check_saved_count("armies", army_count, unit_instance_manager.armies.size())) {
+		return false;
+	}
+	uint64_t navy_count = 0;
+	if (!read_count(reader, navy_count)) {
+		return false;
+	}
+	for (uint64_t index = 0; index < navy_count; ++index) {
+		NavyInstance* navy = nullptr;
+		if (!read_unit_instance_group(navy)) {
+			return false;
+		}
+	}
+	if (!check_saved_count("navies", navy_count, unit_instance_manager.navies.size())) {
+		return false;
+	}
+
+	return ret;
+}
+
+/* Relations */
+
+#define OV_DO_FOR_ALL_COUNTRY_RELATION_MAPS(F) \
+	F(relations) \
+	F(alliances) \
+	F(at_war) \
+	F(military_access) \
+	F(war_subsidies) \
+	F(command_units) \
+	F(vision) \
+	F(opinions) \
+	F(influence) \
+	F(influence_priority) \
+	F(discredits) \
+	F(embassy_bans)
+
+template<typename Writer>
+void InstanceSave::write_relations(write_context_t const& context, Writer& writer) {
+	CountryRelationManager const& country_relation_manager = context.instance_manager.country_relation_manager;
+
+#define WRITE_MAP(map) write_country_pair_map(writer, context.countries, country_relation_manager.map);
+	OV_DO_FOR_ALL_COUNTRY_RELATION_MAPS(WRITE_MAP)
+#undef WRITE_MAP
+}
+
+bool InstanceSave::read_relations(read_context_t const& context, BinaryReader& reader) {
+	CountryRelationManager& country_relation_manager = context.instance_manager.country_relation_manager;
+
+#define READ_MAP(map) \
+	if (!read_country_pair_map(reader, context.countries, country_relation_manager.map)) { \
+		return false; \
+	}
+	OV_DO_FOR_ALL_COUNTRY_RELATION_MAPS(READ_MAP)
+#undef READ_MAP
+
+	// Countries cache who they are at war with
+	for (CountryInstance& country : context.countries) {
+		country.war_enemies.clear();
+	}
+	for (auto const& [pair, at_war] : country_relation_manager.at_war) {
+		if (at_war) {
+			CountryInstance& first = context.countries[index_of(context.countries, pair.first)];
+			CountryInstance& second = context.countries[index_of(context.countries, pair.second)];
+			first.war_enemies.emplace(second);
+			second.war_enemies.emplace(first);
+		}
+	}
+	return true;
+}
+
+#undef OV_DO_FOR_ALL_COUNTRY_RELATION_MAPS
+
+bool InstanceSave::write(InstanceManager const& instance_manager, BinaryWriter& writer) {
+	if (
+		instance_manager.currently_updating_gamestate || instance_manager.currently_executing_game_actions ||
+		!instance_manager.is_bookmark_loaded()
+	) {
+		spdlog::error_s("Cannot save game - the game must have a bookmark loaded and be between ticks!");
+		return false;
+	}
+
+	const write_context_t context { instance_manager };
+
+	if (!can_write_event_modifiers(context)) {
+		spdlog::error_s("Cannot save game - it has event modifiers which can't be saved!");
+		return false;
+	}
+
+	writer.write(header_t {
+		.definitions_fingerprint = get_definitions_fingerprint(instance_manager.definition_manager),
+		.bookmark_index = index_of(
+			instance_manager.definition_manager.get_history_manager().get_bookmark_manager().get_bookmarks(),
+			instance_manager.bookmark
+		),
+		.today = instance_manager.today
+	});
+
+	const auto write_section = [&writer](const section_t section, auto write_contents) -> void {
+		writer.write(section);
+		const size_t count_offset = writer.begin_byte_span();
+		write_contents(writer);
+		writer.end_byte_span(count_offset);
+	};
+
+	write_section(section_t::GLOBAL, [&instance_manager](BinaryWriter& section_writer) -> void {
+		write_global(instance_manager, section_writer);
+	});
+	write_section(section_t::MARKETS, [&instance_manager](BinaryWriter& section_writer) -> void {
+		write_markets(instance_manager, section_writer);
+	});
+	write_section(section_t::COUNTRIES, [&context](BinaryWriter& section_writer) -> void {
+		section_writer.write<uint64_t>(context.countries.size());
+		for (CountryInstance const& country : context.countries) {
+			write_country(context, country, section_writer);
+		}
+	});
+	write_section(section_t::PROVINCES, [&context](BinaryWriter& section_writer) -> void {
+		section_writer.write<uint64_t>(context.provinces.size());
+		for (ProvinceInstance const& province : context.provinces) {
+			write_province(context, province, section_writer);
+		}
+	});
+	write_section(section_t::STATES, [&context](BinaryWriter& section_writer) -> void {
+		write_states(context, section_writer);
+	});
+	write_section(section_t::UNITS, [&context](BinaryWriter& section_writer) -> void {
+		write_units(context, section_writer);
+	});
+	write_section(section_t::RELATIONS, [&context](BinaryWriter& section_writer) -> void {
+		write_relations(context, section_writer);
+	});
+
+	return true;
+}
+
+bool InstanceSave::read_sections(InstanceManager& instance_manager, header_t const& header, BinaryReader& reader) {
+	if (
+		!instance_manager.is_bookmark_loaded() ||
+		header.bookmark_index != index_of(
+			instance_manager.definition_manager.get_history_manager().get_bookmark_manager().get_bookmarks(),
+			instance_manager.bookmark
+		)
+	) {
+		spdlog::error_s("Cannot load save - the game must have loaded the save's bookmark!");
+		return false;
+	}
+
+	const read_context_t context { instance_manager };
+
+	const auto read_section = [&reader](const section_t section, auto read_contents) -> bool {
+		section_t saved_section = section_t::_COUNT;
+		std::span<const uint8_t> section_data;
+		if (!reader.read(saved_section) || saved_section != section || !reader.read_byte_span(section_data)) {
+			spdlog::error_s("Save is missing its {} section!", get_section_name(section));
+			return false;
+		}
+		BinaryReader section_reader { section_data };
+		if (!read_contents(section_reader) || !section_reader.is_at_end()) {
+			spdlog::error_s("Failed to read save's {} section!", get_section_name(section));
+			return false;
+		}
+		return true;
+	};
+
+	instance_manager.today = header.today;
+
+	// Sections depend on earlier ones, e.g. states and units refer to provinces' owners and pops, and relations rebuild the
+	// countries' war enemies
+	const bool ret = read_section(section_t::GLOBAL, [&instance_manager](BinaryReader& section_reader) -> bool {
+		return read_global(instance_manager, section_reader);
+	}) && read_section(section_t::MARKETS, [&instance_manager](BinaryReader& section_reader) -> bool {
+		return read_markets(instance_manager, section_reader);
+	}) && read_section(section_t::COUNTRIES, [&context](BinaryReader& section_reader) -> bool {
+		if (!read_expected_count(section_reader, context.countries.size())) {
+			return false;
+		}
+		bool ret = true;
+		for (CountryInstance& country : context.countries) {
+			ret &= read_country(context, country, section_reader);
+		}
+		return ret;
+	}) && read_section(section_t::PROVINCES, [&context](BinaryReader& section_reader) -> bool {
+		if (!read_expected_count(section_reader, context.provinces.size())) {
+			return false;
+		}
+		bool ret = true;
+		for (ProvinceInstance& province : context.provinces) {
+			ret &= read_province(context, province, section_reader);
+		}
+		return ret;
+	}) && read_section(section_t::STATES, [&context](BinaryReader& section_reader) -> bool {
+		return read_states(context, section_reader);
+	}) && read_section(section_t::UNITS, [&context](BinaryReader& section_reader) -> bool {
+		return read_units(context, section_reader);
+	}) && read_section(section_t::RELATIONS, [&context](BinaryReader& section_reader) -> bool {
+		return read_relations(context, section_reader);
+	});
+
+	if (!ret) {
+		return false;
+	}
+
+	if (!reader.is_at_end()) {
+		spdlog::warn_s("Save has unexpected data after its last section, ignoring it.");
+	}
+
+	// Rebuilds everything derived from the loaded state, such as modifier sums and the pop caches
+	instance_manager.set_gamestate_needs_update();
+	instance_manager.update_gamestate();
+
+	return true;
+}
+
+/* The write functions InstanceChecksum hashes with */
+
+using hash_writer_t = InstanceChecksum::hash_writer_t;
+
+template void InstanceSave::write_global(InstanceManager const& instance_manager, hash_writer_t& writer);
+template void InstanceSave::write_market(GoodMarket const& market, hash_writer_t& writer);
+template void InstanceSave::write_country(write_context_t const& context, CountryInstance const& country, hash_writer_t& writer);
+template void InstanceSave::write_province(
+	write_context_t const& context, ProvinceInstance const& province, hash_writer_t& writer
+);
+template void InstanceSave::write_states(write_context_t const& context, hash_writer_t& writer);
+template void InstanceSave::write_unit_instances(write_context_t const& context, hash_writer_t& writer);
+template void InstanceSave::write_army(write_context_t const& context, ArmyInstance const& army, hash_writer_t& writer);
+template void InstanceSave::write_navy(write_context_t const& context, NavyInstance const& navy, hash_writer_t& writer);
+template void InstanceSave::write_relations(write_context_t const& context, hash_writer_t& writer);
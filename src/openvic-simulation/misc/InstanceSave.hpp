@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "openvic-simulation/core/io/BinaryStream.hpp"
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/core/portable/ForwardableSpan.hpp"
+#include "openvic-simulation/types/Date.hpp"
+#include "openvic-simulation/types/UnitBranchType.hpp"
+
+namespace OpenVic {
+	struct CountryInstance;
+	struct DefinitionManager;
+	struct GoodMarket;
+	struct InstanceManager;
+	struct ModifierInstance;
+	struct Pop;
+	struct ProvinceInstance;
+	struct UnitInstanceGroup;
+
+	/* Binary saves of an InstanceManager's mutable state. A save only stores what can change after its bookmark has been
+	 * loaded, so it is applied on top of a fresh instance set up from the same bookmark and definitions, which provide the
+	 * rest. Each subsystem is written as a separate length prefixed section, with its objects in index order and pointers
+	 * replaced by the indices of what they point to in their registries, or NULL_INDEX for null pointers.
+	 *
+	 * Values are written in native byte order, like the rest of BinaryWriter's output, and the header records a fingerprint
+	 * of the definitions' registries, so a save is only loaded where its indices still refer to the same definitions.
+	 * Values which the next gamestate update recalculates, and anything only valid during a tick, are not saved.
+	 *
+	 * Leaders, regiments, ships and unit groups created after the bookmark are recreated when loading, but none can have
+	 * been removed. States are saved as they are partitioned, and event modifiers must come from the event modifier
+	 * registry, otherwise the game can't be saved. */
+	struct InstanceSave {
+		friend struct InstanceChecksum;
+
+		static constexpr uint32_t MAGIC = 0x5653564F; // "OVSV"
+		static constexpr uint32_t VERSION = 2;
+		static constexpr uint32_t NULL_INDEX = static_cast<uint32_t>(-1);
+
+		enum struct section_t : uint32_t {
+			GLOBAL, MARKETS, COUNTRIES, PROVINCES, STATES, UNITS, RELATIONS, _COUNT
+		};
+
+		static constexpr std::string_view get_section_name(const section_t section) {
+			constexpr std::string_view SECTION_NAMES[static_cast<size_t>(section_t::_COUNT)] {
+				"global", "markets", "countries", "provinces", "states", "units", "relations"
+			};
+			return section < section_t::_COUNT ? SECTION_NAMES[static_cast<size_t>(section)] : "unknown";
+		}
+
+		struct header_t {
+			uint32_t magic = MAGIC;
+			uint32_t version = VERSION;
+			uint64_t definitions_fingerprint = 0;
+			uint32_t bookmark_index = NULL_INDEX;
+			Date today;
+		};
+
+		/* A hash of the identifiers of every registry a save refers to by index, in index order. Saves only load with
+		 * definitions which have the same fingerprint, which doesn't depend on the simulation build or on anything about the
+		 * definition files other than what they define. */
+		static uint64_t get_definitions_fingerprint(DefinitionManager const& definition_manager);
+
+		/* Reads and validates the header at the start of a save, leaving the reader positioned at the first section. */
+		static bool read_header(BinaryReader& reader, header_t& header);
+
+		/* Must be called between ticks and gamestate updates. Only reads instance_manager, so the writer's data can be
+		 * written to disk on another thread once this returns, while the game continues. Fails without writing anything
+		 * if the instance has state which can't be saved. */
+		static bool write(InstanceManager const& instance_manager, BinaryWriter& writer);
+
+		/* Reads the sections following the header into instance_manager, which must have loaded the header's bookmark and
+		 * not have ticked since. The instance should be discarded if this fails, as it may have been partially loaded. */
+		static bool read_sections(InstanceManager& instance_manager, header_t const& header, BinaryReader& reader);
+
+	private:
+		/* Writing uses a const context, so saving can't modify the instance, and reading a mutable one. */
+		template<typename Instance>
+		struct context_t {
+			template<typename T>
+			using element_t = std::conditional_t<std::is_const_v<Instance>, T const, T>;
+
+			Instance& instance_manager;
+			DefinitionManager const& definition_manager;
+			std::span<element_t<CountryInstance>> countries;
+			forwardable_span<element_t<ProvinceInstance>> provinces;
+
+			context_t(Instance& new_instance_manager);
+		};
+		using write_context_t = context_t<InstanceManager const>;
+		using read_context_t = context_t<InstanceManager>;
+
+		/* The write functions take any writer with BinaryWriter's write, write_span and write_string, so InstanceChecksum
+		 * can hash the same values without serialising them. They're instantiated in InstanceSave.cpp for BinaryWriter and
+		 * InstanceChecksum::hash_writer_t. */
+		template<typename Writer>
+		static void write_global(InstanceManager const& instance_manager, Writer& writer);
+		static bool read_global(InstanceManager& instance_manager, BinaryReader& reader);
+		template<typename Writer>
+		static void write_market(GoodMarket const& market, Writer& writer);
+		static bool read_market(GoodMarket& market, BinaryReader& reader);
+		static void write_markets(InstanceManager const& instance_manager, BinaryWriter& writer);
+		static bool read_markets(InstanceManager& instance_manager, BinaryReader& reader);
+		static bool can_write_event_modifiers(write_context_t const& context);
+		template<typename Writer>
+		static void write_event_modifiers(
+			write_context_t const& context, std::span<const ModifierInstance> event_modifiers, Writer& writer
+		);
+		static bool read_event_modifiers(
+			read_context_t const& context, memory::vector<ModifierInstance>& event_modifiers, BinaryReader& reader
+		);
+		template<typename Writer>
+		static void write_country(write_context_t const& context, CountryInstance const& country, Writer& writer);
+		static bool read_country(read_context_t const& context, CountryInstance& country, BinaryReader& reader);
+		template<typename Writer>
+		static void write_pop(write_context_t const& context, Pop const& pop, Writer& writer);
+		static bool read_pop(read_context_t const& context, ProvinceInstance& province, BinaryReader& reader);
+		template<typename Writer>
+		static void write_province(write_context_t const& context, ProvinceInstance const& province, Writer& writer);
+		static bool read_province(read_context_t const& context, ProvinceInstance& province, BinaryReader& reader);
+		template<typename Writer>
+		static void write_states(write_context_t const& context, Writer& writer);
+		static bool read_states(read_context_t const& context, BinaryReader& reader);
+		/* The units section is the unit instances followed by the armies and then the navies. */
+		template<typename Writer>
+		static void write_unit_instances(write_context_t const& context, Writer& writer);
+		template<typename Writer>
+		static void write_unit_instance_group(
+			write_context_t const& context, UnitInstanceGroup const& unit_instance_group, Writer& writer
+		);
+		template<typename Writer>
+		static void write_army(write_context_t const& context, ArmyInstance const& army, Writer& writer);
+		template<typename Writer>
+		static void write_navy(write_context_t const& context, NavyInstance const& navy, Writer& writer);
+		template<typename Writer>
+		static void write_units(write_context_t const& context, Writer& writer);
+		static bool read_units(read_context_t const& context, BinaryReader& reader);
+		template<typename Writer>
+		static void write_relations(write_context_t const& context, Writer& writer);
+		static bool read_relations(read_context_t const& context, BinaryReader& reader);
+	};
+}
@@ -4,11 +4,13 @@
 
 #include "openvic-simulation/core/template/EnumBitfield.hpp"
 #include "openvic-simulation/types/HasIdentifier.hpp"
+#include "openvic-simulation/types/HasIndex.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
 
 namespace OpenVic {
 	struct ModifierManager;
 
-	struct ModifierEffect : HasIdentifier {
+	struct ModifierEffect : HasIdentifier, HasIndex<ModifierEffect, modifier_effect_index_t> {
 		static constexpr size_t FORMAT_MULTIPLIER_BIT_COUNT = 2;
 		static constexpr size_t FORMAT_DECIMAL_PLACES_BIT_COUNT = 2;
 		static constexpr size_t FORMAT_SUFFIX_BIT_COUNT = 2;
@@ -106,7 +108,7 @@ namespace OpenVic {
 		const target_t targets;
 
 		ModifierEffect(
-			std::string_view new_identifier, format_t new_format, target_t new_targets,
+			std::string_view new_identifier, index_t new_index, format_t new_format, target_t new_targets,
 			std::string_view new_localisation_key, bool new_has_no_effect
 		);
 		ModifierEffect(ModifierEffect&&) = default;
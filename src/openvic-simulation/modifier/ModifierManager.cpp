@@ -2,6 +2,8 @@
 
 #include <utility>
 
+#include <type_safe/strong_typedef.hpp>
+
 #include "openvic-simulation/dataloader/NodeTools.hpp"
 #include "openvic-simulation/modifier/Modifier.hpp"
 #include "openvic-simulation/modifier/ModifierEffect.hpp"
@@ -58,16 +60,23 @@ bool ModifierManager::_register_modifier_effect(
 
 	const bool ret = registry.emplace_item(
 		identifier,
-		identifier, format, targets, localisation_key, has_no_effect
+		identifier, modifier_effect_index_t(modifier_effects_by_index.size()), format, targets, localisation_key,
+		has_no_effect
 	);
 
 	if (ret) {
 		effect_cache = &registry.back();
+		modifier_effects_by_index.push_back(effect_cache);
 	}
 
 	return ret;
 }
 
+ModifierEffect const* ModifierManager::get_modifier_effect_by_index(const modifier_effect_index_t index) const {
+	const size_t effect_index = type_safe::get(index);
+	return effect_index < modifier_effects_by_index.size() ? modifier_effects_by_index[effect_index] : nullptr;
+}
+
 #define REGISTER_MODIFIER_EFFECT(MAPPING_TYPE, TARGETS) \
 bool ModifierManager::register_##MAPPING_TYPE##_modifier_effect( \
 	ModifierEffect const*& effect_cache, \
@@ -783,7 +792,14 @@ bool ModifierManager::_add_modifier_cb(
 	if (effect->has_no_effect) {
 		spdlog::warn_s("This modifier does nothing: {}", *effect);
 	}
-	return expect_fixed_point(map_callback(modifier_value.values, effect))(value);
+	return expect_fixed_point([&modifier_value, effect](const fixed_point_t effect_value) -> bool {
+		if (modifier_value.has_effect(*effect)) {
+			spdlog::error_s("Duplicate map entry with key: \"{}\"", *effect);
+			return false;
+		}
+		modifier_value.set_effect(*effect, effect_value);
+		return true;
+	})(value);
 }
 
 key_value_callback_t ModifierManager::_expect_modifier_effect(
@@ -2,10 +2,12 @@
 
 #include <string_view>
 
+#include "openvic-simulation/core/memory/Vector.hpp"
 #include "openvic-simulation/modifier/Modifier.hpp"
 #include "openvic-simulation/modifier/ModifierEffectCache.hpp"
 #include "openvic-simulation/modifier/StaticModifierCache.hpp"
 #include "openvic-simulation/types/IdentifierRegistry.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
 
 namespace OpenVic {
 	struct ModifierManager {
@@ -32,6 +34,8 @@ namespace OpenVic {
 		modifier_effect_registry_t IDENTIFIER_REGISTRY(base_province_modifier_effect);
 		modifier_effect_registry_t IDENTIFIER_REGISTRY(terrain_modifier_effect);
 		case_insensitive_string_set_t complex_modifiers;
+		//effects are spread over several registries, this indexes them all for dense ModifierValue storage
+		memory::vector<ModifierEffect const*> modifier_effects_by_index;
 
 		IdentifierRegistry<IconModifier> IDENTIFIER_REGISTRY(event_modifier);
 		IdentifierRegistry<TriggeredModifier> IDENTIFIER_REGISTRY(triggered_modifier);
@@ -91,6 +95,12 @@ namespace OpenVic {
 		) const;
 
 	public:
+		size_t get_modifier_effect_count() const {
+			return modifier_effects_by_index.size();
+		}
+		//Maps a ModifierEffect::index back to its effect, or nullptr if no effect has that index.
+		ModifierEffect const* get_modifier_effect_by_index(const modifier_effect_index_t index) const;
+
 		bool register_complex_modifier(const std::string_view identifier);
 		static memory::string get_flat_identifier(const std::string_view complex_modifier_identifier, const std::string_view variant_identifier);
 
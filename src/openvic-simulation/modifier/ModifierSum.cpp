@@ -1,5 +1,6 @@
 #include "ModifierSum.hpp"
 
+#include <algorithm>
 #include <variant>
 
 #include "openvic-simulation/core/template/Concepts.hpp"
@@ -63,3 +64,39 @@ void ModifierSum::add_modifier(
 		);
 	}
 }
+
+bool ModifierSum::remove_modifier(
+	Modifier const& modifier, fixed_point_t multiplier, modifier_entry_t::modifier_source_t const& source,
+	ModifierEffect::target_t excluded_targets
+) {
+	// Zero multipliers are never added, so there's nothing to remove
+	if (multiplier == 0) {
+		return true;
+	}
+
+	const modifier_entry_t entry_to_remove {
+		modifier,
+		multiplier,
+		modifier_entry_t::source_or_null_fallback(source, this_source),
+		excluded_targets | this_excluded_targets
+	};
+
+	auto const it = std::find(modifiers.begin(), modifiers.end(), entry_to_remove);
+	if (it == modifiers.end()) {
+		return false;
+	}
+
+	value_sum.multiply_subtract_exclude_targets(
+		*entry_to_remove.modifier,
+		entry_to_remove.multiplier,
+		entry_to_remove.excluded_targets
+	);
+	modifiers.erase(it);
+	return true;
+}
+
+void ModifierSum::remove_modifiers_from_source(modifier_entry_t::modifier_source_t const& source) {
+	remove_modifiers_if([&source](modifier_entry_t const& m) -> bool {
+		return m.source == source;
+	});
+}
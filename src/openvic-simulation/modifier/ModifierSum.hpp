@@ -145,6 +145,34 @@ namespace OpenVic {
 			ModifierEffect::target_t excluded_targets = ModifierEffect::target_t::NO_TARGETS
 		);
 
+		// Removes the first entry add_modifier would have added with the same arguments and subtracts exactly what it
+		// contributed from value_sum. Effects it introduced stay present in value_sum with their targets, at 0.
+		// Returns false if the sum has no such entry; a zero multiplier is never added, so removing one returns true.
+		bool remove_modifier(
+			Modifier const& modifier,
+			fixed_point_t multiplier = 1,
+			modifier_entry_t::modifier_source_t const& source = {},
+			ModifierEffect::target_t excluded_targets = ModifierEffect::target_t::NO_TARGETS
+		);
+
+		// Removes every entry the predicate accepts, subtracting what each one contributed.
+		template<typename Predicate>
+		void remove_modifiers_if(Predicate&& predicate) {
+			for (modifier_entry_t const& m : modifiers) {
+				if (predicate(m)) {
+					value_sum.multiply_subtract_exclude_targets(
+						*m.modifier,
+						m.multiplier,
+						m.excluded_targets
+					);
+				}
+			}
+			modifiers.erase_if(predicate);
+		}
+
+		// Removes every entry from the source, e.g. a province's contribution to its controller's sum.
+		void remove_modifiers_from_source(modifier_entry_t::modifier_source_t const& source);
+
 		constexpr void make_room_for(ModifierSum const& modifier_sum) {
 			modifiers.make_room_for(modifier_sum.size());
 		}
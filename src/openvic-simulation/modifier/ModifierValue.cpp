@@ -1,53 +1,89 @@
 #include "ModifierValue.hpp"
 
-#include "openvic-simulation/core/stl/MutableIterator.hpp"
+#include <algorithm>
+
+#include <type_safe/strong_typedef.hpp>
+
+#include "openvic-simulation/modifier/ModifierManager.hpp"
 
 using namespace OpenVic;
 
+using enum ModifierEffect::target_t;
+
+void ModifierValue::grow_to_effect_count(const size_t effect_count) {
+	if (values_by_effect.size() < effect_count) {
+		values_by_effect.resize(effect_count);
+		targets_by_effect.resize(effect_count, NO_TARGETS);
+	}
+}
+
 void ModifierValue::trim() {
-	erase_if(values, [](effect_map_t::value_type const& value) -> bool {
-		return value.second == 0;
-	});
+	for (size_t i = 0; i < values_by_effect.size(); ++i) {
+		if (values_by_effect[i] == 0) {
+			targets_by_effect[i] = NO_TARGETS;
+		}
+	}
+
+	size_t effect_count = targets_by_effect.size();
+	while (effect_count > 0 && targets_by_effect[effect_count - 1] == NO_TARGETS) {
+		--effect_count;
+	}
+	values_by_effect.resize(effect_count);
+	targets_by_effect.resize(effect_count);
 }
 
 size_t ModifierValue::get_effect_count() const {
-	return values.size();
+	return values_by_effect.size() - std::count(targets_by_effect.begin(), targets_by_effect.end(), NO_TARGETS);
 }
 
 void ModifierValue::clear() {
-	values.clear();
+	values_by_effect.clear();
+	targets_by_effect.clear();
 }
 
 bool ModifierValue::empty() const {
-	return values.empty();
+	return std::all_of(
+		targets_by_effect.begin(), targets_by_effect.end(),
+		[](const ModifierEffect::target_t targets) -> bool {
+			return targets == NO_TARGETS;
+		}
+	);
 }
 
 fixed_point_t ModifierValue::get_effect(ModifierEffect const& effect, bool* effect_found) const {
-	const effect_map_t::const_iterator it = values.find(&effect);
-	if (it != values.end()) {
-		if (effect_found != nullptr) {
-			*effect_found = true;
-		}
-		return it->second;
-	}
+	const size_t i = type_safe::get(effect.index);
+	const bool is_present = i < targets_by_effect.size() && targets_by_effect[i] != NO_TARGETS;
 
 	if (effect_found != nullptr) {
-		*effect_found = false;
+		*effect_found = is_present;
 	}
-	return 0;
+	return is_present ? values_by_effect[i] : fixed_point_t::_0;
 }
 
 bool ModifierValue::has_effect(ModifierEffect const& effect) const {
-	return values.contains(&effect);
+	const size_t i = type_safe::get(effect.index);
+	return i < targets_by_effect.size() && targets_by_effect[i] != NO_TARGETS;
 }
 
 void ModifierValue::set_effect(ModifierEffect const& effect, fixed_point_t value) {
-	values[&effect] = value;
+	const size_t i = type_safe::get(effect.index);
+	grow_to_effect_count(i + 1);
+	values_by_effect[i] = value;
+	targets_by_effect[i] = effect.targets;
 }
 
 ModifierValue& ModifierValue::operator+=(ModifierValue const& right) {
-	for (effect_map_t::value_type const& value : right.values) {
-		values[value.first] += value.second;
+	const size_t effect_count = right.values_by_effect.size();
+	grow_to_effect_count(effect_count);
+
+	fixed_point_t* const values = values_by_effect.data();
+	ModifierEffect::target_t* const targets = targets_by_effect.data();
+	fixed_point_t const* const right_values = right.values_by_effect.data();
+	ModifierEffect::target_t const* const right_targets = right.targets_by_effect.data();
+	for (size_t i = 0; i < effect_count; ++i) {
+		//absent effects are always 0, so adding them is harmless
+		values[i] += right_values[i];
+		targets[i] |= right_targets[i];
 	}
 	return *this;
 }
@@ -59,15 +95,23 @@ ModifierValue ModifierValue::operator+(ModifierValue const& right) const {
 
 ModifierValue ModifierValue::operator-() const {
 	ModifierValue copy = *this;
-	for (auto value : mutable_iterator(copy.values)) {
-		value.second = -value.second;
+	for (fixed_point_t& value : copy.values_by_effect) {
+		value = -value;
 	}
 	return copy;
 }
 
 ModifierValue& ModifierValue::operator-=(ModifierValue const& right) {
-	for (effect_map_t::value_type const& value : right.values) {
-		values[value.first] -= value.second;
+	const size_t effect_count = right.values_by_effect.size();
+	grow_to_effect_count(effect_count);
+
+	fixed_point_t* const values = values_by_effect.data();
+	ModifierEffect::target_t* const targets = targets_by_effect.data();
+	fixed_point_t const* const right_values = right.values_by_effect.data();
+	ModifierEffect::target_t const* const right_targets = right.targets_by_effect.data();
+	for (size_t i = 0; i < effect_count; ++i) {
+		values[i] -= right_values[i];
+		targets[i] |= right_targets[i];
 	}
 	return *this;
 }
@@ -78,8 +122,8 @@ ModifierValue ModifierValue::operator-(ModifierValue const& right) const {
 }
 
 ModifierValue& ModifierValue::operator*=(const fixed_point_t right) {
-	for (auto value : mutable_iterator(values)) {
-		value.second *= right;
+	for (fixed_point_t& value : values_by_effect) {
+		value *= right;
 	}
 	return *this;
 }
@@ -90,41 +134,89 @@ ModifierValue ModifierValue::operator*(const fixed_point_t right) const {
 }
 
 void ModifierValue::apply_exclude_targets(ModifierEffect::target_t excluded_targets) {
-	using enum ModifierEffect::target_t;
-
 	// We could test if excluded_targets is NO_TARGETS (and so we do nothing) or ALL_TARGETS (and so we clear everything),
 	// but so long as this is always called with an explicit/hardcoded value then we'll never have either of those cases.
-	erase_if(
-		values,
-		[excluded_targets](effect_map_t::value_type const& value) -> bool {
-			return !ModifierEffect::excludes_targets(value.first->targets, excluded_targets);
+	for (size_t i = 0; i < values_by_effect.size(); ++i) {
+		if (!ModifierEffect::excludes_targets(targets_by_effect[i], excluded_targets)) {
+			values_by_effect[i] = 0;
+			targets_by_effect[i] = NO_TARGETS;
 		}
-	);
+	}
 }
 
-void ModifierValue::multiply_add_exclude_targets(
+template<bool Subtract>
+void ModifierValue::multiply_accumulate_exclude_targets(
 	ModifierValue const& other, fixed_point_t multiplier, ModifierEffect::target_t excluded_targets
 ) {
-	using enum ModifierEffect::target_t;
-
 	if (multiplier == fixed_point_t::_1 && excluded_targets == NO_TARGETS) {
-		*this += other;
+		if constexpr (Subtract) {
+			*this -= other;
+		} else {
+			*this += other;
+		}
 	} else if (multiplier != 0) {
 		// We could test that excluded_targets != ALL_TARGETS, but in practice it's always
 		// called with an explcit/hardcoded value and so won't ever exclude everything.
-		for (effect_map_t::value_type const& value : other.values) {
-			if (ModifierEffect::excludes_targets(value.first->targets, excluded_targets)) {
-				values[value.first] += value.second * multiplier;
+		const size_t effect_count = other.values_by_effect.size();
+		grow_to_effect_count(effect_count);
+
+		fixed_point_t* const values = values_by_effect.data();
+		ModifierEffect::target_t* const targets = targets_by_effect.data();
+		fixed_point_t const* const other_values = other.values_by_effect.data();
+		ModifierEffect::target_t const* const other_targets = other.targets_by_effect.data();
+		for (size_t i = 0; i < effect_count; ++i) {
+			//branchless so the loop vectorises, absent effects have no targets and so are never included
+			const ModifierEffect::target_t included_targets = ModifierEffect::excludes_targets(other_targets[i], excluded_targets)
+				? other_targets[i]
+				: NO_TARGETS;
+			//the product is rounded identically either way, so subtracting it exactly cancels adding it
+			const fixed_point_t product = included_targets != NO_TARGETS
+				? other_values[i] * multiplier
+				: fixed_point_t::_0;
+			if constexpr (Subtract) {
+				values[i] -= product;
+			} else {
+				values[i] += product;
 			}
+			targets[i] |= included_targets;
 		}
 	}
 }
 
-namespace OpenVic { // so the compiler shuts up
-	std::ostream& operator<<(std::ostream& stream, ModifierValue const& value) {
-		for (ModifierValue::effect_map_t::value_type const& effect : value.values) {
-			stream << effect.first << ": " << effect.second << "\n";
+void ModifierValue::multiply_add_exclude_targets(
+	ModifierValue const& other, fixed_point_t multiplier, ModifierEffect::target_t excluded_targets
+) {
+	multiply_accumulate_exclude_targets<false>(other, multiplier, excluded_targets);
+}
+
+void ModifierValue::multiply_subtract_exclude_targets(
+	ModifierValue const& other, fixed_point_t multiplier, ModifierEffect::target_t excluded_targets
+) {
+	multiply_accumulate_exclude_targets<true>(other, multiplier, excluded_targets);
+}
+
+void ModifierValue::for_each_non_zero_effect(ModifierManager const& modifier_manager, effect_callback_t callback) const {
+	for_each_effect([&modifier_manager, &callback](
+		const modifier_effect_index_t effect_index, const fixed_point_t value
+	) -> void {
+		if (value == 0) {
+			return;
 		}
+		ModifierEffect const* const effect = modifier_manager.get_modifier_effect_by_index(effect_index);
+		if (effect != nullptr) {
+			callback(*effect, value);
+		}
+	});
+}
+
+namespace OpenVic { // so the compiler shuts up
+	std::ostream& operator<<(std::ostream& stream, ModifierValue::effects_printer_t const& printer) {
+		printer.value.for_each_non_zero_effect(
+			printer.modifier_manager,
+			[&stream](ModifierEffect const& effect, const fixed_point_t effect_value) -> void {
+				stream << effect.get_identifier() << ": " << effect_value << "\n";
+			}
+		);
 		return stream;
 	}
 }
@@ -1,20 +1,36 @@
 #pragma once
 
+#include <ostream>
+
+#include <function2/function2.hpp>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
 #include "openvic-simulation/modifier/ModifierEffect.hpp"
-#include "openvic-simulation/types/fixed_point/FixedPointMap.hpp"
+#include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
 
 namespace OpenVic {
+	struct ModifierManager;
+
+	//Effects are stored densely by ModifierEffect::index, so lookups are a single load and
+	//combining values is a straight loop over both arrays that the compiler can vectorise.
 	struct ModifierValue {
 		friend struct ModifierManager;
 
-		using effect_map_t = fixed_point_map_t<ModifierEffect const*>;
-
 	private:
-		effect_map_t PROPERTY(values);
+		memory::vector<fixed_point_t> values_by_effect;
+		//NO_TARGETS marks effects which aren't present, otherwise the targets of the effect at that index
+		memory::vector<ModifierEffect::target_t> targets_by_effect;
+
+		void grow_to_effect_count(const size_t effect_count);
+
+		template<bool Subtract>
+		void multiply_accumulate_exclude_targets(
+			ModifierValue const& other, fixed_point_t multiplier, ModifierEffect::target_t excluded_targets
+		);
 
 	public:
 		ModifierValue() {};
-		ModifierValue(effect_map_t&& new_values) : values { std::move(new_values) } {};
 		ModifierValue(ModifierValue const&) = default;
 		ModifierValue(ModifierValue&&) = default;
 
@@ -31,6 +47,32 @@ namespace OpenVic {
 		bool has_effect(ModifierEffect const& effect) const;
 		void set_effect(ModifierEffect const& effect, fixed_point_t value);
 
+		//Calls callback(modifier_effect_index_t, fixed_point_t) for every present effect in index order.
+		template<typename Functor>
+		void for_each_effect(Functor&& callback) const {
+			for (size_t i = 0; i < values_by_effect.size(); ++i) {
+				if (targets_by_effect[i] != ModifierEffect::target_t::NO_TARGETS) {
+					callback(modifier_effect_index_t(i), values_by_effect[i]);
+				}
+			}
+		}
+
+		using effect_callback_t = fu2::function_view<void(ModifierEffect const&, fixed_point_t) const>;
+
+		//Calls callback for every present effect with a non-zero value in index order, looking the effects up in
+		//modifier_manager, which must be the one whose effects were set.
+		void for_each_non_zero_effect(ModifierManager const& modifier_manager, effect_callback_t callback) const;
+
+		struct effects_printer_t {
+			ModifierValue const& value;
+			ModifierManager const& modifier_manager;
+		};
+
+		//Streams as one "identifier: value" line per non-zero effect.
+		effects_printer_t print_effects(ModifierManager const& modifier_manager) const {
+			return { *this, modifier_manager };
+		}
+
 		ModifierValue& operator+=(ModifierValue const& right);
 		ModifierValue operator+(ModifierValue const& right) const;
 		ModifierValue operator-() const;
@@ -43,7 +85,11 @@ namespace OpenVic {
 		void multiply_add_exclude_targets(
 			ModifierValue const& other, fixed_point_t multiplier, ModifierEffect::target_t excluded_targets
 		);
+		//Exactly undoes multiply_add_exclude_targets with the same arguments, the targets of the effects are left present.
+		void multiply_subtract_exclude_targets(
+			ModifierValue const& other, fixed_point_t multiplier, ModifierEffect::target_t excluded_targets
+		);
 
-		friend std::ostream& operator<<(std::ostream& stream, ModifierValue const& value);
+		friend std::ostream& operator<<(std::ostream& stream, effects_printer_t const& printer);
 	};
 }
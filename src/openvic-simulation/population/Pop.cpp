@@ -306,19 +306,19 @@ void Pop::fill_needs_fulfilled_goods_with_false() {
 	#undef FILL_WITH_FALSE
 }
 
-void Pop::pay_income_tax(fixed_point_t& income) {
+void Pop::pay_income_tax(fixed_point_t& income, CountryReportBuffer& country_report_buffer) {
 	CountryInstance* const tax_collector_nullable = get_location().get_country_to_report_economy();
 	if (tax_collector_nullable == nullptr) {
 		return;
 	}
 	const fixed_point_t effective_tax_rate = tax_collector_nullable->get_effective_tax_rate_by_strata(get_type().strata).get_untracked();
 	const fixed_point_t tax = effective_tax_rate * income;
-	tax_collector_nullable->report_pop_income_tax(type, income, tax);
+	tax_collector_nullable->report_pop_income_tax(country_report_buffer, type, income, tax);
 	income -= tax;
 }
 
 template<bool IsTaxable>
-void Pop::add_artisanal_revenue(const fixed_point_t revenue) {
+void Pop::add_artisanal_revenue(const fixed_point_t revenue, CountryReportBuffer& country_report_buffer) {
 	if (OV_unlikely(revenue == 0)) {
 		if (size >= TRUNCATION_ACCEPTABLE_BELOW_SIZE) {
 			spdlog::warn_s("Adding artisanal_revenue of 0 to pop. Context{}", get_pop_context_text());
@@ -342,7 +342,7 @@ void Pop::add_artisanal_revenue(const fixed_point_t revenue) {
 			);
 		}
 
-		pay_income_tax(income);
+		pay_income_tax(income, country_report_buffer);
 	} else {
 		income = revenue;
 	}
@@ -351,11 +351,11 @@ void Pop::add_artisanal_revenue(const fixed_point_t revenue) {
 	income += income;
 	cash += income;
 }
-template void Pop::add_artisanal_revenue<true>(const fixed_point_t revenue);
-template void Pop::add_artisanal_revenue<false>(const fixed_point_t revenue);
+template void Pop::add_artisanal_revenue<true>(const fixed_point_t revenue, CountryReportBuffer& country_report_buffer);
+template void Pop::add_artisanal_revenue<false>(const fixed_point_t revenue, CountryReportBuffer& country_report_buffer);
 
 #define DEFINE_ADD_INCOME_FUNCTIONS(name) \
-	void Pop::add_##name(fixed_point_t amount){ \
+	void Pop::add_##name(fixed_point_t amount, CountryReportBuffer& country_report_buffer){ \
 		if (OV_unlikely(amount == 0)) { \
 			if (size >= TRUNCATION_ACCEPTABLE_BELOW_SIZE) { \
 				spdlog::warn_s("Adding " #name " of 0 to pop. Context{}", get_pop_context_text()); \
@@ -366,7 +366,7 @@ template void Pop::add_artisanal_revenue<false>(const fixed_point_t revenue);
 			spdlog::error_s("Adding negative " #name " of {} to pop. Context{}", amount, get_pop_context_text()); \
 			return; \
 		} \
-		pay_income_tax(amount); \
+		pay_income_tax(amount, country_report_buffer); \
 		name += amount; \
 		income += amount; \
 		cash += amount; \
@@ -411,11 +411,10 @@ void Pop::add_import_subsidies(const fixed_point_t amount) {
 
 #define DEFINE_NEEDS_FULFILLED(need_category) \
 	fixed_point_t Pop::get_##need_category##_needs_fulfilled() const { \
-		const fixed_point_t desired_quantity_copy = need_category##_needs_desired_quantity.get_copy_of_value(); \
-		if (desired_quantity_copy == 0) { \
+		if (need_category##_needs_desired_quantity == 0) { \
 			return 1; \
 		} \
-		return need_category##_needs_acquired_quantity.get_copy_of_value() / desired_quantity_copy; \
+		return need_category##_needs_acquired_quantity / need_category##_needs_desired_quantity; \
 	}
 OV_DO_FOR_ALL_NEED_CATEGORIES(DEFINE_NEEDS_FULFILLED)
 #undef DEFINE_NEEDS_FULFILLED
@@ -487,6 +486,8 @@ void Pop::allocate_for_needs(
 void Pop::pop_tick(
 	PopValuesFromProvince const& shared_values,
 	RandomU32& random_number_generator,
+	MarketOrderBuffer& market_order_buffer,
+	CountryReportBuffer& country_report_buffer,
 	TypedSpan<good_index_t, char> reusable_goods_mask,
 	forwardable_span<
 		memory::vector<fixed_point_t>,
@@ -496,6 +497,8 @@ void Pop::pop_tick(
 	pop_tick_without_cleanup(
 		shared_values,
 		random_number_generator,
+		market_order_buffer,
+		country_report_buffer,
 		reusable_goods_mask,
 		reusable_vectors
 	);
@@ -507,6 +510,8 @@ void Pop::pop_tick(
 void Pop::pop_tick_without_cleanup(
 	PopValuesFromProvince const& shared_values,
 	RandomU32& random_number_generator,
+	MarketOrderBuffer& market_order_buffer,
+	CountryReportBuffer& country_report_buffer,
 	TypedSpan<good_index_t, char> reusable_goods_mask,
 	forwardable_span<
 		memory::vector<fixed_point_t>,
@@ -532,6 +537,7 @@ void Pop::pop_tick_without_cleanup(
 			*this,
 			shared_values,
 			random_number_generator,
+			country_report_buffer,
 			reusable_goods_mask,
 			max_quantity_to_buy_per_good,
 			money_to_spend_per_good,
@@ -553,7 +559,7 @@ void Pop::pop_tick_without_cleanup(
 	CountryInstance* const country_to_report_economy_nullable = get_location().get_country_to_report_economy();
 
 	if (country_to_report_economy_nullable != nullptr) {
-		country_to_report_economy_nullable->request_salaries_and_welfare_and_import_subsidies(*this);
+		country_to_report_economy_nullable->request_salaries_and_welfare_and_import_subsidies(*this, country_report_buffer);
 	}
 
 	//unemployment subsidies are based on yesterdays unemployment
@@ -583,7 +589,7 @@ void Pop::pop_tick_without_cleanup(
 					continue; \
 				} \
 				if (country_to_report_economy_nullable != nullptr) { \
-					country_to_report_economy_nullable->report_pop_need_demand(pop_type, good_index, max_quantity_to_buy); \
+					country_to_report_economy_nullable->report_pop_need_demand(country_report_buffer, pop_type, good_index, max_quantity_to_buy); \
 				} \
 				need_category##_needs_desired_quantity += max_quantity_to_buy; \
 				auto goods_to_sell_iterator = goods_to_sell.find(good_index); \
@@ -593,7 +599,7 @@ void Pop::pop_tick_without_cleanup(
 					max_quantity_to_buy -= own_produce_consumed; \
 					need_category##_needs_acquired_quantity += own_produce_consumed; \
 					if (country_to_report_economy_nullable != nullptr) { \
-						country_to_report_economy_nullable->report_pop_need_consumption(pop_type, good_index, own_produce_consumed); \
+						country_to_report_economy_nullable->report_pop_need_consumption(country_report_buffer, pop_type, good_index, own_produce_consumed); \
 					} \
 				} \
 				if (OV_likely(max_quantity_to_buy > 0)) { \
@@ -608,7 +614,7 @@ void Pop::pop_tick_without_cleanup(
 	#undef FILL_NEEDS
 
 	//It's safe to use cash as this happens before cash is updated via spending
-	fixed_point_t cash_left_to_spend = cash.get_copy_of_value() / shared_values.get_max_cost_multiplier()
+	fixed_point_t cash_left_to_spend = cash / shared_values.get_max_cost_multiplier()
 		- cash_allocated_for_artisanal_spending;
 
 	#define ALLOCATE_FOR_NEEDS(need_category) \
@@ -638,14 +644,18 @@ void Pop::pop_tick_without_cleanup(
 		
 		const fixed_point_t money_to_spend = money_to_spend_per_good[i];
 
-		market_instance.place_buy_up_to_order({
-			good_index_t(i),
-			country_index_optional,
-			max_quantity_to_buy,
-			money_to_spend,
-			this,
-			after_buy
-		});
+		market_instance.place_buy_up_to_order(
+			{
+				good_index_t(i),
+				country_index_optional,
+				max_quantity_to_buy,
+				money_to_spend,
+				this,
+				after_buy
+			},
+			market_order_buffer,
+			country_report_buffer
+		);
 	}
 
 	for (const auto [good_index, quantity_to_sell] : goods_to_sell) {
@@ -664,12 +674,14 @@ void Pop::pop_tick_without_cleanup(
 				this,
 				after_sell
 			},
+			market_order_buffer,
+			country_report_buffer,
 			reusable_vectors[4]
 		);
 	}
 }
 
-void Pop::after_buy(void* actor, BuyResult const& buy_result) {
+void Pop::after_buy(void* actor, BuyResult const& buy_result, CountryReportBuffer& country_report_buffer) {
 	const fixed_point_t quantity_bought = buy_result.quantity_bought;
 
 	if (quantity_bought == 0) {
@@ -727,7 +739,7 @@ void Pop::after_buy(void* actor, BuyResult const& buy_result) {
 			pop.need_category##_needs_acquired_quantity += consumed_quantity; \
 			quantity_left_to_consume -= consumed_quantity; \
 			if (get_country_to_report_economy_nullable != nullptr) { \
-				get_country_to_report_economy_nullable->report_pop_need_consumption(pop.type, good_index, consumed_quantity); \
+				get_country_to_report_economy_nullable->report_pop_need_consumption(country_report_buffer, pop.type, good_index, consumed_quantity); \
 			} \
 			const fixed_point_t expense = fp::mul_div( \
 				money_spent, \
@@ -741,15 +753,20 @@ void Pop::after_buy(void* actor, BuyResult const& buy_result) {
 	#undef CONSUME_NEED
 }
 
-void Pop::after_sell(void* actor, SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector) {
+void Pop::after_sell(
+	void* actor,
+	SellResult const& sell_result,
+	CountryReportBuffer& country_report_buffer,
+	memory::vector<fixed_point_t>& reusable_vector
+) {
 	Pop& pop = *static_cast<Pop*>(actor);
 	if (sell_result.money_gained > 0) {
 		OV_ERR_FAIL_COND_MSG(!pop.artisanal_producer_optional.has_value(), "Pop is selling artisanal goods but has no artisan.");
 		ArtisanalProducer& artisan = pop.artisanal_producer_optional.value();
 		if (artisan.get_last_produced_good() != nullptr && artisan.get_last_produced_good()->index == sell_result.good_index) {
-			pop.add_artisanal_revenue<true>(sell_result.money_gained);
+			pop.add_artisanal_revenue<true>(sell_result.money_gained, country_report_buffer);
 		} else {
-			pop.add_artisanal_revenue<false>(sell_result.money_gained);
+			pop.add_artisanal_revenue<false>(sell_result.money_gained, country_report_buffer);
 		}
 		artisan.subtract_from_stockpile(sell_result.good_index, sell_result.quantity_sold);
 	}
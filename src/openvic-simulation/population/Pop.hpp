@@ -11,7 +11,6 @@
 #include "openvic-simulation/population/PopIdInProvince.hpp"
 #include "openvic-simulation/population/PopNeedsMacro.hpp"
 #include "openvic-simulation/population/PopSize.hpp"
-#include "openvic-simulation/types/fixed_point/Atomic.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPointMap.hpp"
 #include "openvic-simulation/types/UnitBranchType.hpp"
@@ -20,8 +19,10 @@ namespace OpenVic {
 	struct BuyResult;
 	struct CountryInstance;
 	struct CountryParty;
+	struct CountryReportBuffer;
 	struct Culture;
 	struct MarketInstance;
+	struct MarketOrderBuffer;
 	struct MilitaryDefines;
 	struct PopDeps;
 	struct PopManager;
@@ -35,6 +36,7 @@ namespace OpenVic {
 
 	struct PopBase {
 		friend PopManager;
+		friend struct InstanceSave;
 
 	protected:
 		std::reference_wrapper<const PopType> PROPERTY_ACCESS(type, protected);
@@ -75,6 +77,8 @@ namespace OpenVic {
 	 * POP-18, POP-19, POP-20, POP-21, POP-34, POP-35, POP-36, POP-37
 	 */
 	struct Pop : PopBase {
+		friend struct InstanceSave;
+
 		enum struct culture_status_t : uint8_t {
 			UNACCEPTED, ACCEPTED, PRIMARY
 		};
@@ -140,12 +144,12 @@ namespace OpenVic {
 	private:
 		fixed_point_t PROPERTY(income);
 		fixed_point_t PROPERTY(savings);
-		moveable_atomic_fixed_point_t PROPERTY(cash);
-		moveable_atomic_fixed_point_t PROPERTY(expenses); //positive value means POP paid for goods. This is displayed * -1 in UI.
-		moveable_atomic_fixed_point_t PROPERTY(yesterdays_import_value);
+		fixed_point_t PROPERTY(cash);
+		fixed_point_t PROPERTY(expenses); //positive value means POP paid for goods. This is displayed * -1 in UI.
+		fixed_point_t PROPERTY(yesterdays_import_value);
 
 		#define NEED_MEMBERS(need_category) \
-			moveable_atomic_fixed_point_t need_category##_needs_acquired_quantity, need_category##_needs_desired_quantity; \
+			fixed_point_t need_category##_needs_acquired_quantity, need_category##_needs_desired_quantity; \
 			public: \
 				fixed_point_t get_##need_category##_needs_fulfilled() const; \
 			private: \
@@ -179,20 +183,27 @@ namespace OpenVic {
 		void pop_tick_without_cleanup(
 			PopValuesFromProvince const& shared_values,
 			RandomU32& random_number_generator,
+			MarketOrderBuffer& market_order_buffer,
+			CountryReportBuffer& country_report_buffer,
 			TypedSpan<good_index_t, char> reusable_goods_mask,
 			forwardable_span<
 				memory::vector<fixed_point_t>,
 				VECTORS_FOR_POP_TICK
 			> reusable_vectors
 		);
-		void pay_income_tax(fixed_point_t& income);
+		void pay_income_tax(fixed_point_t& income, CountryReportBuffer& country_report_buffer);
 
 		template<bool IsTaxable>
-		void add_artisanal_revenue(const fixed_point_t revenue);
+		void add_artisanal_revenue(const fixed_point_t revenue, CountryReportBuffer& country_report_buffer);
 
-		static void after_buy(void* actor, BuyResult const& buy_result);
+		static void after_buy(void* actor, BuyResult const& buy_result, CountryReportBuffer& country_report_buffer);
 		//matching GoodMarketSellOrder::callback_t
-		static void after_sell(void* actor, SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector);
+		static void after_sell(
+			void* actor,
+			SellResult const& sell_result,
+			CountryReportBuffer& country_report_buffer,
+			memory::vector<fixed_point_t>& reusable_vector
+		);
 
 	public:
 		Pop(
@@ -216,17 +227,23 @@ namespace OpenVic {
 			const fixed_point_t pop_size_per_regiment_multiplier
 		);
 
+		//income is taxed, which is reported to the tax collector
+		#define DECLARE_POP_INCOME_STORE_FUNCTIONS(name) \
+			void add_##name(fixed_point_t amount, CountryReportBuffer& country_report_buffer);
 		#define DECLARE_POP_MONEY_STORE_FUNCTIONS(name) \
 			void add_##name(fixed_point_t amount);
 
-		OV_DO_FOR_ALL_TYPES_OF_POP_INCOME(DECLARE_POP_MONEY_STORE_FUNCTIONS)
+		OV_DO_FOR_ALL_TYPES_OF_POP_INCOME(DECLARE_POP_INCOME_STORE_FUNCTIONS)
 		OV_DO_FOR_ALL_TYPES_OF_POP_EXPENSES(DECLARE_POP_MONEY_STORE_FUNCTIONS)
 		DECLARE_POP_MONEY_STORE_FUNCTIONS(import_subsidies)
 		#undef DECLARE_POP_MONEY_STORE_FUNCTIONS
+		#undef DECLARE_POP_INCOME_STORE_FUNCTIONS
 
 		void pop_tick(
 			PopValuesFromProvince const& shared_values,
 			RandomU32& random_number_generator,
+			MarketOrderBuffer& market_order_buffer,
+			CountryReportBuffer& country_report_buffer,
 			TypedSpan<good_index_t, char> reusable_goods_mask,
 			forwardable_span<
 				memory::vector<fixed_point_t>,
@@ -163,7 +163,7 @@ void PopsAggregate::add_pops_aggregate(Pop const& pop) {
 	const pop_size_t pop_size = pop.get_size();
 
 	total_population += pop_size;
-	yesterdays_import_value += pop.get_yesterdays_import_value().get_copy_of_value();
+	yesterdays_import_value += pop.get_yesterdays_import_value();
 	const int64_t pop_size_v = type_safe::get(pop_size);
 	update_running_total_raw_128(literacy_running_total_raw, pop_size, pop.get_literacy());
 	update_running_total_raw_128(consciousness_running_total_raw, pop_size, pop.get_consciousness());
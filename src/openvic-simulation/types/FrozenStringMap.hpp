@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/core/template/Concepts.hpp"
+#include "openvic-simulation/types/OrderedContainers.hpp"
+
+namespace OpenVic {
+	/* Read-only string keyed lookup table, built once from a set of unique keys and rebuilt from scratch if they change.
+	 * Keys are copied into one contiguous arena and slots are kept in an open addressed, linearly probed array at most
+	 * half full, each slot holding its key's full hash so that probes rarely touch the arena for keys that don't match.
+	 * Hashing and key comparison use Case, so the table finds the same entries as the template_string_map_t it mirrors. */
+	template<typename T, string_map_case Case = StringMapCaseSensitive>
+	struct FrozenStringMap {
+	private:
+		using hash_t = typename Case::hash;
+		using equal_t = typename Case::equal;
+
+		struct slot_t {
+			std::size_t hash;
+			uint32_t key_offset;
+			uint32_t key_size;
+			T value;
+		};
+
+		static constexpr uint32_t EMPTY_KEY_SIZE = std::numeric_limits<uint32_t>::max();
+		static constexpr std::size_t MIN_SLOT_COUNT = 8;
+
+		memory::vector<char> key_arena;
+		memory::vector<slot_t> slots;
+		std::size_t slot_mask = 0;
+		std::size_t entry_count = 0;
+
+		constexpr std::string_view get_key(slot_t const& slot) const {
+			return { key_arena.data() + slot.key_offset, slot.key_size };
+		}
+
+		constexpr slot_t const* find_slot(std::string_view key) const {
+			if (entry_count == 0) {
+				return nullptr;
+			}
+			const std::size_t hash = hash_t {}(key);
+			for (std::size_t slot_index = hash & slot_mask;; slot_index = (slot_index + 1) & slot_mask) {
+				slot_t const& slot = slots[slot_index];
+				if (slot.key_size == EMPTY_KEY_SIZE) {
+					return nullptr;
+				}
+				if (slot.hash == hash && equal_t {}(get_key(slot), key)) {
+					return &slot;
+				}
+			}
+		}
+
+	public:
+		/* Replaces the contents with the (key, value) pairs of map, whose keys must already be unique under Case. */
+		template<typename Map>
+		constexpr void build(Map const& map) {
+			clear();
+			if (map.empty()) {
+				return;
+			}
+
+			std::size_t arena_size = 0;
+			for (auto const& [key, value] : map) {
+				arena_size += std::string_view { key }.size();
+			}
+			key_arena.reserve(arena_size);
+
+			slots.resize(
+				std::max(std::bit_ceil(map.size() * 2), MIN_SLOT_COUNT),
+				slot_t { 0, 0, EMPTY_KEY_SIZE, T {} }
+			);
+			slot_mask = slots.size() - 1;
+
+			for (auto const& [key, value] : map) {
+				const std::string_view key_view { key };
+				const std::size_t hash = hash_t {}(key_view);
+				std::size_t slot_index = hash & slot_mask;
+				while (slots[slot_index].key_size != EMPTY_KEY_SIZE) {
+					slot_index = (slot_index + 1) & slot_mask;
+				}
+				slots[slot_index] = {
+					hash, static_cast<uint32_t>(key_arena.size()), static_cast<uint32_t>(key_view.size()), value
+				};
+				key_arena.insert(key_arena.end(), key_view.begin(), key_view.end());
+			}
+			entry_count = map.size();
+		}
+
+		constexpr void clear() {
+			key_arena.clear();
+			slots.clear();
+			slot_mask = 0;
+			entry_count = 0;
+		}
+
+		constexpr T const* find(std::string_view key) const {
+			slot_t const* slot = find_slot(key);
+			return slot != nullptr ? &slot->value : nullptr;
+		}
+
+		constexpr bool contains(std::string_view key) const {
+			return find_slot(key) != nullptr;
+		}
+
+		constexpr std::size_t size() const {
+			return entry_count;
+		}
+
+		constexpr bool empty() const {
+			return entry_count == 0;
+		}
+	};
+}
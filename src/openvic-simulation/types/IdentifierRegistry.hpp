@@ -4,6 +4,7 @@
 
 #include "openvic-simulation/core/memory/SmartPtr.hpp"
 #include "openvic-simulation/dataloader/NodeTools.hpp"
+#include "openvic-simulation/types/FrozenStringMap.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPointMap.hpp"
 #include "openvic-simulation/core/template/Concepts.hpp"
 #include "openvic-simulation/utility/Getters.hpp"
@@ -188,6 +189,16 @@ namespace OpenVic {
 		storage_type PROPERTY_REF(items);
 		bool PROPERTY_CUSTOM_PREFIX(locked, is, false);
 		identifier_index_map_t identifier_index_map;
+		/* Built from identifier_index_map by lock(), and used for all identifier lookups while locked. */
+		FrozenStringMap<internal_storage_index_type, Case> frozen_identifier_index_map;
+
+		constexpr internal_storage_index_type const* find_identifier_index(std::string_view identifier) const {
+			if (locked) {
+				return frozen_identifier_index_map.find(identifier);
+			}
+			const typename identifier_index_map_t::const_iterator it = identifier_index_map.find(identifier);
+			return it != identifier_index_map.end() ? &it->second : nullptr;
+		}
 
 		constexpr void emplace_identifier_index() {
 			const internal_storage_index_type index = StorageInfo::get_back_index(items);
@@ -265,6 +276,7 @@ namespace OpenVic {
 			if (locked) {
 				spdlog::error_s("Failed to lock {} registry - already locked!", name);
 			} else {
+				frozen_identifier_index_map.build(identifier_index_map);
 				locked = true;
 				if (log_lock) {
 					SPDLOG_INFO("Locked {} registry after registering {} items", name, size());
@@ -274,6 +286,7 @@ namespace OpenVic {
 
 		constexpr void reset() {
 			identifier_index_map.clear();
+			frozen_identifier_index_map.clear();
 			items.clear();
 			locked = false;
 		}
@@ -333,10 +346,10 @@ namespace OpenVic {
 		return ValueInfo::get_external_value(ItemInfo::get_value(items.back())); \
 	} \
 	constexpr external_value_type CONST* get_item_by_identifier(std::string_view identifier) CONST { \
-		const typename decltype(identifier_index_map)::const_iterator it = identifier_index_map.find(identifier); \
-		if (it != identifier_index_map.end()) { \
+		internal_storage_index_type const* index = find_identifier_index(identifier); \
+		if (index != nullptr) { \
 			return std::addressof( \
-				ValueInfo::get_external_value(ItemInfo::get_value(StorageInfo::get_item_from_index(items, it->second))) \
+				ValueInfo::get_external_value(ItemInfo::get_value(StorageInfo::get_item_from_index(items, *index))) \
 			); \
 		} \
 		return nullptr; \
@@ -521,7 +534,7 @@ namespace OpenVic {
 #undef GETTERS
 
 		constexpr bool has_identifier(std::string_view identifier) const {
-			return identifier_index_map.contains(identifier);
+			return find_identifier_index(identifier) != nullptr;
 		}
 
 		constexpr bool has_index(std::size_t index) const {
@@ -54,6 +54,7 @@ TYPED_INDEX(graphical_culture_index_t)
 TYPED_INDEX(ideology_index_t)
 TYPED_INDEX(invention_index_t)
 TYPED_INDEX(map_mode_index_t)
+TYPED_INDEX(modifier_effect_index_t)
 TYPED_INDEX(party_policy_index_t)
 TYPED_INDEX(party_policy_group_index_t)
 TYPED_INDEX(pop_type_index_t)
@@ -36,6 +36,7 @@ namespace OpenVic {
 		using base_type::front;
 		using base_type::back;
 		using base_type::push_back;
+		using base_type::clear;
 
 		constexpr ValueHistory() {};
 		explicit ValueHistory(size_type capacity) : base_type(capacity) {}
@@ -1,38 +1,110 @@
 #include "ThreadPool.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <numeric>
 #include <span>
 #include <thread>
 
 #include "openvic-simulation/core/stl/containers/TypedSpan.hpp"
+#include "openvic-simulation/core/thread/ConcurrentTaskLimit.hpp"
 #include "openvic-simulation/country/CountryInstance.hpp"
 #include "openvic-simulation/economy/GoodDefinition.hpp" // IWYU pragma: keep for constructor requirement
 #include "openvic-simulation/economy/GoodInstance.hpp"
 #include "openvic-simulation/economy/trading/GoodMarket.hpp"
 #include "openvic-simulation/map/ProvinceInstance.hpp"
+#include "openvic-simulation/map/State.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
 #include "openvic-simulation/types/TypedIndices.hpp"
 
 using namespace OpenVic;
 
+void ThreadPool::WorkBundleRange::set_home_range(const uint32_t new_home_begin, const uint32_t new_home_end) {
+	home_begin = new_home_begin;
+	home_end = new_home_end;
+	reset_to_home_range();
+}
+
+void ThreadPool::WorkBundleRange::reset_to_home_range() {
+	packed_range.store(pack(home_begin, home_end), std::memory_order_relaxed);
+}
+
+bool ThreadPool::WorkBundleRange::try_claim_front(std::size_t& bundle_index) {
+	uint64_t packed = packed_range.load(std::memory_order_acquire);
+	while (true) {
+		const uint32_t begin = unpack_begin(packed);
+		const uint32_t end = unpack_end(packed);
+		if (begin >= end) {
+			return false;
+		}
+
+		if (packed_range.compare_exchange_weak(
+			packed,
+			pack(begin + 1, end),
+			std::memory_order_acq_rel,
+			std::memory_order_acquire
+		)) {
+			bundle_index = begin;
+			return true;
+		}
+	}
+}
+
+bool ThreadPool::WorkBundleRange::try_steal_back(std::size_t& bundle_index) {
+	uint64_t packed = packed_range.load(std::memory_order_acquire);
+	while (true) {
+		const uint32_t begin = unpack_begin(packed);
+		const uint32_t end = unpack_end(packed);
+		if (begin >= end) {
+			return false;
+		}
+
+		if (packed_range.compare_exchange_weak(
+			packed,
+			pack(begin, end - 1),
+			std::memory_order_acq_rel,
+			std::memory_order_acquire
+		)) {
+			bundle_index = end - 1;
+			return true;
+		}
+	}
+}
+
+template<typename Functor>
+void ThreadPool::for_each_claimed_work_bundle(const std::size_t worker_index, Functor&& process_work_bundle) {
+	std::size_t bundle_index;
+	while (work_bundle_ranges[worker_index].try_claim_front(bundle_index)) {
+		process_work_bundle(all_work_bundles[bundle_index]);
+	}
+
+	//own range is done, help the others
+	//work_per_thread is sized before any thread starts, unlike threads
+	const std::size_t worker_count = work_per_thread.size();
+	for (std::size_t offset = 1; offset < worker_count; ++offset) {
+		WorkBundleRange& victim = work_bundle_ranges[(worker_index + offset) % worker_count];
+		while (victim.try_steal_back(bundle_index)) {
+			process_work_bundle(all_work_bundles[bundle_index]);
+		}
+	}
+}
+
 void ThreadPool::loop_until_cancelled(
 	work_t& work_type,
 	GameRulesManager const& game_rules_manager,
 	GoodInstanceManager const& good_instance_manager,
+	MapInstance const& map_instance,
+	MilitaryDefines const& military_defines,
 	ModifierEffectCache const& modifier_effect_cache,
 	PopsDefines const& pop_defines,
 	ProductionTypeManager const& production_type_manager,
-	forwardable_span<const CountryInstance> country_keys,
 	const good_index_t good_count,
 	const strata_index_t strata_count,
-	forwardable_span<WorkBundle> work_bundles
+	const std::size_t worker_index
 ) {
 	memory::FixedVector<char, good_index_t> reusable_goods_mask { good_count, {} };
 
-	memory::FixedVector<fixed_point_t, country_index_t> reusable_country_map_0 { country_index_t(country_keys.size()), fixed_point_t::_0 };
-	memory::FixedVector<fixed_point_t, country_index_t> reusable_country_map_1 { country_index_t(country_keys.size()), fixed_point_t::_0 };
-
 	static constexpr std::size_t VECTOR_COUNT = std::max(
 		GoodMarket::VECTORS_FOR_EXECUTE_ORDERS,
 		std::max(
@@ -73,60 +145,124 @@ void ThreadPool::loop_until_cancelled(
 		switch (work_type_copy) {
 			case work_t::NONE:
 				break;
-			case work_t::GOOD_EXECUTE_ORDERS:
-				for (WorkBundle& work_bundle : work_bundles) {
-					for (GoodMarket& good : work_bundle.goods_chunk) {
-						good.execute_orders(
-							reusable_country_map_0,
-							reusable_country_map_1,
-							reusable_vectors_span.first<GoodMarket::VECTORS_FOR_EXECUTE_ORDERS>()
-						);
+			case work_t::GOOD_EXECUTE_ORDERS: {
+				std::size_t execution_index;
+				while (
+					(execution_index = next_good_execution_index.fetch_add(1, std::memory_order_relaxed))
+					< good_execution_order.size()
+				) {
+					GoodMarket& good = goods[good_execution_order[execution_index]];
+					//canonical order regardless of which thread processed which bundle
+					for (WorkBundle& order_bundle : all_work_bundles) {
+						good.take_orders_from(order_bundle.market_order_buffer);
+						good.take_orders_from(order_bundle.rgo_market_order_buffer);
+					}
+					good.execute_orders(
+						reusable_vectors_span.first<GoodMarket::VECTORS_FOR_EXECUTE_ORDERS>()
+					);
+				}
+				break;
+			}
+			case work_t::APPLY_MARKET_RESULTS:
+				for_each_claimed_work_bundle(worker_index, [&](WorkBundle& work_bundle) -> void {
+					work_bundle.market_order_buffer.apply_results(
+						[this](const good_index_t good_index) -> GoodMarket const& {
+							return get_good_market(good_index);
+						},
+						work_bundle.country_report_buffer,
+						reusable_vectors[0]
+					);
+				});
+				break;
+			case work_t::FOLD_COUNTRY_REPORTS: {
+				std::size_t country_with_reports_index;
+				while (
+					(country_with_reports_index = next_country_with_reports_index.fetch_add(1, std::memory_order_relaxed))
+					< countries_with_reports.size()
+				) {
+					CountryInstance& country = countries[type_safe::get(countries_with_reports[country_with_reports_index])];
+					//canonical order regardless of which thread processed which bundle
+					for (WorkBundle& report_bundle : all_work_bundles) {
+						country.fold_reports_from(report_bundle.country_report_buffer);
 					}
 				}
 				break;
+			}
 			case work_t::PROVINCE_TICK:
-				for (WorkBundle& work_bundle : work_bundles) {
+				for_each_claimed_work_bundle(worker_index, [&](WorkBundle& work_bundle) -> void {
 					for (ProvinceInstance& province : work_bundle.provinces_chunk) {
 						province.province_tick(
 							current_date,
 							reusable_pop_values,
 							work_bundle.random_number_generator,
+							work_bundle.market_order_buffer,
+							work_bundle.rgo_market_order_buffer,
+							work_bundle.country_report_buffer,
 							reusable_goods_mask,
 							reusable_vectors_span.first<ProvinceInstance::VECTORS_FOR_PROVINCE_TICK>()
 						);
 					}
+				});
+				break;
+			case work_t::PROVINCE_UPDATE_GAMESTATE:
+				for_each_claimed_work_bundle(worker_index, [&](WorkBundle& work_bundle) -> void {
+					for (ProvinceInstance& province : work_bundle.provinces_chunk) {
+						province.update_gamestate(current_date, map_instance, military_defines);
+					}
+				});
+				break;
+			case work_t::PROVINCE_CHECKSUM:
+				for_each_claimed_work_bundle(worker_index, [&](WorkBundle& work_bundle) -> void {
+					for (ProvinceInstance const& province : work_bundle.provinces_chunk) {
+						province_checksums[type_safe::get(province.index)] = (*province_checksum_func)(province);
+					}
+				});
+				break;
+			case work_t::STATE_SET_UPDATE_GAMESTATE: {
+				std::size_t state_set_index;
+				while (
+					(state_set_index = next_state_set_index.fetch_add(1, std::memory_order_relaxed))
+					< state_sets.size()
+				) {
+					state_sets[state_set_index].update_gamestate();
 				}
 				break;
+			}
 			case work_t::PROVINCE_INITIALISE_FOR_NEW_GAME:
-				for (WorkBundle& work_bundle : work_bundles) {
+				for_each_claimed_work_bundle(worker_index, [&](WorkBundle& work_bundle) -> void {
 					for (ProvinceInstance& province : work_bundle.provinces_chunk) {
 						province.initialise_for_new_game(
 							current_date,
 							reusable_pop_values,
 							work_bundle.random_number_generator,
+							work_bundle.market_order_buffer,
+							work_bundle.rgo_market_order_buffer,
+							work_bundle.country_report_buffer,
 							reusable_goods_mask,
 							reusable_vectors_span.first<ProvinceInstance::VECTORS_FOR_PROVINCE_TICK>()
 						);
 					}
-				}
+				});
 				break;
 			case work_t::COUNTRY_TICK_BEFORE_MAP:
-				for (WorkBundle& work_bundle : work_bundles) {
+				for_each_claimed_work_bundle(worker_index, [&](WorkBundle& work_bundle) -> void {
 					for (CountryInstance& country : work_bundle.countries_chunk) {
 						country.country_tick_before_map(
+							work_bundle.market_order_buffer,
+							work_bundle.country_report_buffer,
 							reusable_goods_mask,
 							reusable_vectors_span.first<CountryInstance::VECTORS_FOR_COUNTRY_TICK>(),
 							reusable_good_index_vector
 						);
 					}
-				}
+				});
 				break;
 			case work_t::COUNTRY_TICK_AFTER_MAP:
-				for (WorkBundle& work_bundle : work_bundles) {
+				for_each_claimed_work_bundle(worker_index, [&](WorkBundle& work_bundle) -> void {
 					for (CountryInstance& country : work_bundle.countries_chunk) {
 						country.country_tick_after_map(current_date);
 					}
-				}
+				});
 				break;
 		}
 
@@ -151,6 +287,10 @@ void ThreadPool::process_work(const work_t work_type) {
 			active_work_count = threads.size();
 		}
 
+		for (std::size_t i = 0; i < threads.size(); ++i) {
+			work_bundle_ranges[i].reset_to_home_range();
+		}
+
 		for (work_t& work_for_thread : work_per_thread) {
 			work_for_thread = work_type;
 		}
@@ -186,12 +326,15 @@ ThreadPool::~ThreadPool() {
 void ThreadPool::initialise_threadpool(
 	GameRulesManager const& game_rules_manager,
 	GoodInstanceManager const& good_instance_manager,
+	MapInstance const& map_instance,
+	MilitaryDefines const& military_defines,
 	ModifierEffectCache const& modifier_effect_cache,
 	PopsDefines const& pop_defines,
 	ProductionTypeManager const& production_type_manager,
 	const strata_index_t strata_count,
-	forwardable_span<GoodInstance> goods,
-	forwardable_span<CountryInstance> countries,
+	const pop_type_index_t pop_type_count,
+	forwardable_span<GoodInstance> new_goods,
+	forwardable_span<CountryInstance> new_countries,
 	forwardable_span<ProvinceInstance> provinces
 ) {
 	if (threads.size() > 0) {
@@ -201,18 +344,16 @@ void ThreadPool::initialise_threadpool(
 
 	RandomU32 master_rng { }; //TODO seed?
 
+	goods = new_goods;
+	good_execution_order.resize(goods.size());
+	countries = new_countries;
 
-	const auto [goods_quotient, goods_remainder] = std::ldiv(goods.size(), WORK_BUNDLE_COUNT);
 	const auto [countries_quotient, countries_remainder] = std::ldiv(countries.size(),WORK_BUNDLE_COUNT);
 	const auto [provinces_quotient, provinces_remainder] = std::ldiv(provinces.size(),WORK_BUNDLE_COUNT);
-	auto goods_begin = goods.begin();
 	auto countries_begin = countries.begin();
 	auto provinces_begin = provinces.begin();
 
 	for (std::size_t i = 0; i < WORK_BUNDLE_COUNT; i++) {
-		const std::size_t goods_chunk_size = i < goods_remainder
-			? goods_quotient + 1
-			: goods_quotient;
 		const std::size_t countries_chunk_size = i < countries_remainder
 			? countries_quotient + 1
 			: countries_quotient;
@@ -220,93 +361,195 @@ void ThreadPool::initialise_threadpool(
 			? provinces_quotient + 1
 			: provinces_quotient;
 
-		auto goods_end = goods_begin + goods_chunk_size;
 		auto countries_end = countries_begin + countries_chunk_size;
 		auto provinces_end = provinces_begin + provinces_chunk_size;
 
 		all_work_bundles[i] = WorkBundle {
 			master_rng.generator().serialize(),
 			std::span<CountryInstance>{ countries_begin, countries_end },
-			std::span<GoodInstance>{ goods_begin, goods_end },
 			std::span<ProvinceInstance>{ provinces_begin, provinces_end }
 		};
+		all_work_bundles[i].market_order_buffer.set_good_count(good_index_t(goods.size()));
+		all_work_bundles[i].rgo_market_order_buffer.set_good_count(good_index_t(goods.size()));
+		all_work_bundles[i].country_report_buffer.set_sizes(
+			country_index_t(countries.size()),
+			good_index_t(goods.size()),
+			pop_type_count
+		);
 
 		//ensure different state for next WorkBundle
 		master_rng.generator().jump();
 
-		goods_begin = goods_end;
 		countries_begin = countries_end;
 		provinces_begin = provinces_end;
 	}
 
-	const std::size_t max_worker_threads = std::min(
-		std::max<std::size_t>(std::thread::hardware_concurrency(), 1),
-		WORK_BUNDLE_COUNT
-	);
+	const std::size_t max_worker_threads = std::min(get_concurrent_task_limit(), WORK_BUNDLE_COUNT);
 	threads.reserve(max_worker_threads);
 	work_per_thread.resize(max_worker_threads, work_t::NONE);
 
 	
 	const auto [work_bundles_quotient, work_bundles_remainder] = std::ldiv(WORK_BUNDLE_COUNT, max_worker_threads);
-	auto work_bundles_begin = all_work_bundles.begin();
+	std::size_t work_bundles_begin = 0;
 
 	for (std::size_t i = 0; i < max_worker_threads; ++i) {
 		const std::size_t work_bundles_chunk_size = i < work_bundles_remainder
 			? work_bundles_quotient + 1
 			: work_bundles_quotient;
 
-		auto work_bundles_end = work_bundles_begin + work_bundles_chunk_size;
+		const std::size_t work_bundles_end = work_bundles_begin + work_bundles_chunk_size;
+		work_bundle_ranges[i].set_home_range(
+			static_cast<uint32_t>(work_bundles_begin),
+			static_cast<uint32_t>(work_bundles_end)
+		);
+		work_bundles_begin = work_bundles_end;
+	}
 
+	for (std::size_t i = 0; i < max_worker_threads; ++i) {
 		threads.emplace_back(
 			[
 				this,
 				&work_for_thread = work_per_thread[i],
 				&game_rules_manager,
 				&good_instance_manager,
+				&map_instance,
+				&military_defines,
 				&modifier_effect_cache,
 				&pop_defines,
 				&production_type_manager,
-				countries,
 				good_count = good_index_t(goods.size()),
 				strata_count,
-				work_bundles_begin,
-				work_bundles_end
+				worker_index = i
 			]() -> void {
 				loop_until_cancelled(
 					work_for_thread,
 					game_rules_manager,
 					good_instance_manager,
+					map_instance,
+					military_defines,
 					modifier_effect_cache,
 					pop_defines,
 					production_type_manager,
-					countries,
 					good_count,
 					strata_count,
-					std::span<WorkBundle>{ work_bundles_begin, work_bundles_end }
+					worker_index
 				);
 			}
 		);
+	}
+}
 
-		work_bundles_begin = work_bundles_end;
+void ThreadPool::sort_goods_by_descending_order_count() {
+	memory::vector<std::size_t> order_count_per_good(goods.size(), 0);
+	for (WorkBundle& work_bundle : all_work_bundles) {
+		for (std::size_t i = 0; i < goods.size(); ++i) {
+			const good_index_t good_index(i);
+			order_count_per_good[i] += work_bundle.market_order_buffer.get_buy_up_to_orders(good_index).size()
+				+ work_bundle.market_order_buffer.get_market_sell_orders(good_index).size()
+				+ work_bundle.rgo_market_order_buffer.get_market_sell_orders(good_index).size();
+		}
+	}
+
+	std::iota(good_execution_order.begin(), good_execution_order.end(), 0);
+	std::stable_sort(
+		good_execution_order.begin(),
+		good_execution_order.end(),
+		[&order_count_per_good](const std::size_t lhs, const std::size_t rhs) -> bool {
+			return order_count_per_good[lhs] > order_count_per_good[rhs];
+		}
+	);
+}
+
+GoodMarket const& ThreadPool::get_good_market(const good_index_t good_index) const {
+	return goods[type_safe::get(good_index)];
+}
+
+void ThreadPool::apply_rgo_market_results() {
+	for (WorkBundle& work_bundle : all_work_bundles) {
+		work_bundle.rgo_market_order_buffer.apply_results(
+			[this](const good_index_t good_index) -> GoodMarket const& {
+				return get_good_market(good_index);
+			},
+			work_bundle.country_report_buffer,
+			reusable_vector_for_serial_work
+		);
+	}
+}
+
+void ThreadPool::fold_country_reports() {
+	countries_with_reports.clear();
+	for (WorkBundle const& work_bundle : all_work_bundles) {
+		const std::span<const country_index_t> bundle_countries_with_reports
+			= work_bundle.country_report_buffer.get_countries_with_reports();
+		countries_with_reports.insert(
+			countries_with_reports.end(),
+			bundle_countries_with_reports.begin(),
+			bundle_countries_with_reports.end()
+		);
+	}
+	if (countries_with_reports.empty()) {
+		return;
+	}
+
+	std::sort(countries_with_reports.begin(), countries_with_reports.end());
+	countries_with_reports.erase(
+		std::unique(countries_with_reports.begin(), countries_with_reports.end()),
+		countries_with_reports.end()
+	);
+	next_country_with_reports_index.store(0, std::memory_order_relaxed);
+	process_work(work_t::FOLD_COUNTRY_REPORTS);
+	for (WorkBundle& work_bundle : all_work_bundles) {
+		work_bundle.country_report_buffer.reset();
 	}
 }
 
 void ThreadPool::process_good_execute_orders() {
+	sort_goods_by_descending_order_count();
+	next_good_execution_index.store(0, std::memory_order_relaxed);
 	process_work(work_t::GOOD_EXECUTE_ORDERS);
+	//every actor in a bundle is only written by the thread applying that bundle
+	process_work(work_t::APPLY_MARKET_RESULTS);
+	apply_rgo_market_results();
+	fold_country_reports();
 }
 
 void ThreadPool::process_province_ticks() {
 	process_work(work_t::PROVINCE_TICK);
+	fold_country_reports();
+}
+
+void ThreadPool::process_province_update_gamestate() {
+	process_work(work_t::PROVINCE_UPDATE_GAMESTATE);
+	fold_country_reports();
+}
+
+void ThreadPool::process_state_set_update_gamestate(forwardable_span<StateSet> new_state_sets) {
+	state_sets = new_state_sets;
+	next_state_set_index.store(0, std::memory_order_relaxed);
+	process_work(work_t::STATE_SET_UPDATE_GAMESTATE);
 }
 
 void ThreadPool::process_province_initialise_for_new_game() {
 	process_work(work_t::PROVINCE_INITIALISE_FOR_NEW_GAME);
+	fold_country_reports();
 }
 
 void ThreadPool::process_country_ticks_before_map() {
 	process_work(work_t::COUNTRY_TICK_BEFORE_MAP);
+	fold_country_reports();
 }
 
 void ThreadPool::process_country_ticks_after_map(){
 	process_work(work_t::COUNTRY_TICK_AFTER_MAP);
-}
\ No newline at end of file
+	fold_country_reports();
+}
+
+void ThreadPool::process_province_checksums(
+	province_checksum_func_t const& new_province_checksum_func,
+	forwardable_span<uint64_t> new_province_checksums
+) {
+	province_checksum_func = &new_province_checksum_func;
+	province_checksums = new_province_checksums;
+	process_work(work_t::PROVINCE_CHECKSUM);
+	province_checksum_func = nullptr;
+}
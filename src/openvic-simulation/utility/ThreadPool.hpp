@@ -1,17 +1,22 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <thread>
 
-#include "openvic-simulation/population/PopValuesFromProvince.hpp"
+#include <function2/function2.hpp>
+
 #include "openvic-simulation/core/memory/Vector.hpp"
 #include "openvic-simulation/core/portable/ForwardableSpan.hpp"
 #include "openvic-simulation/core/random/RandomGenerator.hpp"
+#include "openvic-simulation/country/CountryReportBuffer.hpp"
+#include "openvic-simulation/economy/trading/MarketOrderBuffer.hpp"
 #include "openvic-simulation/population/PopValuesFromProvince.hpp"
+#include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
 #include "openvic-simulation/types/Date.hpp"
 #include "openvic-simulation/types/TypedIndices.hpp"
 
@@ -21,9 +26,12 @@ namespace OpenVic {
 	struct GoodInstanceManager;
 	struct CountryInstance;
 	struct GoodInstance;
+	struct MapInstance;
+	struct MilitaryDefines;
 	struct ModifierEffectCache;
 	struct PopsDefines;
 	struct ProductionTypeManager;
+	struct StateSet;
 	struct Strata;
 	
 	//bundle work so they always have the same rng regardless of hardware concurrency
@@ -31,36 +39,94 @@ namespace OpenVic {
 	public:
 		RandomU32 random_number_generator;
 		forwardable_span<CountryInstance> countries_chunk;
-		forwardable_span<GoodInstance> goods_chunk;
 		forwardable_span<ProvinceInstance> provinces_chunk;
+		//orders placed while processing this bundle, merged into GoodMarket in bundle order
+		MarketOrderBuffer market_order_buffer;
+		//RGOs pay owner pops anywhere in the state, which may belong to other bundles.
+		//Their results are therefore applied serially instead of by the thread that owns the bundle.
+		MarketOrderBuffer rgo_market_order_buffer;
+		//economy reports made while processing this bundle, folded into the countries at the end of each phase
+		CountryReportBuffer country_report_buffer;
 
-		constexpr WorkBundle() {}
+		WorkBundle() {}
 
 		WorkBundle(
 			RandomU32::state_type rng_state,
 			forwardable_span<CountryInstance> new_countries_chunk,
-			forwardable_span<GoodInstance> new_goods_chunk,
 			forwardable_span<ProvinceInstance> new_provinces_chunk
 		) : random_number_generator { rng_state },
 			countries_chunk { new_countries_chunk },
-			goods_chunk { new_goods_chunk },
 			provinces_chunk { new_provinces_chunk }
 			{}
 	};
 
 	struct ThreadPool {
 	private:
+		//Each worker starts every batch of work with a contiguous range of WorkBundle indices.
+		//The owner claims bundles from the front and, once its own range is empty, steals from the back of other ranges.
+		//Both ends are packed into a single atomic so one compare-exchange arbitrates every claim.
+		//Bundles stay the unit of work, so each bundle's RandomU32 is only ever advanced by one thread at a time.
+		struct alignas(64) WorkBundleRange {
+		private:
+			std::atomic<uint64_t> packed_range = 0;
+			uint32_t home_begin = 0;
+			uint32_t home_end = 0;
+
+			static constexpr uint64_t pack(const uint32_t begin, const uint32_t end) {
+				return (static_cast<uint64_t>(begin) << 32) | end;
+			}
+			static constexpr uint32_t unpack_begin(const uint64_t packed) {
+				return static_cast<uint32_t>(packed >> 32);
+			}
+			static constexpr uint32_t unpack_end(const uint64_t packed) {
+				return static_cast<uint32_t>(packed);
+			}
+
+		public:
+			void set_home_range(const uint32_t new_home_begin, const uint32_t new_home_end);
+			//not thread safe, call before handing out work
+			void reset_to_home_range();
+			bool try_claim_front(std::size_t& bundle_index);
+			bool try_steal_back(std::size_t& bundle_index);
+		};
+
 		enum struct work_t : uint8_t {
 			NONE,
 			GOOD_EXECUTE_ORDERS,
+			APPLY_MARKET_RESULTS,
+			FOLD_COUNTRY_REPORTS,
 			PROVINCE_INITIALISE_FOR_NEW_GAME,
 			PROVINCE_TICK,
+			PROVINCE_UPDATE_GAMESTATE,
+			STATE_SET_UPDATE_GAMESTATE,
 			COUNTRY_TICK_BEFORE_MAP,
-			COUNTRY_TICK_AFTER_MAP
+			COUNTRY_TICK_AFTER_MAP,
+			PROVINCE_CHECKSUM
 		};
 
 		constexpr static std::size_t WORK_BUNDLE_COUNT = 32;
 		std::array<WorkBundle, WORK_BUNDLE_COUNT> all_work_bundles;
+		//max_worker_threads <= WORK_BUNDLE_COUNT, so there is at most one range per bundle
+		std::array<WorkBundleRange, WORK_BUNDLE_COUNT> work_bundle_ranges;
+		//Goods don't use a WorkBundle's RandomU32, so each good is its own unit of work.
+		//They are claimed one at a time, largest order book first, so a heavy good doesn't hold up a whole bundle of goods.
+		forwardable_span<GoodInstance> goods;
+		memory::vector<std::size_t> good_execution_order;
+		std::atomic<std::size_t> next_good_execution_index = 0;
+		//State sets don't belong to a WorkBundle, so each one is claimed individually like goods.
+		forwardable_span<StateSet> state_sets;
+		std::atomic<std::size_t> next_state_set_index = 0;
+		//Only countries which were reported to are folded, so they are claimed individually as well.
+		forwardable_span<CountryInstance> countries;
+		memory::vector<country_index_t> countries_with_reports;
+		std::atomic<std::size_t> next_country_with_reports_index = 0;
+	public:
+		using province_checksum_func_t = fu2::function_view<uint64_t(ProvinceInstance const&) const>;
+	private:
+		//only set while processing PROVINCE_CHECKSUM, each province's result is written to its own index
+		province_checksum_func_t const* province_checksum_func = nullptr;
+		forwardable_span<uint64_t> province_checksums;
+		memory::vector<fixed_point_t> reusable_vector_for_serial_work;
 		memory::vector<std::thread> threads;
 		memory::vector<work_t> work_per_thread;
 		std::mutex thread_mutex, completed_mutex;
@@ -73,14 +139,22 @@ namespace OpenVic {
 			work_t& work_type,
 			GameRulesManager const& game_rules_manager,
 			GoodInstanceManager const& good_instance_manager,
+			MapInstance const& map_instance,
+			MilitaryDefines const& military_defines,
 			ModifierEffectCache const& modifier_effect_cache,
 			PopsDefines const& pop_defines,
 			ProductionTypeManager const& production_type_manager,
-			forwardable_span<const CountryInstance> country_keys,
 			const good_index_t good_count,
 			const strata_index_t strata_count,
-			forwardable_span<WorkBundle> work_bundles
+			const std::size_t worker_index
 		);
+		template<typename Functor>
+		void for_each_claimed_work_bundle(const std::size_t worker_index, Functor&& process_work_bundle);
+		void sort_goods_by_descending_order_count();
+		GoodMarket const& get_good_market(const good_index_t good_index) const;
+		void apply_rgo_market_results();
+		//call at the end of every phase which hands out CountryReportBuffers
+		void fold_country_reports();
 		void await_completion();
 		void process_work(const work_t work_type);
 
@@ -91,19 +165,29 @@ namespace OpenVic {
 		void initialise_threadpool(
 			GameRulesManager const& game_rules_manager,
 			GoodInstanceManager const& good_instance_manager,
+			MapInstance const& map_instance,
+			MilitaryDefines const& military_defines,
 			ModifierEffectCache const& modifier_effect_cache,
 			PopsDefines const& pop_defines,
 			ProductionTypeManager const& production_type_manager,
 			const strata_index_t strata_count,
-			forwardable_span<GoodInstance> goods,
-			forwardable_span<CountryInstance> countries,
+			const pop_type_index_t pop_type_count,
+			forwardable_span<GoodInstance> new_goods,
+			forwardable_span<CountryInstance> new_countries,
 			forwardable_span<ProvinceInstance> provinces
 		);
 
 		void process_good_execute_orders();
 		void process_province_ticks();
+		void process_province_update_gamestate();
+		void process_state_set_update_gamestate(forwardable_span<StateSet> new_state_sets);
 		void process_province_initialise_for_new_game();
 		void process_country_ticks_before_map();
 		void process_country_ticks_after_map();
+		//new_province_checksums must have one element per province, indexed by province index
+		void process_province_checksums(
+			province_checksum_func_t const& new_province_checksum_func,
+			forwardable_span<uint64_t> new_province_checksums
+		);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,887 @@
+#include "SyntheticGameTree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "openvic-simulation/core/io/BinaryStream.hpp"
+#include "openvic-simulation/GameManager.hpp"
+#include "openvic-simulation/modifier/StaticModifierCache.hpp"
+#include "openvic-simulation/utility/Logger.hpp"
+
+using namespace OpenVic;
+
+namespace {
+	/* Land provinces are numbered row by row from 1, followed by any unused cells in the last row and then the sea column. */
+	struct map_layout_t {
+		size_t land_province_count;
+		size_t columns;
+		size_t rows;
+		int32_t province_size_px;
+
+		size_t get_province_count() const {
+			return (columns + 1) * rows;
+		}
+		size_t get_first_sea_column_province() const {
+			return columns * rows + 1;
+		}
+		int32_t get_width() const {
+			return static_cast<int32_t>(columns + 1) * province_size_px;
+		}
+		int32_t get_height() const {
+			return static_cast<int32_t>(rows) * province_size_px;
+		}
+		size_t get_province_at(int32_t x, int32_t y) const {
+			const size_t column = x / province_size_px;
+			const size_t row = y / province_size_px;
+			return column < columns ? row * columns + column + 1 : get_first_sea_column_province() + row;
+		}
+		bool is_land(size_t province) const {
+			return province <= land_province_count;
+		}
+	};
+
+	struct colour_bytes_t {
+		uint8_t red, green, blue;
+	};
+
+	colour_bytes_t get_province_colour(size_t province) {
+		return {
+			static_cast<uint8_t>(province & 0xFF), static_cast<uint8_t>((province >> 8) & 0xFF),
+			static_cast<uint8_t>((province >> 16) & 0xFF)
+		};
+	}
+
+	/* Cycled through by the land provinces. */
+	constexpr std::array<std::string_view, 3> rgo_goods { "grain", "iron", "cotton" };
+	constexpr std::array<std::string_view, 4> culture_names {
+		"northern_synthetic", "southern_synthetic", "eastern_synthetic", "western_synthetic"
+	};
+
+	struct pop_type_t {
+		std::string_view name;
+		std::string_view strata;
+		std::string_view extra_keys;
+		/* How many of the pop type each land province starts with, 0 for none. */
+		uint32_t starting_size;
+	};
+	constexpr std::array<pop_type_t, 9> pop_types {{
+		{ "aristocrats", "rich", "", 400 },
+		{ "artisans", "middle", "is_artisan = yes", 2000 },
+		{ "bureaucrats", "middle", "administrative_efficiency = yes", 300 },
+		{ "capitalists", "rich", "can_build = yes", 100 },
+		{ "craftsmen", "poor", "can_work_factory = yes\n\tfactory = yes", 3000 },
+		{ "farmers", "poor", "", 12000 },
+		{ "labourers", "poor", "", 8000 },
+		{ "slaves", "poor", "is_slave = yes", 0 },
+		{ "soldiers", "poor", "can_be_recruited = yes", 1500 }
+	}};
+
+	struct factory_t {
+		std::string_view name;
+		std::string_view input_good;
+		std::string_view output_good;
+	};
+	constexpr std::array<factory_t, 5> factories {{
+		{ "textile_mill", "cotton", "fabric" },
+		{ "clothes_factory", "fabric", "clothes" },
+		{ "liquor_distillery", "grain", "liquor" },
+		{ "cement_factory", "iron", "cement" },
+		{ "small_arms_factory", "iron", "small_arms" }
+	}};
+
+	/* Every define is required, so each group's keys are listed here and given the value 0 unless overridden below. */
+	constexpr std::array<std::pair<std::string_view, std::string_view>, 7> define_groups {{
+		{
+			"ai",
+			"COLONY_WEIGHT ADMINISTRATOR_WEIGHT INDUSTRYWORKER_WEIGHT EDUCATOR_WEIGHT SOLDIER_WEIGHT SOLDIER_FRACTION "
+			"CAPITALIST_FRACTION PRODUCTION_WEIGHT SPAM_PENALTY ONE_SIDE_MAX_WARSCORE "
+			"POP_PROJECT_INVESTMENT_MAX_BUDGET_FACTOR RELATION_LIMIT_NO_ALLIANCE_OFFER NAVAL_SUPPLY_PENALTY_LIMIT "
+			"CHANCE_BUILD_RAILROAD CHANCE_BUILD_NAVAL_BASE CHANCE_BUILD_FORT CHANCE_INVEST_POP_PROJ "
+			"CHANCE_FOREIGN_INVEST TWS_AWARENESS_SCORE_LOW_CAP TWS_AWARENESS_SCORE_ASPECT PEACE_BASE_RELUCTANCE "
+			"PEACE_TIME_MONTHS PEACE_TIME_FACTOR PEACE_TIME_FACTOR_NO_GOALS PEACE_WAR_EXHAUSTION_FACTOR "
+			"PEACE_WAR_DIRECTION_FACTOR PEACE_WAR_DIRECTION_WINNING_MULT PEACE_FORCE_BALANCE_FACTOR "
+			"PEACE_ALLY_BASE_RELUCTANCE_MULT PEACE_ALLY_TIME_MULT PEACE_ALLY_WAR_EXHAUSTION_MULT "
+			"PEACE_ALLY_WAR_DIRECTION_MULT PEACE_ALLY_FORCE_BALANCE_MULT AGGRESSION_BASE AGGRESSION_UNCIV_BONUS "
+			"FLEET_SIZE MIN_FLEETS MAX_FLEETS MONTHS_BEFORE_DISBAND"
+		},
+		{
+			"country",
+			"YEARS_OF_NATIONALISM REBEL_ACCEPTANCE_MONTHS BASE_COUNTRY_TAX_EFFICIENCY BASE_COUNTRY_ADMIN_EFFICIENCY "
+			"GOLD_TO_CASH_RATE GOLD_TO_WORKER_PAY_RATE GREAT_NATIONS_COUNT GREATNESS_DAYS BADBOY_LIMIT "
+			"MAX_BUREAUCRACY_PERCENTAGE BUREAUCRACY_PERCENTAGE_INCREMENT MIN_CRIMEFIGHT_PERCENT MAX_CRIMEFIGHT_PERCENT "
+			"ADMIN_EFFICIENCY_CRIMEFIGHT_PERCENT CONSERVATIVE_INCREASE_AFTER_REFORM CAMPAIGN_EVENT_BASE_TIME "
+			"CAMPAIGN_DURATION COLONIAL_RANK COLONY_TO_STATE_PRESTIGE_GAIN COLONIAL_LIFERATING "
+			"BASE_GREATPOWER_DAILY_INFLUENCE AI_SUPPORT_REFORM BASE_MONTHLY_DIPLOPOINTS DIPLOMAT_TRAVEL_TIME "
+			"PROVINCE_OVERSEAS_PENALTY NONCORE_TAX_PENALTY BASE_TARIFF_EFFICIENCY COLONY_FORMED_PRESTIGE "
+			"CREATED_CB_VALID_TIME LOYALTY_BOOST_ON_PARTY_WIN MOVEMENT_RADICALISM_BASE "
+			"MOVEMENT_RADICALISM_PASSED_REFORM_EFFECT MOVEMENT_RADICALISM_NATIONALISM_FACTOR "
+			"SUPPRESSION_POINTS_GAIN_BASE SUPPRESS_BUREAUCRAT_FACTOR WRONG_REFORM_MILITANCY_IMPACT "
+			"SUPPRESSION_RADICALISATION_HIT INVESTMENT_SCORE_FACTOR UNCIV_TECH_SPREAD_MAX UNCIV_TECH_SPREAD_MIN "
+			"MIN_DELAY_BETWEEN_REFORMS ECONOMIC_REFORM_UH_FACTOR MILITARY_REFORM_UH_FACTOR WRONG_REFORM_RADICAL_IMPACT "
+			"TECH_YEAR_SPAN TECH_FACTOR_VASSAL MAX_SUPPRESSION PRESTIGE_HIT_ON_BREAK_COUNTRY MIN_MOBILIZE_LIMIT "
+			"POP_GROWTH_COUNTRY_CACHE_DAYS NEWSPAPER_PRINTING_FREQUENCY NEWSPAPER_TIMEOUT_PERIOD NEWSPAPER_MAX_TENSION "
+			"NAVAL_BASE_SUPPLY_SCORE_BASE NAVAL_BASE_SUPPLY_SCORE_EMPTY NAVAL_BASE_NON_CORE_SUPPLY_SCORE "
+			"COLONIAL_POINTS_FROM_SUPPLY_FACTOR COLONIAL_POINTS_FOR_NON_CORE_BASE MOBILIZATION_SPEED_BASE "
+			"MOBILIZATION_SPEED_RAILS_MULT COLONIZATION_INTEREST_LEAD COLONIZATION_INFLUENCE_LEAD "
+			"COLONIZATION_MONTHS_TO_COLONIZE COLONIZATION_DAYS_BETWEEN_INVESTMENT "
+			"COLONIZATION_DAYS_FOR_INITIAL_INVESTMENT COLONIZATION_PROTECTORATE_PROVINCE_MAINTAINANCE "
+			"COLONIZATION_COLONY_PROVINCE_MAINTAINANCE COLONIZATION_COLONY_INDUSTRY_MAINTAINANCE "
+			"COLONIZATION_COLONY_RAILWAY_MAINTAINANCE COLONIZATION_INTEREST_COST_INITIAL "
+			"COLONIZATION_INTEREST_COST_NEIGHBOR_MODIFIER COLONIZATION_INTEREST_COST COLONIZATION_INFLUENCE_COST "
+			"COLONIZATION_EXTRA_GUARD_COST COLONIZATION_RELEASE_DOMINION_COST COLONIZATION_CREATE_STATE_COST "
+			"COLONIZATION_CREATE_PROTECTORATE_COST COLONIZATION_CREATE_COLONY_COST COLONIZATION_COLONY_STATE_DISTANCE "
+			"COLONIZATION_INFLUENCE_TEMPERATURE_PER_DAY COLONIZATION_INFLUENCE_TEMPERATURE_PER_LEVEL "
+			"PARTY_LOYALTY_HIT_ON_WAR_LOSS RESEARCH_POINTS_ON_CONQUER_MULT MAX_RESEARCH_POINTS"
+		},
+		{
+			"diplomacy",
+			"PEACE_COST_ADD_TO_SPHERE PEACE_COST_RELEASE_PUPPET PEACE_COST_MAKE_PUPPET PEACE_COST_DISARMAMENT "
+			"PEACE_COST_DESTROY_FORTS PEACE_COST_DESTROY_NAVAL_BASES PEACE_COST_REPARATIONS "
+			"PEACE_COST_TRANSFER_PROVINCES PEACE_COST_REMOVE_CORES PEACE_COST_PRESTIGE PEACE_COST_CONCEDE "
+			"PEACE_COST_STATUS_QUO PEACE_COST_ANNEX PEACE_COST_DEMAND_STATE PEACE_COST_INSTALL_COMMUNIST_GOV_TYPE "
+			"PEACE_COST_UNINSTALL_COMMUNIST_GOV_TYPE PEACE_COST_COLONY INFAMY_ADD_TO_SPHERE INFAMY_RELEASE_PUPPET "
+			"INFAMY_MAKE_PUPPET INFAMY_DISARMAMENT INFAMY_DESTROY_FORTS INFAMY_DESTROY_NAVAL_BASES INFAMY_REPARATIONS "
+			"INFAMY_TRANSFER_PROVINCES INFAMY_REMOVE_CORES INFAMY_PRESTIGE INFAMY_CONCEDE INFAMY_STATUS_QUO "
+			"INFAMY_ANNEX INFAMY_DEMAND_STATE INFAMY_INSTALL_COMMUNIST_GOV_TYPE INFAMY_UNINSTALL_COMMUNIST_GOV_TYPE "
+			"INFAMY_COLONY PRESTIGE_ADD_TO_SPHERE_BASE PRESTIGE_RELEASE_PUPPET_BASE PRESTIGE_MAKE_PUPPET_BASE "
+			"PRESTIGE_DISARMAMENT_BASE PRESTIGE_DESTROY_FORTS_BASE PRESTIGE_DESTROY_NAVAL_BASES_BASE "
+			"PRESTIGE_REPARATIONS_BASE PRESTIGE_TRANSFER_PROVINCES_BASE PRESTIGE_REMOVE_CORES_BASE "
+			"PRESTIGE_PRESTIGE_BASE PRESTIGE_CONCEDE_BASE PRESTIGE_STATUS_QUO_BASE PRESTIGE_ANNEX_BASE "
+			"PRESTIGE_DEMAND_STATE_BASE PRESTIGE_CLEAR_UNION_SPHERE_BASE PRESTIGE_GUNBOAT_BASE "
+			"PRESTIGE_INSTALL_COMMUNIST_GOV_TYPE_BASE PRESTIGE_UNINSTALL_COMMUNIST_GOV_TYPE_BASE PRESTIGE_COLONY_BASE "
+			"PRESTIGE_ADD_TO_SPHERE PRESTIGE_RELEASE_PUPPET PRESTIGE_MAKE_PUPPET PRESTIGE_DISARMAMENT "
+			"PRESTIGE_DESTROY_FORTS PRESTIGE_DESTROY_NAVAL_BASES PRESTIGE_REPARATIONS PRESTIGE_TRANSFER_PROVINCES "
+			"PRESTIGE_REMOVE_CORES PRESTIGE_PRESTIGE PRESTIGE_CONCEDE PRESTIGE_STATUS_QUO PRESTIGE_ANNEX "
+			"PRESTIGE_DEMAND_STATE PRESTIGE_CLEAR_UNION_SPHERE PRESTIGE_GUNBOAT PRESTIGE_INSTALL_COMMUNIST_GOV_TYPE "
+			"PRESTIGE_UNINSTALL_COMMUNIST_GOV_TYPE PRESTIGE_COLONY BREAKTRUCE_INFAMY_ADD_TO_SPHERE "
+			"BREAKTRUCE_INFAMY_RELEASE_PUPPET BREAKTRUCE_INFAMY_MAKE_PUPPET BREAKTRUCE_INFAMY_DISARMAMENT "
+			"BREAKTRUCE_INFAMY_DESTROY_FORTS BREAKTRUCE_INFAMY_DESTROY_NAVAL_BASES BREAKTRUCE_INFAMY_REPARATIONS "
+			"BREAKTRUCE_INFAMY_TRANSFER_PROVINCES BREAKTRUCE_INFAMY_REMOVE_CORES BREAKTRUCE_INFAMY_PRESTIGE "
+			"BREAKTRUCE_INFAMY_CONCEDE BREAKTRUCE_INFAMY_STATUS_QUO BREAKTRUCE_INFAMY_ANNEX "
+			"BREAKTRUCE_INFAMY_DEMAND_STATE BREAKTRUCE_INFAMY_INSTALL_COMMUNIST_GOV_TYPE "
+			"BREAKTRUCE_INFAMY_UNINSTALL_COMMUNIST_GOV_TYPE BREAKTRUCE_INFAMY_COLONY BREAKTRUCE_PRESTIGE_ADD_TO_SPHERE "
+			"BREAKTRUCE_PRESTIGE_RELEASE_PUPPET BREAKTRUCE_PRESTIGE_MAKE_PUPPET BREAKTRUCE_PRESTIGE_DISARMAMENT "
+			"BREAKTRUCE_PRESTIGE_DESTROY_FORTS BREAKTRUCE_PRESTIGE_DESTROY_NAVAL_BASES BREAKTRUCE_PRESTIGE_REPARATIONS "
+			"BREAKTRUCE_PRESTIGE_TRANSFER_PROVINCES BREAKTRUCE_PRESTIGE_REMOVE_CORES BREAKTRUCE_PRESTIGE_PRESTIGE "
+			"BREAKTRUCE_PRESTIGE_CONCEDE BREAKTRUCE_PRESTIGE_STATUS_QUO BREAKTRUCE_PRESTIGE_ANNEX "
+			"BREAKTRUCE_PRESTIGE_DEMAND_STATE BREAKTRUCE_PRESTIGE_INSTALL_COMMUNIST_GOV_TYPE "
+			"BREAKTRUCE_PRESTIGE_UNINSTALL_COMMUNIST_GOV_TYPE BREAKTRUCE_PRESTIGE_COLONY "
+			"BREAKTRUCE_MILITANCY_ADD_TO_SPHERE BREAKTRUCE_MILITANCY_RELEASE_PUPPET BREAKTRUCE_MILITANCY_MAKE_PUPPET "
+			"BREAKTRUCE_MILITANCY_DISARMAMENT BREAKTRUCE_MILITANCY_DESTROY_FORTS "
+			"BREAKTRUCE_MILITANCY_DESTROY_NAVAL_BASES BREAKTRUCE_MILITANCY_REPARATIONS "
+			"BREAKTRUCE_MILITANCY_TRANSFER_PROVINCES BREAKTRUCE_MILITANCY_REMOVE_CORES BREAKTRUCE_MILITANCY_PRESTIGE "
+			"BREAKTRUCE_MILITANCY_CONCEDE BREAKTRUCE_MILITANCY_STATUS_QUO BREAKTRUCE_MILITANCY_ANNEX "
+			"BREAKTRUCE_MILITANCY_DEMAND_STATE BREAKTRUCE_MILITANCY_INSTALL_COMMUNIST_GOV_TYPE "
+			"BREAKTRUCE_MILITANCY_UNINSTALL_COMMUNIST_GOV_TYPE BREAKTRUCE_MILITANCY_COLONY "
+			"GOODRELATION_INFAMY_ADD_TO_SPHERE GOODRELATION_INFAMY_RELEASE_PUPPET GOODRELATION_INFAMY_MAKE_PUPPET "
+			"GOODRELATION_INFAMY_DISARMAMENT GOODRELATION_INFAMY_DESTROY_FORTS GOODRELATION_INFAMY_DESTROY_NAVAL_BASES "
+			"GOODRELATION_INFAMY_REPARATIONS GOODRELATION_INFAMY_TRANSFER_PROVINCES GOODRELATION_INFAMY_REMOVE_CORES "
+			"GOODRELATION_INFAMY_PRESTIGE GOODRELATION_INFAMY_CONCEDE GOODRELATION_INFAMY_STATUS_QUO "
+			"GOODRELATION_INFAMY_ANNEX GOODRELATION_INFAMY_DEMAND_STATE GOODRELATION_INFAMY_INSTALL_COMMUNIST_GOV_TYPE "
+			"GOODRELATION_INFAMY_UNINSTALL_COMMUNIST_GOV_TYPE GOODRELATION_INFAMY_COLONY "
+			"GOODRELATION_PRESTIGE_ADD_TO_SPHERE GOODRELATION_PRESTIGE_RELEASE_PUPPET "
+			"GOODRELATION_PRESTIGE_MAKE_PUPPET GOODRELATION_PRESTIGE_DISARMAMENT GOODRELATION_PRESTIGE_DESTROY_FORTS "
+			"GOODRELATION_PRESTIGE_DESTROY_NAVAL_BASES GOODRELATION_PRESTIGE_REPARATIONS "
+			"GOODRELATION_PRESTIGE_TRANSFER_PROVINCES GOODRELATION_PRESTIGE_REMOVE_CORES "
+			"GOODRELATION_PRESTIGE_PRESTIGE GOODRELATION_PRESTIGE_CONCEDE GOODRELATION_PRESTIGE_STATUS_QUO "
+			"GOODRELATION_PRESTIGE_ANNEX GOODRELATION_PRESTIGE_DEMAND_STATE "
+			"GOODRELATION_PRESTIGE_INSTALL_COMMUNIST_GOV_TYPE GOODRELATION_PRESTIGE_UNINSTALL_COMMUNIST_GOV_TYPE "
+			"GOODRELATION_PRESTIGE_COLONY GOODRELATION_MILITANCY_ADD_TO_SPHERE GOODRELATION_MILITANCY_RELEASE_PUPPET "
+			"GOODRELATION_MILITANCY_MAKE_PUPPET GOODRELATION_MILITANCY_DISARMAMENT "
+			"GOODRELATION_MILITANCY_DESTROY_FORTS GOODRELATION_MILITANCY_DESTROY_NAVAL_BASES "
+			"GOODRELATION_MILITANCY_REPARATIONS GOODRELATION_MILITANCY_TRANSFER_PROVINCES "
+			"GOODRELATION_MILITANCY_REMOVE_CORES GOODRELATION_MILITANCY_PRESTIGE GOODRELATION_MILITANCY_CONCEDE "
+			"GOODRELATION_MILITANCY_STATUS_QUO GOODRELATION_MILITANCY_ANNEX GOODRELATION_MILITANCY_DEMAND_STATE "
+			"GOODRELATION_MILITANCY_INSTALL_COMMUNIST_GOV_TYPE GOODRELATION_MILITANCY_UNINSTALL_COMMUNIST_GOV_TYPE "
+			"GOODRELATION_MILITANCY_COLONY WAR_PRESTIGE_COST_BASE WAR_PRESTIGE_COST_HIGH_PRESTIGE "
+			"WAR_PRESTIGE_COST_NEG_PRESTIGE WAR_PRESTIGE_COST_TRUCE WAR_PRESTIGE_COST_HONOR_ALLIANCE "
+			"WAR_PRESTIGE_COST_HONOR_GUARNATEE WAR_PRESTIGE_COST_UNCIVILIZED WAR_PRESTIGE_COST_CORE "
+			"WAR_FAILED_GOAL_MILITANCY WAR_FAILED_GOAL_PRESTIGE_BASE WAR_FAILED_GOAL_PRESTIGE DISCREDIT_DAYS "
+			"DISCREDIT_INFLUENCE_COST_FACTOR DISCREDIT_INFLUENCE_GAIN_FACTOR BANEMBASSY_DAYS "
+			"DECLAREWAR_RELATION_ON_ACCEPT DECLAREWAR_DIPLOMATIC_COST ADDWARGOAL_RELATION_ON_ACCEPT "
+			"ADDWARGOAL_DIPLOMATIC_COST ADD_UNJUSTIFIED_GOAL_BADBOY PEACE_RELATION_ON_ACCEPT PEACE_RELATION_ON_DECLINE "
+			"PEACE_DIPLOMATIC_COST ALLIANCE_RELATION_ON_ACCEPT ALLIANCE_RELATION_ON_DECLINE ALLIANCE_DIPLOMATIC_COST "
+			"CANCELALLIANCE_RELATION_ON_ACCEPT CANCELALLIANCE_DIPLOMATIC_COST CALLALLY_RELATION_ON_ACCEPT "
+			"CALLALLY_RELATION_ON_DECLINE CALLALLY_DIPLOMATIC_COST ASKMILACCESS_RELATION_ON_ACCEPT "
+			"ASKMILACCESS_RELATION_ON_DECLINE ASKMILACCESS_DIPLOMATIC_COST CANCELASKMILACCESS_RELATION_ON_ACCEPT "
+			"CANCELASKMILACCESS_DIPLOMATIC_COST GIVEMILACCESS_RELATION_ON_ACCEPT GIVEMILACCESS_RELATION_ON_DECLINE "
+			"GIVEMILACCESS_DIPLOMATIC_COST CANCELGIVEMILACCESS_RELATION_ON_ACCEPT CANCELGIVEMILACCESS_DIPLOMATIC_COST "
+			"WARSUBSIDY_RELATION_ON_ACCEPT WARSUBSIDY_DIPLOMATIC_COST CANCELWARSUBSIDY_RELATION_ON_ACCEPT "
+			"CANCELWARSUBSIDY_DIPLOMATIC_COST DISCREDIT_RELATION_ON_ACCEPT DISCREDIT_INFLUENCE_COST "
+			"EXPELADVISORS_RELATION_ON_ACCEPT EXPELADVISORS_INFLUENCE_COST CEASECOLONIZATION_RELATION_ON_ACCEPT "
+			"CEASECOLONIZATION_RELATION_ON_DECLINE BANEMBASSY_RELATION_ON_ACCEPT BANEMBASSY_INFLUENCE_COST "
+			"INCREASERELATION_RELATION_ON_ACCEPT INCREASERELATION_RELATION_ON_DECLINE INCREASERELATION_DIPLOMATIC_COST "
+			"DECREASERELATION_RELATION_ON_ACCEPT DECREASERELATION_DIPLOMATIC_COST ADDTOSPHERE_RELATION_ON_ACCEPT "
+			"ADDTOSPHERE_INFLUENCE_COST REMOVEFROMSPHERE_RELATION_ON_ACCEPT REMOVEFROMSPHERE_INFLUENCE_COST "
+			"REMOVEFROMSPHERE_PRESTIGE_COST REMOVEFROMSPHERE_INFAMY_COST INCREASEOPINION_RELATION_ON_ACCEPT "
+			"INCREASEOPINION_INFLUENCE_COST DECREASEOPINION_RELATION_ON_ACCEPT DECREASEOPINION_INFLUENCE_COST "
+			"MAKE_CB_DIPLOMATIC_COST MAKE_CB_RELATION_ON_ACCEPT DISARMAMENT_ARMY_HIT REPARATIONS_TAX_HIT "
+			"PRESTIGE_REDUCTION_BASE PRESTIGE_REDUCTION REPARATIONS_YEARS MIN_WARSCORE_TO_INTERVENE "
+			"MIN_MONTHS_TO_INTERVENE MAX_WARSCORE_FROM_BATTLES GUNBOAT_DIPLOMATIC_COST GUNBOAT_RELATION_ON_ACCEPT "
+			"WARGOAL_JINGOISM_REQUIREMENT LIBERATE_STATE_RELATION_INCREASE DISHONORED_CALLALLY_PRESTIGE_PENALTY "
+			"BASE_TRUCE_MONTHS MAX_INFLUENCE WARSUBSIDIES_PERCENT NEIGHBOUR_BONUS_INFLUENCE_PERCENT "
+			"SPHERE_NEIGHBOUR_BONUS_INFLUENCE_PERCENT OTHER_CONTINENT_BONUS_INFLUENCE_PERCENT "
+			"PUPPET_BONUS_INFLUENCE_PERCENT RELEASE_NATION_PRESTIGE RELEASE_NATION_INFAMY INFAMY_CLEAR_UNION_SPHERE "
+			"BREAKTRUCE_INFAMY_CLEAR_UNION_SPHERE BREAKTRUCE_PRESTIGE_CLEAR_UNION_SPHERE "
+			"BREAKTRUCE_MILITANCY_CLEAR_UNION_SPHERE GOODRELATION_INFAMY_CLEAR_UNION_SPHERE "
+			"GOODRELATION_PRESTIGE_CLEAR_UNION_SPHERE GOODRELATION_MILITANCY_CLEAR_UNION_SPHERE "
+			"PEACE_COST_CLEAR_UNION_SPHERE GOOD_PEACE_REFUSAL_MILITANCY GOOD_PEACE_REFUSAL_WAREXH PEACE_COST_GUNBOAT "
+			"INFAMY_GUNBOAT BREAKTRUCE_INFAMY_GUNBOAT BREAKTRUCE_PRESTIGE_GUNBOAT BREAKTRUCE_MILITANCY_GUNBOAT "
+			"GOODRELATION_INFAMY_GUNBOAT GOODRELATION_PRESTIGE_GUNBOAT GOODRELATION_MILITANCY_GUNBOAT "
+			"CB_GENERATION_BASE_SPEED CB_GENERATION_SPEED_BONUS_ON_COLONY_COMPETITION "
+			"CB_GENERATION_SPEED_BONUS_ON_COLONY_COMPETITION_TROOPS_PRESENCE MAKE_CB_RELATION_LIMIT "
+			"CB_DETECTION_CHANCE_BASE INVESTMENT_INFLUENCE_DEFENSE RELATION_INFLUENCE_MODIFIER "
+			"ON_CB_DETECTED_RELATION_CHANGE GW_INTERVENE_MIN_RELATIONS GW_INTERVENE_MAX_EXHAUSTION "
+			"GW_JUSTIFY_CB_BADBOY_IMPACT GW_CB_CONSTRUCTION_SPEED GW_WARGOAL_JINGOISM_REQUIREMENT_MOD "
+			"GW_WARSCORE_COST_MOD GW_WARSCORE_COST_MOD_2 GW_WARSCORE_2_THRESHOLD TENSION_DECAY TENSION_FROM_CB "
+			"TENSION_FROM_MOVEMENT TENSION_FROM_MOVEMENT_MAX AT_WAR_TENSION_DECAY TENSION_ON_CB_DISCOVERED "
+			"TENSION_ON_REVOLT TENSION_WHILE_CRISIS CRISIS_COOLDOWN_MONTHS CRISIS_BASE_CHANCE "
+			"CRISIS_TEMPERATURE_INCREASE CRISIS_OFFER_DIPLOMATIC_COST CRISIS_OFFER_RELATION_ON_ACCEPT "
+			"CRISIS_OFFER_RELATION_ON_DECLINE CRISIS_DID_NOT_TAKE_SIDE_PRESTIGE_FACTOR_BASE "
+			"CRISIS_DID_NOT_TAKE_SIDE_PRESTIGE_FACTOR_YEAR CRISIS_WINNER_PRESTIGE_FACTOR_BASE "
+			"CRISIS_WINNER_PRESTIGE_FACTOR_YEAR CRISIS_WINNER_RELATIONS_IMPACT BACK_CRISIS_DIPLOMATIC_COST "
+			"BACK_CRISIS_RELATION_ON_ACCEPT BACK_CRISIS_RELATION_ON_DECLINE CRISIS_TEMPERATURE_ON_OFFER_DECLINE "
+			"CRISIS_TEMPERATURE_PARTICIPANT_FACTOR CRISIS_TEMPERATURE_ON_MOBILIZE CRISIS_WARGOAL_INFAMY_MULT "
+			"CRISIS_WARGOAL_PRESTIGE_MULT CRISIS_WARGOAL_MILITANCY_MULT CRISIS_INTEREST_WAR_EXHAUSTION_LIMIT "
+			"RANK_1_TENSION_DECAY RANK_2_TENSION_DECAY RANK_3_TENSION_DECAY RANK_4_TENSION_DECAY RANK_5_TENSION_DECAY "
+			"RANK_6_TENSION_DECAY RANK_7_TENSION_DECAY RANK_8_TENSION_DECAY TWS_FULFILLED_SPEED "
+			"TWS_NOT_FULFILLED_SPEED TWS_GRACE_PERIOD_DAYS TWS_CB_LIMIT_DEFAULT TWS_FULFILLED_IDLE_SPACE "
+			"TWS_BATTLE_MIN_COUNT TWS_BATTLE_MAX_ASPECT LARGE_POPULATION_INFLUENCE_PENALTY LONE_BACKER_PRESTIGE_FACTOR"
+		},
+		{
+			"economy",
+			"MAX_DAILY_RESEARCH LOAN_BASE_INTEREST BANKRUPTCY_EXTERNAL_LOAN_YEARS BANKRUPTCY_FACTOR "
+			"SHADOWY_FINANCIERS_MAX_LOAN_AMOUNT MAX_LOAN_CAP_FROM_BANKS GUNBOAT_LOW_TAX_CAP GUNBOAT_HIGH_TAX_CAP "
+			"GUNBOAT_FLEET_SIZE_FACTOR PROVINCE_SIZE_DIVIDER CAPITALIST_BUILD_FACTORY_STATE_EMPLOYMENT_PERCENT "
+			"GOODS_FOCUS_SWAP_CHANCE NUM_CLOSED_FACTORIES_PER_STATE_LASSIEZ_FAIRE "
+			"MIN_NUM_FACTORIES_PER_STATE_BEFORE_DELETING_LASSIEZ_FAIRE BANKRUPCY_DURATION "
+			"SECOND_RANK_BASE_SHARE_FACTOR CIV_BASE_SHARE_FACTOR UNCIV_BASE_SHARE_FACTOR "
+			"FACTORY_PAYCHECKS_LEFTOVER_FACTOR MAX_FACTORY_MONEY_SAVE SMALL_DEBT_LIMIT FACTORY_UPGRADE_EMPLOYEE_FACTOR "
+			"RGO_SUPPLY_DEMAND_FACTOR_HIRE_HI RGO_SUPPLY_DEMAND_FACTOR_HIRE_LO RGO_SUPPLY_DEMAND_FACTOR_FIRE "
+			"EMPLOYMENT_HIRE_LOWEST EMPLOYMENT_FIRE_LOWEST TRADE_CAP_LOW_LIMIT_LAND TRADE_CAP_LOW_LIMIT_NAVAL "
+			"TRADE_CAP_LOW_LIMIT_CONSTRUCTIONS FACTORY_PURCHASE_MIN_FACTOR FACTORY_PURCHASE_DRAWDOWN_FACTOR"
+		},
+		{
+			"graphics",
+			"CITIES_SPRAWL_OFFSET CITIES_SPRAWL_WIDTH CITIES_SPRAWL_HEIGHT CITIES_SPRAWL_ITERATIONS "
+			"CITIES_MESH_POOL_SIZE_FOR_COUNTRY CITIES_MESH_POOL_SIZE_FOR_CULTURE CITIES_MESH_POOL_SIZE_FOR_GENERIC "
+			"CITIES_MESH_TYPES_COUNT CITIES_MESH_SIZES_COUNT CITIES_SPECIAL_BUILDINGS_POOL_SIZE "
+			"CITIES_SIZE_MAX_POPULATION_K"
+		},
+		{
+			"military",
+			"DIG_IN_INCREASE_EACH_DAYS REINFORCE_SPEED COMBAT_DIFFICULTY_IMPACT BASE_COMBAT_WIDTH "
+			"POP_MIN_SIZE_FOR_REGIMENT POP_SIZE_PER_REGIMENT SOLDIER_TO_POP_DAMAGE LAND_SPEED_MODIFIER "
+			"NAVAL_SPEED_MODIFIER EXP_GAIN_DIV LEADER_RECRUIT_COST SUPPLY_RANGE "
+			"POP_MIN_SIZE_FOR_REGIMENT_PROTECTORATE_MULTIPLIER POP_MIN_SIZE_FOR_REGIMENT_COLONY_MULTIPLIER "
+			"POP_MIN_SIZE_FOR_REGIMENT_NONCORE_MULTIPLIER GAS_ATTACK_MODIFIER COMBATLOSS_WAR_EXHAUSTION "
+			"LEADER_MAX_RANDOM_PRESTIGE LEADER_AGE_DEATH_FACTOR LEADER_PRESTIGE_TO_MORALE_FACTOR "
+			"LEADER_PRESTIGE_TO_MAX_ORG_FACTOR LEADER_TRANSFER_PENALTY_ON_COUNTRY_PRESTIGE LEADER_PRESTIGE_LAND_GAIN "
+			"LEADER_PRESTIGE_NAVAL_GAIN NAVAL_COMBAT_SEEKING_CHANCE NAVAL_COMBAT_SEEKING_CHANCE_MIN "
+			"NAVAL_COMBAT_SELF_DEFENCE_CHANCE NAVAL_COMBAT_SHIFT_BACK_ON_NEXT_TARGET "
+			"NAVAL_COMBAT_SHIFT_BACK_DURATION_SCALE NAVAL_COMBAT_SPEED_TO_DISTANCE_FACTOR "
+			"NAVAL_COMBAT_CHANGE_TARGET_CHANCE NAVAL_COMBAT_DAMAGE_ORG_MULT NAVAL_COMBAT_DAMAGE_STR_MULT "
+			"NAVAL_COMBAT_DAMAGE_MULT_NO_ORG NAVAL_COMBAT_RETREAT_CHANCE NAVAL_COMBAT_RETREAT_STR_ORG_LEVEL "
+			"NAVAL_COMBAT_RETREAT_SPEED_MOD NAVAL_COMBAT_RETREAT_MIN_DISTANCE NAVAL_COMBAT_DAMAGED_TARGET_SELECTION "
+			"NAVAL_COMBAT_STACKING_TARGET_CHANGE NAVAL_COMBAT_STACKING_TARGET_SELECT NAVAL_COMBAT_MAX_TARGETS "
+			"AI_BIGSHIP_PROPORTION AI_LIGHTSHIP_PROPORTION AI_TRANSPORT_PROPORTION AI_CAVALRY_PROPORTION "
+			"AI_SUPPORT_PROPORTION AI_SPECIAL_PROPORTION AI_ESCORT_RATIO AI_ARMY_TAXBASE_FRACTION "
+			"AI_NAVY_TAXBASE_FRACTION AI_BLOCKADE_RANGE RECON_UNIT_RATIO ENGINEER_UNIT_RATIO SIEGE_BRIGADES_MIN "
+			"SIEGE_BRIGADES_MAX SIEGE_BRIGADES_BONUS RECON_SIEGE_EFFECT SIEGE_ATTRITION BASE_MILITARY_TACTICS "
+			"NAVAL_LOW_SUPPLY_DAMAGE_SUPPLY_STATUS NAVAL_LOW_SUPPLY_DAMAGE_DAYS_DELAY NAVAL_LOW_SUPPLY_DAMAGE_MIN_STR "
+			"NAVAL_LOW_SUPPLY_DAMAGE_PER_DAY"
+		},
+		{
+			"pops",
+			"BASE_CLERGY_FOR_LITERACY MAX_CLERGY_FOR_LITERACY LITERACY_CHANGE_SPEED ASSIMILATION_SCALE "
+			"CONVERSION_SCALE IMMIGRATION_SCALE PROMOTION_SCALE PROMOTION_ASSIMILATION_CHANCE LUXURY_THRESHOLD "
+			"BASE_GOODS_DEMAND BASE_POPGROWTH MIN_LIFE_RATING_FOR_GROWTH LIFE_RATING_GROWTH_BONUS "
+			"LIFE_NEED_STARVATION_LIMIT MIL_LACK_EVERYDAY_NEED MIL_HAS_EVERYDAY_NEED MIL_HAS_LUXURY_NEED "
+			"MIL_NO_LIFE_NEED MIL_REQUIRE_REFORM MIL_IDEOLOGY MIL_RULING_PARTY MIL_REFORM_IMPACT MIL_WAR_EXHAUSTION "
+			"MIL_NON_ACCEPTED CON_LITERACY CON_LUXURY_GOODS CON_POOR_CLERGY CON_MIDRICH_CLERGY CON_REFORM_IMPACT "
+			"CON_COLONIAL_FACTOR RULING_PARTY_HAPPY_CHANGE RULING_PARTY_ANGRY_CHANGE PDEF_BASE_CON "
+			"NATIONAL_FOCUS_DIVIDER POP_SAVINGS STATE_CREATION_ADMIN_LIMIT MIL_TO_JOIN_REBEL MIL_TO_JOIN_RISING "
+			"MIL_TO_AUTORISE REDUCTION_AFTER_RISEING REDUCTION_AFTER_DEFEAT POP_TO_LEADERSHIP ARTISAN_MIN_PRODUCTIVITY "
+			"SLAVE_GROWTH_DIVISOR MIL_HIT_FROM_CONQUEST LUXURY_CON_CHANGE INVENTION_IMPACT_ON_DEMAND "
+			"ARTISAN_SUPPRESSED_COLONIAL_GOODS_CATEGORY ISSUE_MOVEMENT_JOIN_LIMIT ISSUE_MOVEMENT_LEAVE_LIMIT "
+			"MOVEMENT_CON_FACTOR MOVEMENT_LIT_FACTOR MIL_ON_REB_MOVE POPULATION_SUPPRESSION_FACTOR "
+			"POPULATION_MOVEMENT_RADICAL_FACTOR NATIONALIST_MOVEMENT_MIL_CAP MOVEMENT_SUPPORT_UH_FACTOR "
+			"REBEL_OCCUPATION_STRENGTH_BONUS LARGE_POPULATION_LIMIT LARGE_POPULATION_INFLUENCE_PENALTY_CHUNK"
+		}
+	}};
+
+	/* Defines the simulation divides by or otherwise needs to be sensible to run. */
+	constexpr std::array<std::pair<std::string_view, std::string_view>, 27> define_overrides {{
+		{ "GREAT_NATIONS_COUNT", "8" },
+		{ "COLONIAL_RANK", "16" },
+		{ "BASE_COUNTRY_TAX_EFFICIENCY", "0.1" },
+		{ "GOLD_TO_CASH_RATE", "0.5" },
+		{ "GOLD_TO_WORKER_PAY_RATE", "0.2" },
+		{ "MAX_BUREAUCRACY_PERCENTAGE", "0.1" },
+		{ "BUREAUCRACY_PERCENTAGE_INCREMENT", "0.01" },
+		{ "MIN_MOBILIZE_LIMIT", "3" },
+		{ "MAX_RESEARCH_POINTS", "1000" },
+		{ "MAX_DAILY_RESEARCH", "50" },
+		{ "PROVINCE_SIZE_DIVIDER", "1" },
+		{ "BASE_COMBAT_WIDTH", "4" },
+		{ "POP_MIN_SIZE_FOR_REGIMENT", "1000" },
+		{ "POP_SIZE_PER_REGIMENT", "3000" },
+		{ "LEADER_RECRUIT_COST", "20" },
+		{ "POP_MIN_SIZE_FOR_REGIMENT_PROTECTORATE_MULTIPLIER", "1" },
+		{ "POP_MIN_SIZE_FOR_REGIMENT_COLONY_MULTIPLIER", "1" },
+		{ "POP_MIN_SIZE_FOR_REGIMENT_NONCORE_MULTIPLIER", "1" },
+		{ "LEADER_PRESTIGE_TO_MORALE_FACTOR", "0.5" },
+		{ "LEADER_PRESTIGE_TO_MAX_ORG_FACTOR", "0.5" },
+		{ "BASE_MILITARY_TACTICS", "0.5" },
+		{ "BASE_GOODS_DEMAND", "0.6" },
+		{ "BASE_POPGROWTH", "0.0001" },
+		{ "PDEF_BASE_CON", "3" },
+		{ "INVENTION_IMPACT_ON_DEMAND", "0.05" },
+		{ "MIN_LIFE_RATING_FOR_GROWTH", "10" },
+		{ "LIFE_RATING_GROWTH_BONUS", "0.0001" }
+	}};
+
+	std::string make_tag(size_t country) {
+		return {
+			static_cast<char>('A' + country / (26 * 26)), static_cast<char>('A' + country / 26 % 26),
+			static_cast<char>('A' + country % 26)
+		};
+	}
+
+	template<typename F>
+	bool write_text_file(fs::path const& path, F&& write_contents) {
+		std::error_code ec;
+		fs::create_directories(path.parent_path(), ec);
+		std::ofstream stream { path, std::ios::binary | std::ios::trunc };
+		if (stream) {
+			write_contents(stream);
+			stream.flush();
+		}
+		if (!stream) {
+			spdlog::error_s("Failed to write synthetic game tree file \"{}\"", path.string());
+			return false;
+		}
+		return true;
+	}
+
+	/* Writes an uncompressed bottom-up BMP, with a 256 entry greyscale palette if it has 8 bits per pixel. Rows aren't
+	 * padded, so width * bits_per_pixel must be a multiple of 32. */
+	template<typename F>
+	bool write_bmp(fs::path const& path, int32_t width, int32_t height, uint16_t bits_per_pixel, F&& write_pixel) {
+		static constexpr uint32_t header_size = 54;
+		static constexpr uint32_t palette_colour_count = 256;
+
+		const uint32_t palette_size = bits_per_pixel == 8 ? palette_colour_count * sizeof(uint32_t) : 0;
+		const uint32_t image_size = static_cast<uint32_t>(width) * height * bits_per_pixel / 8;
+
+		BinaryWriter writer;
+		writer.write<uint16_t>(0x4D42);
+		writer.write<uint32_t>(header_size + palette_size + image_size);
+		writer.write<uint16_t>(0);
+		writer.write<uint16_t>(0);
+		writer.write<uint32_t>(header_size + palette_size);
+		writer.write<uint32_t>(40);
+		writer.write<int32_t>(width);
+		writer.write<int32_t>(height);
+		writer.write<uint16_t>(1);
+		writer.write<uint16_t>(bits_per_pixel);
+		writer.write<uint32_t>(0);
+		writer.write<uint32_t>(image_size);
+		writer.write<int32_t>(2835);
+		writer.write<int32_t>(2835);
+		writer.write<uint32_t>(palette_size > 0 ? palette_colour_count : 0);
+		writer.write<uint32_t>(0);
+		if (palette_size > 0) {
+			for (uint32_t index = 0; index < palette_colour_count; ++index) {
+				writer.write<uint32_t>(index * 0x010101);
+			}
+		}
+		for (int32_t y = height - 1; y >= 0; --y) {
+			for (int32_t x = 0; x < width; ++x) {
+				write_pixel(writer, x, y);
+			}
+		}
+		return writer.save_to_file(path);
+	}
+
+	void write_province_list(std::ostream& stream, size_t first, size_t last) {
+		for (size_t province = first; province <= last; ++province) {
+			stream << province << (province < last ? " " : "");
+		}
+	}
+}
+
+SyntheticGameTree::settings_t SyntheticGameTree::scaled_settings(size_t scale) {
+	settings_t settings;
+	settings.land_province_count *= scale;
+	settings.country_count *= scale;
+	return settings;
+}
+
+SyntheticGameTree::settings_t SyntheticGameTree::small_settings() {
+	return { .land_province_count = 32, .country_count = 4, .provinces_per_region = 4, .province_size_px = 8 };
+}
+
+bool SyntheticGameTree::write(fs::path const& root, settings_t const& settings) {
+	if (settings.land_province_count < 2 || settings.country_count < 1 ||
+		settings.country_count > settings.land_province_count || settings.country_count > 26 * 26 * 26 ||
+		settings.provinces_per_region < 1 || settings.province_size_px < 4 || settings.province_size_px % 4 != 0) {
+		spdlog::error_s(
+			"Invalid synthetic game tree settings: {} land provinces, {} countries, {} provinces per region, {}px provinces",
+			settings.land_province_count, settings.country_count, settings.provinces_per_region, settings.province_size_px
+		);
+		return false;
+	}
+
+	map_layout_t layout { settings.land_province_count, 0, 0, settings.province_size_px };
+	layout.columns = std::max<size_t>(
+		static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(settings.land_province_count)))), 2
+	);
+	layout.rows = (settings.land_province_count + layout.columns - 1) / layout.columns;
+
+	const auto get_owner = [&settings](size_t province) -> size_t {
+		return (province - 1) * settings.country_count / settings.land_province_count;
+	};
+	const auto get_capital = [&settings](size_t country) -> size_t {
+		return (country * settings.land_province_count + settings.country_count - 1) / settings.country_count + 1;
+	};
+
+	bool ret = true;
+
+	/* Interface */
+	ret &= write_text_file(root / "interface/sound.sfx", [](std::ostream&) {});
+	for (std::string_view gui_file : {
+		"core", "province_interface", "topbar", "menubar", "outliner", "goto", "v2ledger", "country_production",
+		"country_budget", "country_technology", "country_politics", "country_pops", "country_trade", "country_diplomacy",
+		"country_military"
+	}) {
+		ret &= write_text_file(root / "interface" / (std::string { gui_file } + ".gui"), [](std::ostream&) {});
+	}
+	ret &= write_text_file(root / "interface/colors.txt", [](std::ostream& stream) {
+		stream << "color = { 200 120 80 }\ncolor = { 90 160 70 }\ncolor = { 180 170 60 }\ncolor = { 110 110 190 }\n";
+	});
+	for (std::string_view leader_picture : { "european_general_0.dds", "european_admiral_0.dds" }) {
+		ret &= write_text_file(root / "gfx/interface/leaders" / leader_picture, [](std::ostream&) {});
+	}
+
+	/* Defines */
+	ret &= write_text_file(root / "common/defines.lua", [](std::ostream& stream) {
+		stream << "defines = {\n\tstart_date = '1836.1.1',\n\tend_date = '1936.1.1',\n";
+		for (auto const& [group, keys] : define_groups) {
+			stream << "\t" << group << " = {\n";
+			for (size_t start = keys.find_first_not_of(' '); start != std::string_view::npos;) {
+				const size_t end = std::min(keys.find(' ', start), keys.size());
+				const std::string_view key = keys.substr(start, end - start);
+				const auto override_it = std::find_if(define_overrides.begin(), define_overrides.end(), [key](auto const& entry) {
+					return entry.first == key;
+				});
+				stream << "\t\t" << key << " = " << (override_it != define_overrides.end() ? override_it->second : "0") << ",\n";
+				start = keys.find_first_not_of(' ', end);
+			}
+			stream << "\t},\n";
+		}
+		stream << "}\n";
+	});
+
+	/* Economy */
+	ret &= write_text_file(root / "common/goods.txt", [](std::ostream& stream) {
+		stream << "military_goods = {\n"
+			"\tsmall_arms = { cost = 37 color = { 150 150 150 } }\n"
+			"}\n"
+			"raw_material_goods = {\n"
+			"\tgrain = { cost = 2.2 color = { 220 200 80 } }\n"
+			"\tiron = { cost = 3.5 color = { 110 100 100 } }\n"
+			"\tcotton = { cost = 2 color = { 240 240 230 } }\n"
+			"}\n"
+			"industrial_goods = {\n"
+			"\tcement = { cost = 16 color = { 190 190 180 } }\n"
+			"\tfabric = { cost = 1.8 color = { 200 170 220 } }\n"
+			"}\n"
+			"consumer_goods = {\n"
+			"\tclothes = { cost = 5.8 color = { 90 60 160 } }\n"
+			"\tliquor = { cost = 6.4 color = { 160 60 40 } }\n"
+			"}\n";
+	});
+	for (size_t index = 0; index < pop_types.size(); ++index) {
+		pop_type_t const& pop_type = pop_types[index];
+		ret &= write_text_file(root / "poptypes" / (std::string { pop_type.name } + ".txt"), [&](std::ostream& stream) {
+			stream << "sprite = " << index + 1 << "\n"
+				"color = { " << 40 + 20 * index << " " << 200 - 15 * index << " 120 }\n"
+				"strata = " << pop_type.strata << "\n"
+				"life_needs = { grain = 1 }\n"
+				"everyday_needs = { clothes = 0.5 }\n"
+				"luxury_needs = { liquor = 0.5 }\n";
+			if (!pop_type.extra_keys.empty()) {
+				stream << pop_type.extra_keys << "\n";
+			}
+		});
+	}
+	ret &= write_text_file(root / "common/pop_types.txt", [](std::ostream& stream) {
+		for (std::string_view chance : {
+			"promotion", "demotion", "migration", "colonialmigration", "emigration", "assimilation", "conversion"
+		}) {
+			stream << chance << "_chance = { factor = 1 }\n";
+		}
+	});
+	ret &= write_text_file(root / "common/production_types.txt", [](std::ostream& stream) {
+		stream << "rgo_farm_template = {\n"
+			"\towner = { poptype = aristocrats effect = output }\n"
+			"\temployees = {\n"
+			"\t\t{ poptype = farmers effect = throughput amount = 1 }\n"
+			"\t\t{ poptype = slaves effect = output amount = 1 }\n"
+			"\t}\n"
+			"\ttype = rgo\n"
+			"\tworkforce = 40000\n"
+			"}\n"
+			"rgo_mine_template = {\n"
+			"\towner = { poptype = aristocrats effect = output }\n"
+			"\temployees = {\n"
+			"\t\t{ poptype = labourers effect = throughput amount = 1 }\n"
+			"\t\t{ poptype = slaves effect = output amount = 1 }\n"
+			"\t}\n"
+			"\ttype = rgo\n"
+			"\tworkforce = 40000\n"
+			"}\n"
+			"factory_template = {\n"
+			"\towner = { poptype = capitalists effect = input }\n"
+			"\temployees = {\n"
+			"\t\t{ poptype = craftsmen effect = throughput amount = 0.8 }\n"
+			"\t\t{ poptype = bureaucrats effect = output amount = 0.2 }\n"
+			"\t}\n"
+			"\ttype = factory\n"
+			"\tworkforce = 10000\n"
+			"}\n"
+			"artisan_template = {\n"
+			"\ttype = artisan\n"
+			"\tworkforce = 10000\n"
+			"}\n"
+			"grain_farm = { template = rgo_farm_template output_goods = grain value = 1.8 farm = yes }\n"
+			"cotton_farm = { template = rgo_farm_template output_goods = cotton value = 1 farm = yes }\n"
+			"iron_mine = { template = rgo_mine_template output_goods = iron value = 1 mine = yes }\n";
+		for (factory_t const& factory : factories) {
+			stream << factory.name << " = { template = factory_template input_goods = { " << factory.input_good
+				<< " = 1 } output_goods = " << factory.output_good << " value = 1 }\n";
+			stream << "artisan_" << factory.output_good << " = { template = artisan_template input_goods = { "
+				<< factory.input_good << " = 1 } output_goods = " << factory.output_good << " value = 0.5 }\n";
+		}
+	});
+	ret &= write_text_file(root / "common/buildings.txt", [](std::ostream& stream) {
+		stream << "fort = {\n"
+			"\ttype = fort\n\tmax_level = 6\n\tgoods_cost = { cement = 50 }\n\ttime = 730\n\tvisibility = yes\n\tonmap = yes\n"
+			"\tprovince = yes\n\tfort_level = 1\n"
+			"}\n"
+			"naval_base = {\n"
+			"\ttype = naval_base\n\tmax_level = 6\n\tgoods_cost = { cement = 50 }\n\ttime = 730\n\tvisibility = yes\n"
+			"\tonmap = yes\n\tprovince = yes\n\tport = yes\n\tnaval_capacity = 1\n"
+			"}\n"
+			"railroad = {\n"
+			"\ttype = infrastructure\n\tmax_level = 5\n\tgoods_cost = { cement = 40 }\n\ttime = 365\n\tvisibility = yes\n"
+			"\tonmap = yes\n\tprovince = yes\n\tinfrastructure = 0.16\n"
+			"}\n";
+		for (factory_t const& factory : factories) {
+			stream << factory.name << " = {\n"
+				"\ttype = factory\n\tmax_level = 99\n\tgoods_cost = { cement = 20 }\n\ttime = 730\n\tvisibility = yes\n"
+				"\tonmap = no\n\tproduction_type = " << factory.name << "\n\tpop_build_factory = yes\n"
+				"}\n";
+		}
+	});
+
+	/* Military */
+	ret &= write_text_file(root / "units/infantry.txt", [](std::ostream& stream) {
+		stream << "infantry = {\n"
+			"\ticon = 1\n\ttype = land\n\tsprite = Infantry\n\tactive = yes\n\tunit_type = infantry\n\tfloating_flag = no\n"
+			"\tpriority = 1\n\tmax_strength = 3\n\tdefault_organisation = 30\n\tmaximum_speed = 4\n\tweighted_value = 3\n"
+			"\tbuild_time = 90\n\tbuild_cost = { small_arms = 10 }\n\tsupply_consumption = 1\n\tsupply_cost = { grain = 0.1 }\n"
+			"\treconnaissance = 0\n\tattack = 2\n\tdefence = 4\n\tdiscipline = 1\n\tsupport = 0\n\tmaneuver = 1\n"
+			"}\n";
+	});
+	ret &= write_text_file(root / "units/frigate.txt", [](std::ostream& stream) {
+		stream << "frigate = {\n"
+			"\ticon = 2\n\tnaval_icon = 1\n\ttype = naval\n\tsprite = Frigate\n\tactive = yes\n\tunit_type = light_ship\n"
+			"\tfloating_flag = yes\n\tpriority = 2\n\tmax_strength = 100\n\tdefault_organisation = 30\n\tmaximum_speed = 8\n"
+			"\tweighted_value = 2\n\tbuild_time = 180\n\tbuild_cost = { small_arms = 20 }\n\tsupply_consumption = 1\n"
+			"\tsupply_cost = { grain = 0.1 }\n\tmin_port_level = 1\n\tlimit_per_port = -1\n\thull = 25\n\tgun_power = 12\n"
+			"\tfire_range = 1\n\tevasion = 0.2\n"
+			"}\n";
+	});
+	ret &= write_text_file(root / "common/traits.txt", [](std::ostream& stream) {
+		stream << "personality = {\n\tno_personality = { }\n}\nbackground = {\n\tno_background = { }\n}\n";
+	});
+	ret &= write_text_file(root / "common/cb_types.txt", [](std::ostream& stream) {
+		stream << "peace_order = { conquest }\n"
+			"conquest = {\n\twar_name = NORMAL_WAR_NAME\n\ttruce_months = 60\n\tsprite_index = 1\n\tpo_annex = yes\n}\n";
+	});
+
+	/* Politics */
+	ret &= write_text_file(root / "common/ideologies.txt", [](std::ostream& stream) {
+		for (auto [group, ideology, colour] : {
+			std::array<std::string_view, 3> { "conservative_group", "conservative", "10 10 250" },
+			std::array<std::string_view, 3> { "liberal_group", "liberal", "250 250 10" }
+		}) {
+			stream << group << " = {\n\t" << ideology << " = {\n\t\tuncivilized = no\n\t\tcolor = { " << colour << " }\n";
+			for (std::string_view reform_weight : {
+				"add_political_reform", "remove_political_reform", "add_social_reform", "remove_social_reform"
+			}) {
+				stream << "\t\t" << reform_weight << " = { base = 1 }\n";
+			}
+			stream << "\t}\n}\n";
+		}
+	});
+	ret &= write_text_file(root / "common/governments.txt", [](std::ostream& stream) {
+		stream << "absolute_monarchy = {\n\tconservative = yes\n\tliberal = yes\n\telection = no\n"
+			"\tappoint_ruling_party = yes\n}\n"
+			"democracy = {\n\tconservative = yes\n\tliberal = yes\n\telection = yes\n\tduration = 48\n"
+			"\tappoint_ruling_party = no\n}\n";
+	});
+	ret &= write_text_file(root / "common/issues.txt", [](std::ostream& stream) {
+		stream << "party_issues = {\n"
+			"\ttrade_policy = {\n\t\tprotectionism = { }\n\t\tfree_trade = { }\n\t}\n"
+			"\teconomic_policy = {\n\t\tlaissez_faire = { }\n\t\tinterventionism = { }\n\t}\n"
+			"}\n"
+			"political_reforms = {\n"
+			"\tslavery = {\n\t\tnext_step_only = yes\n\t\tyes_slavery = { }\n\t\tno_slavery = { }\n\t}\n"
+			"\tvote_franchise = {\n\t\tnext_step_only = yes\n\t\tnone_voting = { }\n\t\tuniversal_voting = { }\n\t}\n"
+			"}\n"
+			"social_reforms = {\n"
+			"\twage_reform = {\n\t\tnext_step_only = yes\n\t\tno_minimum_wage = { }\n\t\tminimum_wage = { }\n\t}\n"
+			"}\n";
+	});
+	ret &= write_text_file(root / "common/nationalvalues.txt", [](std::ostream& stream) {
+		stream << "nv_order = { }\n";
+	});
+	for (std::string_view empty_file : {
+		"common/rebel_types.txt", "common/national_focus.txt", "common/crime.txt", "common/event_modifiers.txt",
+		"common/triggered_modifiers.txt", "common/on_actions.txt"
+	}) {
+		ret &= write_text_file(root / empty_file, [](std::ostream&) {});
+	}
+	ret &= write_text_file(root / "common/static_modifiers.txt", [](std::ostream& stream) {
+#define STATIC_MODIFIER(PROP) stream << #PROP " = { }\n";
+#define STATIC_MODIFIER_ID(PROP, ID) stream << #ID " = { }\n";
+		COUNTRY_DIFFICULTY_MODIFIER_LIST(STATIC_MODIFIER, STATIC_MODIFIER_ID)
+		COUNTRY_MODIFIER_LIST(STATIC_MODIFIER, STATIC_MODIFIER_ID)
+		PROVINCE_MODIFIER_LIST(STATIC_MODIFIER, STATIC_MODIFIER_ID)
+#undef STATIC_MODIFIER_ID
+#undef STATIC_MODIFIER
+		stream << "base_values = { }\nbad_debter = { }\nin_bankrupcy = { }\ngeneralised_debt_default = { }\n";
+	});
+
+	/* Research */
+	ret &= write_text_file(root / "common/technology.txt", [](std::ostream& stream) {
+		stream << "folders = {\n\tarmy_tech = { army_doctrine }\n\tcommerce_tech = { economic_thought }\n}\n"
+			"schools = {\n\ttraditional_academic = { }\n}\n";
+	});
+	for (auto [folder, area, first_tech, second_tech] : {
+		std::array<std::string_view, 4> { "army_tech", "army_doctrine", "post_napoleonic_thought", "strategic_mobility" },
+		std::array<std::string_view, 4> { "commerce_tech", "economic_thought", "private_banks", "stock_exchange" }
+	}) {
+		ret &= write_text_file(root / "technologies" / (std::string { folder } + ".txt"), [&](std::ostream& stream) {
+			stream << first_tech << " = {\n\tarea = " << area << "\n\tyear = 1836\n\tcost = 3600\n\tai_chance = { factor = 1 }\n}\n"
+				<< second_tech << " = {\n\tarea = " << area << "\n\tyear = 1850\n\tcost = 7200\n\tai_chance = { factor = 1 }\n}\n";
+		});
+	}
+
+	/* Population */
+	ret &= write_text_file(root / "common/graphicalculturetype.txt", [](std::ostream& stream) {
+		stream << "EuropeanGC\n";
+	});
+	ret &= write_text_file(root / "common/religion.txt", [](std::ostream& stream) {
+		stream << "synthetic_faiths = {\n"
+			"\tcatholic = {\n\t\ticon = 1\n\t\tcolor = { 204 204 25 }\n\t}\n"
+			"\tprotestant = {\n\t\ticon = 2\n\t\tcolor = { 25 25 204 }\n\t}\n"
+			"}\n";
+	});
+	ret &= write_text_file(root / "common/cultures.txt", [](std::ostream& stream) {
+		stream << "synthetic_group = {\n\tleader = european\n\tunit = EuropeanGC\n";
+		for (size_t index = 0; index < culture_names.size(); ++index) {
+			stream << "\t" << culture_names[index] << " = {\n\t\tcolor = { " << 60 * index << " 100 " << 200 - 40 * index
+				<< " }\n\t\tfirst_names = { Adam Bernard Carl }\n\t\tlast_names = { Smith Jones Brown }\n\t}\n";
+		}
+		stream << "}\n";
+	});
+
+	/* Countries */
+	ret &= write_text_file(root / "common/countries.txt", [&settings](std::ostream& stream) {
+		for (size_t country = 0; country < settings.country_count; ++country) {
+			const std::string tag = make_tag(country);
+			stream << tag << " = \"countries/" << tag << ".txt\"\n";
+		}
+	});
+	ret &= write_text_file(root / "common/country_colors.txt", [&settings](std::ostream& stream) {
+		for (size_t country = 0; country < settings.country_count; ++country) {
+			stream << make_tag(country) << " = {\n\tcolor1 = { " << country * 37 % 256 << " 60 90 }\n"
+				"\tcolor2 = { 250 250 250 }\n\tcolor3 = { 20 20 20 }\n}\n";
+		}
+	});
+	for (size_t country = 0; country < settings.country_count; ++country) {
+		const std::string tag = make_tag(country);
+		ret &= write_text_file(root / "common/countries" / (tag + ".txt"), [&](std::ostream& stream) {
+			stream << "color = { " << country * 37 % 256 << " " << country * 91 % 256 << " " << country * 53 % 256 << " }\n"
+				"graphical_culture = EuropeanGC\n"
+				"party = {\n\tname = \"" << tag << "_conservative\"\n\tstart_date = 1800.1.1\n\tend_date = 2000.1.1\n"
+				"\tideology = conservative\n\ttrade_policy = protectionism\n\teconomic_policy = laissez_faire\n}\n"
+				"party = {\n\tname = \"" << tag << "_liberal\"\n\tstart_date = 1800.1.1\n\tend_date = 2000.1.1\n"
+				"\tideology = liberal\n\ttrade_policy = free_trade\n\teconomic_policy = interventionism\n}\n";
+		});
+		ret &= write_text_file(root / "history/countries" / (tag + " - Synthetic.txt"), [&](std::ostream& stream) {
+			stream << "capital = " << get_capital(country) << "\n"
+				"primary_culture = " << culture_names[country % culture_names.size()] << "\n"
+				"religion = catholic\n"
+				"government = " << (country % 2 == 0 ? "absolute_monarchy" : "democracy") << "\n"
+				"civilized = yes\n"
+				"ruling_party = " << tag << "_conservative\n"
+				"last_election = 1834.1.1\n"
+				"literacy = 0.5\n"
+				"upper_house = {\n\tconservative = 0.5\n\tliberal = 0.5\n}\n"
+				"slavery = no_slavery\nvote_franchise = none_voting\nwage_reform = no_minimum_wage\n"
+				"post_napoleonic_thought = 1\nprivate_banks = 1\n"
+				"schools = traditional_academic\n";
+		});
+	}
+
+	/* History */
+	ret &= write_text_file(root / "common/bookmarks.txt", [&layout](std::ostream& stream) {
+		stream << "bookmark = {\n\tname = \"SYNTHETIC_START\"\n\tdesc = \"SYNTHETIC_START_DESC\"\n\tdate = 1836.1.1\n"
+			"\tcameraX = " << layout.get_width() / 2 << "\n\tcameraY = " << layout.get_height() / 2 << "\n}\n";
+	});
+	for (size_t province = 1; province <= layout.land_province_count; ++province) {
+		const std::string tag = make_tag(get_owner(province));
+		ret &= write_text_file(
+			root / "history/provinces/synthetic" / (std::to_string(province) + " - Synthetic.txt"),
+			[&](std::ostream& stream) {
+				stream << "owner = " << tag << "\ncontroller = " << tag << "\nadd_core = " << tag << "\n"
+					"trade_goods = " << rgo_goods[province % rgo_goods.size()] << "\n"
+					"life_rating = 35\n";
+			}
+		);
+	}
+	ret &= write_text_file(root / "history/pops/1836.1.1/Synthetic.txt", [&](std::ostream& stream) {
+		for (size_t province = 1; province <= layout.land_province_count; ++province) {
+			const std::string_view culture = culture_names[get_owner(province) % culture_names.size()];
+			stream << province << " = {\n";
+			for (pop_type_t const& pop_type : pop_types) {
+				if (pop_type.starting_size > 0) {
+					stream << "\t" << pop_type.name << " = {\n\t\tculture = " << culture << "\n\t\treligion = catholic\n"
+						"\t\tsize = " << pop_type.starting_size << "\n\t}\n";
+				}
+			}
+			stream << "}\n";
+		}
+	});
+
+	/* Map */
+	ret &= write_text_file(root / "map/default.map", [&layout](std::ostream& stream) {
+		stream << "max_provinces = " << layout.get_province_count() + 1 << "\nsea_starts = {\n\t";
+		write_province_list(stream, layout.land_province_count + 1, layout.get_province_count());
+		stream << "\n}\n"
+			"definitions = \"definition.csv\"\nprovinces = \"provinces.bmp\"\npositions = \"positions.txt\"\n"
+			"terrain = \"terrain.bmp\"\nrivers = \"rivers.bmp\"\nterrain_definition = \"terrain.txt\"\n"
+			"tree_definition = \"trees.txt\"\ncontinent = \"continent.txt\"\nadjacencies = \"adjacencies.csv\"\n"
+			"region = \"region.txt\"\nregion_sea = \"region_sea.txt\"\nprovince_flag_sprite = \"province_flag_sprites\"\n";
+	});
+	ret &= write_text_file(root / "map/definition.csv", [&layout](std::ostream& stream) {
+		stream << "province;red;green;blue;x;x\n";
+		for (size_t province = 1; province <= layout.get_province_count(); ++province) {
+			const colour_bytes_t colour = get_province_colour(province);
+			stream << province << ";" << +colour.red << ";" << +colour.green << ";" << +colour.blue << ";"
+				<< (layout.is_land(province) ? "Land" : "Sea") << province << ";x\n";
+		}
+	});
+	ret &= write_bmp(
+		root / "map/provinces.bmp", layout.get_width(), layout.get_height(), 24,
+		[&layout](BinaryWriter& writer, int32_t x, int32_t y) {
+			const colour_bytes_t colour = get_province_colour(layout.get_province_at(x, y));
+			writer.write(std::array<uint8_t, 3> { colour.blue, colour.green, colour.red });
+		}
+	);
+	/* Palette indices matching the mappings in terrain.txt. */
+	static constexpr uint8_t plains_terrain_index = 0, ocean_terrain_index = 254, no_river_index = 255;
+	ret &= write_bmp(
+		root / "map/terrain.bmp", layout.get_width(), layout.get_height(), 8,
+		[&layout](BinaryWriter& writer, int32_t x, int32_t y) {
+			writer.write<uint8_t>(layout.is_land(layout.get_province_at(x, y)) ? plains_terrain_index : ocean_terrain_index);
+		}
+	);
+	ret &= write_bmp(
+		root / "map/rivers.bmp", layout.get_width(), layout.get_height(), 8,
+		[](BinaryWriter& writer, int32_t, int32_t) {
+			writer.write<uint8_t>(no_river_index);
+		}
+	);
+	ret &= write_text_file(root / "map/terrain.txt", [](std::ostream& stream) {
+		stream << "terrain = 64\n"
+			"categories = {\n"
+			"\tplains = {\n\t\tcolor = { 130 150 90 }\n\t\tmovement_cost = 1\n\t}\n"
+			"\tocean = {\n\t\tcolor = { 40 60 200 }\n\t\tmovement_cost = 1\n\t\tis_water = yes\n\t}\n"
+			"}\n"
+			"plains_terrain = {\n\ttype = plains\n\tcolor = { " << +plains_terrain_index << " }\n}\n"
+			"ocean_terrain = {\n\ttype = ocean\n\tcolor = { " << +ocean_terrain_index << " }\n\thas_texture = no\n}\n";
+	});
+	ret &= write_text_file(root / "map/positions.txt", [](std::ostream&) {});
+	ret &= write_text_file(root / "map/adjacencies.csv", [&layout](std::ostream& stream) {
+		/* A strait across the sea column between the two ends of the first row of land provinces. */
+		stream << "From;To;Type;Through;Data;Comment\n"
+			<< 1 << ";" << std::min(layout.columns, layout.land_province_count) << ";sea;"
+			<< layout.get_first_sea_column_province() << ";0;Synthetic strait\n";
+	});
+	ret &= write_text_file(root / "map/region.txt", [&layout, &settings](std::ostream& stream) {
+		for (size_t first = 1; first <= layout.land_province_count; first += settings.provinces_per_region) {
+			stream << "SYN_" << (first - 1) / settings.provinces_per_region + 1 << " = { ";
+			write_province_list(stream, first, std::min(first + settings.provinces_per_region - 1, layout.land_province_count));
+			stream << " }\n";
+		}
+	});
+	ret &= write_text_file(root / "map/continent.txt", [&layout](std::ostream& stream) {
+		stream << "synthetic_continent = {\n\tprovinces = {\n\t\t";
+		write_province_list(stream, 1, layout.land_province_count);
+		stream << "\n\t}\n}\n";
+	});
+	ret &= write_text_file(root / "map/climate.txt", [&layout](std::ostream& stream) {
+		stream << "temperate = { }\ntemperate = {\n\t";
+		write_province_list(stream, 1, layout.land_province_count);
+		stream << "\n}\n";
+	});
+
+	return ret;
+}
+
+fs::path SyntheticGameTree::get_unique_temp_path(std::string_view prefix) {
+	// The random run id separates concurrent runs and the call count separates paths within a run
+	static const uint64_t run_id = (static_cast<uint64_t>(std::random_device {}()) << 32) | std::random_device {}();
+	static std::atomic<uint64_t> call_count = 0;
+	return fs::temp_directory_path() / fmt::format("{}_{:016x}_{}", prefix, run_id, call_count++);
+}
+
+fs::path SyntheticGameTree::write_to_unique_temp_path(std::string_view prefix, settings_t const& settings) {
+	const fs::path root = get_unique_temp_path(prefix);
+	if (!write(root, settings)) {
+		std::error_code ec;
+		fs::remove_all(root, ec);
+		return {};
+	}
+	return root;
+}
+
+bool SyntheticGameTree::load_definitions(GameManager& game_manager, fs::path const& root) {
+	const Dataloader::path_vector_t roots { root };
+	return game_manager.set_base_path(roots) && game_manager.load_definitions();
+}
+
+bool SyntheticGameTree::start_game(GameManager& game_manager, fs::path const& root) {
+	return load_definitions(game_manager, root) && game_manager.setup_instance(
+		game_manager.get_definition_manager().get_history_manager().get_bookmark_manager().get_front_bookmark()
+	) && game_manager.start_game_session() && game_manager.update_clock();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace OpenVic {
+	namespace fs = std::filesystem;
+
+	struct GameManager;
+
+	/* Writes a self-consistent, Victoria 2 shaped game tree with generated map images, so dataloading and the simulation
+	 * can be benchmarked without the proprietary game files. The map is a grid of square land provinces with a column of
+	 * sea provinces on its right, which wraps around to touch the grid's left edge. Countries own contiguous runs of land
+	 * provinces, and every land province gets one pop of each pop type. Events, decisions, inventions, rivers, wars and
+	 * diplomatic history are left out, and the defines have placeholder values. */
+	struct SyntheticGameTree {
+		struct settings_t {
+			size_t land_province_count = 256;
+			size_t country_count = 16;
+			size_t provinces_per_region = 4;
+			/* The side length in pixels of each province's square in the map images. */
+			int32_t province_size_px = 16;
+		};
+
+		/* The default settings with the province and country counts multiplied by scale. */
+		static settings_t scaled_settings(size_t scale);
+		/* Settings for a tree small enough for tests to load and play quickly. */
+		static settings_t small_settings();
+
+		/* Writes the game tree into root, creating it if necessary and overwriting any files with the same names.
+		 * Logs an error and returns false if the settings are invalid or a file couldn't be written. */
+		static bool write(fs::path const& root, settings_t const& settings);
+
+		/* Returns a path in the system temp directory starting with prefix, which differs between calls and between runs,
+		 * so concurrent runs never share or remove each other's files. Nothing is created at the path. */
+		static fs::path get_unique_temp_path(std::string_view prefix);
+
+		/* Writes the game tree into a new directory at get_unique_temp_path(prefix), which the caller should remove.
+		 * Returns an empty path if it couldn't be written. */
+		static fs::path write_to_unique_temp_path(std::string_view prefix, settings_t const& settings);
+
+		/* Sets root as game_manager's only base path and loads its definitions. */
+		static bool load_definitions(GameManager& game_manager, fs::path const& root);
+		/* Loads the definitions at root and starts a game from their first bookmark. */
+		static bool start_game(GameManager& game_manager, fs::path const& root);
+	};
+}
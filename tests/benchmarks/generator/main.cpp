@@ -0,0 +1,47 @@
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <system_error>
+
+#include <fmt/base.h>
+
+#include <openvic-simulation/core/string/Utility.hpp>
+
+#include "SyntheticGameTree.hpp"
+
+using namespace OpenVic;
+
+static void print_help(FILE* file, std::string_view program_name) {
+	fmt::println(file, "Usage: {} <path> [scale]", program_name);
+	fmt::println(file, "    Writes a synthetic game tree to the path, which can then be used as a base directory.");
+	fmt::println(file, "    The default province and country counts are multiplied by the scale, which defaults to 1.");
+}
+
+int main(int argc, char const* argv[]) {
+	const std::string_view program_name = get_filename(argc > 0 ? argv[0] : "", "<program>");
+
+	if (argc < 2 || argc > 3) {
+		print_help(stderr, program_name);
+		return -1;
+	}
+
+	size_t scale = 1;
+	if (argc == 3) {
+		const std::string_view scale_str = argv[2];
+		const std::from_chars_result result = std::from_chars(scale_str.data(), scale_str.data() + scale_str.size(), scale);
+		if (result.ec != std::errc {} || result.ptr != scale_str.data() + scale_str.size() || scale == 0) {
+			fmt::println(stderr, "Invalid scale: {}", scale_str);
+			print_help(stderr, program_name);
+			return -1;
+		}
+	}
+
+	if (!SyntheticGameTree::write(argv[1], SyntheticGameTree::scaled_settings(scale))) {
+		fmt::println(stderr, "Failed to write synthetic game tree to {}", argv[1]);
+		return -1;
+	}
+
+	fmt::println("Wrote synthetic game tree to {}", argv[1]);
+	return 0;
+}
@@ -0,0 +1,71 @@
+#include <array>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+#include <nanobench.h>
+
+#include "openvic-simulation/GameManager.hpp"
+#include "openvic-simulation/InstanceManager.hpp"
+
+#include "SyntheticGameTree.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+namespace {
+	// Multiples of SyntheticGameTree's default province, country and pop counts
+	constexpr std::array<size_t, 3> SCALES { 1, 4, 16 };
+	constexpr size_t TICK_COUNT = 30;
+
+	bool load_definitions(GameManager& game_manager, fs::path const& root) {
+		const Dataloader::path_vector_t roots { root };
+		return game_manager.set_base_path(roots) && game_manager.load_definitions();
+	}
+
+	Bookmark const& get_front_bookmark(GameManager const& game_manager) {
+		return game_manager.get_definition_manager().get_history_manager().get_bookmark_manager().get_front_bookmark();
+	}
+}
+
+TEST_CASE("Synthetic game tree benchmark", "[benchmarks][benchmark-synthetic-game-tree]") {
+	for (const size_t scale : SCALES) {
+		const std::string suffix = " (" + std::to_string(scale) + "x)";
+		const fs::path root = SyntheticGameTree::get_unique_temp_path(
+			"openvic_synthetic_game_tree_" + std::to_string(scale) + "x"
+		);
+		REQUIRE(SyntheticGameTree::write(root, SyntheticGameTree::scaled_settings(scale)));
+
+		ankerl::nanobench::Bench().epochs(5).run("load_definitions" + suffix, [&] {
+			GameManager game_manager { []() {}, nullptr, nullptr };
+			CHECK(load_definitions(game_manager, root));
+		});
+
+		GameManager game_manager { []() {}, nullptr, nullptr };
+		REQUIRE(load_definitions(game_manager, root));
+
+		ankerl::nanobench::Bench().epochs(5).run("setup_instance" + suffix, [&] {
+			CHECK(game_manager.setup_instance(get_front_bookmark(game_manager)));
+			CHECK(game_manager.end_game_session());
+		});
+
+		REQUIRE(game_manager.setup_instance(get_front_bookmark(game_manager)));
+		REQUIRE(game_manager.start_game_session());
+		REQUIRE(game_manager.update_clock());
+		InstanceManager& instance_manager = *game_manager.get_instance_manager();
+
+		ankerl::nanobench::Bench().epochs(5).batch(TICK_COUNT).unit("tick").run(
+			std::to_string(TICK_COUNT) + " ticks" + suffix, [&] {
+				for (size_t tick = 0; tick < TICK_COUNT; ++tick) {
+					instance_manager.force_tick_and_update();
+				}
+			}
+		);
+
+		CHECK(game_manager.end_game_session());
+		std::error_code ec;
+		fs::remove_all(root, ec);
+	}
+}
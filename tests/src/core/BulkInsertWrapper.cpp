@@ -159,4 +159,19 @@ TEST_CASE("bulk_insert_wrapper shrink_to_fit", "[bulk_insert_wrapper][bulk_inser
 	CHECK(wrapper.capacity() <= capacity_before_shrink);
 	CHECK(spy_allocator.metrics->allocation_count >= 1);
 	CHECK(spy_allocator.metrics->allocation_count <= 2);
-}
\ No newline at end of file
+}
+
+TEST_CASE("bulk_insert_wrapper append_range + erase_if keep values", "[bulk_insert_wrapper][bulk_insert_wrapper-erase_if]") {
+	bulk_insert_wrapper<std::vector<int>> wrapper;
+
+	std::vector<int> a { 1, 2, 3, 4 };
+	wrapper.make_room_for(a.size());
+	wrapper.append_range(a);
+	CHECK(wrapper[0] == 1);
+	CHECK(wrapper[3] == 4);
+
+	CHECK(wrapper.erase_if([](const int value) -> bool { return value % 2 == 0; }) == 2);
+	CHECK(wrapper.size() == 2);
+	CHECK(wrapper[0] == 1);
+	CHECK(wrapper[1] == 3);
+}
@@ -0,0 +1,78 @@
+#include "openvic-simulation/core/io/BMP.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include "openvic-simulation/core/io/MappedFile.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+static void write_u16(std::ofstream& file, uint16_t value) {
+	file.put(value & 0xFF).put(value >> 8);
+}
+
+static void write_u32(std::ofstream& file, uint32_t value) {
+	write_u16(file, value & 0xFFFF);
+	write_u16(file, value >> 16);
+}
+
+TEST_CASE("BMP reads mapped pixel data", "[BMP]") {
+	const fs::path bmp_path = fs::temp_directory_path() / "openvic_bmp_test.bmp";
+
+	static constexpr int32_t width = 4, height = 2;
+	static constexpr uint32_t header_size = 54;
+	std::array<uint8_t, width * height * 3> pixels;
+	for (size_t i = 0; i < pixels.size(); ++i) {
+		pixels[i] = static_cast<uint8_t>(i);
+	}
+
+	{
+		std::ofstream file { bmp_path, std::ios::binary };
+		write_u16(file, 0x4d42);
+		write_u32(file, header_size + pixels.size());
+		write_u32(file, 0);
+		write_u32(file, header_size);
+		write_u32(file, 40);
+		write_u32(file, width);
+		write_u32(file, height);
+		write_u16(file, 1);
+		write_u16(file, 24);
+		write_u32(file, 0);
+		write_u32(file, pixels.size());
+		write_u32(file, 0);
+		write_u32(file, 0);
+		write_u32(file, 0);
+		write_u32(file, 0);
+		file.write(reinterpret_cast<char const*>(pixels.data()), pixels.size());
+	}
+
+	{
+		BMP bmp;
+		REQUIRE(bmp.open(bmp_path));
+		REQUIRE(bmp.read_header());
+		REQUIRE(bmp.read_pixel_data());
+		CHECK(bmp.get_width() == width);
+		CHECK(bmp.get_height() == height);
+		CHECK(bmp.get_bits_per_pixel() == 24);
+		REQUIRE(bmp.get_pixel_data().size() == pixels.size());
+		CHECK(std::equal(pixels.begin(), pixels.end(), bmp.get_pixel_data().begin()));
+	}
+
+	MappedFile empty_file;
+	const fs::path empty_path = fs::temp_directory_path() / "openvic_mapped_file_test.empty";
+	std::ofstream { empty_path };
+	CHECK(empty_file.open(empty_path));
+	CHECK(empty_file.get_data().empty());
+	empty_file.close();
+
+	std::error_code ec;
+	fs::remove(bmp_path, ec);
+	fs::remove(empty_path, ec);
+}
@@ -0,0 +1,71 @@
+#include "openvic-simulation/core/io/BinaryStream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include "openvic-simulation/core/io/MappedFile.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+TEST_CASE("BinaryWriter save_to_file and in place reads", "[BinaryStream]") {
+	const fs::path path = fs::temp_directory_path() / "openvic_binary_stream_test.bin";
+
+	static constexpr std::array<uint8_t, 5> bytes { 1, 2, 3, 4, 5 };
+
+	BinaryWriter writer;
+	writer.write<uint32_t>(7);
+	writer.write_span<uint8_t>(bytes);
+	REQUIRE(writer.save_to_file(path));
+
+	MappedFile file;
+	REQUIRE(file.open(path));
+	MappedFile moved_file = std::move(file);
+	CHECK_FALSE(file.is_open());
+	REQUIRE(moved_file.is_open());
+
+	BinaryReader reader { moved_file.get_data() };
+	uint32_t value = 0;
+	std::span<const uint8_t> read_bytes;
+	CHECK(reader.read(value));
+	CHECK(reader.read_byte_span(read_bytes));
+	CHECK(value == 7);
+	REQUIRE(read_bytes.size() == bytes.size());
+	CHECK(std::equal(bytes.begin(), bytes.end(), read_bytes.begin()));
+	CHECK(reader.is_at_end());
+	CHECK_FALSE(reader.read_byte_span(read_bytes));
+	CHECK(reader.has_failed());
+
+	moved_file.close();
+	std::error_code ec;
+	fs::remove(path, ec);
+}
+
+TEST_CASE("BinaryWriter byte spans written in place match write_span", "[BinaryStream]") {
+	static constexpr std::array<uint8_t, 5> bytes { 1, 2, 3, 4, 5 };
+
+	BinaryWriter span_writer;
+	span_writer.write<uint32_t>(7);
+	span_writer.write_span<uint8_t>(bytes);
+	span_writer.write_span<uint8_t>({});
+
+	BinaryWriter in_place_writer;
+	in_place_writer.write<uint32_t>(7);
+	const size_t count_offset = in_place_writer.begin_byte_span();
+	for (const uint8_t byte : bytes) {
+		in_place_writer.write(byte);
+	}
+	in_place_writer.end_byte_span(count_offset);
+	in_place_writer.end_byte_span(in_place_writer.begin_byte_span());
+
+	const std::span<const uint8_t> span_data = span_writer.get_data();
+	const std::span<const uint8_t> in_place_data = in_place_writer.get_data();
+	CHECK(std::equal(span_data.begin(), span_data.end(), in_place_data.begin(), in_place_data.end()));
+}
@@ -0,0 +1,221 @@
+#include "openvic-simulation/country/CountryReportBuffer.hpp"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "openvic-simulation/economy/GoodDefinition.hpp"
+#include "openvic-simulation/economy/production/ProductionType.hpp"
+#include "openvic-simulation/misc/GameRulesManager.hpp"
+#include "openvic-simulation/population/PopSize.hpp"
+#include "openvic-simulation/types/Colour.hpp"
+#include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+namespace {
+	//Records what CountryInstance::fold_reports_from would add to the country, in the order it would add it.
+	struct RecordingReportTarget {
+		using good_report_t = std::tuple<good_index_t, fixed_point_t>;
+		using pop_type_report_t = std::tuple<pop_type_index_t, good_index_t, fixed_point_t>;
+		using production_type_report_t = std::tuple<ProductionType const*, good_index_t, fixed_point_t>;
+
+		std::vector<good_report_t> pop_demand;
+		std::vector<good_report_t> factory_demand;
+		std::vector<pop_type_report_t> need_consumption;
+		std::vector<std::tuple<pop_type_index_t, fixed_point_t>> taxable_income;
+		std::vector<production_type_report_t> input_consumption;
+		std::vector<production_type_report_t> output;
+
+		void add_pop_demand(const good_index_t good_index, const fixed_point_t quantity) {
+			pop_demand.emplace_back(good_index, quantity);
+		}
+		void add_factory_demand(const good_index_t good_index, const fixed_point_t quantity) {
+			factory_demand.emplace_back(good_index, quantity);
+		}
+		void add_pop_need_consumption(
+			const pop_type_index_t pop_type_index,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		) {
+			need_consumption.emplace_back(pop_type_index, good_index, quantity);
+		}
+		void add_taxable_income(const pop_type_index_t pop_type_index, const fixed_point_t gross_income) {
+			taxable_income.emplace_back(pop_type_index, gross_income);
+		}
+		void add_input_consumption(
+			ProductionType const& production_type,
+			const good_index_t good_index,
+			const fixed_point_t quantity
+		) {
+			input_consumption.emplace_back(&production_type, good_index, quantity);
+		}
+		void add_output(ProductionType const& production_type, const good_index_t good_index, const fixed_point_t quantity) {
+			output.emplace_back(&production_type, good_index, quantity);
+		}
+	};
+}
+
+TEST_CASE("CountryReportBuffer accumulates per country", "[CountryReportBuffer]") {
+	const country_index_t country_count { 4 };
+	const good_index_t good_count { 3 };
+	const pop_type_index_t pop_type_count { 2 };
+	const country_index_t reporting_country { 2 };
+	const country_index_t silent_country { 1 };
+
+	CountryReportBuffer report_buffer;
+	report_buffer.set_sizes(country_count, good_count, pop_type_count);
+
+	report_buffer.report_pop_need_consumption(reporting_country, pop_type_index_t { 1 }, good_index_t { 2 }, 3);
+	report_buffer.report_pop_need_consumption(reporting_country, pop_type_index_t { 1 }, good_index_t { 2 }, 4);
+	report_buffer.report_pop_demand(reporting_country, good_index_t { 0 }, 5);
+	report_buffer.report_factory_demand(reporting_country, good_index_t { 1 }, 6);
+	report_buffer.report_taxable_income(reporting_country, pop_type_index_t { 0 }, 10);
+	report_buffer.report_taxable_income(reporting_country, pop_type_index_t { 0 }, 20);
+
+	CHECK(report_buffer.get_reports_nullable(silent_country) == nullptr);
+	CountryReportBuffer::country_reports_t const* reports = report_buffer.get_reports_nullable(reporting_country);
+	REQUIRE(reports != nullptr);
+	CHECK(reports->need_consumption_per_good_and_pop_type[2 * 2 + 1] == 7);
+	CHECK(reports->pop_demand_per_good[0] == 5);
+	CHECK(reports->factory_demand_per_good[1] == 6);
+	CHECK(reports->taxable_income_per_pop_type[0] == 30);
+	CHECK(reports->reported_good_indices == memory::vector<good_index_t> { good_index_t { 2 }, good_index_t { 0 }, good_index_t { 1 } });
+
+	const std::span<const country_index_t> countries_with_reports = report_buffer.get_countries_with_reports();
+	REQUIRE(countries_with_reports.size() == 1);
+	CHECK(countries_with_reports[0] == reporting_country);
+
+	RecordingReportTarget report_target;
+	report_buffer.fold_reports_into(reporting_country, report_target);
+	report_buffer.reset();
+	CHECK(report_buffer.get_reports_nullable(reporting_country) == nullptr);
+	CHECK(report_buffer.get_countries_with_reports().empty());
+
+	//reused reports start from zero
+	report_buffer.report_pop_demand(silent_country, good_index_t { 0 }, 1);
+	reports = report_buffer.get_reports_nullable(silent_country);
+	REQUIRE(reports != nullptr);
+	CHECK(reports->pop_demand_per_good[0] == 1);
+	CHECK(reports->factory_demand_per_good[1] == 0);
+	CHECK(reports->need_consumption_per_good_and_pop_type[2 * 2 + 1] == 0);
+	CHECK(reports->taxable_income_per_pop_type[0] == 0);
+	CHECK(reports->reported_good_indices == memory::vector<good_index_t> { good_index_t { 0 } });
+}
+
+TEST_CASE("CountryReportBuffer folds only the reported entries in bundle order", "[CountryReportBuffer]") {
+	const country_index_t country_count { 3 };
+	const good_index_t good_count { 4 };
+	const pop_type_index_t pop_type_count { 3 };
+	const country_index_t folding_country { 0 };
+	const country_index_t other_country { 2 };
+
+	const GameRulesManager game_rules_manager {};
+	const GoodCategory good_category { "test_good_category", good_category_index_t { 0 } };
+	const GoodDefinition output_good {
+		"test_good", colour_rgb_t {}, good_index_t { 1 }, good_category, 1, true, true, false, false
+	};
+	const ProductionType artisan_production_type {
+		game_rules_manager,
+		"test_artisan",
+		std::nullopt,
+		{},
+		ProductionType::template_type_t::ARTISAN,
+		pop_size_t { std::int32_t { 1 } },
+		{},
+		output_good,
+		1,
+		{},
+		{},
+		false,
+		false,
+		false
+	};
+	ProductionType const* const production_type = &artisan_production_type;
+
+	std::array<CountryReportBuffer, 2> bundle_report_buffers;
+	for (CountryReportBuffer& report_buffer : bundle_report_buffers) {
+		report_buffer.set_sizes(country_count, good_count, pop_type_count);
+	}
+	CountryReportBuffer& first_bundle = bundle_report_buffers[0];
+	CountryReportBuffer& second_bundle = bundle_report_buffers[1];
+
+	second_bundle.report_pop_need_consumption(folding_country, pop_type_index_t { 2 }, good_index_t { 1 }, 1);
+	second_bundle.report_output(folding_country, *production_type, good_index_t { 1 }, 2);
+	first_bundle.report_pop_demand(folding_country, good_index_t { 3 }, 3);
+	first_bundle.report_pop_need_consumption(folding_country, pop_type_index_t { 1 }, good_index_t { 3 }, 4);
+	first_bundle.report_pop_need_consumption(folding_country, pop_type_index_t { 0 }, good_index_t { 3 }, 5);
+	first_bundle.report_factory_demand(folding_country, good_index_t { 0 }, 6);
+	first_bundle.report_input_consumption(folding_country, *production_type, good_index_t { 0 }, 7);
+	first_bundle.report_input_consumption(folding_country, *production_type, good_index_t { 0 }, 8);
+	first_bundle.report_taxable_income(folding_country, pop_type_index_t { 2 }, 9);
+	second_bundle.report_taxable_income(folding_country, pop_type_index_t { 2 }, 10);
+	//reports which cancel out are skipped
+	first_bundle.report_pop_demand(folding_country, good_index_t { 2 }, 11);
+	first_bundle.report_pop_demand(folding_country, good_index_t { 2 }, -11);
+	second_bundle.report_pop_demand(other_country, good_index_t { 0 }, 12);
+
+	//the same order CountryInstance::fold_reports_from uses, regardless of which bundle reported first
+	RecordingReportTarget report_target;
+	for (CountryReportBuffer& report_buffer : bundle_report_buffers) {
+		report_buffer.fold_reports_into(folding_country, report_target);
+	}
+
+	using good_report_t = RecordingReportTarget::good_report_t;
+	using pop_type_report_t = RecordingReportTarget::pop_type_report_t;
+	using production_type_report_t = RecordingReportTarget::production_type_report_t;
+	CHECK(report_target.pop_demand == std::vector<good_report_t> { { good_index_t { 3 }, 3 } });
+	CHECK(report_target.factory_demand == std::vector<good_report_t> { { good_index_t { 0 }, 6 } });
+	CHECK(report_target.need_consumption == std::vector<pop_type_report_t> {
+		{ pop_type_index_t { 0 }, good_index_t { 3 }, 5 },
+		{ pop_type_index_t { 1 }, good_index_t { 3 }, 4 },
+		{ pop_type_index_t { 2 }, good_index_t { 1 }, 1 }
+	});
+	CHECK(report_target.taxable_income == std::vector<std::tuple<pop_type_index_t, fixed_point_t>> {
+		{ pop_type_index_t { 2 }, 9 },
+		{ pop_type_index_t { 2 }, 10 }
+	});
+	CHECK(report_target.input_consumption == std::vector<production_type_report_t> {
+		{ production_type, good_index_t { 0 }, 7 },
+		{ production_type, good_index_t { 0 }, 8 }
+	});
+	CHECK(report_target.output == std::vector<production_type_report_t> { { production_type, good_index_t { 1 }, 2 } });
+
+	//folding clears the country's reports without touching other countries
+	for (CountryReportBuffer const& report_buffer : bundle_report_buffers) {
+		CHECK(report_buffer.get_reports_nullable(folding_country) == nullptr);
+	}
+	CHECK(second_bundle.get_reports_nullable(other_country) != nullptr);
+
+	RecordingReportTarget second_fold_target;
+	first_bundle.fold_reports_into(folding_country, second_fold_target);
+	CHECK(second_fold_target.pop_demand.empty());
+	CHECK(second_fold_target.taxable_income.empty());
+	CHECK(second_fold_target.input_consumption.empty());
+
+	second_bundle.fold_reports_into(other_country, second_fold_target);
+	CHECK(second_fold_target.pop_demand == std::vector<good_report_t> { { good_index_t { 0 }, 12 } });
+	for (CountryReportBuffer& report_buffer : bundle_report_buffers) {
+		report_buffer.reset();
+	}
+
+	//folded reports are zeroed for reuse
+	first_bundle.report_factory_demand(other_country, good_index_t { 1 }, 13);
+	CountryReportBuffer::country_reports_t const* const reused_reports = first_bundle.get_reports_nullable(other_country);
+	REQUIRE(reused_reports != nullptr);
+	for (const fixed_point_t consumed_quantity : reused_reports->need_consumption_per_good_and_pop_type) {
+		CHECK(consumed_quantity == 0);
+	}
+	CHECK(reused_reports->pop_demand_per_good[3] == 0);
+	CHECK(reused_reports->factory_demand_per_good[0] == 0);
+	CHECK(reused_reports->taxable_income_per_pop_type[2] == 0);
+	CHECK(reused_reports->input_consumption_reports.empty());
+	CHECK(reused_reports->reported_good_indices == memory::vector<good_index_t> { good_index_t { 1 } });
+}
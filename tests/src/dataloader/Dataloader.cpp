@@ -0,0 +1,55 @@
+#include "openvic-simulation/dataloader/Dataloader.hpp"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+static void write_test_file(fs::path const& path) {
+	fs::create_directories(path.parent_path());
+	std::ofstream { path } << "test";
+}
+
+TEST_CASE("Dataloader path index lookups", "[Dataloader]") {
+	const fs::path test_root = fs::temp_directory_path() / "openvic_dataloader_path_index_test";
+	std::error_code ec;
+	fs::remove_all(test_root, ec);
+
+	const fs::path base_root = test_root / "base";
+	const fs::path mod_root = test_root / "mod";
+	write_test_file(base_root / "common" / "goods.txt");
+	write_test_file(base_root / "common" / "Defines.lua");
+	write_test_file(base_root / "history" / "pops" / "1836.1.1" / "france.txt");
+	write_test_file(base_root / "events" / "a.txt");
+	write_test_file(base_root / "events" / "nested" / "b.txt");
+	write_test_file(mod_root / "common" / "goods.txt");
+	write_test_file(mod_root / "history" / "pops" / "1836.1.1" / "england.txt");
+	write_test_file(mod_root / "events" / "c.txt");
+
+	const std::array<fs::path, 2> roots { base_root, mod_root };
+	const std::array<fs::path, 1> replace_paths { "history/pops" };
+
+	Dataloader dataloader;
+	REQUIRE(dataloader.set_roots(roots, replace_paths));
+
+	CHECK(dataloader.lookup_file("common/goods.txt") == mod_root / "common" / "goods.txt");
+	CHECK(dataloader.lookup_file("/common/defines.lua") == base_root / "common" / "Defines.lua");
+	CHECK(dataloader.lookup_file("COMMON/Goods.TXT") == mod_root / "common" / "goods.txt");
+	CHECK(dataloader.lookup_file("events\\nested\\B.txt") == base_root / "events" / "nested" / "b.txt");
+	CHECK(dataloader.lookup_file("history/pops/1836.1.1/france.txt", false).empty());
+	CHECK(dataloader.lookup_file("common/missing.txt", false).empty());
+
+	CHECK(dataloader.lookup_files_in_dir("history/pops/1836.1.1", ".txt").size() == 1);
+	CHECK(dataloader.lookup_files_in_dir("events", ".txt").size() == 2);
+	CHECK(dataloader.lookup_files_in_dir_recursive("events", ".txt").size() == 3);
+	CHECK(dataloader.lookup_files_in_dir("common", ".txt").size() == 1);
+	CHECK(dataloader.lookup_dirs_in_dir("history/pops").size() == 1);
+
+	fs::remove_all(test_root, ec);
+}
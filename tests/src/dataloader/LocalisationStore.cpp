@@ -0,0 +1,56 @@
+#include "openvic-simulation/dataloader/LocalisationStore.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+TEST_CASE("LocalisationStore lets later files override earlier ones", "[LocalisationStore]") {
+	using enum Dataloader::locale_t;
+
+	memory::vector<memory::vector<LocalisationStore::source_entry_t>> file_entries {
+		{
+			{ "GREETING", English, "Hello" },
+			{ "GREETING", French, "Hello" },
+			{ "FAREWELL", English, "Goodbye" }
+		},
+		{
+			{ "GREETING", English, "Overridden" },
+			{ "GREETING", German, "Hallo" },
+			{ "FAREWELL", French, "Goodbye" }
+		}
+	};
+
+	LocalisationStore store;
+	store.build(file_entries);
+	file_entries.clear();
+
+	CHECK(store.get_key_count() == 2);
+	CHECK(store.get_entry_count() == 5);
+	// "Goodbye" is shared between locales
+	CHECK(store.get_arena_size() == std::string_view { "GREETINGOverriddenHelloHalloFAREWELLGoodbye" }.size());
+	CHECK(store.has_key("GREETING"));
+	CHECK_FALSE(store.has_key("MISSING"));
+	// Later files override earlier ones
+	CHECK(store.get_localisation("GREETING", English) == "Overridden");
+	CHECK(store.get_localisation("GREETING", French) == "Hello");
+	CHECK(store.get_localisation("GREETING", German) == "Hallo");
+	CHECK(store.get_localisation("GREETING", Spanish).empty());
+	CHECK(store.get_localisation("FAREWELL", English) == "Goodbye");
+	CHECK(store.get_localisation("FAREWELL", French) == "Goodbye");
+
+	size_t callback_count = 0;
+	Dataloader::localisation_callback_t callback = [&callback_count](
+		std::string_view key, Dataloader::locale_t locale, std::string_view entry
+	) -> bool {
+		++callback_count;
+		return !key.empty() && !entry.empty();
+	};
+	CHECK(store.for_each_entry(callback));
+	CHECK(callback_count == store.get_entry_count());
+}
@@ -1,12 +1,16 @@
 #include "openvic-simulation/economy/GoodDefinition.hpp"
 #include "openvic-simulation/economy/trading/GoodMarket.hpp"
+#include "openvic-simulation/economy/trading/MarketOrderBuffer.hpp"
 
+#include <algorithm>
 #include <optional>
+#include <vector>
 
-#include "openvic-simulation/core/stl/containers/TypedSpan.hpp"
+#include "openvic-simulation/country/CountryReportBuffer.hpp"
 #include "openvic-simulation/misc/GameRulesManager.hpp"
 #include "openvic-simulation/types/Colour.hpp"
 #include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/types/fixed_point/Math.hpp"
 #include "openvic-simulation/types/TypedIndices.hpp"
 
 #include <snitch/snitch_macros_check.hpp>
@@ -33,6 +37,18 @@ GoodDefinition good_definition {
 	is_not_money,
 	does_not_counter_overseas_penalty
 };
+constexpr bool is_available_from_start = true;
+GoodDefinition available_good_definition {
+	"test_available_good",
+	colour_rgb_t {},
+	good_index_t{1},
+	good_category,
+	base_price,
+	is_available_from_start,
+	is_tradeable,
+	is_not_money,
+	does_not_counter_overseas_penalty
+};
 GameRulesManager game_rules_manager {};
 
 struct Trader {
@@ -48,9 +64,16 @@ public:
 		FAIL("Did not expect sell callback");
 	};
 
-	static void after_buy(void* actor, BuyResult const& buy_result) {
+	static void after_buy(void* actor, BuyResult const& buy_result, CountryReportBuffer& country_report_buffer) {
+		static_cast<Trader*>(actor)->buy_callback(buy_result);
 	}
-	static void after_sell(void* actor, SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector) {
+	static void after_sell(
+		void* actor,
+		SellResult const& sell_result,
+		CountryReportBuffer& country_report_buffer,
+		memory::vector<fixed_point_t>& reusable_vector
+	) {
+		static_cast<Trader*>(actor)->sell_callback(sell_result, reusable_vector);
 	}
 };
 
@@ -58,48 +81,437 @@ TEST_CASE("GoodMarket no trading when good isn't available", "[GoodMarket]") {
 	GoodMarket good_market { game_rules_manager, good_definition };
 	const std::optional<country_index_t> country_index_optional = std::nullopt;
 
-	Trader buyer {
-		.buy_callback=[](BuyResult const& buy_result) -> void {
-			CHECK(buy_result.good_index == good_definition.index);
-			CHECK(buy_result.quantity_bought == 0);
-			CHECK(buy_result.money_spent_total == 0);
-			CHECK(buy_result.money_spent_on_imports == 0);
-		}
-	};
+	Trader trader {};
 	const fixed_point_t quantity_to_buy = 1;
 	const fixed_point_t money_to_spend = quantity_to_buy * good_market.get_max_next_price();
 	good_market.add_buy_up_to_order({
 		country_index_optional,
 		quantity_to_buy,
 		money_to_spend,
-		&buyer,
+		&trader,
 		Trader::after_buy
 	});
 
-	Trader seller {
-		.sell_callback=[](SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector) -> void {
-			CHECK(sell_result.good_index == good_definition.index);
-			CHECK(sell_result.quantity_sold == 0);
-			CHECK(sell_result.money_gained == 0);
-		}
-	};
 	const fixed_point_t quantity_to_sell = 1;
 	good_market.add_market_sell_order({
 		country_index_optional,
 		quantity_to_sell,
-		&seller,
+		&trader,
 		Trader::after_sell
 	});
 
-	TypedSpan<country_index_t, fixed_point_t> reusable_country_map_0 {};
-	TypedSpan<country_index_t, fixed_point_t> reusable_country_map_1 {};
 	std::array<memory::vector<fixed_point_t>, GoodMarket::VECTORS_FOR_EXECUTE_ORDERS> reusable_vectors;
-	good_market.execute_orders(
-		reusable_country_map_0,
-		reusable_country_map_1,
-		reusable_vectors
-	);
+	good_market.execute_orders(reusable_vectors);
 
 	CHECK(good_market.get_price() == base_price);
 	CHECK(good_market.get_price_change_yesterday() == 0);
-}
\ No newline at end of file
+
+	REQUIRE(good_market.get_buy_results().size() == 1);
+	BuyResult const& buy_result = good_market.get_buy_results()[0];
+	CHECK(buy_result.good_index == good_definition.index);
+	CHECK(buy_result.quantity_bought == 0);
+	CHECK(buy_result.money_spent_total == 0);
+	CHECK(buy_result.money_spent_on_imports == 0);
+
+	REQUIRE(good_market.get_sell_results().size() == 1);
+	SellResult const& sell_result = good_market.get_sell_results()[0];
+	CHECK(sell_result.good_index == good_definition.index);
+	CHECK(sell_result.quantity_sold == 0);
+	CHECK(sell_result.money_gained == 0);
+}
+
+TEST_CASE("MarketOrderBuffer applies results in placement order", "[GoodMarket]") {
+	GoodMarket good_market { game_rules_manager, available_good_definition };
+	const std::optional<country_index_t> country_index_optional = std::nullopt;
+	const good_index_t good_count { 2 };
+	const good_index_t good_index = available_good_definition.index;
+
+	std::vector<char> applied_trades;
+	Trader trader {
+		.buy_callback=[&applied_trades](BuyResult const& buy_result) -> void {
+			CHECK(buy_result.quantity_bought == 1);
+			applied_trades.push_back('b');
+		},
+		.sell_callback=[&applied_trades](SellResult const& sell_result, memory::vector<fixed_point_t>& reusable_vector) -> void {
+			CHECK(sell_result.quantity_sold == 1);
+			applied_trades.push_back('s');
+		}
+	};
+	std::array<MarketOrderBuffer, 2> order_buffers;
+	for (MarketOrderBuffer& order_buffer : order_buffers) {
+		order_buffer.set_good_count(good_count);
+		order_buffer.add_market_sell_order(good_index, {
+			country_index_optional,
+			1,
+			&trader,
+			Trader::after_sell
+		});
+		order_buffer.add_buy_up_to_order(good_index, {
+			country_index_optional,
+			1,
+			good_market.get_max_next_price(),
+			&trader,
+			Trader::after_buy
+		});
+	}
+
+	for (MarketOrderBuffer& order_buffer : order_buffers) {
+		good_market.take_orders_from(order_buffer);
+	}
+	std::array<memory::vector<fixed_point_t>, GoodMarket::VECTORS_FOR_EXECUTE_ORDERS> reusable_vectors;
+	good_market.execute_orders(reusable_vectors);
+	CHECK(good_market.get_buy_results().size() == 2);
+	CHECK(good_market.get_sell_results().size() == 2);
+
+	CountryReportBuffer country_report_buffer;
+	for (MarketOrderBuffer& order_buffer : order_buffers) {
+		order_buffer.apply_results(
+			[&good_market](const good_index_t) -> GoodMarket const& {
+				return good_market;
+			},
+			country_report_buffer,
+			reusable_vectors[0]
+		);
+		CHECK(order_buffer.get_buy_up_to_orders(good_index).empty());
+		CHECK(order_buffer.get_market_sell_orders(good_index).empty());
+	}
+	CHECK(applied_trades == std::vector<char> { 's', 'b', 's', 'b' });
+}
+
+TEST_CASE("GoodMarket take_orders_from merges buffers in the order they are taken", "[GoodMarket]") {
+	const std::optional<country_index_t> country_index_optional = std::nullopt;
+	const good_index_t good_count { 2 };
+	const good_index_t good_index = available_good_definition.index;
+
+	//buffer i buys (i + 1) units and sells (i + 1) units, so supply covers demand exactly
+	//and every buyer's result quantity identifies which buffer its order came from
+	Trader trader {};
+	std::array<MarketOrderBuffer, 2> order_buffers;
+	for (size_t i = 0; i < order_buffers.size(); i++) {
+		const fixed_point_t quantity = static_cast<int32_t>(i + 1);
+		MarketOrderBuffer& order_buffer = order_buffers[i];
+		order_buffer.set_good_count(good_count);
+		order_buffer.add_buy_up_to_order(good_index, {
+			country_index_optional,
+			quantity,
+			quantity * base_price * 2,
+			&trader,
+			Trader::after_buy
+		});
+		order_buffer.add_market_sell_order(good_index, {
+			country_index_optional,
+			quantity,
+			&trader,
+			Trader::after_sell
+		});
+	}
+
+	const auto merged_buy_quantities = [&](const bool reversed) -> std::vector<fixed_point_t> {
+		GoodMarket good_market { game_rules_manager, available_good_definition };
+		if (reversed) {
+			good_market.take_orders_from(order_buffers[1]);
+			good_market.take_orders_from(order_buffers[0]);
+		} else {
+			good_market.take_orders_from(order_buffers[0]);
+			good_market.take_orders_from(order_buffers[1]);
+		}
+		std::array<memory::vector<fixed_point_t>, GoodMarket::VECTORS_FOR_EXECUTE_ORDERS> reusable_vectors;
+		good_market.execute_orders(reusable_vectors);
+
+		std::vector<fixed_point_t> quantities;
+		for (BuyResult const& buy_result : good_market.get_buy_results()) {
+			quantities.push_back(buy_result.quantity_bought);
+		}
+		return quantities;
+	};
+
+	//results are indexed by merged order position, which follows the take order, not the buffer index
+	CHECK(merged_buy_quantities(false) == std::vector<fixed_point_t> { 1, 2 });
+	CHECK(merged_buy_quantities(true) == std::vector<fixed_point_t> { 2, 1 });
+
+	//taking orders leaves them in the buffer until apply_results, so both merges saw both buffers
+	CHECK(order_buffers[0].get_buy_up_to_orders(good_index).size() == 1);
+	CHECK(order_buffers[1].get_buy_up_to_orders(good_index).size() == 1);
+}
+
+struct BuyerSetup {
+	fixed_point_t max_quantity;
+	fixed_point_t money_to_spend;
+};
+
+//mirrors the original per-buyer rescan in GoodMarket::execute_orders
+static std::vector<fixed_point_t> distribute_supply_by_rescanning(
+	std::vector<BuyerSetup> const& buyers,
+	const fixed_point_t max_next_price,
+	fixed_point_t remaining_supply
+) {
+	std::vector<fixed_point_t> purchasing_power_per_order(buyers.size());
+	fixed_point_t purchasing_power_sum = 0;
+	for (size_t i = 0; i < buyers.size(); i++) {
+		const fixed_point_t purchasing_power = purchasing_power_per_order[i] = buyers[i].money_to_spend / max_next_price;
+		purchasing_power_sum += std::min(purchasing_power, buyers[i].max_quantity);
+	}
+
+	std::vector<fixed_point_t> quantity_bought_per_order(buyers.size());
+	bool someone_bought_max_quantity;
+	do {
+		someone_bought_max_quantity = false;
+		for (size_t i = 0; i < buyers.size(); i++) {
+			const fixed_point_t max_quantity = buyers[i].max_quantity;
+			fixed_point_t& distributed_supply = quantity_bought_per_order[i];
+			if (distributed_supply == max_quantity) {
+				continue;
+			}
+
+			distributed_supply = fp::mul_div(remaining_supply, purchasing_power_per_order[i], purchasing_power_sum);
+			if (distributed_supply >= max_quantity) {
+				someone_bought_max_quantity = true;
+				distributed_supply = max_quantity;
+				remaining_supply -= max_quantity;
+				purchasing_power_sum -= purchasing_power_per_order[i];
+				break;
+			}
+		}
+	} while (someone_bought_max_quantity);
+	return quantity_bought_per_order;
+}
+
+TEST_CASE("GoodMarket water-filling matches rescanning", "[GoodMarket]") {
+	const std::optional<country_index_t> country_index_optional = std::nullopt;
+
+	for (const size_t buyer_count : { 1, 2, 7, 64, 301 }) {
+		GoodMarket good_market { game_rules_manager, available_good_definition };
+		const fixed_point_t max_next_price = good_market.get_max_next_price();
+
+		std::vector<BuyerSetup> buyer_setups;
+		fixed_point_t max_quantity_to_buy_sum = 0;
+		for (size_t i = 0; i < buyer_count; i++) {
+			const fixed_point_t max_quantity = fixed_point_t(1 + static_cast<int32_t>((i * 5) % 9));
+			//even buyers can afford a bit more than max_quantity, odd ones only a fraction of it
+			const fixed_point_t money_to_spend = i % 2 == 0
+				? max_quantity * max_next_price * (100 + static_cast<int32_t>(1 + (i * 7) % 20)) / 100
+				: max_quantity * max_next_price * static_cast<int32_t>(10 + (i * 13) % 81) / 100;
+			buyer_setups.push_back({ max_quantity, money_to_spend });
+			max_quantity_to_buy_sum += std::min(money_to_spend / max_next_price, max_quantity);
+		}
+		const fixed_point_t supply = max_quantity_to_buy_sum * 9 / 10;
+		const std::vector<fixed_point_t> expected_quantities = distribute_supply_by_rescanning(
+			buyer_setups, max_next_price, supply
+		);
+
+		Trader trader {};
+		for (size_t i = 0; i < buyer_count; i++) {
+			good_market.add_buy_up_to_order({
+				country_index_optional,
+				buyer_setups[i].max_quantity,
+				buyer_setups[i].money_to_spend,
+				&trader,
+				Trader::after_buy
+			});
+		}
+
+		good_market.add_market_sell_order({
+			country_index_optional,
+			supply,
+			&trader,
+			Trader::after_sell
+		});
+
+		std::array<memory::vector<fixed_point_t>, GoodMarket::VECTORS_FOR_EXECUTE_ORDERS> reusable_vectors;
+		good_market.execute_orders(reusable_vectors);
+
+		CHECK(good_market.get_price() == max_next_price);
+		REQUIRE(good_market.get_buy_results().size() == buyer_count);
+		for (size_t i = 0; i < buyer_count; i++) {
+			CHECK(good_market.get_buy_results()[i].quantity_bought == expected_quantities[i]);
+		}
+	}
+}
+
+//mirrors the original optimal-pricing sweep in GoodMarket::execute_orders, which rescanned every buyer per price step
+static fixed_point_t find_optimal_price_by_rescanning(
+	std::vector<BuyerSetup> const& buyers,
+	const fixed_point_t price,
+	const fixed_point_t max_next_price,
+	fixed_point_t min_next_price,
+	fixed_point_t remaining_supply
+) {
+	fixed_point_t money_left_to_spend_sum = 0;
+	for (BuyerSetup const& buyer : buyers) {
+		min_next_price = std::max(min_next_price, buyer.money_to_spend / buyer.max_quantity);
+		money_left_to_spend_sum += buyer.money_to_spend / max_next_price >= buyer.max_quantity
+			? buyer.max_quantity * max_next_price
+			: buyer.money_to_spend;
+	}
+
+	std::vector<bool> bought_max_quantity(buyers.size(), false);
+	fixed_point_t new_price = price;
+	while (remaining_supply > 0) {
+		const fixed_point_t possible_price = money_left_to_spend_sum / remaining_supply;
+		if (possible_price >= new_price) {
+			break;
+		}
+		if (possible_price < min_next_price) {
+			new_price = min_next_price;
+			break;
+		}
+		new_price = possible_price;
+
+		for (size_t i = 0; i < buyers.size(); i++) {
+			if (bought_max_quantity[i] || buyers[i].money_to_spend < new_price * buyers[i].max_quantity) {
+				continue;
+			}
+			bought_max_quantity[i] = true;
+			remaining_supply -= buyers[i].max_quantity;
+			money_left_to_spend_sum -= buyers[i].money_to_spend;
+		}
+	}
+	return new_price;
+}
+
+TEST_CASE("GoodMarket optimal pricing drops price until supply clears", "[GoodMarket]") {
+	const std::optional<country_index_t> country_index_optional = std::nullopt;
+	GameRulesManager optimal_pricing_rules {};
+	optimal_pricing_rules.use_recommended_rules();
+	REQUIRE(optimal_pricing_rules.get_use_optimal_pricing());
+
+	//no buyer can afford max_quantity, so every step of the sweep is money_left_to_spend_sum / supply
+	std::vector<BuyerSetup> buyer_setups;
+	fixed_point_t money_to_spend_sum = 0;
+	for (int32_t i = 0; i < 5; i++) {
+		const fixed_point_t money_to_spend = base_price * 3 * (i + 1);
+		buyer_setups.push_back({ fixed_point_t(1000 + i), money_to_spend });
+		money_to_spend_sum += money_to_spend;
+	}
+
+	enum struct expected_stop_t { AT_PRICE, BETWEEN_LIMITS, AT_MIN_NEXT_PRICE };
+	struct SweepSetup {
+		std::vector<BuyerSetup> buyers;
+		fixed_point_t supply;
+		expected_stop_t expected_stop;
+	};
+
+	//this buyer can afford max_quantity just below price, which raises the floor the sweep stops at
+	std::vector<BuyerSetup> buyer_setups_with_floor = buyer_setups;
+	buyer_setups_with_floor.push_back({ 1, base_price - base_price / 512 });
+
+	for (SweepSetup const& sweep_setup : {
+		//clearing price is above price but below max_next_price, so the sweep never starts
+		SweepSetup { buyer_setups, money_to_spend_sum / (base_price + base_price / 512), expected_stop_t::AT_PRICE },
+		//clearing price lies between min_next_price and price
+		SweepSetup { buyer_setups, money_to_spend_sum / (base_price - base_price / 256), expected_stop_t::BETWEEN_LIMITS },
+		//clearing price is below min_next_price
+		SweepSetup { buyer_setups, money_to_spend_sum / (base_price / 2), expected_stop_t::AT_MIN_NEXT_PRICE },
+		SweepSetup { buyer_setups_with_floor, money_to_spend_sum, expected_stop_t::AT_MIN_NEXT_PRICE }
+	}) {
+		GoodMarket good_market { optimal_pricing_rules, available_good_definition };
+		const fixed_point_t price = good_market.get_price();
+		const fixed_point_t max_next_price = good_market.get_max_next_price();
+		const fixed_point_t min_next_price = good_market.get_min_next_price();
+		REQUIRE(min_next_price < price);
+
+		fixed_point_t max_quantity_to_buy_sum = 0;
+		fixed_point_t raised_min_next_price = min_next_price;
+		for (BuyerSetup const& buyer : sweep_setup.buyers) {
+			max_quantity_to_buy_sum += std::min(buyer.money_to_spend / max_next_price, buyer.max_quantity);
+			raised_min_next_price = std::max(raised_min_next_price, buyer.money_to_spend / buyer.max_quantity);
+		}
+		//otherwise execute_orders sells for max_next_price and skips the sweep
+		REQUIRE(max_quantity_to_buy_sum < sweep_setup.supply);
+
+		const fixed_point_t expected_price = find_optimal_price_by_rescanning(
+			sweep_setup.buyers, price, max_next_price, min_next_price, sweep_setup.supply
+		);
+		switch (sweep_setup.expected_stop) {
+		case expected_stop_t::AT_PRICE:
+			CHECK(expected_price == price);
+			break;
+		case expected_stop_t::BETWEEN_LIMITS:
+			CHECK(expected_price < price);
+			CHECK(expected_price > raised_min_next_price);
+			CHECK(expected_price == money_to_spend_sum / sweep_setup.supply);
+			break;
+		case expected_stop_t::AT_MIN_NEXT_PRICE:
+			CHECK(expected_price == raised_min_next_price);
+			break;
+		}
+
+		Trader trader {};
+		for (BuyerSetup const& buyer : sweep_setup.buyers) {
+			good_market.add_buy_up_to_order({
+				country_index_optional,
+				buyer.max_quantity,
+				buyer.money_to_spend,
+				&trader,
+				Trader::after_buy
+			});
+		}
+
+		good_market.add_market_sell_order({
+			country_index_optional,
+			sweep_setup.supply,
+			&trader,
+			Trader::after_sell
+		});
+
+		std::array<memory::vector<fixed_point_t>, GoodMarket::VECTORS_FOR_EXECUTE_ORDERS> reusable_vectors;
+		good_market.execute_orders(reusable_vectors);
+
+		CHECK(good_market.get_price() == expected_price);
+		REQUIRE(good_market.get_buy_results().size() == sweep_setup.buyers.size());
+		for (size_t i = 0; i < sweep_setup.buyers.size(); i++) {
+			BuyerSetup const& buyer = sweep_setup.buyers[i];
+			CHECK(
+				good_market.get_buy_results()[i].quantity_bought
+				== std::min(buyer.max_quantity, buyer.money_to_spend / expected_price)
+			);
+		}
+	}
+}
+
+TEST_CASE("GoodMarket only imports what domestic supply can't cover", "[GoodMarket]") {
+	GoodMarket good_market { game_rules_manager, available_good_definition };
+	const fixed_point_t max_next_price = good_market.get_max_next_price();
+	const country_index_t exporting_country_index { 0 };
+	const country_index_t importing_country_index { 7 };
+
+	Trader trader {};
+	for (const country_index_t country_index : { exporting_country_index, importing_country_index }) {
+		good_market.add_buy_up_to_order({
+			country_index,
+			1,
+			max_next_price,
+			&trader,
+			Trader::after_buy
+		});
+	}
+
+	for (const std::optional<country_index_t> country_index_optional : {
+		std::optional { exporting_country_index },
+		std::optional<country_index_t> {}
+	}) {
+		good_market.add_market_sell_order({
+			country_index_optional,
+			1,
+			&trader,
+			Trader::after_sell
+		});
+	}
+
+	std::array<memory::vector<fixed_point_t>, GoodMarket::VECTORS_FOR_EXECUTE_ORDERS> reusable_vectors;
+	good_market.execute_orders(reusable_vectors);
+
+	CHECK(good_market.get_quantity_traded_yesterday() == 2);
+
+	REQUIRE(good_market.get_buy_results().size() == 2);
+	BuyResult const& domestic_buy_result = good_market.get_buy_results()[0];
+	CHECK(domestic_buy_result.quantity_bought == 1);
+	CHECK(domestic_buy_result.money_spent_on_imports == 0);
+	BuyResult const& importing_buy_result = good_market.get_buy_results()[1];
+	CHECK(importing_buy_result.quantity_bought == 1);
+	CHECK(importing_buy_result.money_spent_on_imports == importing_buy_result.money_spent_total);
+
+	for (SellResult const& sell_result : good_market.get_sell_results()) {
+		CHECK(sell_result.quantity_sold == 1);
+	}
+}
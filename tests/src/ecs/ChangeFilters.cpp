@@ -0,0 +1,335 @@
+#include "openvic-simulation/ecs/ChunkSystem.hpp"
+#include "openvic-simulation/ecs/ComponentTypeID.hpp"
+#include "openvic-simulation/ecs/EntityID.hpp"
+#include "openvic-simulation/ecs/QueryFilter.hpp"
+#include "openvic-simulation/ecs/SystemImpl.hpp"
+#include "openvic-simulation/ecs/SystemTypeID.hpp"
+#include "openvic-simulation/ecs/World.hpp"
+#include "openvic-simulation/types/Date.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic::ecs;
+using OpenVic::Date;
+
+// === Change-detection filters (`Filter<Changed<C>>`, `Filter<Added<C>>`). ===
+// A system's query skips chunks whose C column was not written (Changed) or that received
+// no rows (Added) since that system last ran. Granularity is the chunk: rows sharing a chunk
+// with a written row are visited too, so counts below are per chunk, not per row.
+
+namespace {
+	// ~500 bytes so a chunk holds ~31 rows and a few hundred entities span many chunks.
+	struct CfValue {
+		std::array<int64_t, 62> pad {};
+		int64_t v = 0;
+	};
+	struct CfHot {}; // tag: the archetype the bumpers write
+	struct CfOther {
+		int64_t v = 0;
+	};
+	struct CfSeen {
+		int64_t v = 0;
+	};
+	struct CfLink {
+		EntityID target;
+	};
+}
+ECS_COMPONENT(CfValue, "test_ChangeFilters::Value")
+ECS_COMPONENT(CfHot, "test_ChangeFilters::Hot")
+ECS_COMPONENT(CfOther, "test_ChangeFilters::Other")
+ECS_COMPONENT(CfSeen, "test_ChangeFilters::Seen")
+ECS_COMPONENT(CfLink, "test_ChangeFilters::Link")
+
+namespace {
+	// Rows visited by the watcher systems below; reset before each tick.
+	std::atomic<int64_t> g_cf_visited { 0 };
+
+	// Writes CfValue on the CfHot archetype only — every other chunk stays untouched.
+	struct CfBumpHot : System<CfBumpHot> {
+		void tick(TickContext const& /*ctx*/, CfValue& value, CfHot const& /*hot*/) {
+			value.v += 1;
+		}
+	};
+
+	struct CfWatchChanged : System<CfWatchChanged> {
+		using Filters = Filter<Changed<CfValue>>;
+		void tick(TickContext const& /*ctx*/, CfValue const& /*value*/) {
+			g_cf_visited.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+
+	struct CfWatchChangedThreaded : SystemThreaded<CfWatchChangedThreaded> {
+		using Filters = Filter<Changed<CfValue>>;
+		void tick(TickContext const& /*ctx*/, CfValue const& /*value*/) {
+			g_cf_visited.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+
+	struct CfWatchChangedChunk : ChunkSystem<CfWatchChangedChunk, CfValue const> {
+		using Filters = Filter<Changed<CfValue>>;
+		void tick_chunk(ChunkView<CfValue> view, TickContext const& /*ctx*/) {
+			g_cf_visited.fetch_add(static_cast<int64_t>(view.count()), std::memory_order_relaxed);
+		}
+	};
+
+	// Filters on the column it writes itself: its own stamps are never newer than its run.
+	struct CfSelfWriter : System<CfSelfWriter> {
+		using Filters = Filter<Changed<CfValue>>;
+		void tick(TickContext const& /*ctx*/, CfValue& value) {
+			g_cf_visited.fetch_add(1, std::memory_order_relaxed);
+			value.v += 1;
+		}
+	};
+
+	struct CfWatchAdded : System<CfWatchAdded> {
+		using Filters = Filter<Added<CfValue>>;
+		void tick(TickContext const& /*ctx*/, CfValue const& /*value*/) {
+			g_cf_visited.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+
+	// Writes CfValue on whatever entity the link points at — a write the driver cannot see,
+	// so it is declared through extra_writes.
+	struct CfLinkWriter : System<CfLinkWriter> {
+		void tick(TickContext const& ctx, CfLink const& link) {
+			if (CfValue* value = ctx.world.get_component<CfValue>(link.target); value != nullptr) {
+				value->v += 1;
+			}
+		}
+
+		static constexpr std::array<component_type_id_t, 1> extra_writes() {
+			return { component_type_id_of<CfValue>() };
+		}
+	};
+}
+ECS_SYSTEM(CfBumpHot)
+ECS_SYSTEM(CfWatchChanged)
+ECS_SYSTEM(CfWatchChangedThreaded)
+ECS_SYSTEM(CfWatchChangedChunk)
+ECS_SYSTEM(CfSelfWriter)
+ECS_SYSTEM(CfWatchAdded)
+ECS_SYSTEM(CfLinkWriter)
+
+namespace {
+	struct CfPopulation {
+		std::vector<EntityID> cold;
+		std::vector<EntityID> hot;
+	};
+
+	CfPopulation populate(World& world, std::size_t cold_count, std::size_t hot_count) {
+		CfPopulation pop;
+		for (std::size_t i = 0; i < cold_count; ++i) {
+			pop.cold.push_back(world.create_entity(CfValue {}));
+		}
+		for (std::size_t i = 0; i < hot_count; ++i) {
+			pop.hot.push_back(world.create_entity(CfValue {}, CfHot {}));
+		}
+		return pop;
+	}
+
+	int64_t tick_and_count(World& world) {
+		g_cf_visited.store(0, std::memory_order_relaxed);
+		world.tick_systems(Date {});
+		return g_cf_visited.load(std::memory_order_relaxed);
+	}
+
+	template<typename Watcher>
+	void check_changed_skips_untouched_chunks(uint32_t worker_count) {
+		World world;
+		world.set_ecs_worker_count(worker_count);
+		populate(world, 300, 40);
+		world.register_system<Watcher>();
+
+		// First run: everything was created after the watcher's (zero) last run.
+		CHECK(tick_and_count(world) == 340);
+		// Nothing written since.
+		CHECK(tick_and_count(world) == 0);
+
+		// A writer on the hot archetype only: the watcher sees its chunks and nothing else.
+		// The pair conflicts on CfValue with no declared edge, so the auto-orienter runs the
+		// lower system_type_id_t first (equal depth either way). Writer first: the watcher
+		// sees this tick's writes now. Watcher first: it sees them on its next run.
+		world.register_system<CfBumpHot>();
+		bool const writer_first = system_type_id_of<CfBumpHot>() < system_type_id_of<Watcher>();
+		CHECK(tick_and_count(world) == (writer_first ? 40 : 0));
+		for (int t = 0; t < 3; ++t) {
+			CHECK(tick_and_count(world) == 40);
+		}
+	}
+}
+
+TEST_CASE("Filter splits Changed / Added / Without ids", "[ecs][ChangeFilters]") {
+	using F = Filter<Changed<CfValue>, Added<CfOther>, Without<CfHot>>;
+	CHECK(F::changed_ids() == std::vector<component_type_id_t> { component_type_id_of<CfValue>() });
+	CHECK(F::added_ids() == std::vector<component_type_id_t> { component_type_id_of<CfOther>() });
+	CHECK(F::exclude_ids() == std::vector<component_type_id_t> { component_type_id_of<CfHot>() });
+	CHECK(F::require_ids().size() == 2u);
+}
+
+TEST_CASE("Changed<C> skips chunks untouched since the system last ran (serial)", "[ecs][ChangeFilters]") {
+	check_changed_skips_untouched_chunks<CfWatchChanged>(1);
+}
+
+TEST_CASE("Changed<C> skips chunks untouched since the system last ran (threaded)", "[ecs][ChangeFilters]") {
+	for (uint32_t wc : { 1u, 4u, 8u }) {
+		check_changed_skips_untouched_chunks<CfWatchChangedThreaded>(wc);
+	}
+}
+
+TEST_CASE("Changed<C> skips chunks untouched since the system last ran (ChunkSystem)", "[ecs][ChangeFilters]") {
+	check_changed_skips_untouched_chunks<CfWatchChangedChunk>(1);
+}
+
+TEST_CASE("Changed<C> system does not see its own writes", "[ecs][ChangeFilters]") {
+	World world;
+	populate(world, 100, 0);
+	world.register_system<CfSelfWriter>();
+
+	CHECK(tick_and_count(world) == 100);
+	CHECK(tick_and_count(world) == 0);
+	CHECK(tick_and_count(world) == 0);
+}
+
+TEST_CASE("Changed<C> sees out-of-tick mutable access at chunk granularity", "[ecs][ChangeFilters]") {
+	World world;
+	CfPopulation const pop = populate(world, 10, 0); // one chunk
+	world.register_system<CfWatchChanged>();
+	CHECK(tick_and_count(world) == 10);
+	CHECK(tick_and_count(world) == 0);
+
+	// Const access is not a write.
+	World const& const_world = world;
+	CHECK(const_world.get_component<CfValue>(pop.cold[3]) != nullptr);
+	CHECK(tick_and_count(world) == 0);
+
+	world.get_component<CfValue>(pop.cold[3])->v = 7;
+	CHECK(tick_and_count(world) == 10); // the whole chunk, not just the one row
+	CHECK(tick_and_count(world) == 0);
+
+	world.for_each<CfValue>([](CfValue& value) {
+		value.v += 1;
+	});
+	CHECK(tick_and_count(world) == 10);
+}
+
+TEST_CASE("Changed<C> sees writes declared through extra_writes", "[ecs][ChangeFilters]") {
+	World world;
+	CfPopulation const pop = populate(world, 60, 0);
+	world.create_entity(CfLink { pop.cold[0] });
+	world.register_system<CfWatchChanged>();
+	CHECK(tick_and_count(world) == 60);
+	CHECK(tick_and_count(world) == 0);
+
+	// The link writer can touch any CfValue row, so every CfValue chunk counts as written.
+	world.register_system<CfLinkWriter>();
+	CHECK(tick_and_count(world) == 60);
+	CHECK(tick_and_count(world) == 60);
+}
+
+TEST_CASE("Added<C> passes only chunks that received rows since the last run", "[ecs][ChangeFilters]") {
+	World world;
+	CfPopulation const pop = populate(world, 200, 0);
+	world.register_system<CfWatchAdded>();
+	CHECK(tick_and_count(world) == 200);
+	CHECK(tick_and_count(world) == 0);
+
+	// Writes are not additions.
+	world.get_component<CfValue>(pop.cold[5])->v = 1;
+	CHECK(tick_and_count(world) == 0);
+
+	// A new archetype's first chunk holds only the new row.
+	world.create_entity(CfValue {}, CfOther {});
+	CHECK(tick_and_count(world) == 1);
+
+	// Migration counts as entry into the destination; the row swapped into the vacated slot
+	// of the source came from a chunk that entered nothing new.
+	world.add_component(pop.cold[0], CfHot {});
+	CHECK(tick_and_count(world) == 1);
+	CHECK(tick_and_count(world) == 0);
+}
+
+namespace {
+	// Changed<C> reader interleaved with writers and structural commands, for the
+	// determinism gate: visited rows fold into CfSeen, which is digested afterwards.
+	struct CfFoldChanged : SystemThreaded<CfFoldChanged> {
+		using Filters = Filter<Changed<CfValue>>;
+		void tick(TickContext const& /*ctx*/, CfValue const& value, CfSeen& seen) {
+			seen.v = seen.v * 31 + value.v + 1;
+		}
+	};
+
+	struct CfSpawnHot : System<CfSpawnHot> {
+		void tick(TickContext const& ctx, CfOther& other) {
+			other.v += 1;
+			if (other.v % 3 == 0) {
+				ctx.cmd.create_entity(ctx.world, CfValue { {}, other.v }, CfSeen {}, CfHot {});
+			}
+		}
+	};
+}
+ECS_SYSTEM(CfFoldChanged)
+ECS_SYSTEM(CfSpawnHot)
+
+namespace {
+	struct CfBumpHotSeen : System<CfBumpHotSeen> {
+		void tick(TickContext const& /*ctx*/, CfValue& value, CfHot const& /*hot*/) {
+			value.v += 1;
+		}
+
+		static constexpr std::array<system_type_id_t, 1> declared_run_before() {
+			return { system_type_id_of<CfFoldChanged>() };
+		}
+	};
+}
+ECS_SYSTEM(CfBumpHotSeen)
+
+namespace {
+	int64_t run_change_scenario(uint32_t worker_count, bool dependency_mode) {
+		World world;
+		world.set_ecs_worker_count(worker_count);
+		world.set_dependency_mode(dependency_mode);
+
+		for (std::size_t i = 0; i < 240; ++i) {
+			if (i % 4 == 0) {
+				world.create_entity(CfValue { {}, static_cast<int64_t>(i) }, CfSeen {}, CfHot {});
+			} else {
+				world.create_entity(CfValue { {}, static_cast<int64_t>(i) }, CfSeen {});
+			}
+		}
+		for (std::size_t i = 0; i < 5; ++i) {
+			world.create_entity(CfOther { static_cast<int64_t>(i) });
+		}
+
+		world.register_system<CfFoldChanged>();
+		world.register_system<CfBumpHotSeen>();
+		world.register_system<CfSpawnHot>();
+
+		for (int t = 0; t < 8; ++t) {
+			world.tick_systems(Date {});
+		}
+
+		int64_t digest = 0;
+		world.for_each<CfValue, CfSeen>([&](CfValue& value, CfSeen& seen) {
+			digest = digest * 1000003 + value.v;
+			digest = digest * 1000003 + seen.v;
+		});
+		return digest;
+	}
+}
+
+TEST_CASE("Changed<C> dispatch is identical across worker counts", "[ecs][ChangeFilters][determinism]") {
+	// Each mode against its own baseline: the spawner has no DAG edge to the reader, so when
+	// its entities are applied relative to the reader legitimately differs between modes.
+	for (bool const dependency_mode : { false, true }) {
+		int64_t const baseline = run_change_scenario(1, dependency_mode);
+		for (uint32_t wc : { 2u, 4u, 8u, 16u }) {
+			CHECK(run_change_scenario(wc, dependency_mode) == baseline);
+		}
+	}
+}
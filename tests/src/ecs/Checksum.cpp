@@ -187,6 +187,15 @@ TEST_CASE("Breakdown total matches world_checksum and refolds from its entries",
 	CHECK(breakdown.singleton_entries.size() == 2u);
 }
 
+TEST_CASE("Reference world checksum has its pinned value", "[ecs][Checksum]") {
+	// Pinned so a change to the walk's fold order is always deliberate: digests from builds with
+	// different walks never compare equal. Last changed when each chunk's ids and columns became
+	// separate sub-hashes for WorldChecksumCache.
+	World world;
+	build_reference_world(world);
+	CHECK(world_checksum(world) == 0xabe6fb03fa81d64dULL);
+}
+
 // === (b) sensitivity ===
 
 TEST_CASE("Flipping a single component field changes the checksum", "[ecs][Checksum]") {
@@ -356,3 +365,95 @@ TEST_CASE("Full-state checksum is identical across worker counts and serial mode
 	uint64_t const serial = run_and_checksum(1, true, seeds, ticks);
 	CHECK(serial == baseline);
 }
+
+// === (d) cached checksum — must agree with the full walk after any mix of mutations ===
+
+namespace {
+	void check_cached_matches_full(World& world, WorldChecksumCache& cache) {
+		WorldChecksumBreakdown const full = world_checksum_breakdown(world);
+		WorldChecksumBreakdown const cached = world_checksum_breakdown(world, cache);
+		CHECK(cached.total == full.total);
+		REQUIRE(cached.archetype_entries.size() == full.archetype_entries.size());
+		for (std::size_t i = 0; i < full.archetype_entries.size(); ++i) {
+			CHECK(cached.archetype_entries[i].archetype_index == full.archetype_entries[i].archetype_index);
+			CHECK(cached.archetype_entries[i].hash == full.archetype_entries[i].hash);
+		}
+		CHECK(cached.singleton_entries.size() == full.singleton_entries.size());
+		CHECK(world_checksum(world, cache) == full.total);
+	}
+}
+
+TEST_CASE("Cached checksum equals the full walk across mutations and ticks", "[ecs][Checksum][cached]") {
+	World world;
+	build_reference_world(world);
+	WorldChecksumCache cache;
+	check_cached_matches_full(world, cache);
+
+	// Out-of-tick write, creation, tail and mid-chunk destruction, migration, singletons.
+	EntityID const extra = world.create_entity(CkValue { 7 });
+	check_cached_matches_full(world, cache);
+	world.get_component<CkValue>(extra)->v += 1;
+	check_cached_matches_full(world, cache);
+	world.destroy_entity(extra);
+	check_cached_matches_full(world, cache);
+
+	std::vector<EntityID> pairs;
+	world.for_each_with_entity<CkPair>([&](EntityID id, CkPair&) {
+		pairs.push_back(id);
+	});
+	REQUIRE(pairs.size() == 5u);
+	world.destroy_entity(pairs[1]);
+	check_cached_matches_full(world, cache);
+	world.add_component(pairs[2], CkTag {});
+	check_cached_matches_full(world, cache);
+	world.get_singleton<CkConfigA>()->v += 1;
+	check_cached_matches_full(world, cache);
+
+	// System writes, threaded spawns applied at the stage barrier.
+	for (std::size_t i = 0; i < 50; ++i) {
+		world.create_entity(CkSeed { static_cast<int64_t>(i + 1) }, CkValue { static_cast<int64_t>(i) });
+	}
+	world.register_system<CkSpawner>();
+	world.register_system<CkChurn>();
+	for (int t = 0; t < 4; ++t) {
+		world.tick_systems(Date {});
+		check_cached_matches_full(world, cache);
+	}
+}
+
+TEST_CASE("Cached checksum rehashes only chunks stamped since the last call", "[ecs][Checksum][cached]") {
+	World world;
+	build_reference_world(world);
+	EntityID const pair = world.create_entity(CkPair { 9, 9 }); // joins the CkPair chunk
+	WorldChecksumCache cache;
+
+	// First call fills everything; an untouched World rehashes nothing.
+	uint64_t const first = world_checksum(world, cache);
+	CHECK(cache.rehashed_last_call() > 0u);
+	CHECK(world_checksum(world, cache) == first);
+	CHECK(cache.rehashed_last_call() == 0u);
+
+	// Const access is not a write.
+	World const& const_world = world;
+	CHECK(const_world.get_component<CkPair>(pair) != nullptr);
+	CHECK(world_checksum(world, cache) == first);
+	CHECK(cache.rehashed_last_call() == 0u);
+
+	// One mutable access: one data column of one chunk.
+	world.get_component<CkPair>(pair)->a += 1;
+	CHECK(world_checksum(world, cache) != first);
+	CHECK(cache.rehashed_last_call() == 1u);
+	CHECK(world_checksum(world, cache) == world_checksum(world));
+
+	// Destroying the chunk's last row moves nothing — only the row count changes, which
+	// rehashes that chunk's ids and its one data column.
+	world.destroy_entity(pair);
+	CHECK(world_checksum(world, cache) == world_checksum(world));
+	CHECK(cache.rehashed_last_call() == 2u);
+
+	// clear() forces a full rehash with the same answer.
+	uint64_t const before_clear = world_checksum(world, cache);
+	cache.clear();
+	CHECK(world_checksum(world, cache) == before_clear);
+	CHECK(cache.rehashed_last_call() > 2u);
+}
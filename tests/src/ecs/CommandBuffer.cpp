@@ -5,8 +5,10 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <set>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -500,3 +502,157 @@ TEST_CASE("allocate_entity_slot generations stay below DEFERRED_GENERATION_BIT",
 		world.destroy_entity(eid);
 	}
 }
+
+// === Arena-backed payload storage ===
+
+namespace {
+	// Counts live instances (moved-from husks included) so tests can prove every queued
+	// payload is destroyed exactly once on each discard path.
+	struct CBCounted {
+		static inline int live = 0;
+		int v = 0;
+
+		CBCounted(int value) : v { value } {
+			++live;
+		}
+		CBCounted(CBCounted const& other) : v { other.v } {
+			++live;
+		}
+		CBCounted(CBCounted&& other) noexcept : v { other.v } {
+			++live;
+		}
+		CBCounted& operator=(CBCounted const&) = default;
+		CBCounted& operator=(CBCounted&&) noexcept = default;
+		~CBCounted() {
+			--live;
+		}
+	};
+	inline uint64_t ecs_checksum(CBCounted const& c, uint64_t seed) {
+		return fold_uint64(static_cast<uint64_t>(static_cast<uint32_t>(c.v)), seed);
+	}
+}
+
+ECS_COMPONENT(CBCounted, "test_CommandBuffer::CBCounted")
+
+TEST_CASE("Queued payloads are destroyed exactly once on every discard path",
+          "[ecs][CommandBuffer][arena]") {
+	CBCounted::live = 0;
+	{
+		World world;
+		EntityID const target = world.create_entity(CBA { 1 });
+
+		// clear() without applying.
+		{
+			CommandBuffer cmd;
+			cmd.create_entity(world, CBCounted { 1 }, CBA { 2 });
+			cmd.add_component(target, CBCounted { 3 });
+			cmd.clear();
+			CHECK(CBCounted::live == 0);
+		}
+
+		// Buffer dropped with ops still queued, including a bulk batch.
+		{
+			CommandBuffer cmd;
+			cmd.set_parallel_mode(true);
+			std::vector<CBCounted> values(8, CBCounted { 4 });
+			std::vector<EntityID> ids(values.size());
+			cmd.create_entities<CBCounted>(world, values.size(), ids, std::span<CBCounted>(values));
+			cmd.create_entity(world, CBCounted { 5 });
+			values.clear();
+		}
+		CHECK(CBCounted::live == 0);
+
+		// apply() skips an add onto a dead entity: its payload is still destroyed.
+		{
+			CommandBuffer cmd;
+			cmd.destroy_entity(target);
+			cmd.add_component(target, CBCounted { 6 });
+			cmd.apply(world);
+			CHECK(CBCounted::live == 0);
+		}
+
+		// Applied payloads move into the World; only the stored components stay alive.
+		{
+			CommandBuffer cmd;
+			cmd.create_entity(world, CBCounted { 7 });
+			cmd.create_entity(world, CBCounted { 8 }, CBTag {});
+			cmd.apply(world);
+			CHECK(CBCounted::live == 2);
+		}
+	}
+	CHECK(CBCounted::live == 0);
+}
+
+TEST_CASE("Payload arena is reused across apply cycles", "[ecs][CommandBuffer][arena]") {
+	World world;
+	CommandBuffer cmd;
+	std::size_t reserved_after_first = 0;
+	for (int cycle = 0; cycle < 5; ++cycle) {
+		cmd.set_parallel_mode(true);
+		for (int i = 0; i < 2000; ++i) {
+			EntityID const e = cmd.create_entity(world, CBA { i }, CBB { cycle });
+			if (i % 4 == 0) {
+				cmd.add_component(e, CBTag {});
+			}
+		}
+		cmd.set_parallel_mode(false);
+		cmd.apply(world);
+		CHECK(cmd.empty());
+		if (cycle == 0) {
+			reserved_after_first = cmd.reserved_payload_bytes();
+			CHECK(reserved_after_first > 0u);
+		} else {
+			CHECK(cmd.reserved_payload_bytes() == reserved_after_first);
+		}
+	}
+	std::size_t count = 0;
+	world.for_each<CBA, CBB>([&](CBA&, CBB&) {
+		++count;
+	});
+	CHECK(count == 10000u);
+}
+
+TEST_CASE("merge_from keeps payloads in place and the per-chunk footprint stable",
+          "[ecs][CommandBuffer][arena]") {
+	World world;
+	CommandBuffer pending;
+	std::vector<CommandBuffer> chunks(4);
+	// The first merge hands the per-chunk blocks to `pending` with nothing to give back, so
+	// the chunks allocate once more on the second cycle; from then on blocks only circulate.
+	std::size_t footprint_after_warmup = 0;
+	for (int cycle = 0; cycle < 5; ++cycle) {
+		for (std::size_t c = 0; c < chunks.size(); ++c) {
+			chunks[c].set_parallel_mode(true);
+			for (int i = 0; i < 1500; ++i) {
+				chunks[c].create_entity(world, CBB { static_cast<int>(c) * 10000 + i });
+			}
+			chunks[c].set_parallel_mode(false);
+		}
+		for (CommandBuffer& chunk : chunks) {
+			pending.merge_from(std::move(chunk));
+		}
+		pending.apply(world);
+
+		std::size_t footprint = pending.reserved_payload_bytes();
+		for (CommandBuffer const& chunk : chunks) {
+			footprint += chunk.reserved_payload_bytes();
+		}
+		if (cycle == 1) {
+			footprint_after_warmup = footprint;
+		} else if (cycle > 1) {
+			CHECK(footprint == footprint_after_warmup);
+		}
+	}
+
+	// Every value arrived intact, in chunk order.
+	std::vector<int> seen;
+	world.for_each<CBB>([&](CBB& b) {
+		seen.push_back(b.w);
+	});
+	REQUIRE(seen.size() == 5u * 4u * 1500u);
+	for (std::size_t k = 0; k < 4u * 1500u; ++k) {
+		std::size_t const c = k / 1500u;
+		std::size_t const i = k % 1500u;
+		CHECK(seen[k] == static_cast<int>(c) * 10000 + static_cast<int>(i));
+	}
+}
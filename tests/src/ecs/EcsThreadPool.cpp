@@ -82,3 +82,25 @@ TEST_CASE("EcsThreadPool::parallel_for blocks until done", "[ecs][EcsThreadPool]
 	});
 	CHECK(counter.load() == 100 * 1000);
 }
+
+TEST_CASE("EcsThreadPool::parallel_for nested inside run_concurrent completes", "[ecs][EcsThreadPool]") {
+	for (uint32_t worker_count : { 2u, 4u, 8u }) {
+		EcsThreadPool pool { worker_count };
+		static constexpr std::size_t N = 300;
+		std::vector<std::atomic<int>> seen(N * 5);
+		std::vector<std::function<void()>> bodies;
+		for (std::size_t b = 0; b < 5; ++b) {
+			bodies.emplace_back([&pool, &seen, b]() {
+				pool.parallel_for(N, [&seen, b](std::size_t chunk_idx, uint32_t /*worker_id*/) {
+					seen[b * N + chunk_idx].fetch_add(1, std::memory_order_relaxed);
+				});
+			});
+		}
+		pool.run_concurrent(std::span<std::function<void()> const>(bodies.data(), bodies.size()));
+		bool all_once = true;
+		for (std::atomic<int> const& s : seen) {
+			all_once = all_once && s.load() == 1;
+		}
+		CHECK(all_once);
+	}
+}
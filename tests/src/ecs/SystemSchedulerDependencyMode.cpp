@@ -0,0 +1,227 @@
+#include "openvic-simulation/ecs/CommandBuffer.hpp"
+#include "openvic-simulation/ecs/ComponentTypeID.hpp"
+#include "openvic-simulation/ecs/EntityID.hpp"
+#include "openvic-simulation/ecs/SystemImpl.hpp"
+#include "openvic-simulation/ecs/SystemTypeID.hpp"
+#include "openvic-simulation/ecs/World.hpp"
+#include "openvic-simulation/types/Date.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic::ecs;
+using OpenVic::Date;
+
+// Dependency mode (World::set_dependency_mode): systems start as soon as their DAG
+// predecessors are done instead of waiting for the whole previous stage. With no structural
+// commands the result must match stage mode bit-for-bit; with structural commands a
+// run_after successor must still observe its predecessor's applied buffer in the same tick,
+// and the outcome must not depend on the worker count.
+
+namespace {
+	struct SdmA {
+		int64_t v = 0;
+	};
+	struct SdmB {
+		int64_t v = 0;
+	};
+	struct SdmC {
+		int64_t v = 0;
+	};
+}
+ECS_COMPONENT(SdmA, "test_SystemSchedulerDependencyMode::A")
+ECS_COMPONENT(SdmB, "test_SystemSchedulerDependencyMode::B")
+ECS_COMPONENT(SdmC, "test_SystemSchedulerDependencyMode::C")
+
+namespace {
+	// StepA and StepB touch disjoint columns and share a stage; FoldC reads A, so it waits on
+	// StepA only — in dependency mode it may run while StepB is still going.
+	struct SdmStepA : SystemThreaded<SdmStepA> {
+		void tick(TickContext const& /*ctx*/, SdmA& a) {
+			a.v = a.v * 31 + 7;
+		}
+	};
+	struct SdmStepB : System<SdmStepB> {
+		void tick(TickContext const& /*ctx*/, SdmB& b) {
+			b.v = b.v * 17 + 3;
+		}
+	};
+}
+ECS_SYSTEM(SdmStepA)
+ECS_SYSTEM(SdmStepB)
+
+namespace {
+	struct SdmFoldC : SystemThreaded<SdmFoldC> {
+		void tick(TickContext const& /*ctx*/, SdmA const& a, SdmC& c) {
+			c.v = c.v * 13 + a.v;
+		}
+
+		static constexpr std::array<system_type_id_t, 1> declared_run_after() {
+			return { system_type_id_of<SdmStepA>() };
+		}
+	};
+}
+ECS_SYSTEM(SdmFoldC)
+
+namespace {
+	int64_t run_values_and_digest(uint32_t worker_count, bool dependency_mode) {
+		World world;
+		world.set_ecs_worker_count(worker_count);
+		world.set_dependency_mode(dependency_mode);
+
+		std::vector<EntityID> ids;
+		for (std::size_t i = 0; i < 400; ++i) {
+			int64_t const seed = static_cast<int64_t>(i % 29 + 1);
+			if (i % 3 == 0) {
+				ids.push_back(world.create_entity(SdmB { seed }));
+			} else {
+				ids.push_back(world.create_entity(SdmA { seed }, SdmC { seed }));
+			}
+		}
+
+		world.register_system<SdmStepA>();
+		world.register_system<SdmStepB>();
+		world.register_system<SdmFoldC>();
+
+		for (int t = 0; t < 8; ++t) {
+			world.tick_systems(Date {});
+		}
+
+		int64_t digest = 0;
+		for (EntityID const& id : ids) {
+			if (SdmA const* a = world.get_component<SdmA>(id); a != nullptr) {
+				digest = digest * 1000003 + a->v;
+			}
+			if (SdmB const* b = world.get_component<SdmB>(id); b != nullptr) {
+				digest = digest * 1000003 + b->v;
+			}
+			if (SdmC const* c = world.get_component<SdmC>(id); c != nullptr) {
+				digest = digest * 1000003 + c->v;
+			}
+		}
+		return digest;
+	}
+}
+
+TEST_CASE("Dependency mode matches stage mode for value-only systems",
+          "[ecs][SystemScheduler][dependency_mode][determinism]") {
+	int64_t const baseline = run_values_and_digest(1, false);
+
+	for (uint32_t wc : { 1u, 2u, 4u, 8u, 16u }) {
+		CHECK(run_values_and_digest(wc, false) == baseline);
+		CHECK(run_values_and_digest(wc, true) == baseline);
+	}
+}
+
+namespace {
+	struct SdmSource {
+		int32_t count = 0;
+	};
+	struct SdmSpawned {
+		int32_t generation = 0;
+	};
+	struct SdmSpawnedTotal {
+		int64_t value = 0;
+	};
+}
+ECS_COMPONENT(SdmSource, "test_SystemSchedulerDependencyMode::Source")
+ECS_COMPONENT(SdmSpawned, "test_SystemSchedulerDependencyMode::Spawned")
+ECS_COMPONENT(SdmSpawnedTotal, "test_SystemSchedulerDependencyMode::SpawnedTotal")
+
+namespace {
+	struct SdmSpawner : SystemThreaded<SdmSpawner> {
+		void tick(TickContext const& ctx, SdmSource const& src) {
+			for (int32_t i = 0; i < src.count; ++i) {
+				ctx.cmd.create_entity(ctx.world, SdmSpawned { i });
+			}
+		}
+	};
+}
+ECS_SYSTEM(SdmSpawner)
+
+namespace {
+	// Runs after the spawner; counts every SdmSpawned alive when it runs. Seeing this tick's
+	// spawns means the spawner's buffer was applied before the counter started.
+	struct SdmSpawnedCounter : System<SdmSpawnedCounter> {
+		void tick(TickContext const& ctx, SdmSpawned const&) {
+			SdmSpawnedTotal* total = ctx.world.get_singleton<SdmSpawnedTotal>();
+			if (total != nullptr) {
+				total->value += 1;
+			}
+		}
+
+		static constexpr std::array<system_type_id_t, 1> declared_run_after() {
+			return { system_type_id_of<SdmSpawner>() };
+		}
+	};
+}
+ECS_SYSTEM(SdmSpawnedCounter)
+
+namespace {
+	struct SpawnResult {
+		int64_t counted = 0;
+		std::vector<int32_t> generations; // iteration order
+	};
+
+	SpawnResult run_spawn_scenario(uint32_t worker_count, bool dependency_mode, int tick_count) {
+		World world;
+		world.set_ecs_worker_count(worker_count);
+		world.set_dependency_mode(dependency_mode);
+		world.set_singleton<SdmSpawnedTotal>(SdmSpawnedTotal { 0 });
+
+		for (std::size_t i = 0; i < 150; ++i) {
+			world.create_entity(SdmSource { static_cast<int32_t>(i % 3 + 1) });
+		}
+
+		world.register_system<SdmSpawner>();
+		world.register_system<SdmSpawnedCounter>();
+		// Value-only systems alongside, so rounds contain more than the spawn chain.
+		world.register_system<SdmStepA>();
+		world.register_system<SdmStepB>();
+		world.register_system<SdmFoldC>();
+
+		for (int t = 0; t < tick_count; ++t) {
+			world.tick_systems(Date {});
+		}
+
+		SpawnResult r;
+		if (SdmSpawnedTotal const* total = world.get_singleton<SdmSpawnedTotal>(); total != nullptr) {
+			r.counted = total->value;
+		}
+		world.for_each<SdmSpawned>([&](SdmSpawned& s) {
+			r.generations.push_back(s.generation);
+		});
+		return r;
+	}
+}
+
+TEST_CASE("Dependency mode: run_after successor observes structural commands in the same tick",
+          "[ecs][SystemScheduler][dependency_mode]") {
+	// 150 sources spawning 1, 2, 3 in turn → 300 per tick.
+	SpawnResult const one_tick = run_spawn_scenario(8, true, 1);
+	CHECK(one_tick.counted == 300);
+	CHECK(one_tick.generations.size() == 300);
+
+	// Tick t counts every entity spawned in ticks 1..t: 300 + 600 + 900.
+	SpawnResult const three_ticks = run_spawn_scenario(8, true, 3);
+	CHECK(three_ticks.counted == 1800);
+	CHECK(three_ticks.generations.size() == 900);
+}
+
+TEST_CASE("Dependency mode with structural commands is identical across worker counts and to stage mode",
+          "[ecs][SystemScheduler][dependency_mode][determinism]") {
+	SpawnResult const baseline = run_spawn_scenario(1, false, 3);
+
+	for (uint32_t wc : { 1u, 2u, 4u, 8u, 16u }) {
+		SpawnResult const r = run_spawn_scenario(wc, true, 3);
+		CHECK(r.counted == baseline.counted);
+		REQUIRE(r.generations.size() == baseline.generations.size());
+		for (std::size_t i = 0; i < baseline.generations.size(); ++i) {
+			CHECK(r.generations[i] == baseline.generations[i]);
+		}
+	}
+}
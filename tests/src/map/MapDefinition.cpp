@@ -0,0 +1,283 @@
+#include "openvic-simulation/map/MapDefinition.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+#include "openvic-simulation/core/memory/Vector.hpp"
+#include "openvic-simulation/core/thread/ConcurrentTaskLimit.hpp"
+#include "openvic-simulation/map/ProvinceDefinition.hpp"
+#include "openvic-simulation/map/TerrainType.hpp"
+#include "openvic-simulation/types/Colour.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+// Rows of 16 pixels need no padding at 8 or 24 bits per pixel
+static constexpr int32_t synthetic_map_width = 16, synthetic_map_height = 12;
+static constexpr ProvinceDefinition::province_number_t synthetic_province_count = 9;
+
+static void write_u16(std::ofstream& file, uint16_t value) {
+	file.put(value & 0xFF).put(value >> 8);
+}
+
+static void write_u32(std::ofstream& file, uint32_t value) {
+	write_u16(file, value & 0xFFFF);
+	write_u16(file, value >> 16);
+}
+
+static void write_bmp(fs::path const& path, const uint16_t bits_per_pixel, std::span<const uint8_t> pixels) {
+	static constexpr uint32_t header_size = 54;
+	// 8 bit images get a full greyscale palette
+	const uint32_t palette_size = bits_per_pixel == 8 ? 256 : 0;
+	const uint32_t offset = header_size + palette_size * 4;
+
+	std::ofstream file { path, std::ios::binary };
+	write_u16(file, 0x4d42);
+	write_u32(file, offset + pixels.size());
+	write_u32(file, 0);
+	write_u32(file, offset);
+	write_u32(file, 40);
+	write_u32(file, synthetic_map_width);
+	write_u32(file, synthetic_map_height);
+	write_u16(file, 1);
+	write_u16(file, bits_per_pixel);
+	write_u32(file, 0);
+	write_u32(file, pixels.size());
+	write_u32(file, 0);
+	write_u32(file, 0);
+	write_u32(file, palette_size);
+	write_u32(file, 0);
+	for (uint32_t i = 0; i < palette_size; ++i) {
+		write_u32(file, i * 0x010101);
+	}
+	file.write(reinterpret_cast<char const*>(pixels.data()), pixels.size());
+}
+
+/* Grey, so the colour reads the same whichever order its channels are stored in. */
+static colour_t synthetic_province_colour(const ProvinceDefinition::province_number_t province_number) {
+	const uint8_t value = static_cast<uint8_t>(province_number * 20);
+	return { value, value, value };
+}
+
+/* Irregular blocks with a checkerboard fringe, so provinces meet along every kind of border, including across the
+ * horizontal wrap and between neighbouring rows which land in different bands. */
+static ProvinceDefinition::province_number_t synthetic_province_number_at(const int32_t x, const int32_t y) {
+	return 1 + ((x / 3) * 7 + (y / 2) * 3 + ((x ^ y) & 1)) % synthetic_province_count;
+}
+
+/* Writes provinces.bmp, terrain.bmp and rivers.bmp for the synthetic map into a fresh directory. The rivers image has a
+ * single river running down the middle of the map. */
+static fs::path write_synthetic_map_images(std::string_view name) {
+	const fs::path directory = fs::temp_directory_path() / name;
+	std::error_code ec;
+	fs::remove_all(directory, ec);
+	fs::create_directories(directory);
+
+	static constexpr size_t pixel_count = synthetic_map_width * synthetic_map_height;
+	std::vector<uint8_t> province_pixels(pixel_count * 3);
+	std::vector<uint8_t> terrain_pixels(pixel_count);
+	std::vector<uint8_t> river_pixels(pixel_count, 255);
+	for (int32_t y = 0; y < synthetic_map_height; ++y) {
+		for (int32_t x = 0; x < synthetic_map_width; ++x) {
+			const size_t pixel_index = x + y * synthetic_map_width;
+			const colour_t colour = synthetic_province_colour(synthetic_province_number_at(x, y));
+			province_pixels[pixel_index * 3] = colour.blue;
+			province_pixels[pixel_index * 3 + 1] = colour.green;
+			province_pixels[pixel_index * 3 + 2] = colour.red;
+			terrain_pixels[pixel_index] = static_cast<uint8_t>((x + y) % 4);
+		}
+	}
+	// River source, then a size 3 segment which widens to size 5 halfway down
+	static constexpr int32_t river_x = synthetic_map_width / 2;
+	river_pixels[river_x] = 0;
+	for (int32_t y = 1; y < synthetic_map_height - 1; ++y) {
+		river_pixels[river_x + y * synthetic_map_width] = y < synthetic_map_height / 2 ? 3 : 5;
+	}
+
+	write_bmp(directory / "provinces.bmp", 24, province_pixels);
+	write_bmp(directory / "terrain.bmp", 8, terrain_pixels);
+	write_bmp(directory / "rivers.bmp", 8, river_pixels);
+	return directory;
+}
+
+static bool load_synthetic_map(MapDefinition& map_definition, fs::path const& directory, fs::path const& cache_path = {}) {
+	if (!map_definition.set_max_provinces(province_index_t(synthetic_province_count))) {
+		return false;
+	}
+	for (ProvinceDefinition::province_number_t province_number = 1; province_number <= synthetic_province_count; ++province_number) {
+		if (!map_definition.add_province_definition(
+			std::to_string(province_number), synthetic_province_colour(province_number)
+		)) {
+			return false;
+		}
+	}
+	map_definition.lock_province_definitions();
+
+	TerrainTypeManager& terrain_type_manager = map_definition.get_terrain_type_manager();
+	terrain_type_manager.lock_terrain_types();
+	terrain_type_manager.lock_terrain_type_mappings();
+
+	if (!map_definition.load_map_images(
+		directory / "provinces.bmp", directory / "terrain.bmp", directory / "rivers.bmp", false, cache_path
+	)) {
+		return false;
+	}
+
+	// There's no adjacencies file, which is reported as an error only after the standard adjacencies have been generated
+	map_definition.generate_and_load_province_adjacencies({});
+	return true;
+}
+
+using adjacency_summary_t = std::tuple<province_index_t, ProvinceDefinition::distance_t, ProvinceDefinition::adjacency_t::type_t>;
+
+/* Every province's adjacencies, in the order they're stored. */
+static std::vector<std::vector<adjacency_summary_t>> get_adjacency_lists(MapDefinition const& map_definition) {
+	std::vector<std::vector<adjacency_summary_t>> adjacency_lists;
+	for (ProvinceDefinition const& province : map_definition.get_province_definitions()) {
+		std::vector<adjacency_summary_t>& adjacency_list = adjacency_lists.emplace_back();
+		for (ProvinceDefinition::adjacency_t const& adjacency : province.get_adjacencies()) {
+			adjacency_list.emplace_back(adjacency.get_to().index, adjacency.get_distance(), adjacency.get_type());
+		}
+	}
+	return adjacency_lists;
+}
+
+TEST_CASE("MapDefinition standard adjacencies don't depend on the task count", "[MapDefinition]") {
+	const fs::path directory = write_synthetic_map_images("openvic_map_definition_adjacency_test");
+
+	std::vector<std::vector<adjacency_summary_t>> single_task_adjacency_lists;
+	{
+		const ScopedConcurrentTaskLimit task_limit { 1 };
+		MapDefinition map_definition;
+		REQUIRE(load_synthetic_map(map_definition, directory));
+		single_task_adjacency_lists = get_adjacency_lists(map_definition);
+	}
+
+	size_t adjacency_count = 0;
+	for (std::vector<adjacency_summary_t> const& adjacency_list : single_task_adjacency_lists) {
+		CHECK_FALSE(adjacency_list.empty());
+		adjacency_count += adjacency_list.size();
+	}
+	CHECK(adjacency_count > synthetic_province_count);
+
+	// Includes limits which don't divide the height evenly and one with a band per row
+	for (const size_t task_limit_count : { 2, 3, 5, 7, synthetic_map_height, 64 }) {
+		const ScopedConcurrentTaskLimit task_limit { task_limit_count };
+		MapDefinition map_definition;
+		REQUIRE(load_synthetic_map(map_definition, directory));
+		CHECK(get_adjacency_lists(map_definition) == single_task_adjacency_lists);
+	}
+
+	std::error_code ec;
+	fs::remove_all(directory, ec);
+}
+
+TEST_CASE("MapDefinition derived map cache round trip", "[MapDefinition]") {
+	const fs::path directory = write_synthetic_map_images("openvic_map_definition_cache_test");
+	const fs::path cache_path = directory / "derived_map.cache";
+
+	MapDefinition cold_map_definition;
+	REQUIRE(load_synthetic_map(cold_map_definition, directory, cache_path));
+	REQUIRE(fs::is_regular_file(cache_path));
+
+	// A cache miss always saves the cache again, so an unchanged write time means the second load used it
+	const fs::file_time_type stale_write_time = fs::last_write_time(cache_path) - std::chrono::hours { 1 };
+	fs::last_write_time(cache_path, stale_write_time);
+
+	MapDefinition cached_map_definition;
+	REQUIRE(load_synthetic_map(cached_map_definition, directory, cache_path));
+	CHECK(fs::last_write_time(cache_path) == stale_write_time);
+
+	const std::span<const MapDefinition::shape_pixel_t> cold_shape_image = cold_map_definition.get_province_shape_image();
+	const std::span<const MapDefinition::shape_pixel_t> cached_shape_image = cached_map_definition.get_province_shape_image();
+	REQUIRE(cold_shape_image.size() == static_cast<size_t>(synthetic_map_width * synthetic_map_height));
+	REQUIRE(cached_shape_image.size() == cold_shape_image.size());
+	CHECK(std::memcmp(cold_shape_image.data(), cached_shape_image.data(), cold_shape_image.size_bytes()) == 0);
+
+	REQUIRE(
+		cached_map_definition.get_province_definition_count() == cold_map_definition.get_province_definition_count()
+	);
+	for (ProvinceDefinition const& cold_province : cold_map_definition.get_province_definitions()) {
+		ProvinceDefinition const* cached_province = cached_map_definition.get_province_definition_by_index(
+			cold_province.index
+		);
+		REQUIRE(cached_province != nullptr);
+		CHECK(cold_province.get_on_map());
+		CHECK(cached_province->get_on_map());
+		CHECK(cached_province->get_centre() == cold_province.get_centre());
+	}
+
+	CHECK(get_adjacency_lists(cached_map_definition) == get_adjacency_lists(cold_map_definition));
+
+	const std::span<const memory::vector<RiverSegment>> cold_rivers = cold_map_definition.get_rivers();
+	const std::span<const memory::vector<RiverSegment>> cached_rivers = cached_map_definition.get_rivers();
+	REQUIRE(cold_rivers.size() == 1);
+	REQUIRE(cached_rivers.size() == cold_rivers.size());
+	REQUIRE_FALSE(cold_rivers[0].empty());
+	REQUIRE(cached_rivers[0].size() == cold_rivers[0].size());
+	for (size_t segment_index = 0; segment_index < cold_rivers[0].size(); ++segment_index) {
+		RiverSegment const& cold_segment = cold_rivers[0][segment_index];
+		RiverSegment const& cached_segment = cached_rivers[0][segment_index];
+		CHECK(cached_segment.size == cold_segment.size);
+		CHECK(std::equal(
+			cold_segment.get_points().begin(), cold_segment.get_points().end(),
+			cached_segment.get_points().begin(), cached_segment.get_points().end()
+		));
+	}
+
+	std::error_code ec;
+	fs::remove_all(directory, ec);
+}
+
+TEST_CASE("MapDefinition derived map cache rejects out of range province numbers", "[MapDefinition]") {
+	const fs::path directory = write_synthetic_map_images("openvic_map_definition_corrupt_cache_test");
+	const fs::path cache_path = directory / "derived_map.cache";
+
+	{
+		MapDefinition cold_map_definition;
+		REQUIRE(load_synthetic_map(cold_map_definition, directory, cache_path));
+		REQUIRE(fs::is_regular_file(cache_path));
+	}
+
+	// The shape image comes after the magic number, the key and the image's byte count
+	static constexpr std::streamoff first_pixel_offset = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint64_t);
+	const ProvinceDefinition::province_number_t out_of_range_province_number = synthetic_province_count + 1;
+	{
+		std::fstream cache_file { cache_path, std::ios::binary | std::ios::in | std::ios::out };
+		cache_file.seekp(first_pixel_offset);
+		cache_file.write(reinterpret_cast<char const*>(&out_of_range_province_number), sizeof(out_of_range_province_number));
+		REQUIRE(cache_file.good());
+	}
+	const fs::file_time_type stale_write_time = fs::last_write_time(cache_path) - std::chrono::hours { 1 };
+	fs::last_write_time(cache_path, stale_write_time);
+
+	// Falls back to a cold load, which saves the cache again
+	MapDefinition map_definition;
+	REQUIRE(load_synthetic_map(map_definition, directory, cache_path));
+	CHECK(fs::last_write_time(cache_path) != stale_write_time);
+	const std::span<const MapDefinition::shape_pixel_t> shape_image = map_definition.get_province_shape_image();
+	REQUIRE_FALSE(shape_image.empty());
+	CHECK(std::all_of(
+		shape_image.begin(), shape_image.end(),
+		[](MapDefinition::shape_pixel_t const& pixel) -> bool {
+			return pixel.province_number <= synthetic_province_count;
+		}
+	));
+
+	std::error_code ec;
+	fs::remove_all(directory, ec);
+}
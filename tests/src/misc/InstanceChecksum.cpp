@@ -0,0 +1,210 @@
+#include "openvic-simulation/misc/InstanceChecksum.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include "openvic-simulation/core/io/BinaryStream.hpp"
+#include "openvic-simulation/core/thread/ConcurrentTaskLimit.hpp"
+#include "openvic-simulation/ecs/ChecksumTraits.hpp"
+#include "openvic-simulation/GameManager.hpp"
+#include "openvic-simulation/InstanceManager.hpp"
+
+#include "SyntheticGameTree.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+namespace {
+	InstanceChecksum make_checksum() {
+		InstanceChecksum checksum;
+		checksum.total = 1;
+		checksum.section_checksums = { 10, 20, 30, 40, 50, 60, 70 };
+		checksum.market_checksums = { 1, 2 };
+		checksum.country_checksums = { 3, 4, 5 };
+		checksum.province_checksums = { 6, InstanceChecksum::NOT_SAMPLED, 8 };
+		checksum.unit_group_checksums = { 9, 10 };
+		return checksum;
+	}
+
+	/* The total checksum after each of tick_count ticks, or an empty vector if the game failed to start. */
+	std::vector<uint64_t> get_tick_totals(fs::path const& root, const size_t tick_count) {
+		GameManager game_manager { []() {}, nullptr, nullptr };
+		if (!SyntheticGameTree::start_game(game_manager, root)) {
+			return {};
+		}
+		InstanceManager& instance_manager = *game_manager.get_instance_manager();
+
+		std::vector<uint64_t> totals;
+		InstanceChecksum checksum;
+		for (size_t tick = 0; tick < tick_count; ++tick) {
+			instance_manager.force_tick_and_update();
+			if (!InstanceChecksum::compute(instance_manager, checksum)) {
+				return {};
+			}
+			totals.push_back(checksum.total);
+		}
+		return totals;
+	}
+}
+
+TEST_CASE("InstanceChecksum equal checksums don't diverge", "[InstanceChecksum]") {
+	CHECK_FALSE(make_checksum().find_first_divergence(make_checksum()).has_value());
+}
+
+TEST_CASE("InstanceChecksum finds the first divergent section and entity", "[InstanceChecksum]") {
+	const InstanceChecksum lhs = make_checksum();
+	InstanceChecksum rhs = make_checksum();
+	rhs.total = 2;
+	rhs.section_checksums[static_cast<size_t>(InstanceChecksum::section_t::COUNTRIES)] = 31;
+	rhs.country_checksums[1] = 44;
+	rhs.section_checksums[static_cast<size_t>(InstanceChecksum::section_t::PROVINCES)] = 41;
+	rhs.province_checksums[2] = 88;
+
+	std::optional<InstanceChecksum::divergence_t> divergence = lhs.find_first_divergence(rhs);
+	REQUIRE(divergence.has_value());
+	CHECK(divergence->section == InstanceChecksum::section_t::COUNTRIES);
+	CHECK(divergence->entity_index == std::optional<size_t> { 1 });
+
+	rhs.section_checksums[static_cast<size_t>(InstanceChecksum::section_t::GLOBAL)] = 11;
+	divergence = lhs.find_first_divergence(rhs);
+	REQUIRE(divergence.has_value());
+	CHECK(divergence->section == InstanceChecksum::section_t::GLOBAL);
+	CHECK_FALSE(divergence->entity_index.has_value());
+}
+
+TEST_CASE("InstanceChecksum finds the first divergent unit group", "[InstanceChecksum]") {
+	const InstanceChecksum lhs = make_checksum();
+	InstanceChecksum rhs = make_checksum();
+	rhs.total = 2;
+	rhs.section_checksums[static_cast<size_t>(InstanceChecksum::section_t::UNITS)] = 61;
+	rhs.unit_group_checksums[1] = 100;
+
+	std::optional<InstanceChecksum::divergence_t> divergence = lhs.find_first_divergence(rhs);
+	REQUIRE(divergence.has_value());
+	CHECK(divergence->section == InstanceChecksum::section_t::UNITS);
+	CHECK(divergence->entity_index == std::optional<size_t> { 1 });
+
+	// Only the leaders, regiments or ships differ
+	rhs.unit_group_checksums[1] = 10;
+	divergence = lhs.find_first_divergence(rhs);
+	REQUIRE(divergence.has_value());
+	CHECK(divergence->section == InstanceChecksum::section_t::UNITS);
+	CHECK_FALSE(divergence->entity_index.has_value());
+}
+
+TEST_CASE("InstanceChecksum hash writer matches hashing written data", "[InstanceChecksum]") {
+	const auto write_values = [](auto& writer) -> void {
+		writer.write(uint32_t { 0x01020304 });
+		writer.write_string("event_modifier");
+		writer.template write_span<uint16_t>(std::vector<uint16_t> { 5, 6, 7 });
+		writer.write_string("");
+	};
+
+	BinaryWriter binary_writer;
+	write_values(binary_writer);
+	InstanceChecksum::hash_writer_t hash_writer;
+	write_values(hash_writer);
+
+	const std::span<const uint8_t> data = binary_writer.get_data();
+	CHECK(hash_writer.digest == ecs::fnv1a_64_bytes(data.data(), data.size(), ecs::CHECKSUM_SEED));
+}
+
+TEST_CASE("InstanceChecksum identically seeded instances stay in lockstep", "[InstanceChecksum]") {
+	static constexpr size_t tick_count = 10;
+
+	const fs::path root = SyntheticGameTree::write_to_unique_temp_path(
+		"openvic_instance_checksum_lockstep_test", SyntheticGameTree::small_settings()
+	);
+	REQUIRE_FALSE(root.empty());
+
+	GameManager first_game_manager { []() {}, nullptr, nullptr };
+	GameManager second_game_manager { []() {}, nullptr, nullptr };
+	REQUIRE(SyntheticGameTree::start_game(first_game_manager, root));
+	REQUIRE(SyntheticGameTree::start_game(second_game_manager, root));
+	InstanceManager& first_instance_manager = *first_game_manager.get_instance_manager();
+	InstanceManager& second_instance_manager = *second_game_manager.get_instance_manager();
+
+	InstanceChecksum first_checksum, second_checksum;
+	for (size_t tick = 0; tick < tick_count; ++tick) {
+		first_instance_manager.force_tick_and_update();
+		second_instance_manager.force_tick_and_update();
+		REQUIRE(InstanceChecksum::compute(first_instance_manager, first_checksum));
+		REQUIRE(InstanceChecksum::compute(second_instance_manager, second_checksum));
+		CHECK(first_checksum.total == second_checksum.total);
+		CHECK_FALSE(first_checksum.find_first_divergence(second_checksum).has_value());
+	}
+	CHECK(
+		first_checksum.province_checksums.size() == first_instance_manager.get_map_instance().get_province_instances().size()
+	);
+	CHECK_FALSE(first_checksum.unit_group_checksums.empty());
+
+	std::error_code ec;
+	fs::remove_all(root, ec);
+}
+
+TEST_CASE("InstanceChecksum doesn't depend on the thread count", "[InstanceChecksum]") {
+	static constexpr size_t tick_count = 5;
+
+	const fs::path root = SyntheticGameTree::write_to_unique_temp_path(
+		"openvic_instance_checksum_thread_count_test", SyntheticGameTree::small_settings()
+	);
+	REQUIRE_FALSE(root.empty());
+
+	std::vector<uint64_t> single_thread_totals;
+	{
+		const ScopedConcurrentTaskLimit task_limit { 1 };
+		single_thread_totals = get_tick_totals(root, tick_count);
+	}
+	REQUIRE(single_thread_totals.size() == tick_count);
+
+	for (const size_t task_limit_count : { 2, 3, 8 }) {
+		const ScopedConcurrentTaskLimit task_limit { task_limit_count };
+		CHECK(get_tick_totals(root, tick_count) == single_thread_totals);
+	}
+
+	std::error_code ec;
+	fs::remove_all(root, ec);
+}
+
+TEST_CASE("InstanceChecksum sampling keeps the unsampled provinces' checksums", "[InstanceChecksum]") {
+	static constexpr size_t province_sample_stride = 3;
+
+	const fs::path root = SyntheticGameTree::write_to_unique_temp_path(
+		"openvic_instance_checksum_sampling_test", SyntheticGameTree::small_settings()
+	);
+	REQUIRE_FALSE(root.empty());
+
+	GameManager game_manager { []() {}, nullptr, nullptr };
+	REQUIRE(SyntheticGameTree::start_game(game_manager, root));
+	InstanceManager& instance_manager = *game_manager.get_instance_manager();
+	instance_manager.force_tick_and_update();
+
+	InstanceChecksum full_checksum;
+	REQUIRE(InstanceChecksum::compute(instance_manager, full_checksum));
+
+	// Nothing has changed since the full checksum, so the provinces it doesn't rehash are still up to date
+	InstanceChecksum sampled_checksum = full_checksum;
+	REQUIRE(InstanceChecksum::compute(instance_manager, sampled_checksum, province_sample_stride));
+	CHECK(sampled_checksum.total == full_checksum.total);
+
+	InstanceChecksum first_sampled_checksum;
+	REQUIRE(InstanceChecksum::compute(instance_manager, first_sampled_checksum, province_sample_stride));
+	size_t sampled_count = 0;
+	for (size_t index = 0; index < first_sampled_checksum.province_checksums.size(); ++index) {
+		if (first_sampled_checksum.province_checksums[index] != InstanceChecksum::NOT_SAMPLED) {
+			CHECK(first_sampled_checksum.province_checksums[index] == full_checksum.province_checksums[index]);
+			++sampled_count;
+		}
+	}
+	CHECK(sampled_count > 0);
+	CHECK(sampled_count < first_sampled_checksum.province_checksums.size());
+
+	std::error_code ec;
+	fs::remove_all(root, ec);
+}
@@ -0,0 +1,91 @@
+#include "openvic-simulation/misc/InstanceSave.hpp"
+
+#include <cstddef>
+#include <system_error>
+
+#include "openvic-simulation/core/io/BinaryStream.hpp"
+#include "openvic-simulation/GameManager.hpp"
+#include "openvic-simulation/InstanceManager.hpp"
+#include "openvic-simulation/misc/InstanceChecksum.hpp"
+
+#include "SyntheticGameTree.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+TEST_CASE("InstanceSave header round trip", "[InstanceSave]") {
+	BinaryWriter writer;
+	writer.write(InstanceSave::header_t {
+		.definitions_fingerprint = 0x0123456789ABCDEF,
+		.bookmark_index = 2,
+		.today = { 1836, 1, 1 }
+	});
+
+	BinaryReader reader { writer.get_data() };
+	InstanceSave::header_t header;
+	CHECK(InstanceSave::read_header(reader, header));
+	CHECK(header.definitions_fingerprint == 0x0123456789ABCDEF);
+	CHECK(header.bookmark_index == 2);
+	CHECK(header.today == Date { 1836, 1, 1 });
+	CHECK(reader.is_at_end());
+}
+
+TEST_CASE("InstanceSave header rejects other files and versions", "[InstanceSave]") {
+	InstanceSave::header_t header;
+
+	{
+		BinaryWriter writer;
+		writer.write(InstanceSave::header_t { .magic = 0 });
+		BinaryReader reader { writer.get_data() };
+		CHECK_FALSE(InstanceSave::read_header(reader, header));
+	}
+	{
+		BinaryWriter writer;
+		writer.write(InstanceSave::header_t { .version = InstanceSave::VERSION + 1 });
+		BinaryReader reader { writer.get_data() };
+		CHECK_FALSE(InstanceSave::read_header(reader, header));
+	}
+	{
+		BinaryWriter writer;
+		writer.write(InstanceSave::MAGIC);
+		BinaryReader reader { writer.get_data() };
+		CHECK_FALSE(InstanceSave::read_header(reader, header));
+	}
+}
+
+TEST_CASE("InstanceSave loaded game matches the saved game's checksum", "[InstanceSave]") {
+	static constexpr size_t tick_count = 5;
+
+	const fs::path root = SyntheticGameTree::write_to_unique_temp_path(
+		"openvic_instance_save_test", SyntheticGameTree::small_settings()
+	);
+	REQUIRE_FALSE(root.empty());
+	const fs::path save_path = root / "test.ovsave";
+
+	InstanceChecksum saved_checksum;
+	{
+		GameManager game_manager { []() {}, nullptr, nullptr };
+		REQUIRE(SyntheticGameTree::start_game(game_manager, root));
+
+		InstanceManager& instance_manager = *game_manager.get_instance_manager();
+		for (size_t tick = 0; tick < tick_count; ++tick) {
+			instance_manager.force_tick_and_update();
+		}
+		REQUIRE(InstanceChecksum::compute(instance_manager, saved_checksum));
+		REQUIRE(game_manager.save_game(save_path));
+	}
+
+	GameManager game_manager { []() {}, nullptr, nullptr };
+	REQUIRE(SyntheticGameTree::load_definitions(game_manager, root));
+	REQUIRE(game_manager.load_game(save_path));
+
+	InstanceChecksum loaded_checksum;
+	REQUIRE(InstanceChecksum::compute(*game_manager.get_instance_manager(), loaded_checksum));
+	CHECK(loaded_checksum.total == saved_checksum.total);
+	CHECK_FALSE(saved_checksum.find_first_divergence(loaded_checksum).has_value());
+
+	std::error_code ec;
+	fs::remove_all(root, ec);
+}
@@ -0,0 +1,51 @@
+#include "openvic-simulation/modifier/ModifierSum.hpp"
+
+#include "openvic-simulation/modifier/Modifier.hpp"
+#include "openvic-simulation/modifier/ModifierEffect.hpp"
+#include "openvic-simulation/modifier/ModifierValue.hpp"
+#include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+using enum ModifierEffect::format_t;
+using enum ModifierEffect::target_t;
+
+static const ModifierEffect sum_effect {
+	"test_sum_effect", modifier_effect_index_t { 1 }, FORMAT_x1_2DP_POS, COUNTRY, {}, false
+};
+
+static IconModifier make_test_modifier(std::string_view identifier, const fixed_point_t value) {
+	ModifierValue values;
+	values.set_effect(sum_effect, value);
+	return { identifier, std::move(values), Modifier::modifier_type_t::STATIC, 0 };
+}
+
+TEST_CASE("ModifierSum remove_modifier undoes add_modifier", "[ModifierSum]") {
+	const IconModifier first_modifier = make_test_modifier("test_first_modifier", fixed_point_t::_1 / 3);
+	const IconModifier second_modifier = make_test_modifier("test_second_modifier", 5);
+	const fixed_point_t multiplier = fixed_point_t::_1 / 7;
+
+	ModifierSum only_second;
+	only_second.add_modifier(second_modifier);
+
+	ModifierSum sum;
+	sum.add_modifier(first_modifier, multiplier);
+	sum.add_modifier(second_modifier);
+	CHECK(sum.size() == 2);
+
+	CHECK_FALSE(sum.remove_modifier(first_modifier));
+	CHECK(sum.remove_modifier(first_modifier, multiplier));
+	CHECK(sum.size() == 1);
+	CHECK(sum.get_modifier_effect_value(sum_effect) == only_second.get_modifier_effect_value(sum_effect));
+
+	sum.add_modifier(first_modifier, -multiplier);
+	sum.remove_modifiers_if([&first_modifier](modifier_entry_t const& entry) -> bool {
+		return entry.modifier == &first_modifier;
+	});
+	CHECK(sum.size() == 1);
+	CHECK(sum.get_modifier_effect_value(sum_effect) == only_second.get_modifier_effect_value(sum_effect));
+}
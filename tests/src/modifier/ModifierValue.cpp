@@ -0,0 +1,100 @@
+#include "openvic-simulation/modifier/ModifierValue.hpp"
+
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "openvic-simulation/modifier/ModifierEffect.hpp"
+#include "openvic-simulation/modifier/ModifierManager.hpp"
+#include "openvic-simulation/types/fixed_point/FixedPoint.hpp"
+#include "openvic-simulation/types/TypedIndices.hpp"
+
+#include <snitch/snitch_macros_check.hpp>
+#include <snitch/snitch_macros_test_case.hpp>
+
+using namespace OpenVic;
+
+using enum ModifierEffect::format_t;
+using enum ModifierEffect::target_t;
+
+static const ModifierEffect country_effect {
+	"test_country_effect", modifier_effect_index_t { 0 }, FORMAT_x1_2DP_POS, COUNTRY, {}, false
+};
+static const ModifierEffect province_effect {
+	"test_province_effect", modifier_effect_index_t { 3 }, FORMAT_x1_2DP_POS, PROVINCE, {}, false
+};
+
+TEST_CASE("ModifierValue get and set effects", "[ModifierValue]") {
+	ModifierValue value;
+	CHECK(value.empty());
+
+	bool effect_found = true;
+	CHECK(value.get_effect(province_effect, &effect_found) == 0);
+	CHECK_FALSE(effect_found);
+
+	value.set_effect(province_effect, 0);
+	CHECK(value.has_effect(province_effect));
+	CHECK_FALSE(value.has_effect(country_effect));
+	CHECK(value.get_effect_count() == 1);
+
+	value.trim();
+	CHECK(value.empty());
+}
+
+TEST_CASE("ModifierValue multiply_add_exclude_targets", "[ModifierValue]") {
+	ModifierValue modifier;
+	modifier.set_effect(country_effect, 2);
+	modifier.set_effect(province_effect, 3);
+
+	ModifierValue sum;
+	sum.multiply_add_exclude_targets(modifier, 1, NO_TARGETS);
+	sum.multiply_add_exclude_targets(modifier, fixed_point_t::_0_50, PROVINCE);
+
+	CHECK(sum.get_effect(country_effect) == 3);
+	CHECK(sum.get_effect(province_effect) == 3);
+	CHECK(sum.get_effect_count() == 2);
+
+	ModifierValue country_only;
+	country_only.multiply_add_exclude_targets(modifier, 2, PROVINCE);
+	CHECK(country_only.get_effect(country_effect) == 4);
+	CHECK_FALSE(country_only.has_effect(province_effect));
+
+	sum -= modifier;
+	CHECK(sum.get_effect(country_effect) == 1);
+	CHECK(sum.get_effect(province_effect) == 0);
+	CHECK(sum.has_effect(province_effect));
+}
+
+TEST_CASE("ModifierValue looks effects up by index", "[ModifierValue]") {
+	ModifierManager modifier_manager;
+	REQUIRE(modifier_manager.setup_modifier_effects());
+	ModifierEffectCache const& effect_cache = modifier_manager.get_modifier_effect_cache();
+	ModifierEffect const* const tax_eff = effect_cache.get_tax_eff();
+	ModifierEffect const* const morale = effect_cache.get_morale_global();
+	REQUIRE(tax_eff != nullptr);
+	REQUIRE(morale != nullptr);
+
+	CHECK(modifier_manager.get_modifier_effect_by_index(tax_eff->index) == tax_eff);
+	CHECK(modifier_manager.get_modifier_effect_by_index(morale->index) == morale);
+	CHECK(modifier_manager.get_modifier_effect_by_index(
+		modifier_effect_index_t(modifier_manager.get_modifier_effect_count())
+	) == nullptr);
+
+	ModifierValue value;
+	value.set_effect(*morale, 2);
+	value.set_effect(*tax_eff, 0);
+
+	std::vector<std::tuple<ModifierEffect const*, fixed_point_t>> effects;
+	value.for_each_non_zero_effect(
+		modifier_manager,
+		[&effects](ModifierEffect const& effect, const fixed_point_t effect_value) -> void {
+			effects.emplace_back(&effect, effect_value);
+		}
+	);
+	CHECK(effects == std::vector<std::tuple<ModifierEffect const*, fixed_point_t>> { { morale, 2 } });
+
+	std::ostringstream stream, expected_stream;
+	stream << value.print_effects(modifier_manager);
+	expected_stream << morale->get_identifier() << ": " << fixed_point_t { 2 } << "\n";
+	CHECK(stream.str() == expected_stream.str());
+}
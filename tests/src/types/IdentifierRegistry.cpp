@@ -88,6 +88,48 @@ TEST_CASE("IdentifierRegistry lock blocks further adds", "[IdentifierRegistry]")
 	CHECK(registry.size() == 1);
 }
 
+TEST_CASE("IdentifierRegistry lookups after lock", "[IdentifierRegistry]") {
+	IdentifierRegistry<TestItem> registry { "test", false };
+
+	for (std::string_view identifier : { "alpha"sv, "beta"sv, "gamma"sv, "delta"sv, "epsilon"sv, "zeta"sv, "eta"sv }) {
+		REQUIRE(registry.emplace_item(identifier, index_from_count<good_index_t>(registry.size()), identifier));
+	}
+	registry.lock();
+
+	TestItem const* epsilon = registry.get_item_by_identifier("epsilon");
+	REQUIRE(epsilon != nullptr);
+	CHECK(epsilon->index == good_index_t { 4 });
+	CHECK(registry.has_identifier("eta"));
+	CHECK_FALSE(registry.has_identifier("theta"));
+	CHECK_FALSE(registry.has_identifier(""));
+	CHECK_FALSE(registry.has_identifier("Alpha"));
+	CHECK(registry.get_item_by_identifier("iota") == nullptr);
+
+	/* Resetting unlocks the registry and forgets the identifiers it held when locked. */
+	registry.reset();
+	CHECK_FALSE(registry.has_identifier("alpha"));
+	REQUIRE(registry.emplace_item("theta", good_index_t { 0 }, "theta"));
+	CHECK(registry.has_identifier("theta"));
+	registry.lock();
+	CHECK(registry.has_identifier("theta"));
+	CHECK_FALSE(registry.has_identifier("alpha"));
+}
+
+TEST_CASE("CaseInsensitiveIdentifierRegistry lookups after lock", "[IdentifierRegistry]") {
+	CaseInsensitiveIdentifierRegistry<TestItem> registry { "test", false };
+
+	REQUIRE(registry.emplace_item("Alpha", good_index_t { 0 }, "Alpha"));
+	REQUIRE(registry.emplace_item("BETA", good_index_t { 1 }, "BETA"));
+	CHECK_FALSE(registry.emplace_item("alpha", good_index_t { 2 }, "alpha"));
+	registry.lock();
+
+	TestItem const* alpha = registry.get_item_by_identifier("aLPHA");
+	REQUIRE(alpha != nullptr);
+	CHECK(alpha->index == good_index_t { 0 });
+	CHECK(registry.has_identifier("beta"));
+	CHECK_FALSE(registry.has_identifier("gamma"));
+}
+
 TEST_CASE("IdentifierRegistry expect_item_identifier", "[IdentifierRegistry]") {
 	IdentifierRegistry<TestItem> registry { "test" };
 	REQUIRE(registry.emplace_item("alpha", good_index_t { 0 }, "alpha"));
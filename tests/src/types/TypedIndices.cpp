@@ -21,6 +21,7 @@ static_assert(sizeof(graphical_culture_index_t) == 4);
 static_assert(sizeof(ideology_index_t) == 4);
 static_assert(sizeof(invention_index_t) == 4);
 static_assert(sizeof(map_mode_index_t) == 4);
+static_assert(sizeof(modifier_effect_index_t) == 4);
 static_assert(sizeof(party_policy_index_t) == 4);
 static_assert(sizeof(party_policy_group_index_t) == 4);
 static_assert(sizeof(pop_type_index_t) == 4);